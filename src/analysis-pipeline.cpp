@@ -0,0 +1,50 @@
+/*
+ * Analysis Pipeline Implementation
+ * Copyright (C) 2025
+ */
+
+#include "analysis-pipeline.hpp"
+
+void KWeight::configure(const DspTables &tables)
+{
+	shelf = tables.kShelf;
+	highPass = tables.kHighPass;
+}
+
+void KWeight::reset()
+{
+	shelfState.reset();
+	highPassState.reset();
+}
+
+void Energy::begin()
+{
+	sum = 0.0;
+	peak = 0.0f;
+	count = 0;
+}
+
+void VadFeatures::configure(const DspTables &tables)
+{
+	const uint32_t rate = tables.config.sampleRate;
+	highPass = BiquadCoeffs::highPass(rate, 150.0, 0.707);
+	lowPass = BiquadCoeffs::lowPass(rate, std::min(4000.0, 0.45 * rate), 0.707);
+	frameLength = std::max<size_t>(1, static_cast<size_t>(rate * FRAME_SECONDS));
+}
+
+void VadFeatures::reset()
+{
+	highPassState.reset();
+	lowPassState.reset();
+	frames = 0;
+	position = 0;
+	bandSum = 0.0;
+}
+
+void VadFeatures::closeFrame()
+{
+	if (frames < MAX_FRAMES)
+		framePower[frames++] = bandSum / static_cast<double>(frameLength);
+	position = 0;
+	bandSum = 0.0;
+}
@@ -0,0 +1,160 @@
+/*
+ * Analysis Pipeline - Per-sample analysis stages fused into one loop
+ * Copyright (C) 2025
+ *
+ * Each stage takes one sample and returns the sample the next stage sees:
+ * filters (K-weighting) return the filtered value, measurements (energy,
+ * VAD features) accumulate and pass it through.
+ * Pipeline<A, B, C> runs every stage on a sample before moving to the
+ * next, so intermediates stay in registers and a block is read once. The
+ * stage list is a template argument, so each combination the analysis
+ * code uses is its own compiled loop with the stage calls inlined.
+ * processStaged() runs the same stages one pass each through a scratch
+ * buffer; it exists for the benchmark.
+ */
+
+#ifndef ANALYSIS_PIPELINE_HPP
+#define ANALYSIS_PIPELINE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+
+#include "biquad.hpp"
+#include "dsp-tables.hpp"
+
+// BS.1770 pre-filter and high-pass
+struct KWeight {
+	BiquadCoeffs shelf;
+	BiquadCoeffs highPass;
+	BiquadState shelfState;
+	BiquadState highPassState;
+
+	void configure(const DspTables &tables);
+	void reset();
+	void begin() {}
+
+	inline float process(float x) { return highPassState.process(highPass, shelfState.process(shelf, x)); }
+};
+
+// Mean square and peak of the samples seen since begin()
+struct Energy {
+	double sum = 0.0;
+	float peak = 0.0f;
+	size_t count = 0;
+
+	void configure(const DspTables &) {}
+	void reset() { begin(); }
+	void begin();
+
+	inline float process(float x)
+	{
+		sum += static_cast<double>(x) * x;
+		peak = std::max(peak, std::fabs(x));
+		count++;
+		return x;
+	}
+
+	double meanSquare() const { return count > 0 ? sum / static_cast<double>(count) : 0.0; }
+};
+
+// 10 ms speech-band (150 Hz - 4 kHz) mean square per frame, for the frames
+// that completed since begin(); the same filters and framing as
+// VoiceActivityDetector, which classifies them
+struct VadFeatures {
+	static constexpr size_t MAX_FRAMES = 32;
+	static constexpr float FRAME_SECONDS = 0.01f;
+
+	double framePower[MAX_FRAMES] = {};
+	size_t frames = 0;
+
+	BiquadCoeffs highPass;
+	BiquadCoeffs lowPass;
+	BiquadState highPassState;
+	BiquadState lowPassState;
+	size_t frameLength = 480;
+	size_t position = 0;
+	double bandSum = 0.0;
+
+	void configure(const DspTables &tables);
+	void reset();
+	void begin() { frames = 0; }
+
+	inline float process(float x)
+	{
+		const float band = lowPassState.process(lowPass, highPassState.process(highPass, x));
+		bandSum += static_cast<double>(band) * band;
+		if (++position == frameLength)
+			closeFrame();
+		return x;
+	}
+
+private:
+	void closeFrame();
+};
+
+template<typename... Stages> class Pipeline {
+public:
+	static constexpr size_t SCRATCH_FRAMES = 1024; // 4 KiB, stays in L1
+
+	void configure(const DspTables &tables)
+	{
+		std::apply([&tables](auto &...stage) { (stage.configure(tables), ...); }, stages);
+		reset();
+	}
+
+	void reset()
+	{
+		std::apply([](auto &...stage) { (stage.reset(), ...); }, stages);
+	}
+
+	// Start a block: per-block measurements restart
+	void begin()
+	{
+		std::apply([](auto &...stage) { (stage.begin(), ...); }, stages);
+	}
+
+	void process(const float *samples, size_t count)
+	{
+		std::apply(
+			[samples, count](auto &...stage) {
+				for (size_t i = 0; i < count; i++) {
+					float x = samples[i];
+					((x = stage.process(x)), ...);
+				}
+			},
+			stages);
+	}
+
+	// Same result as process(), one pass per stage through scratch
+	void processStaged(const float *samples, size_t count, float *scratch)
+	{
+		for (size_t pos = 0; pos < count; pos += SCRATCH_FRAMES) {
+			const size_t chunk = std::min(SCRATCH_FRAMES, count - pos);
+			std::copy(samples + pos, samples + pos + chunk, scratch);
+			std::apply([scratch, chunk](auto &...stage) { (runStage(stage, scratch, chunk), ...); }, stages);
+		}
+	}
+
+	template<size_t I> auto &stage() { return std::get<I>(stages); }
+	template<size_t I> const auto &stage() const { return std::get<I>(stages); }
+
+private:
+	template<typename Stage> static void runStage(Stage &stage, float *samples, size_t count)
+	{
+		for (size_t i = 0; i < count; i++)
+			samples[i] = stage.process(samples[i]);
+	}
+
+	std::tuple<Stages...> stages;
+};
+
+// The combinations the analysis worker runs: the first channel is measured
+// raw (level, peak), feeds the VAD and is K-weighted, the others are only
+// K-weighted
+using FirstChannelPipeline = Pipeline<Energy, VadFeatures, KWeight, Energy>;
+using ChannelPipeline = Pipeline<KWeight, Energy>;
+
+#endif // ANALYSIS_PIPELINE_HPP
@@ -0,0 +1,393 @@
+/*
+ * Analysis Worker Implementation
+ * Copyright (C) 2025
+ */
+
+#include "analysis-worker.hpp"
+#include <plugin-support.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+static inline float toDb(float amplitude)
+{
+	return amplitude > 0.00001f ? 20.0f * std::log10(amplitude) : -100.0f;
+}
+
+AnalysisTap::AnalysisTap(obs_source_t *source, double retroSeconds)
+{
+	audioSource = obs_source_get_ref(source);
+	const char *name = audioSource ? obs_source_get_name(audioSource) : nullptr;
+	sourceName = name ? name : "";
+
+	const DspConfig config = DspConfig::fromAudioOutput();
+	DspConfig analysis = config;
+	analysis.sampleRate = ANALYSIS_RATE;
+	tableHandle = DspTableHandle::create(analysis);
+
+	const size_t channels = std::max<uint32_t>(1, std::min<uint32_t>(config.channels, MAX_AUDIO_CHANNELS));
+	const size_t capacity = static_cast<size_t>(RING_SECONDS * config.sampleRate);
+	for (size_t ch = 0; ch < channels; ch++)
+		rings.push_back(std::make_unique<SampleRing>(capacity));
+	blockSamples.resize(channels);
+
+	timelineMonitor.configure(config.sampleRate);
+	setRetroSeconds(retroSeconds);
+	if (audioSource)
+		obs_source_add_audio_capture_callback(audioSource, audioCallback, this);
+}
+
+AnalysisTap::~AnalysisTap()
+{
+	if (audioSource) {
+		obs_source_remove_audio_capture_callback(audioSource, audioCallback, this);
+		obs_source_release(audioSource);
+	}
+}
+
+int AnalysisTap::addListener(AnalysisListener listener)
+{
+	std::lock_guard<std::mutex> lock(listenerMutex);
+	const int id = nextListenerId++;
+	listeners.emplace(id, std::move(listener));
+	return id;
+}
+
+void AnalysisTap::removeListener(int id)
+{
+	std::lock_guard<std::mutex> lock(listenerMutex);
+	listeners.erase(id);
+}
+
+void AnalysisTap::audioCallback(void *param, obs_source_t *, const struct audio_data *audioData, bool muted)
+{
+	auto *tap = static_cast<AnalysisTap *>(param);
+	if (!audioData || audioData->frames == 0)
+		return;
+	tap->timelineMonitor.check(audioData->timestamp, audioData->frames);
+
+	// Generation first: the ring loaded after it is at least that new
+	const uint64_t generation = tap->retroGeneration.load(std::memory_order_acquire);
+	if (RetroRing *retro = tap->activeRetroRing.load(std::memory_order_acquire); retro && !muted && audioData->data[0])
+		retro->push(audioData);
+	tap->retroAcknowledged.store(generation, std::memory_order_release);
+
+	static const float silence[AUDIO_OUTPUT_FRAMES] = {};
+	for (size_t ch = 0; ch < tap->rings.size(); ch++) {
+		const float *samples = reinterpret_cast<const float *>(audioData->data[ch]);
+		if (samples && !muted) {
+			tap->rings[ch]->write(samples, audioData->frames);
+			continue;
+		}
+		// Muted or missing planes still advance time, as silence
+		for (size_t done = 0; done < audioData->frames; done += AUDIO_OUTPUT_FRAMES)
+			tap->rings[ch]->write(silence, std::min<size_t>(AUDIO_OUTPUT_FRAMES, audioData->frames - done));
+	}
+}
+
+void AnalysisTap::setRetroSeconds(double seconds)
+{
+	std::lock_guard<std::mutex> lock(retroMutex);
+	const bool hasRing = activeRetroRing.load(std::memory_order_acquire) != nullptr;
+	if (seconds == retroLength && hasRing == (seconds > 0.0))
+		return;
+	retroLength = seconds;
+
+	std::shared_ptr<RetroRing> ring;
+	if (seconds > 0.0) {
+		const DspConfig config = DspConfig::fromAudioOutput();
+		ring = std::make_shared<RetroRing>(config.sampleRate, config.channels, seconds);
+	}
+	activeRetroRing.store(ring.get(), std::memory_order_release);
+	const uint64_t generation = retroGeneration.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+	for (RetroSlot &slot : retroRings) {
+		if (slot.retiredAt == UINT64_MAX)
+			slot.retiredAt = generation;
+	}
+	if (ring)
+		retroRings.push_back({std::move(ring), UINT64_MAX});
+	releaseRetroRings();
+}
+
+// With retroMutex held. Only callbacks that started before a swap can still
+// hold the ring it retired.
+void AnalysisTap::releaseRetroRings()
+{
+	const uint64_t acknowledged = retroAcknowledged.load(std::memory_order_acquire);
+	retroRings.erase(std::remove_if(retroRings.begin(), retroRings.end(),
+					[acknowledged](const RetroSlot &slot) { return slot.retiredAt <= acknowledged; }),
+			 retroRings.end());
+}
+
+std::shared_ptr<RetroRing> AnalysisTap::retroRing() const
+{
+	std::lock_guard<std::mutex> lock(retroMutex);
+	if (!activeRetroRing.load(std::memory_order_acquire) || retroRings.empty())
+		return nullptr;
+	return retroRings.back().ring;
+}
+
+void AnalysisTap::drain()
+{
+	// A ring retired by a resize is freed once the callback has moved on
+	if (std::unique_lock<std::mutex> lock(retroMutex, std::try_to_lock); lock && retroRings.size() > 1)
+		releaseRetroRings();
+
+	const DspConfig output = DspConfig::fromAudioOutput();
+	DspConfig analysis = output;
+	analysis.sampleRate = ANALYSIS_RATE;
+	const DspTables *tables = tableHandle->tablesFor(analysis);
+	if (!tables)
+		return;
+
+	if (tables != lastTables) {
+		firstChannel.configure(*tables);
+		for (auto &pipeline : otherChannels)
+			pipeline.configure(*tables);
+		vad.configure(ANALYSIS_RATE);
+		proximity.configure(ANALYSIS_RATE);
+		transientDetector.configure(ANALYSIS_RATE);
+		lastTables = tables;
+	}
+
+	if (output.sampleRate != sourceRate) {
+		// Identity plan when the output already runs at the analysis rate
+		const std::shared_ptr<const PolyphasePlan> plan =
+			DspTableCache::instance().resamplerPlan(output.sampleRate, ANALYSIS_RATE);
+		for (size_t ch = 0; ch < rings.size(); ch++) {
+			resamplers[ch].configure(plan);
+			blockSamples[ch].clear();
+		}
+		sourceRate = output.sampleRate;
+	}
+
+	const size_t readFrames = static_cast<size_t>(BLOCK_SECONDS * sourceRate);
+	const size_t blockFrames = static_cast<size_t>(BLOCK_SECONDS * ANALYSIS_RATE);
+	if (readFrames == 0)
+		return;
+
+	uint64_t written = UINT64_MAX;
+	uint64_t oldest = 0;
+	for (const auto &ring : rings) {
+		written = std::min(written, ring->written());
+		oldest = std::max(oldest, ring->oldest());
+	}
+
+	// Held only for its retro ring: keep up without analysing
+	bool idle = false;
+	{
+		std::lock_guard<std::mutex> lock(listenerMutex);
+		idle = listeners.empty();
+	}
+	if (idle) {
+		for (size_t ch = 0; ch < rings.size(); ch++) {
+			resamplers[ch].reset();
+			blockSamples[ch].clear();
+		}
+		readPosition = written;
+		return;
+	}
+
+	// Fell behind (worker stalled): skip what was overwritten
+	if (readPosition < oldest)
+		readPosition = oldest;
+
+	sourceSamples.resize(readFrames);
+	while (written - readPosition >= readFrames) {
+		bool ok = true;
+		for (size_t ch = 0; ch < rings.size() && ok; ch++) {
+			ok = rings[ch]->read(readPosition, sourceSamples.data(), readFrames);
+			if (ok)
+				resamplers[ch].process(sourceSamples.data(), readFrames, blockSamples[ch]);
+		}
+		if (!ok) {
+			// Channels must stay in step: restart the resamplers from the gap
+			for (size_t ch = 0; ch < rings.size(); ch++) {
+				resamplers[ch].reset();
+				blockSamples[ch].clear();
+			}
+			readPosition = rings[0]->oldest();
+			break;
+		}
+		readPosition += readFrames;
+
+		// Every channel has the same phase, so they fill up together
+		while (blockSamples[0].size() >= blockFrames) {
+			analyzeBlock(*tables, blockFrames);
+			for (auto &samples : blockSamples)
+				samples.erase(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(blockFrames));
+		}
+	}
+}
+
+void AnalysisTap::analyzeBlock(const DspTables &tables, size_t frames)
+{
+	AnalysisBlock block;
+	block.index = blockIndex++;
+	block.seconds = static_cast<double>(frames) / tables.config.sampleRate;
+
+	// Counted per drain, so the first block analysed after a gap carries it
+	const uint64_t discontinuities = timelineMonitor.discontinuities();
+	block.continuous = discontinuities == lastDiscontinuities;
+	lastDiscontinuities = discontinuities;
+
+	// First channel: unweighted level and peak, speech-band frame levels
+	// for the VAD, then K-weighted power, in one pass
+	const float *first = blockSamples[0].data();
+	firstChannel.begin();
+	firstChannel.process(first, frames);
+	const Energy &raw = firstChannel.stage<0>();
+	block.rmsDb = toDb(static_cast<float>(std::sqrt(raw.meanSquare())));
+	block.peakDb = toDb(raw.peak);
+
+	// K-weighted, channel-weighted power as in the analyzer's meter
+	const size_t channels = std::min(rings.size(), tables.channelWeights.size());
+	if (channels > 0)
+		block.kPower += static_cast<double>(tables.channelWeights[0]) * firstChannel.stage<3>().meanSquare();
+	for (size_t ch = 1; ch < channels; ch++) {
+		const float weight = tables.channelWeights[ch];
+		if (weight == 0.0f)
+			continue;
+		ChannelPipeline &pipeline = otherChannels[ch - 1];
+		pipeline.begin();
+		pipeline.process(blockSamples[ch].data(), frames);
+		block.kPower += static_cast<double>(weight) * pipeline.stage<1>().meanSquare();
+	}
+
+	// Majority of 10 ms frames voiced
+	const VadFeatures &features = firstChannel.stage<1>();
+	size_t voiced = 0;
+	for (size_t f = 0; f < features.frames; f++) {
+		if (vad.classify(features.framePower[f]))
+			voiced++;
+	}
+	block.speech = features.frames > 0 && voiced * 2 >= features.frames;
+	block.noiseFloorDb = vad.noiseFloorDb();
+
+	proximity.measure(first, frames, block.lowBandPower, block.midBandPower);
+
+	TransientEvent events[8];
+	block.transients = transientDetector.process(first, frames, events, 8);
+	for (int i = 0; i < std::min(block.transients, 8); i++) {
+		block.transientPeakDb = std::max(block.transientPeakDb, events[i].peakDb);
+		block.transientLevelDb = std::max(block.transientLevelDb, events[i].levelDb);
+	}
+
+	std::lock_guard<std::mutex> lock(listenerMutex);
+	for (auto &entry : listeners)
+		entry.second(block);
+}
+
+AnalysisWorker &AnalysisWorker::shared()
+{
+	static AnalysisWorker worker;
+	return worker;
+}
+
+AnalysisWorker::~AnalysisWorker()
+{
+	shutdown();
+}
+
+std::shared_ptr<AnalysisTap> AnalysisWorker::tap(obs_source_t *source)
+{
+	if (!source)
+		return nullptr;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if (stopping)
+		return nullptr;
+
+	for (const auto &weak : taps) {
+		std::shared_ptr<AnalysisTap> existing = weak.lock();
+		if (existing && existing->source() == source)
+			return existing;
+	}
+
+	std::shared_ptr<AnalysisTap> created(new AnalysisTap(source, retroLength));
+	if (!created->source())
+		return nullptr;
+	taps.push_back(created);
+
+	if (!thread.joinable()) {
+		thread = std::thread(&AnalysisWorker::run, this);
+		obs_log(LOG_INFO, "[AnalysisWorker] Started");
+	}
+	obs_log(LOG_INFO, "[AnalysisWorker] Tapped %s", created->name().c_str());
+	return created;
+}
+
+std::vector<std::shared_ptr<AnalysisTap>> AnalysisWorker::liveTaps()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	std::vector<std::shared_ptr<AnalysisTap>> result;
+	for (const auto &weak : taps) {
+		if (std::shared_ptr<AnalysisTap> tap = weak.lock())
+			result.push_back(std::move(tap));
+	}
+	return result;
+}
+
+void AnalysisWorker::setRetroSeconds(double seconds)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (seconds == retroLength)
+			return;
+		retroLength = seconds;
+	}
+	// Taps created from here on already get the new length
+	for (const auto &tap : liveTaps())
+		tap->setRetroSeconds(seconds);
+	obs_log(LOG_INFO, "[AnalysisWorker] Retro capture keeps %.0f s per source", seconds);
+}
+
+double AnalysisWorker::retroSeconds() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return retroLength;
+}
+
+void AnalysisWorker::shutdown()
+{
+	std::thread joining;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (stopping)
+			return;
+		stopping = true;
+		joining.swap(thread);
+	}
+	wake.notify_all();
+	if (joining.joinable())
+		joining.join();
+}
+
+void AnalysisWorker::run()
+{
+	std::vector<std::shared_ptr<AnalysisTap>> live;
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake.wait_for(lock, std::chrono::milliseconds(TICK_MS), [this]() { return stopping; });
+			if (stopping)
+				return;
+
+			taps.erase(std::remove_if(taps.begin(), taps.end(),
+						  [](const std::weak_ptr<AnalysisTap> &weak) { return weak.expired(); }),
+				   taps.end());
+			for (const auto &weak : taps) {
+				if (std::shared_ptr<AnalysisTap> tap = weak.lock())
+					live.push_back(std::move(tap));
+			}
+		}
+
+		for (const auto &tap : live)
+			tap->drain();
+
+		// A tap released elsewhere in the meantime is destroyed here
+		live.clear();
+	}
+}
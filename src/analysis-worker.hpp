@@ -0,0 +1,199 @@
+/*
+ * Analysis Worker - One background thread analysing every tapped source
+ * Copyright (C) 2025
+ *
+ * A tap copies a source's audio into per-channel rings from the capture
+ * callback and does nothing else on the audio thread. The worker drains
+ * all taps every few milliseconds and turns them into 100 ms analysis
+ * blocks (K-weighted power, level, peak, voice activity, proximity band
+ * energies, keyboard and desk transients), which are handed to the tap's
+ * listeners on the worker thread. Every source is first resampled to
+ * ANALYSIS_RATE (polyphase-resampler.hpp), so the analyzers always run at
+ * one rate whatever the output is set to. Level, peak, the VAD's speech-band
+ * frame levels and K-weighting of each channel run as one fused pass
+ * (analysis-pipeline.hpp).
+ * Several features can share one tap, so each source is filtered and
+ * measured once. Each tap also keeps a retro ring of the last
+ * AnalysisWorker::retroSeconds() of the source, so "did I just clip?" can
+ * be answered after the fact without the wizard open.
+ */
+
+#ifndef ANALYSIS_WORKER_HPP
+#define ANALYSIS_WORKER_HPP
+
+#include <obs.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "analysis-pipeline.hpp"
+#include "dsp-tables.hpp"
+#include "polyphase-resampler.hpp"
+#include "proximity-bands.hpp"
+#include "retro-capture.hpp"
+#include "sample-ring.hpp"
+#include "timeline-monitor.hpp"
+#include "transient-detector.hpp"
+#include "voice-activity.hpp"
+
+struct AnalysisBlock {
+	uint64_t index = 0;  // running block number for this tap
+	double seconds = 0.0;
+
+	// BS.1770 channel-weighted mean square of the K-weighted signal
+	double kPower = 0.0;
+
+	// First channel, unweighted
+	float rmsDb = -100.0f;
+	float peakDb = -100.0f;
+
+	bool speech = false; // most of the block was voiced
+	float noiseFloorDb = -100.0f;
+
+	// First channel, 100-300 Hz and 1-3 kHz mean square (decimated)
+	double lowBandPower = 0.0;
+	double midBandPower = 0.0;
+
+	// First channel, clicks and bumps that ended in this block
+	int transients = 0;
+	float transientPeakDb = -100.0f;
+	float transientLevelDb = -100.0f; // 10 ms RMS
+
+	// No gap or overlap in the source's timeline since the previous block
+	bool continuous = true;
+
+	float loudnessLufs() const
+	{
+		return kPower > 1e-10 ? static_cast<float>(-0.691 + 10.0 * std::log10(kPower)) : -100.0f;
+	}
+};
+
+using AnalysisListener = std::function<void(const AnalysisBlock &)>;
+
+class AnalysisTap {
+public:
+	// Rate every block is analysed at
+	static constexpr uint32_t ANALYSIS_RATE = 48000;
+
+	~AnalysisTap();
+
+	AnalysisTap(const AnalysisTap &) = delete;
+	AnalysisTap &operator=(const AnalysisTap &) = delete;
+
+	// Strong reference held for the tap's lifetime
+	obs_source_t *source() const { return audioSource; }
+	const std::string &name() const { return sourceName; }
+	const TimelineMonitor &timeline() const { return timelineMonitor; }
+
+	// Listeners run on the worker thread; keep them short
+	int addListener(AnalysisListener listener);
+	void removeListener(int id);
+
+	// Rolling buffer of the source's unmuted audio, every channel; nullptr
+	// while retro capture is disabled
+	std::shared_ptr<RetroRing> retroRing() const;
+
+private:
+	friend class AnalysisWorker;
+
+	AnalysisTap(obs_source_t *source, double retroSeconds);
+
+	static void audioCallback(void *param, obs_source_t *source, const struct audio_data *audioData, bool muted);
+
+	// Swap in a ring of this length. The callback switches on its next
+	// call; setting the current length again keeps the buffered audio.
+	void setRetroSeconds(double seconds);
+	void releaseRetroRings();
+
+	// Worker thread
+	void drain();
+	void analyzeBlock(const DspTables &tables, size_t frames);
+
+	static constexpr double BLOCK_SECONDS = 0.1;
+	static constexpr double RING_SECONDS = 2.0;
+
+	obs_source_t *audioSource = nullptr;
+	std::string sourceName;
+	std::shared_ptr<DspTableHandle> tableHandle;
+	std::vector<std::unique_ptr<SampleRing>> rings;
+	TimelineMonitor timelineMonitor;
+
+	// Worker-only state
+	uint64_t readPosition = 0;
+	uint64_t blockIndex = 0;
+	uint64_t lastDiscontinuities = 0;
+	const DspTables *lastTables = nullptr;
+	uint32_t sourceRate = 0;
+	PolyphaseResampler resamplers[MAX_AUDIO_CHANNELS];
+	std::vector<float> sourceSamples;
+	FirstChannelPipeline firstChannel;
+	ChannelPipeline otherChannels[MAX_AUDIO_CHANNELS - 1];
+	VoiceActivityDetector vad;
+	ProximityBands proximity;
+	TransientDetector transientDetector;
+	std::vector<std::vector<float>> blockSamples; // resampled, up to the next block boundary
+
+	std::mutex listenerMutex;
+	std::map<int, AnalysisListener> listeners;
+	int nextListenerId = 1;
+
+	// Retro ring, swapped as in AudioAnalyzer: every swap bumps
+	// retroGeneration and the callback acknowledges the generation it
+	// started with, so a superseded ring is freed once a callback that
+	// began after the swap has finished.
+	struct RetroSlot {
+		std::shared_ptr<RetroRing> ring;
+		uint64_t retiredAt = UINT64_MAX; // generation that replaced it
+	};
+	std::atomic<RetroRing *> activeRetroRing{nullptr};
+	std::atomic<uint64_t> retroGeneration{0};
+	std::atomic<uint64_t> retroAcknowledged{0};
+	mutable std::mutex retroMutex; // never taken by the callback
+	double retroLength = 0.0;
+	std::vector<RetroSlot> retroRings; // current ring last
+};
+
+class AnalysisWorker {
+public:
+	static AnalysisWorker &shared();
+
+	// Existing tap for this source, or a new one. The tap (and its capture
+	// callback) lives until the last shared_ptr is released.
+	std::shared_ptr<AnalysisTap> tap(obs_source_t *source);
+
+	// Every tap that is still alive
+	std::vector<std::shared_ptr<AnalysisTap>> liveTaps();
+
+	// Length of every tap's retro ring, now and for taps created later
+	// (0 disables). UI thread.
+	static constexpr double DEFAULT_RETRO_SECONDS = 30.0;
+	void setRetroSeconds(double seconds);
+	double retroSeconds() const;
+
+	void shutdown();
+
+private:
+	AnalysisWorker() = default;
+	~AnalysisWorker();
+
+	void run();
+
+	static constexpr int TICK_MS = 20;
+
+	mutable std::mutex mutex;
+	std::condition_variable wake;
+	std::thread thread;
+	bool stopping = false;
+	double retroLength = DEFAULT_RETRO_SECONDS;
+	std::vector<std::weak_ptr<AnalysisTap>> taps;
+};
+
+#endif // ANALYSIS_WORKER_HPP
@@ -6,6 +6,8 @@
 #include "audio-analyzer.hpp"
 #include <plugin-support.h>
 
+#include <algorithm>
+
 AudioAnalyzer::AudioAnalyzer()
 {
 }
@@ -51,15 +53,29 @@ void AudioAnalyzer::audioCallback(void *param, obs_source_t *source,
 
 void AudioAnalyzer::processAudio(const struct audio_data *audioData, bool muted)
 {
-    if (!capturing.load() || muted || !audioData)
+    if (!capturing.load() || !audioData)
         return;
-    
-    if (audioData->frames == 0 || !audioData->data[0])
+
+    // Ahead of the mute check: muted audio still advances the timeline
+    timeline.check(audioData->timestamp, audioData->frames);
+
+    const bool silent = muted || audioData->frames == 0 || !audioData->data[0];
+
+    // Generation first: the buffer loaded after it is at least that new
+    const uint64_t captureGen = captureGeneration.load(std::memory_order_acquire);
+    if (StepBuffer *buffer = stepBuffer.load(std::memory_order_acquire); buffer && !silent)
+        buffer->write(audioData);
+    captureAcknowledged.store(captureGen, std::memory_order_release);
+
+    if (silent)
         return;
     
     // Process first channel (mono or left)
     const float *samples = reinterpret_cast<const float*>(audioData->data[0]);
     size_t frameCount = audioData->frames;
+
+    if (history)
+        history->push(samples, frameCount);
     
     // Calculate RMS
     float rms = calculateRMS(samples, frameCount);
@@ -88,6 +104,78 @@ void AudioAnalyzer::processAudio(const struct audio_data *audioData, bool muted)
     if (peakDB > currentMax) {
         maxPeak.store(peakDB);
     }
+
+    processLoudness(audioData);
+}
+
+void AudioAnalyzer::StepBuffer::write(const struct audio_data *audioData)
+{
+    const size_t written = frames.load(std::memory_order_relaxed);
+    const size_t taken = std::min<size_t>(audioData->frames, samples.size() - written);
+    if (taken == 0)
+        return;
+
+    const float *first = reinterpret_cast<const float*>(audioData->data[0]);
+    std::copy(first, first + taken, samples.begin() + static_cast<std::ptrdiff_t>(written));
+
+    // Blocks before the source went multi-channel stay silent in the mix
+    size_t planes = 1;
+    while (planes < MAX_AUDIO_CHANNELS && audioData->data[planes])
+        planes++;
+    if (planes > 1 && !mix.empty()) {
+        const float scale = 1.0f / static_cast<float>(planes);
+        for (size_t i = 0; i < taken; i++) {
+            float sum = 0.0f;
+            for (size_t ch = 0; ch < planes; ch++)
+                sum += reinterpret_cast<const float*>(audioData->data[ch])[i];
+            mix[written + i] = sum * scale;
+        }
+        mixed.store(true, std::memory_order_relaxed);
+    }
+
+    frames.store(written + taken, std::memory_order_release);
+}
+
+void AudioAnalyzer::processLoudness(const struct audio_data *audioData)
+{
+    const DspTables *tables = tableHandle ? tableHandle->tablesFor(DspConfig::fromAudioOutput()) : nullptr;
+    if (!tables)
+        return;
+
+    // Filter state belongs to the previous configuration after a reset
+    if (tables != lastTables) {
+        for (size_t ch = 0; ch < MAX_AUDIO_CHANNELS; ch++) {
+            kShelfState[ch].reset();
+            kHighPassState[ch].reset();
+        }
+        loudnessPower = 0.0;
+        lastTables = tables;
+    }
+
+    const size_t frameCount = audioData->frames;
+    const size_t channels = std::min<size_t>(tables->config.channels, MAX_AUDIO_CHANNELS);
+    double weighted = 0.0;
+    for (size_t ch = 0; ch < channels; ch++) {
+        const float *samples = reinterpret_cast<const float*>(audioData->data[ch]);
+        const float weight = tables->channelWeights[ch];
+        if (!samples || weight == 0.0f)
+            continue;
+
+        BiquadState &shelf = kShelfState[ch];
+        BiquadState &highPass = kHighPassState[ch];
+        double sum = 0.0;
+        for (size_t i = 0; i < frameCount; i++) {
+            const float y = highPass.process(tables->kHighPass, shelf.process(tables->kShelf, samples[i]));
+            sum += static_cast<double>(y * y);
+        }
+        weighted += static_cast<double>(weight) * sum / static_cast<double>(frameCount);
+    }
+
+    loudnessPower += static_cast<double>(tables->momentaryAlpha) * (weighted - loudnessPower);
+    const float lufs = loudnessPower > 1e-10
+        ? static_cast<float>(-0.691 + 10.0 * std::log10(loudnessPower))
+        : -100.0f;
+    currentLoudness.store(lufs);
 }
 
 bool AudioAnalyzer::startCapture(obs_source_t *source)
@@ -109,8 +197,19 @@ bool AudioAnalyzer::startCapture(obs_source_t *source)
     // Reset levels
     currentRMS.store(0.0f);
     currentPeak.store(-100.0f);
+    currentLoudness.store(-100.0f);
     smoothedRMS = 0.0f;
-    
+
+    // Cache hit for every source after the first at this configuration
+    tableHandle = DspTableHandle::create(DspConfig::fromAudioOutput());
+    lastTables = nullptr;
+
+    history.reset();
+    if (historySeconds > 0.0)
+        history = PcmHistory::create(DspConfig::fromAudioOutput().sampleRate, historySeconds);
+
+    timeline.configure(DspConfig::fromAudioOutput().sampleRate);
+
     // Add audio capture callback
     obs_source_add_audio_capture_callback(audioSource, audioCallback, this);
     capturing.store(true);
@@ -121,12 +220,80 @@ bool AudioAnalyzer::startCapture(obs_source_t *source)
     return true;
 }
 
+void AudioAnalyzer::beginStepCapture(double maxSeconds)
+{
+    const DspConfig config = DspConfig::fromAudioOutput();
+    const size_t capacity = static_cast<size_t>(maxSeconds * config.sampleRate);
+    auto buffer = std::make_shared<StepBuffer>();
+    buffer->samples.resize(capacity);
+    if (config.channels > 1)
+        buffer->mix.resize(capacity);
+    captureRate = config.sampleRate;
+    swapStepBuffer(std::move(buffer));
+}
+
+CapturedAudioPtr AudioAnalyzer::endStepCapture()
+{
+    if (!stepBuffer.load(std::memory_order_acquire))
+        return nullptr;
+    const std::shared_ptr<StepBuffer> buffer = stepBuffers.back().buffer;
+    swapStepBuffer(nullptr);
+
+    // Copy what was published; a callback still writing past it is left out
+    const size_t frames = buffer->frames.load(std::memory_order_acquire);
+    auto capture = std::make_shared<CapturedAudio>();
+    capture->sampleRate = captureRate;
+    capture->samples.assign(buffer->samples.begin(), buffer->samples.begin() + static_cast<std::ptrdiff_t>(frames));
+    if (buffer->mixed.load(std::memory_order_relaxed))
+        capture->mix.assign(buffer->mix.begin(), buffer->mix.begin() + static_cast<std::ptrdiff_t>(frames));
+    return capture;
+}
+
+// UI thread
+void AudioAnalyzer::swapStepBuffer(std::shared_ptr<StepBuffer> next)
+{
+    stepBuffer.store(next.get(), std::memory_order_release);
+    const uint64_t generation = captureGeneration.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+    for (StepSlot &slot : stepBuffers) {
+        if (slot.retiredAt == UINT64_MAX)
+            slot.retiredAt = generation;
+    }
+    if (next)
+        stepBuffers.push_back({std::move(next), UINT64_MAX});
+    releaseStepBuffers();
+}
+
+void AudioAnalyzer::releaseStepBuffers()
+{
+    const uint64_t acknowledged =
+        capturing.load() ? captureAcknowledged.load(std::memory_order_acquire) : UINT64_MAX - 1;
+    stepBuffers.erase(std::remove_if(stepBuffers.begin(), stepBuffers.end(),
+                                     [acknowledged](const StepSlot &slot) {
+                                         return slot.retiredAt <= acknowledged;
+                                     }),
+                      stepBuffers.end());
+}
+
 void AudioAnalyzer::stopCapture()
 {
     if (capturing.load() && audioSource) {
         obs_source_remove_audio_capture_callback(audioSource, audioCallback, this);
         obs_source_release(audioSource);
         audioSource = nullptr;
+
+        // The callback is gone, so retired buffers can go
+        captureAcknowledged.store(captureGeneration.load());
+        releaseStepBuffers();
+
+        if (history) {
+            const PcmHistory::Stats stats = history->stats();
+            obs_log(LOG_INFO, "[AudioAnalyzer] History: %zu blocks, %.1f MB, ratio %.2fx, "
+                    "encode %.1f ms, %llu samples dropped",
+                    stats.storedBlocks, static_cast<double>(stats.storedBytes) / 1e6,
+                    stats.ratio(), static_cast<double>(stats.encodeNs) / 1e6,
+                    static_cast<unsigned long long>(stats.droppedSamples));
+        }
     }
     capturing.store(false);
     
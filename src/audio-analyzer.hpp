@@ -9,9 +9,30 @@
 #include <obs.h>
 #include <cmath>
 #include <atomic>
-#include <mutex>
+#include <cstdint>
+#include <memory>
 #include <vector>
 
+#include "dsp-tables.hpp"
+#include "pcm-history.hpp"
+#include "timeline-monitor.hpp"
+
+// Raw first-channel audio captured during one calibration step
+struct CapturedAudio {
+    uint32_t sampleRate = 0;
+    std::vector<float> samples; // first channel
+    std::vector<float> mix;     // mean of all channels; empty for mono sources
+
+    // What detectors that run on the channel mean (the breath filter) hear
+    const std::vector<float> &channelMean() const { return mix.empty() ? samples : mix; }
+
+    double seconds() const
+    {
+        return sampleRate ? static_cast<double>(samples.size()) / sampleRate : 0.0;
+    }
+};
+using CapturedAudioPtr = std::shared_ptr<const CapturedAudio>;
+
 class AudioAnalyzer {
 public:
     AudioAnalyzer();
@@ -25,6 +46,8 @@ public:
     float getCurrentRMS() const { return currentRMS.load(); }
     float getCurrentPeak() const { return currentPeak.load(); }
     float getMaxPeak() const { return maxPeak.load(); }
+    // K-weighted momentary loudness (LUFS, 400 ms), all channels
+    float getCurrentLoudness() const { return currentLoudness.load(); }
     
     // Convert to dB
     static float toDB(float amplitude);
@@ -36,22 +59,80 @@ public:
     // Check if capturing
     bool isCapturing() const { return capturing.load(); }
 
+    // Callback timestamp continuity since startCapture()
+    const TimelineMonitor &getTimeline() const { return timeline; }
+
+    // Record raw samples for a calibration step (at most maxSeconds; the
+    // buffer is allocated here so the audio thread only copies). A callback
+    // still running when the capture ends is left out of it.
+    void beginStepCapture(double maxSeconds);
+    CapturedAudioPtr endStepCapture();
+
+    // Keep a compressed history of the first channel for this many seconds
+    // (0 disables). Takes effect on the next startCapture().
+    void setHistorySeconds(double seconds) { historySeconds = seconds; }
+    std::shared_ptr<PcmHistory> getHistory() const { return history; }
+
 private:
+    // Preallocated buffer the audio thread records a step into
+    struct StepBuffer {
+        std::vector<float> samples;    // sized to the maximum
+        std::vector<float> mix;        // same; empty for mono output
+        std::atomic<size_t> frames{0}; // published by the audio thread
+        std::atomic<bool> mixed{false};
+
+        void write(const struct audio_data *audioData);
+    };
+
     static void audioCallback(void *param, obs_source_t *source,
                               const struct audio_data *audioData, bool muted);
     
     void processAudio(const struct audio_data *audioData, bool muted);
+    void processLoudness(const struct audio_data *audioData);
     float calculateRMS(const float *samples, size_t count);
+    void swapStepBuffer(std::shared_ptr<StepBuffer> next);
+    void releaseStepBuffers();
 
     obs_source_t *audioSource = nullptr;
     std::atomic<bool> capturing{false};
     std::atomic<float> currentRMS{0.0f};
     std::atomic<float> currentPeak{-100.0f};
     std::atomic<float> maxPeak{-100.0f};
+    std::atomic<float> currentLoudness{-100.0f};
     
     // Smoothing
     float smoothedRMS = 0.0f;
     static constexpr float SMOOTHING_FACTOR = 0.1f;
+
+    // Shared precomputed tables (K-weighting, FFT plan, band map) for the
+    // current audio configuration; re-planned off-thread on audio reset
+    std::shared_ptr<DspTableHandle> tableHandle;
+    const DspTables *lastTables = nullptr;
+    BiquadState kShelfState[MAX_AUDIO_CHANNELS];
+    BiquadState kHighPassState[MAX_AUDIO_CHANNELS];
+    double loudnessPower = 0.0;
+
+    TimelineMonitor timeline;
+
+    // Step capture. Every swap bumps captureGeneration and the audio
+    // thread acknowledges the generation it started each callback with,
+    // so a superseded buffer is freed once a callback that began after the
+    // swap has finished. The callback publishes each block through the
+    // buffer's frame count, so endStepCapture() copies the published part
+    // without waiting.
+    struct StepSlot {
+        std::shared_ptr<StepBuffer> buffer;
+        uint64_t retiredAt = UINT64_MAX;
+    };
+    uint32_t captureRate = 0;
+    std::atomic<StepBuffer*> stepBuffer{nullptr};
+    std::atomic<uint64_t> captureGeneration{0};
+    std::atomic<uint64_t> captureAcknowledged{0};
+    std::vector<StepSlot> stepBuffers; // UI thread; current buffer last
+
+    // Rolling history, replaced on each startCapture
+    double historySeconds = 0.0;
+    std::shared_ptr<PcmHistory> history;
 };
 
 #endif // AUDIO_ANALYZER_HPP
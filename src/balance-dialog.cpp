@@ -0,0 +1,119 @@
+/*
+ * Balance Dialog Implementation
+ * Copyright (C) 2025
+ */
+
+#include "balance-dialog.hpp"
+
+#include <obs-module.h>
+
+#include "plugin-support.h"
+#include "loudness-balancer.hpp"
+
+#include <QVBoxLayout>
+
+BalanceDialog::BalanceDialog(QWidget *parent) : QDialog(parent)
+{
+	setWindowTitle("Live Loudness Balance");
+	setModal(false);
+	setMinimumWidth(360);
+
+	auto *mainLayout = new QVBoxLayout(this);
+	mainLayout->setSpacing(6);
+	mainLayout->setContentsMargins(8, 8, 8, 8);
+
+	auto *hint = new QLabel("Tick each host's microphone. While running, talkers are kept within 1 LU of each "
+				"other by nudging their volume; stopping restores the original faders.");
+	hint->setWordWrap(true);
+	mainLayout->addWidget(hint);
+
+	sourceList = new QListWidget(this);
+	mainLayout->addWidget(sourceList, 1);
+
+	toggleButton = new QPushButton("Start", this);
+	mainLayout->addWidget(toggleButton);
+
+	statusLabel = new QLabel(this);
+	statusLabel->setTextFormat(Qt::PlainText);
+	mainLayout->addWidget(statusLabel);
+
+	connect(toggleButton, &QPushButton::clicked, this, &BalanceDialog::onToggleClicked);
+
+	statusTimer = new QTimer(this);
+	connect(statusTimer, &QTimer::timeout, this, &BalanceDialog::updateStatus);
+	statusTimer->start(500);
+
+	populateAudioSources();
+	updateStatus();
+}
+
+void BalanceDialog::populateAudioSources()
+{
+	sourceList->clear();
+
+	obs_enum_sources(
+		[](void *param, obs_source_t *source) {
+			auto *list = static_cast<QListWidget *>(param);
+			if (!source)
+				return true;
+
+			const uint32_t flags = obs_source_get_output_flags(source);
+			if ((flags & OBS_SOURCE_AUDIO) == 0)
+				return true;
+
+			const char *name = obs_source_get_name(source);
+			if (!name || !*name)
+				return true;
+
+			auto *item = new QListWidgetItem(QString::fromUtf8(name), list);
+			item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+			item->setCheckState(Qt::Unchecked);
+			return true;
+		},
+		sourceList);
+}
+
+void BalanceDialog::onToggleClicked()
+{
+	LoudnessBalancer &balancer = LoudnessBalancer::instance();
+	if (balancer.isRunning()) {
+		balancer.stop();
+		updateStatus();
+		return;
+	}
+
+	std::vector<std::string> names;
+	for (int i = 0; i < sourceList->count(); i++) {
+		QListWidgetItem *item = sourceList->item(i);
+		if (item->checkState() == Qt::Checked)
+			names.push_back(item->text().toStdString());
+	}
+
+	if (!balancer.start(names))
+		statusLabel->setText("Select at least two audio sources.");
+	else
+		updateStatus();
+}
+
+void BalanceDialog::updateStatus()
+{
+	LoudnessBalancer &balancer = LoudnessBalancer::instance();
+	const bool running = balancer.isRunning();
+	toggleButton->setText(running ? "Stop" : "Start");
+	sourceList->setEnabled(!running);
+	if (!running)
+		return;
+
+	QString text;
+	for (const BalanceHostStatus &host : balancer.status()) {
+		const QString level = host.loudnessLufs > -99.0f ? QString::number(host.loudnessLufs, 'f', 1) + " LUFS"
+								 : QString("--");
+		const bool moved = host.distance == MicDistance::TooClose || host.distance == MicDistance::TooFar;
+		text += QString("%1: %2, %3%4 dB%5%6\n")
+				.arg(QString::fromStdString(host.name), level, host.offsetDb >= 0.0f ? "+" : "")
+				.arg(host.offsetDb, 0, 'f', 1)
+				.arg(host.active ? "  (talking)" : "")
+				.arg(moved ? QString("  (%1)").arg(DistanceMonitor::describe(host.distance)) : QString());
+	}
+	statusLabel->setText(text.trimmed());
+}
@@ -0,0 +1,37 @@
+/*
+ * Balance Dialog Header
+ * Copyright (C) 2025
+ *
+ * Pick the hosts' microphones and keep them level with each other live
+ */
+
+#ifndef BALANCE_DIALOG_HPP
+#define BALANCE_DIALOG_HPP
+
+#include <QDialog>
+#include <QLabel>
+#include <QListWidget>
+#include <QPushButton>
+#include <QTimer>
+
+class BalanceDialog : public QDialog
+{
+	Q_OBJECT
+
+public:
+	explicit BalanceDialog(QWidget *parent = nullptr);
+
+private slots:
+	void onToggleClicked();
+	void updateStatus();
+
+private:
+	void populateAudioSources();
+
+	QListWidget *sourceList;
+	QPushButton *toggleButton;
+	QLabel *statusLabel;
+	QTimer *statusTimer;
+};
+
+#endif // BALANCE_DIALOG_HPP
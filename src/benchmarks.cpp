@@ -0,0 +1,606 @@
+/*
+ * Benchmarks Implementation
+ * Copyright (C) 2025
+ */
+
+#include "benchmarks.hpp"
+#include "analysis-pipeline.hpp"
+#include "biquad.hpp"
+#include "filter-models.hpp"
+#include "meter-bridge-widget.hpp"
+#include "multiband-compressor.hpp"
+#include "pcm-codec.hpp"
+#include "polyphase-resampler.hpp"
+#include "sweep-measurement.hpp"
+
+#include <obs-module.h>
+#include <plugin-support.h>
+#include <util/platform.h>
+
+#include <QImage>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static constexpr double PI = 3.14159265358979323846;
+static constexpr uint32_t SAMPLE_RATE = 48000;
+
+static double elapsedMs(uint64_t startNs)
+{
+	return static_cast<double>(os_gettime_ns() - startNs) / 1e6;
+}
+
+// Speech-like test signal: gliding harmonic voice with a syllable envelope,
+// pauses, and a low noise floor
+static std::vector<float> makeVoiceSignal(double seconds)
+{
+	const size_t count = static_cast<size_t>(seconds * SAMPLE_RATE);
+	std::vector<float> samples(count);
+	std::mt19937 rng(1234);
+	std::normal_distribution<float> noise(0.0f, 1.0f);
+
+	double phase = 0.0;
+	for (size_t i = 0; i < count; i++) {
+		const double t = static_cast<double>(i) / SAMPLE_RATE;
+		const double f0 = 140.0 + 40.0 * std::sin(2.0 * PI * 0.3 * t);
+		phase += 2.0 * PI * f0 / SAMPLE_RATE;
+
+		const double syllable = std::max(0.0, std::sin(2.0 * PI * 4.0 * t));
+		const double phrase = std::fmod(t, 6.0) < 4.5 ? 1.0 : 0.0;
+		const double voice = 0.5 * std::sin(phase) + 0.25 * std::sin(2.0 * phase) +
+				     0.12 * std::sin(3.0 * phase) + 0.06 * std::sin(5.0 * phase);
+
+		samples[i] = static_cast<float>(0.4 * syllable * phrase * voice + 0.0005 * noise(rng));
+	}
+	return samples;
+}
+
+void Benchmarks::runAll()
+{
+	obs_log(LOG_INFO, "[Benchmarks] Starting");
+	pcmCodec();
+	sweepResponse();
+	multibandCompressor();
+	analysisPipeline();
+	resampler();
+	obs_log(LOG_INFO, "[Benchmarks] Done");
+}
+
+void Benchmarks::pcmCodec()
+{
+	const double seconds = 60.0;
+	const std::vector<float> input = makeVoiceSignal(seconds);
+	const size_t blockCount = (input.size() + PcmCodec::BLOCK_SAMPLES - 1) / PcmCodec::BLOCK_SAMPLES;
+
+	std::vector<uint8_t> encoded;
+	std::vector<size_t> offsets;
+	offsets.reserve(blockCount + 1);
+
+	uint64_t start = os_gettime_ns();
+	for (size_t pos = 0; pos < input.size(); pos += PcmCodec::BLOCK_SAMPLES) {
+		offsets.push_back(encoded.size());
+		PcmCodec::encodeBlock(input.data() + pos, std::min(PcmCodec::BLOCK_SAMPLES, input.size() - pos), encoded);
+	}
+	offsets.push_back(encoded.size());
+	const double encodeMs = elapsedMs(start);
+
+	// Full decode doubles as the lossless check
+	std::vector<float> decoded(input.size());
+	start = os_gettime_ns();
+	for (size_t b = 0; b < blockCount; b++) {
+		PcmCodec::decodeBlock(encoded.data() + offsets[b], offsets[b + 1] - offsets[b],
+				      decoded.data() + b * PcmCodec::BLOCK_SAMPLES, PcmCodec::BLOCK_SAMPLES);
+	}
+	const double decodeMs = elapsedMs(start);
+
+	size_t mismatches = 0;
+	for (size_t i = 0; i < input.size(); i++) {
+		if (decoded[i] != PcmCodec::dequantize(PcmCodec::quantize(input[i])))
+			mismatches++;
+	}
+
+	// Random 1 s reads: decode every block the range touches
+	std::mt19937 rng(42);
+	const size_t rangeSamples = SAMPLE_RATE;
+	std::uniform_int_distribution<size_t> pick(0, input.size() - rangeSamples);
+	std::vector<float> scratch(rangeSamples + 2 * PcmCodec::BLOCK_SAMPLES);
+	const int reads = 200;
+	double totalReadMs = 0.0;
+	double worstReadMs = 0.0;
+	for (int r = 0; r < reads; r++) {
+		const size_t first = pick(rng) / PcmCodec::BLOCK_SAMPLES;
+		const size_t last = std::min(blockCount - 1, (first * PcmCodec::BLOCK_SAMPLES + rangeSamples) /
+								     PcmCodec::BLOCK_SAMPLES);
+		start = os_gettime_ns();
+		float *out = scratch.data();
+		for (size_t b = first; b <= last; b++)
+			out += PcmCodec::decodeBlock(encoded.data() + offsets[b], offsets[b + 1] - offsets[b], out,
+						     PcmCodec::BLOCK_SAMPLES);
+		const double ms = elapsedMs(start);
+		totalReadMs += ms;
+		worstReadMs = std::max(worstReadMs, ms);
+	}
+
+	const double rawFloatBytes = static_cast<double>(input.size() * sizeof(float));
+	const double raw24Bytes = static_cast<double>(input.size() * 3);
+	const double encodedBytes = static_cast<double>(std::max<size_t>(encoded.size(), 1));
+
+	obs_log(LOG_INFO,
+		"[Benchmarks] PCM codec: %.0f s mono, %.2f MB -> %.2f MB, ratio %.2fx vs float, %.2fx vs 24-bit, "
+		"%zu mismatches",
+		seconds, rawFloatBytes / 1e6, encodedBytes / 1e6, rawFloatBytes / encodedBytes,
+		raw24Bytes / encodedBytes, mismatches);
+	obs_log(LOG_INFO, "[Benchmarks] PCM codec: encode %.1f ms (%.0fx realtime), decode %.1f ms (%.0fx realtime)",
+		encodeMs, seconds * 1000.0 / std::max(encodeMs, 1e-3), decodeMs,
+		seconds * 1000.0 / std::max(decodeMs, 1e-3));
+	obs_log(LOG_INFO, "[Benchmarks] PCM codec: random 1 s read avg %.3f ms, worst %.3f ms over %d reads",
+		totalReadMs / reads, worstReadMs, reads);
+}
+
+void Benchmarks::sweepResponse()
+{
+	const SweepParams params;
+	const ExponentialSweep sweep(params);
+
+	// Synthetic room: direct sound with a proximity bump and a dull top,
+	// two early reflections and a 0.3 s diffuse tail
+	std::vector<float> room(static_cast<size_t>(0.3 * SAMPLE_RATE), 0.0f);
+	room[0] = 0.5f;
+	room[149] += 0.25f;
+	room[379] -= 0.15f;
+	std::mt19937 rng(99);
+	std::normal_distribution<float> diffuse(0.0f, 1.0f);
+	for (size_t i = 200; i < room.size(); i++)
+		room[i] += 0.02f * diffuse(rng) * static_cast<float>(std::exp(-6.9 * i / (0.3 * SAMPLE_RATE)));
+	const BiquadCoeffs bump = BiquadCoeffs::peaking(SAMPLE_RATE, 150.0, 1.0, 6.0);
+	const BiquadCoeffs dull = BiquadCoeffs::highShelf(SAMPLE_RATE, 8000.0, 0.7, -4.0);
+	BiquadState bumpState;
+	BiquadState dullState;
+	for (float &sample : room)
+		sample = dullState.process(dull, bumpState.process(bump, sample));
+
+	// Half a second of lead-in plus 10 ms of flight, -80 dBFS noise
+	const size_t delay = SAMPLE_RATE / 2 + SAMPLE_RATE / 100;
+	const std::vector<float> recording =
+		SweepDeconvolver::simulatePlayback(sweep.samples(), room, delay, -80.0f, 5);
+
+	uint64_t start = os_gettime_ns();
+	const SweepDeconvolver deconvolver(sweep, recording.size());
+	const double planMs = elapsedMs(start);
+
+	const int runs = 5;
+	double totalMs = 0.0;
+	double worstMs = 0.0;
+	SweepResult result;
+	for (int r = 0; r < runs; r++) {
+		result = deconvolver.deconvolve(recording.data(), recording.size());
+		totalMs += result.deconvolveMs;
+		worstMs = std::max(worstMs, result.deconvolveMs);
+	}
+	if (!result.ok) {
+		obs_log(LOG_WARNING, "[Benchmarks] Sweep: %s", result.message.c_str());
+		return;
+	}
+
+	// Reference: the room's own response, windowed like the measurement
+	const size_t pre = static_cast<size_t>(SweepDeconvolver::PRE_SECONDS * SAMPLE_RATE);
+	std::vector<float> reference(result.impulse.size(), 0.0f);
+	std::copy(room.begin(), room.end(), reference.begin() + static_cast<std::ptrdiff_t>(pre));
+	const std::vector<ResponsePoint> expected = SweepDeconvolver::frequencyResponse(
+		reference.data(), reference.size(), SAMPLE_RATE, params.startHz, params.endHz);
+
+	float worstErrorDb = 0.0f;
+	for (size_t i = 0; i < expected.size() && i < result.response.size(); i++) {
+		if (expected[i].hz >= 50.0f && expected[i].hz <= 12000.0f)
+			worstErrorDb = std::max(worstErrorDb, std::fabs(result.response[i].db - expected[i].db));
+	}
+
+	obs_log(LOG_INFO,
+		"[Benchmarks] Sweep: %.0f s at %u Hz, plan %.1f ms, deconvolve avg %.1f ms worst %.1f ms "
+		"(budget 100 ms) over %d runs",
+		params.seconds, params.sampleRate, planMs, totalMs / runs, worstMs, runs);
+	obs_log(LOG_INFO, "[Benchmarks] Sweep: latency %.2f ms (expected %.2f), 50 Hz-12 kHz worst error %.2f dB, %s",
+		result.latencyMs, 1000.0 * delay / SAMPLE_RATE, worstErrorDb, result.summary().c_str());
+}
+
+void Benchmarks::multibandCompressor()
+{
+	const double seconds = 60.0;
+	const size_t channels = 2;
+	const size_t block = 1024; // OBS audio block
+	const std::vector<float> voice = makeVoiceSignal(seconds);
+	std::vector<float> left(voice);
+	std::vector<float> right(voice);
+	const CompressorBand bands[CompressorBand::BANDS] = {
+		{-24.0f, 3.0f, 15.0f, 150.0f}, {-24.0f, 2.0f, 8.0f, 100.0f}, {-30.0f, 3.0f, 2.0f, 60.0f}};
+
+	// Native: every band of every channel in one loop
+	MultibandSettings settings;
+	std::copy(std::begin(bands), std::end(bands), settings.bands);
+	MultibandCompressor native;
+	native.configure(SAMPLE_RATE, channels, settings);
+	uint64_t start = os_gettime_ns();
+	for (size_t pos = 0; pos < voice.size(); pos += block) {
+		float *planes[2] = {left.data() + pos, right.data() + pos};
+		native.process(planes, std::min(block, voice.size() - pos));
+	}
+	const double nativeMs = elapsedMs(start);
+
+	// Stock parts: per channel, the crossover sections one at a time and
+	// a compressor per band, summed back
+	const BiquadCoeffs lowPass = BiquadCoeffs::lowPass(SAMPLE_RATE, settings.lowHz, 0.7071);
+	const BiquadCoeffs lowHighPass = BiquadCoeffs::highPass(SAMPLE_RATE, settings.lowHz, 0.7071);
+	const BiquadCoeffs highLowPass = BiquadCoeffs::lowPass(SAMPLE_RATE, settings.highHz, 0.7071);
+	const BiquadCoeffs highPass = BiquadCoeffs::highPass(SAMPLE_RATE, settings.highHz, 0.7071);
+	BiquadState state[2][12];
+	CompressorModel compressors[2][CompressorBand::BANDS];
+	for (auto &channel : compressors) {
+		for (int b = 0; b < CompressorBand::BANDS; b++)
+			channel[b].configure(SAMPLE_RATE, bands[b].ratio, bands[b].thresholdDb, bands[b].attackMs,
+					     bands[b].releaseMs, 0.0f);
+	}
+	left = voice;
+	right = voice;
+	std::vector<float> split[CompressorBand::BANDS];
+	for (auto &band : split)
+		band.resize(block);
+	start = os_gettime_ns();
+	for (size_t pos = 0; pos < voice.size(); pos += block) {
+		const size_t frames = std::min(block, voice.size() - pos);
+		float *planes[2] = {left.data() + pos, right.data() + pos};
+		for (size_t c = 0; c < channels; c++) {
+			BiquadState *s = state[c];
+			for (size_t i = 0; i < frames; i++) {
+				const float x = planes[c][i];
+				const float low = s[1].process(lowPass, s[0].process(lowPass, x));
+				const float rest = s[3].process(lowHighPass, s[2].process(lowHighPass, x));
+				split[0][i] = s[5].process(highPass, s[4].process(highPass, low)) +
+					      s[7].process(highLowPass, s[6].process(highLowPass, low));
+				split[1][i] = s[9].process(highLowPass, s[8].process(highLowPass, rest));
+				split[2][i] = s[11].process(highPass, s[10].process(highPass, rest));
+			}
+			for (int b = 0; b < CompressorBand::BANDS; b++)
+				compressors[c][b].process(split[b].data(), frames);
+			for (size_t i = 0; i < frames; i++)
+				planes[c][i] = split[0][i] + split[1][i] + split[2][i];
+		}
+	}
+	const double chainedMs = elapsedMs(start);
+
+	// One broadband compressor per channel, for scale
+	CompressorModel broadband[2];
+	for (auto &compressor : broadband)
+		compressor.configure(SAMPLE_RATE, 3.0f, -24.0f, 6.0f, 60.0f, 0.0f);
+	left = voice;
+	right = voice;
+	start = os_gettime_ns();
+	for (size_t pos = 0; pos < voice.size(); pos += block) {
+		const size_t frames = std::min(block, voice.size() - pos);
+		broadband[0].process(left.data() + pos, frames);
+		broadband[1].process(right.data() + pos, frames);
+	}
+	const double broadbandMs = elapsedMs(start);
+
+	obs_log(LOG_INFO,
+		"[Benchmarks] Multiband: %.0f s stereo, native %.1f ms (%.0fx realtime), stock crossovers + 3 "
+		"compressors %.1f ms (%.0fx), single compressor %.1f ms (%.0fx)",
+		seconds, nativeMs, seconds * 1000.0 / std::max(nativeMs, 1e-3), chainedMs,
+		seconds * 1000.0 / std::max(chainedMs, 1e-3), broadbandMs, seconds * 1000.0 / std::max(broadbandMs, 1e-3));
+}
+
+// Stages the worker does not run, to show how the fused loop scales with
+// a longer chain
+
+// One-pole DC blocker at the tables' corner
+struct DcBlock {
+	float pole = 0.999f;
+	float x1 = 0.0f;
+	float y1 = 0.0f;
+
+	void configure(const DspTables &tables) { pole = tables.dcBlockPole; }
+	void reset() { x1 = y1 = 0.0f; }
+	void begin() {}
+
+	inline float process(float x)
+	{
+		const float y = x - x1 + pole * y1;
+		x1 = x;
+		y1 = y;
+		return y;
+	}
+};
+
+// 10 ms frame levels in 1 dB bins from -100 to 0 dBFS, kept across blocks
+// until reset()
+struct LevelHistogram {
+	static constexpr int BINS = 100;
+
+	uint32_t bins[BINS] = {};
+	size_t frameLength = 480;
+	size_t position = 0;
+	float frameSum = 0.0f;
+
+	void configure(const DspTables &tables)
+	{
+		frameLength = std::max<size_t>(1, static_cast<size_t>(0.01 * tables.config.sampleRate));
+	}
+
+	void reset()
+	{
+		std::fill(bins, bins + BINS, 0u);
+		position = 0;
+		frameSum = 0.0f;
+	}
+
+	void begin() {}
+
+	inline float process(float x)
+	{
+		frameSum += x * x;
+		if (++position == frameLength) {
+			const float power = frameSum / static_cast<float>(frameLength);
+			const float db = power > 1e-10f ? 10.0f * std::log10(power) : -100.0f;
+			bins[std::clamp(static_cast<int>(db + 100.0f), 0, BINS - 1)]++;
+			position = 0;
+			frameSum = 0.0f;
+		}
+		return x;
+	}
+
+	// Level below which `fraction` of the frames fall
+	float percentileDb(float fraction) const
+	{
+		uint32_t frames = 0;
+		for (uint32_t count : bins)
+			frames += count;
+		const double wanted = std::clamp(static_cast<double>(fraction), 0.0, 1.0) * frames;
+		uint32_t seen = 0;
+		for (int b = 0; b < BINS; b++) {
+			seen += bins[b];
+			if (frames > 0 && seen >= wanted)
+				return static_cast<float>(b) - 100.0f + 1.0f;
+		}
+		return -100.0f;
+	}
+};
+
+// Everything a meter could want from one channel
+using FullAnalysisPipeline = Pipeline<DcBlock, VadFeatures, KWeight, Energy, LevelHistogram>;
+
+// Runs one pipeline over the signal in 100 ms blocks, fused or staged, and
+// returns the time taken
+template<typename P>
+static double timePipeline(P &pipeline, const std::vector<float> &input, bool fused, std::vector<float> &scratch)
+{
+	const size_t block = SAMPLE_RATE / 10;
+	pipeline.reset();
+	const uint64_t start = os_gettime_ns();
+	for (size_t pos = 0; pos + block <= input.size(); pos += block) {
+		pipeline.begin();
+		if (fused)
+			pipeline.process(input.data() + pos, block);
+		else
+			pipeline.processStaged(input.data() + pos, block, scratch.data());
+	}
+	return elapsedMs(start);
+}
+
+void Benchmarks::analysisPipeline()
+{
+	const double seconds = 60.0;
+	const std::vector<float> input = makeVoiceSignal(seconds);
+	DspConfig config;
+	config.sampleRate = SAMPLE_RATE;
+	const std::shared_ptr<const DspTables> tables = DspTableCache::instance().acquire(config);
+	std::vector<float> scratch(FullAnalysisPipeline::SCRATCH_FRAMES);
+
+	FullAnalysisPipeline full;
+	full.configure(*tables);
+	const double fullStagedMs = timePipeline(full, input, false, scratch);
+	const float stagedP95 = full.stage<4>().percentileDb(0.95f);
+	const double stagedPower = full.stage<3>().meanSquare();
+	const double fullFusedMs = timePipeline(full, input, true, scratch);
+	const bool fullMatches = full.stage<4>().percentileDb(0.95f) == stagedP95 &&
+				 full.stage<3>().meanSquare() == stagedPower;
+
+	FirstChannelPipeline first;
+	first.configure(*tables);
+	const double firstStagedMs = timePipeline(first, input, false, scratch);
+	const double firstFusedMs = timePipeline(first, input, true, scratch);
+
+	obs_log(LOG_INFO,
+		"[Benchmarks] Pipeline: %.0f s mono in 100 ms blocks, DC+VAD+K+energy+histogram fused %.1f ms, "
+		"staged %.1f ms (%.2fx), results %s",
+		seconds, fullFusedMs, fullStagedMs, fullStagedMs / std::max(fullFusedMs, 1e-3),
+		fullMatches ? "identical" : "DIFFER");
+	obs_log(LOG_INFO,
+		"[Benchmarks] Pipeline: level+VAD+K-weighting (analysis worker) fused %.1f ms, staged %.1f ms (%.2fx)",
+		firstFusedMs, firstStagedMs, firstStagedMs / std::max(firstFusedMs, 1e-3));
+}
+
+struct ToneFit {
+	float gainDb = -100.0f;  // fitted tone against the input
+	float noiseDb = -100.0f; // everything else, relative to the input tone
+	float levelDb = -100.0f; // whole output, relative to the input tone
+};
+
+// Resamples a 2 s tone at hz in 100 ms chunks and fits the same tone to the
+// settled output, allowing for the filter delay
+static ToneFit resampleTone(uint32_t inputRate, uint32_t outputRate, double hz)
+{
+	const std::shared_ptr<const PolyphasePlan> plan =
+		DspTableCache::instance().resamplerPlan(inputRate, outputRate);
+	PolyphaseResampler resampler;
+	resampler.configure(plan);
+
+	const double amplitude = 0.5;
+	std::vector<float> input(2 * inputRate);
+	for (size_t i = 0; i < input.size(); i++)
+		input[i] = static_cast<float>(amplitude * std::sin(2.0 * PI * hz * i / inputRate));
+	std::vector<float> output;
+	const size_t chunk = inputRate / 10;
+	for (size_t pos = 0; pos < input.size(); pos += chunk)
+		resampler.process(input.data() + pos, std::min(chunk, input.size() - pos), output);
+
+	const double delay = 0.5 * static_cast<double>(plan->taps() * plan->phases() - 1) / plan->phases() / inputRate;
+	const size_t first = outputRate / 5;
+	const size_t last = output.size() - outputRate / 5;
+	double c = 0.0;
+	double s = 0.0;
+	for (size_t k = first; k < last; k++) {
+		const double w = 2.0 * PI * hz * (static_cast<double>(k) / outputRate - delay);
+		c += output[k] * std::cos(w);
+		s += output[k] * std::sin(w);
+	}
+	const double n = static_cast<double>(last - first);
+	c *= 2.0 / n;
+	s *= 2.0 / n;
+
+	double residual = 0.0;
+	double power = 0.0;
+	for (size_t k = first; k < last; k++) {
+		power += static_cast<double>(output[k]) * output[k];
+		const double w = 2.0 * PI * hz * (static_cast<double>(k) / outputRate - delay);
+		const double e = output[k] - (c * std::cos(w) + s * std::sin(w));
+		residual += e * e;
+	}
+
+	ToneFit fit;
+	fit.gainDb = static_cast<float>(20.0 * std::log10(std::max(std::sqrt(c * c + s * s), 1e-12) / amplitude));
+	const double tonePower = 0.5 * amplitude * amplitude;
+	fit.noiseDb = static_cast<float>(10.0 * std::log10(std::max(residual / n, 1e-20) / tonePower));
+	fit.levelDb = static_cast<float>(10.0 * std::log10(std::max(power / n, 1e-20) / tonePower));
+	return fit;
+}
+
+static double timeResampler(uint32_t inputRate, uint32_t outputRate, const std::vector<float> &input)
+{
+	PolyphaseResampler resampler;
+	resampler.configure(DspTableCache::instance().resamplerPlan(inputRate, outputRate));
+	std::vector<float> output;
+	output.reserve(resampler.maxOutput(input.size()));
+
+	const size_t chunk = inputRate / 10;
+	const uint64_t start = os_gettime_ns();
+	for (size_t pos = 0; pos < input.size(); pos += chunk)
+		resampler.process(input.data() + pos, std::min(chunk, input.size() - pos), output);
+	return elapsedMs(start);
+}
+
+void Benchmarks::resampler()
+{
+	const uint32_t target = 48000;
+
+	// 44.1 kHz output: passband ripple and noise up to 18 kHz
+	float worstGainDb = 0.0f;
+	float worstNoiseDb = -200.0f;
+	for (double hz : {100.0, 1000.0, 5000.0, 10000.0, 15000.0, 18000.0}) {
+		const ToneFit fit = resampleTone(44100, target, hz);
+		if (std::fabs(fit.gainDb) > std::fabs(worstGainDb))
+			worstGainDb = fit.gainDb;
+		worstNoiseDb = std::max(worstNoiseDb, fit.noiseDb);
+	}
+
+	// 96 kHz source: content above 24 kHz must not fold into the output (a
+	// folded tone is indistinguishable from a real one, so count all of it)
+	float worstAliasDb = -200.0f;
+	for (double hz : {25000.0, 30000.0, 40000.0}) {
+		const ToneFit fit = resampleTone(96000, target, hz);
+		worstAliasDb = std::max(worstAliasDb, fit.levelDb);
+	}
+
+	const std::shared_ptr<const PolyphasePlan> cd = DspTableCache::instance().resamplerPlan(44100, target);
+	const std::shared_ptr<const PolyphasePlan> high = DspTableCache::instance().resamplerPlan(96000, target);
+	obs_log(LOG_INFO,
+		"[Benchmarks] Resampler: 44.1 -> 48 kHz (%u phases x %zu taps) worst gain %.3f dB, "
+		"noise %.1f dB to 18 kHz; 96 -> 48 kHz (%zu taps) aliases at %.1f dB",
+		cd->phases(), cd->taps(), worstGainDb, worstNoiseDb, high->taps(), worstAliasDb);
+
+	const double seconds = 60.0;
+	const std::vector<float> voice = makeVoiceSignal(seconds);
+	const std::vector<float> cdInput(voice.begin(), voice.begin() + static_cast<std::ptrdiff_t>(seconds * 44100));
+	std::vector<float> highInput(static_cast<size_t>(seconds * 96000));
+	for (size_t i = 0; i < highInput.size(); i++)
+		highInput[i] = voice[(i / 2) % voice.size()];
+
+	const double cdMs = timeResampler(44100, target, cdInput);
+	const double highMs = timeResampler(96000, target, highInput);
+	obs_log(LOG_INFO,
+		"[Benchmarks] Resampler: %.0f s mono, 44.1 -> 48 kHz %.1f ms (%.0fx realtime), "
+		"96 -> 48 kHz %.1f ms (%.0fx realtime)",
+		seconds, cdMs, seconds * 1000.0 / std::max(cdMs, 1e-3), highMs, seconds * 1000.0 / std::max(highMs, 1e-3));
+}
+
+// Synthetic readings: levels moving at speech rate, a new block every
+// 100 ms, every other source calibrated
+static void meterReadings(std::vector<MeterReading> &readings, size_t sources, int frame)
+{
+	readings.resize(sources);
+	const double t = frame * MeterBridgeWidget::FRAME_MS / 1000.0;
+	for (size_t i = 0; i < sources; i++) {
+		MeterReading &reading = readings[i];
+		if (reading.name.empty()) {
+			char name[64];
+			snprintf(name, sizeof(name), "Source %zu with a long descriptive name", i + 1);
+			reading.name = name;
+		}
+		const double level = -30.0 + 14.0 * std::sin(2.0 * PI * (0.7 + 0.05 * i) * t + i);
+		reading.rmsDb = static_cast<float>(level);
+		reading.peakDb = static_cast<float>(level + 9.0 + 3.0 * std::sin(2.0 * PI * 3.1 * t + i));
+		reading.blocks = static_cast<uint64_t>(t * 10.0);
+		reading.momentaryLufs = static_cast<float>(level + 3.0);
+		reading.calibrated = i % 2 == 0;
+	}
+}
+
+// Frames of ballistics plus an offscreen render; returns ms per frame
+static double timeMeterFrames(MeterBridgeWidget &widget, QImage &image, size_t sources, int frames)
+{
+	const float dt = MeterBridgeWidget::FRAME_MS / 1000.0f;
+	uint64_t now = os_gettime_ns();
+	double busyMs = 0.0;
+	for (int f = 0; f < frames; f++) {
+		meterReadings(widget.readings, sources, f);
+		now += static_cast<uint64_t>(MeterBridgeWidget::FRAME_MS) * 1000000;
+		const uint64_t start = os_gettime_ns();
+		widget.advance(now, dt);
+		widget.render(&image);
+		busyMs += elapsedMs(start);
+	}
+	return busyMs / frames;
+}
+
+void Benchmarks::meterBridgePaint()
+{
+	const size_t sources = 32;
+	const int frames = 600; // 10 s at 60 fps
+
+	MeterBridgeWidget widget;
+	QImage image;
+	for (const QSize &size : {QSize(300, 32 * 20 + 8), QSize(300, 200)}) {
+		widget.resize(size);
+		widget.rows.clear();
+		widget.readings.clear();
+		widget.backgroundDirty = true;
+		image = QImage(size, QImage::Format_ARGB32_Premultiplied);
+
+		// Warm-up lays out the rows and text once
+		timeMeterFrames(widget, image, sources, 10);
+		const double frameMs = timeMeterFrames(widget, image, sources, frames);
+
+		const uint64_t start = os_gettime_ns();
+		for (int i = 0; i < 20; i++)
+			widget.paintBackground();
+		const double backgroundMs = elapsedMs(start) / 20.0;
+
+		obs_log(LOG_INFO,
+			"[Benchmarks] Meter bridge: %zu sources at %dx%d (%s), %.3f ms per frame offscreen "
+			"(%.1f%% of the UI thread at 60 fps), background rebuild %.3f ms",
+			sources, size.width(), size.height(), widget.layout.showText ? "with text" : "bars only",
+			frameMs, 100.0 * frameMs / MeterBridgeWidget::FRAME_MS, backgroundMs);
+	}
+}
@@ -0,0 +1,44 @@
+/*
+ * Benchmarks - Throughput and quality measurements for the DSP code
+ * Copyright (C) 2025
+ *
+ * Run from Tools > Audio Calibrator Benchmarks; results go to the OBS log.
+ * Inputs are synthetic so numbers are comparable between machines.
+ */
+
+#ifndef BENCHMARKS_HPP
+#define BENCHMARKS_HPP
+
+class Benchmarks {
+public:
+	// Runs every benchmark in turn (call from a worker thread)
+	static void runAll();
+
+	// Lossless history codec: compression ratio, encode throughput and
+	// random 1 s decode latency
+	static void pcmCodec();
+
+	// Swept-sine measurement: deconvolution time for a 10 s sweep and
+	// response error against a synthetic room
+	static void sweepResponse();
+
+	// Native multiband compressor against the same split built from stock
+	// parts (scalar crossovers feeding three compressors) and against a
+	// single broadband compressor, on stereo speech
+	static void multibandCompressor();
+
+	// Fused analysis pipelines against the same stages run one pass each
+	static void analysisPipeline();
+
+	// Polyphase resampler: passband error, noise and aliasing on pure tones,
+	// and throughput into the analysis rate from 44.1 and 96 kHz
+	static void resampler();
+
+	// Meter dock with 32 synthetic sources: ballistics and paint per frame,
+	// rendered offscreen into an image (excludes compositing to screen),
+	// at full row height and squeezed to bars only. Not part of runAll, as
+	// widgets can only be painted on the UI thread.
+	static void meterBridgePaint();
+};
+
+#endif // BENCHMARKS_HPP
@@ -0,0 +1,120 @@
+/*
+ * Biquad Implementation
+ * Copyright (C) 2025
+ */
+
+#include "biquad.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+static constexpr double PI = 3.14159265358979323846;
+
+static BiquadCoeffs normalise(double b0, double b1, double b2, double a0, double a1, double a2)
+{
+	BiquadCoeffs c;
+	c.b0 = static_cast<float>(b0 / a0);
+	c.b1 = static_cast<float>(b1 / a0);
+	c.b2 = static_cast<float>(b2 / a0);
+	c.a1 = static_cast<float>(a1 / a0);
+	c.a2 = static_cast<float>(a2 / a0);
+	return c;
+}
+
+BiquadCoeffs BiquadCoeffs::highPass(double sampleRate, double freq, double q)
+{
+	const double w0 = 2.0 * PI * freq / sampleRate;
+	const double alpha = std::sin(w0) / (2.0 * q);
+	const double cosw = std::cos(w0);
+	return normalise((1.0 + cosw) / 2.0, -(1.0 + cosw), (1.0 + cosw) / 2.0, 1.0 + alpha, -2.0 * cosw, 1.0 - alpha);
+}
+
+BiquadCoeffs BiquadCoeffs::lowPass(double sampleRate, double freq, double q)
+{
+	const double w0 = 2.0 * PI * freq / sampleRate;
+	const double alpha = std::sin(w0) / (2.0 * q);
+	const double cosw = std::cos(w0);
+	return normalise((1.0 - cosw) / 2.0, 1.0 - cosw, (1.0 - cosw) / 2.0, 1.0 + alpha, -2.0 * cosw, 1.0 - alpha);
+}
+
+BiquadCoeffs BiquadCoeffs::bandPass(double sampleRate, double freq, double q)
+{
+	const double w0 = 2.0 * PI * freq / sampleRate;
+	const double alpha = std::sin(w0) / (2.0 * q);
+	const double cosw = std::cos(w0);
+	return normalise(alpha, 0.0, -alpha, 1.0 + alpha, -2.0 * cosw, 1.0 - alpha);
+}
+
+BiquadCoeffs BiquadCoeffs::notch(double sampleRate, double freq, double q)
+{
+	const double w0 = 2.0 * PI * freq / sampleRate;
+	const double alpha = std::sin(w0) / (2.0 * q);
+	const double cosw = std::cos(w0);
+	return normalise(1.0, -2.0 * cosw, 1.0, 1.0 + alpha, -2.0 * cosw, 1.0 - alpha);
+}
+
+BiquadCoeffs BiquadCoeffs::peaking(double sampleRate, double freq, double q, double gainDb)
+{
+	const double a = std::pow(10.0, gainDb / 40.0);
+	const double w0 = 2.0 * PI * freq / sampleRate;
+	const double alpha = std::sin(w0) / (2.0 * q);
+	const double cosw = std::cos(w0);
+	return normalise(1.0 + alpha * a, -2.0 * cosw, 1.0 - alpha * a, 1.0 + alpha / a, -2.0 * cosw,
+			 1.0 - alpha / a);
+}
+
+BiquadCoeffs BiquadCoeffs::highShelf(double sampleRate, double freq, double q, double gainDb)
+{
+	const double a = std::pow(10.0, gainDb / 40.0);
+	const double w0 = 2.0 * PI * freq / sampleRate;
+	const double alpha = std::sin(w0) / (2.0 * q);
+	const double cosw = std::cos(w0);
+	const double sqrtA2alpha = 2.0 * std::sqrt(a) * alpha;
+	return normalise(a * ((a + 1.0) + (a - 1.0) * cosw + sqrtA2alpha), -2.0 * a * ((a - 1.0) + (a + 1.0) * cosw),
+			 a * ((a + 1.0) + (a - 1.0) * cosw - sqrtA2alpha), (a + 1.0) - (a - 1.0) * cosw + sqrtA2alpha,
+			 2.0 * ((a - 1.0) - (a + 1.0) * cosw), (a + 1.0) - (a - 1.0) * cosw - sqrtA2alpha);
+}
+
+BiquadCoeffs BiquadCoeffs::kWeightingShelf(double sampleRate)
+{
+	// Pre-filter parameters from BS.1770 (as popularised by libebur128)
+	const double f0 = 1681.974450955533;
+	const double gainDb = 3.999843853973347;
+	const double q = 0.7071752369554196;
+
+	const double k = std::tan(PI * f0 / sampleRate);
+	const double vh = std::pow(10.0, gainDb / 20.0);
+	const double vb = std::pow(vh, 0.4996667741545416);
+	const double a0 = 1.0 + k / q + k * k;
+	return normalise(vh + vb * k / q + k * k, 2.0 * (k * k - vh), vh - vb * k / q + k * k, a0,
+			 2.0 * (k * k - 1.0), 1.0 - k / q + k * k);
+}
+
+BiquadCoeffs BiquadCoeffs::kWeightingHighPass(double sampleRate)
+{
+	const double f0 = 38.13547087602444;
+	const double q = 0.5003270373238773;
+
+	// The standard leaves the numerator unnormalised ([1, -2, 1] at 48 kHz)
+	const double k = std::tan(PI * f0 / sampleRate);
+	const double a0 = 1.0 + k / q + k * k;
+	BiquadCoeffs c;
+	c.b0 = 1.0f;
+	c.b1 = -2.0f;
+	c.b2 = 1.0f;
+	c.a1 = static_cast<float>(2.0 * (k * k - 1.0) / a0);
+	c.a2 = static_cast<float>((1.0 - k / q + k * k) / a0);
+	return c;
+}
+
+double BiquadCoeffs::responseDb(double sampleRate, double freq) const
+{
+	const std::complex<double> z1 = std::polar(1.0, -2.0 * PI * freq / sampleRate);
+	const std::complex<double> z2 = z1 * z1;
+	const std::complex<double> num = static_cast<double>(b0) + static_cast<double>(b1) * z1 +
+					 static_cast<double>(b2) * z2;
+	const std::complex<double> den = 1.0 + static_cast<double>(a1) * z1 + static_cast<double>(a2) * z2;
+	const double mag = std::abs(num / den);
+	return 20.0 * std::log10(std::max(mag, 1e-12));
+}
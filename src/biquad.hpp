@@ -0,0 +1,49 @@
+/*
+ * Biquad - Second-order IIR sections used by analyzers and native filters
+ * Copyright (C) 2025
+ */
+
+#ifndef BIQUAD_HPP
+#define BIQUAD_HPP
+
+struct BiquadCoeffs {
+	// Normalised so that a0 == 1
+	float b0 = 1.0f;
+	float b1 = 0.0f;
+	float b2 = 0.0f;
+	float a1 = 0.0f;
+	float a2 = 0.0f;
+
+	// RBJ cookbook designs
+	static BiquadCoeffs highPass(double sampleRate, double freq, double q);
+	static BiquadCoeffs lowPass(double sampleRate, double freq, double q);
+	static BiquadCoeffs bandPass(double sampleRate, double freq, double q);
+	static BiquadCoeffs notch(double sampleRate, double freq, double q);
+	static BiquadCoeffs peaking(double sampleRate, double freq, double q, double gainDb);
+	static BiquadCoeffs highShelf(double sampleRate, double freq, double q, double gainDb);
+
+	// ITU-R BS.1770 K-weighting stages, re-derived for any sample rate
+	static BiquadCoeffs kWeightingShelf(double sampleRate);
+	static BiquadCoeffs kWeightingHighPass(double sampleRate);
+
+	// Magnitude response in dB at freq
+	double responseDb(double sampleRate, double freq) const;
+};
+
+// Transposed direct form II state
+struct BiquadState {
+	float z1 = 0.0f;
+	float z2 = 0.0f;
+
+	inline float process(const BiquadCoeffs &c, float x)
+	{
+		const float y = c.b0 * x + z1;
+		z1 = c.b1 * x - c.a1 * y + z2;
+		z2 = c.b2 * x - c.a2 * y;
+		return y;
+	}
+
+	void reset() { z1 = z2 = 0.0f; }
+};
+
+#endif // BIQUAD_HPP
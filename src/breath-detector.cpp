@@ -0,0 +1,214 @@
+/*
+ * Breath Detector Implementation
+ * Copyright (C) 2025
+ */
+
+#include "breath-detector.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+// Pitch range searched for periodicity
+static constexpr double MIN_PITCH_HZ = 70.0;
+static constexpr double MAX_PITCH_HZ = 400.0;
+
+// Training: what counts as clearly voiced, and as a breath between phrases
+static constexpr float VOICED_MARGIN_DB = 15.0f;
+static constexpr float VOICED_HARMONICITY = 0.5f;
+static constexpr float BREATH_UNDER_SPEECH_DB = 10.0f;
+static constexpr float BREATH_HARMONICITY = 0.4f;
+static constexpr int BREATH_RUN_FRAMES = 15;
+static constexpr int MIN_VOICED_FRAMES = 20;
+static constexpr int MIN_BREATH_FRAMES = 10;
+
+static float powerDb(double power)
+{
+	return power > 1e-12 ? static_cast<float>(10.0 * std::log10(power)) : -120.0f;
+}
+
+static float percentile(std::vector<float> values, double fraction)
+{
+	if (values.empty())
+		return 0.0f;
+	const size_t index = std::min(values.size() - 1, static_cast<size_t>(values.size() * fraction));
+	std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+	return values[index];
+}
+
+void BreathDetector::configure(uint32_t sampleRate, const BreathModel &model)
+{
+	breathModel = model;
+	factor = std::max<size_t>(1, static_cast<size_t>(std::lround(static_cast<double>(sampleRate) / TARGET_RATE)));
+	const double rate = static_cast<double>(sampleRate) / static_cast<double>(factor);
+
+	frameLength = std::max<size_t>(1, static_cast<size_t>(rate * FRAME_MS / 1000.0));
+	windowLength = std::min<size_t>(MAX_WINDOW, frameLength * WINDOW_FRAMES);
+	frameLength = windowLength / WINDOW_FRAMES;
+	minLag = std::max<size_t>(1, static_cast<size_t>(rate / MAX_PITCH_HZ));
+	maxLag = std::min<size_t>(windowLength / 2, static_cast<size_t>(rate / MIN_PITCH_HZ));
+	highPass = BiquadCoeffs::highPass(rate, 300.0, 0.707);
+
+	// Butterworth pole pair Qs
+	antiAlias[0] = BiquadCoeffs::lowPass(sampleRate, ANTI_ALIAS_HZ, 0.5412);
+	antiAlias[1] = BiquadCoeffs::lowPass(sampleRate, ANTI_ALIAS_HZ, 1.3066);
+	reset();
+}
+
+void BreathDetector::reset()
+{
+	for (BiquadState &state : antiAliasStates)
+		state.reset();
+	highPassState.reset();
+	pendingCount = 0;
+	std::fill(window, window + MAX_WINDOW, 0.0f);
+	filled = 0;
+	frameEnergy = 0.0;
+	frameDb = -100.0f;
+	frameHarmonicity = 0.0f;
+	run = 0;
+	breath = false;
+}
+
+bool BreathDetector::process(const float *samples, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		push(samples[i]);
+	return breath;
+}
+
+void BreathDetector::decimated(float sample)
+{
+	const float x = highPassState.process(highPass, sample);
+	pendingCount = 0;
+
+	window[windowLength - frameLength + filled] = x;
+	frameEnergy += static_cast<double>(x) * x;
+	if (++filled == frameLength)
+		endFrame();
+}
+
+float BreathDetector::harmonicity() const
+{
+	// Prefix sums of the squared window give both energies of every lag
+	double prefix[MAX_WINDOW + 1];
+	prefix[0] = 0.0;
+	for (size_t n = 0; n < windowLength; n++)
+		prefix[n + 1] = prefix[n] + static_cast<double>(window[n]) * window[n];
+
+	float best = 0.0f;
+	for (size_t lag = minLag; lag <= maxLag; lag++) {
+		const size_t span = windowLength - lag;
+		float dot = 0.0f;
+		for (size_t n = 0; n < span; n++)
+			dot += window[n] * window[n + lag];
+		const double energy = prefix[span] * (prefix[windowLength] - prefix[lag]);
+		if (energy > 1e-20)
+			best = std::max(best, static_cast<float>(dot / std::sqrt(energy)));
+	}
+	return best;
+}
+
+void BreathDetector::endFrame()
+{
+	frameDb = powerDb(frameEnergy / static_cast<double>(frameLength));
+	const bool inRange =
+		frameDb > breathModel.floorDb + FLOOR_MARGIN_DB && frameDb < breathModel.ceilingDb;
+
+	// Voice and silence are decided on level alone
+	frameHarmonicity = inRange || trace ? harmonicity() : 0.0f;
+	const bool candidate = inRange && frameHarmonicity < breathModel.harmonicity;
+	run = candidate ? run + 1 : 0;
+	breath = run >= CONFIRM_FRAMES;
+	if (trace)
+		trace->emplace_back(frameDb, frameHarmonicity);
+
+	std::memmove(window, window + frameLength, (windowLength - frameLength) * sizeof(float));
+	filled = 0;
+	frameEnergy = 0.0;
+}
+
+BreathModel BreathDetector::train(const BreathTrainingClip &noise, const std::vector<BreathTrainingClip> &speech,
+				  uint32_t sampleRate)
+{
+	BreathModel model;
+	if (sampleRate == 0)
+		return model;
+
+	auto frames = [sampleRate, &model](const BreathTrainingClip &clip) {
+		std::vector<std::pair<float, float>> result;
+		BreathDetector detector;
+		detector.configure(sampleRate, model);
+		detector.trace = &result;
+		if (clip.samples)
+			detector.process(clip.samples, clip.count);
+		return result;
+	};
+
+	std::vector<float> levels;
+	for (const auto &frame : frames(noise))
+		levels.push_back(frame.first);
+	if (levels.empty())
+		return model;
+	model.floorDb = percentile(levels, 0.5);
+
+	std::vector<std::vector<std::pair<float, float>>> clips;
+	std::vector<float> voicedLevels;
+	std::vector<float> voicedHarmonicity;
+	for (const BreathTrainingClip &clip : speech) {
+		clips.push_back(frames(clip));
+		for (const auto &frame : clips.back()) {
+			if (frame.first > model.floorDb + VOICED_MARGIN_DB && frame.second >= VOICED_HARMONICITY) {
+				voicedLevels.push_back(frame.first);
+				voicedHarmonicity.push_back(frame.second);
+			}
+		}
+	}
+	if (voicedLevels.size() < static_cast<size_t>(MIN_VOICED_FRAMES))
+		return model;
+	model.speechDb = percentile(voicedLevels, 0.5);
+
+	// Breaths: long runs of quiet, aperiodic frames between the phrases
+	const float breathTop = model.speechDb - BREATH_UNDER_SPEECH_DB;
+	std::vector<float> breathLevels;
+	std::vector<float> breathHarmonicity;
+	for (const auto &clip : clips) {
+		size_t start = 0;
+		for (size_t i = 0; i <= clip.size(); i++) {
+			const bool quiet = i < clip.size() && clip[i].first > model.floorDb + FLOOR_MARGIN_DB &&
+					   clip[i].first < breathTop && clip[i].second < BREATH_HARMONICITY;
+			if (quiet)
+				continue;
+			if (i - start >= static_cast<size_t>(BREATH_RUN_FRAMES)) {
+				for (size_t k = start; k < i; k++) {
+					breathLevels.push_back(clip[k].first);
+					breathHarmonicity.push_back(clip[k].second);
+				}
+			}
+			start = i + 1;
+		}
+	}
+
+	model.breathFrames = static_cast<int>(breathLevels.size());
+	if (model.breathFrames >= MIN_BREATH_FRAMES) {
+		model.ceilingDb = std::min(model.speechDb - 6.0f, percentile(breathLevels, 0.9) + 3.0f);
+		const float between = 0.5f * (percentile(breathHarmonicity, 0.9) + percentile(voicedHarmonicity, 0.25));
+		model.harmonicity = std::max(0.3f, std::min(between, 0.6f));
+	} else {
+		model.ceilingDb = model.speechDb - 12.0f;
+	}
+	model.trained = true;
+	return model;
+}
+
+std::string BreathModel::summary() const
+{
+	char text[160];
+	if (!trained)
+		return "breath model not trained (defaults)";
+	snprintf(text, sizeof(text),
+		 "breaths between %.1f and %.1f dB under harmonicity %.2f (voice %.1f dB, %d breath frames)",
+		 floorDb + BreathDetector::FLOOR_MARGIN_DB, ceilingDb, harmonicity, speechDb, breathFrames);
+	return text;
+}
@@ -0,0 +1,118 @@
+/*
+ * Breath Detector - Inhalations between phrases, for the breath filter
+ * Copyright (C) 2025
+ *
+ * A breath is a run of quiet, noise-like frames: above the room's noise,
+ * well under the voice, and without the periodicity of voiced speech. The
+ * input is low-passed at ANTI_ALIAS_HZ (4th-order Butterworth, as in
+ * proximity-bands.hpp) and decimated to about 8 kHz; breath noise above
+ * 5 kHz, which would fold into the measured band, is at least 18 dB down,
+ * and 24 dB from 6 kHz up. Each 10 ms frame is high-passed at 300 Hz and
+ * measured for level; only frames inside the breath level range pay for
+ * the normalised autocorrelation over 70-400 Hz lags that gives the
+ * harmonicity. A run has to last CONFIRM_FRAMES before it counts, which
+ * keeps short unvoiced consonants inside words out. The level range and
+ * harmonicity threshold are trained on the wizard's noise and speaking
+ * steps.
+ */
+
+#ifndef BREATH_DETECTOR_HPP
+#define BREATH_DETECTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "biquad.hpp"
+
+struct BreathModel {
+	float floorDb = -60.0f;       // room noise in the breath band
+	float ceilingDb = -35.0f;     // louder frames are voice
+	float harmonicity = 0.45f;    // more periodic frames are voice
+
+	// Training results, for the log
+	bool trained = false;
+	float speechDb = -100.0f;
+	int breathFrames = 0;
+
+	std::string summary() const;
+};
+
+struct BreathTrainingClip {
+	const float *samples = nullptr;
+	size_t count = 0;
+};
+
+class BreathDetector {
+public:
+	static constexpr uint32_t TARGET_RATE = 8000;
+	static constexpr double ANTI_ALIAS_HZ = 3000.0;
+	static constexpr float FRAME_MS = 10.0f;
+	static constexpr int WINDOW_FRAMES = 3;   // harmonicity over 30 ms
+	static constexpr int CONFIRM_FRAMES = 4;  // 40 ms of breath-like frames
+	static constexpr float FLOOR_MARGIN_DB = 6.0f;
+	static constexpr size_t MAX_WINDOW = 512; // decimated samples
+
+	void configure(uint32_t sampleRate, const BreathModel &model);
+	void reset();
+
+	// New thresholds from the next frame on, keeping the detector's state
+	void setModel(const BreathModel &model) { breathModel = model; }
+
+	// Feed samples one at a time (the filter) or in blocks; true while a
+	// confirmed breath is in progress
+	bool push(float sample)
+	{
+		if (factor > 1)
+			sample = antiAliasStates[1].process(antiAlias[1], antiAliasStates[0].process(antiAlias[0], sample));
+		if (++pendingCount == factor)
+			decimated(sample);
+		return breath;
+	}
+	bool process(const float *samples, size_t count);
+
+	bool inBreath() const { return breath; }
+	float lastFrameDb() const { return frameDb; }
+	float lastHarmonicity() const { return frameHarmonicity; }
+
+	// Noise step (step 1) and speaking steps; the clips must share a rate
+	static BreathModel train(const BreathTrainingClip &noise, const std::vector<BreathTrainingClip> &speech,
+				 uint32_t sampleRate);
+
+	// Periodicity of the last window: the largest normalised
+	// autocorrelation over voice pitch lags (0..1)
+	float harmonicity() const;
+
+private:
+	void decimated(float sample);
+	void endFrame();
+
+	BreathModel breathModel;
+	size_t factor = 6;
+	size_t frameLength = 80;
+	size_t minLag = 20;
+	size_t maxLag = 114;
+
+	BiquadCoeffs antiAlias[2];
+	BiquadState antiAliasStates[2];
+	BiquadCoeffs highPass;
+	BiquadState highPassState;
+	size_t pendingCount = 0;
+
+	float window[MAX_WINDOW] = {};
+	size_t windowLength = 160;
+	size_t filled = 0; // samples of the current frame
+	double frameEnergy = 0.0;
+
+	float frameDb = -100.0f;
+	float frameHarmonicity = 0.0f;
+	int run = 0;
+	bool breath = false;
+
+	// Training: every frame's level and harmonicity
+	std::vector<std::pair<float, float>> *trace = nullptr;
+};
+
+#endif // BREATH_DETECTOR_HPP
@@ -0,0 +1,198 @@
+/*
+ * Breath Filter Implementation
+ * Copyright (C) 2025
+ *
+ * The detector runs on a mono mix inside filter_audio. The output is the
+ * input delayed by the lookahead (10 ms at most, one detector frame), so
+ * the gain is back at unity by the time a voiced frame that ended a breath
+ * is played. Delay lines are sized for the highest OBS sample rate at
+ * creation; nothing is allocated on the audio thread. Settings arrive from
+ * the UI thread through atomics.
+ */
+
+#include "breath-filter.hpp"
+#include "breath-detector.hpp"
+#include "dsp-tables.hpp"
+
+#include <obs-module.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+static constexpr uint32_t MAX_SAMPLE_RATE = 192000;
+static constexpr int MAX_LOOKAHEAD_MS = 10;
+static constexpr size_t MAX_DELAY = MAX_SAMPLE_RATE * MAX_LOOKAHEAD_MS / 1000;
+
+// Gain ramps: ease into the cut, come back fast for the next phrase
+static constexpr float ATTACK_MS = 20.0f;
+static constexpr float RELEASE_MS = 3.0f;
+
+struct BreathFilter {
+	BreathDetector detector;
+	float delay[MAX_AUDIO_CHANNELS][MAX_DELAY] = {};
+	size_t delayLength = 0;
+	size_t delayPosition = 0;
+	int appliedLookaheadMs = -1;
+	uint32_t sampleRate = 0;
+	float gain = 1.0f;
+	float attackCoeff = 0.0f;
+	float releaseCoeff = 0.0f;
+
+	std::atomic<float> attenuationDb{-12.0f};
+	std::atomic<int> lookaheadMs{MAX_LOOKAHEAD_MS};
+	std::atomic<float> floorDb{-60.0f};
+	std::atomic<float> ceilingDb{-35.0f};
+	std::atomic<float> harmonicity{0.45f};
+	std::atomic<bool> settingsChanged{true};
+};
+
+static const char *breathFilterName(void *)
+{
+	return "Audio Calibrator Breath Filter";
+}
+
+static void breathFilterUpdate(void *data, obs_data_t *settings)
+{
+	auto *filter = static_cast<BreathFilter *>(data);
+	filter->attenuationDb.store(static_cast<float>(obs_data_get_double(settings, "attenuation")));
+	filter->lookaheadMs.store(static_cast<int>(obs_data_get_int(settings, "lookahead_ms")));
+	filter->floorDb.store(static_cast<float>(obs_data_get_double(settings, "floor_db")));
+	filter->ceilingDb.store(static_cast<float>(obs_data_get_double(settings, "ceiling_db")));
+	filter->harmonicity.store(static_cast<float>(obs_data_get_double(settings, "harmonicity")));
+	filter->settingsChanged.store(true, std::memory_order_release);
+}
+
+static void *breathFilterCreate(obs_data_t *settings, obs_source_t *)
+{
+	auto *filter = new BreathFilter();
+	breathFilterUpdate(filter, settings);
+	return filter;
+}
+
+static void breathFilterDestroy(void *data)
+{
+	delete static_cast<BreathFilter *>(data);
+}
+
+static void breathFilterDefaults(obs_data_t *settings)
+{
+	obs_data_set_default_double(settings, "attenuation", -12.0);
+	obs_data_set_default_int(settings, "lookahead_ms", MAX_LOOKAHEAD_MS);
+	obs_data_set_default_double(settings, "floor_db", -60.0);
+	obs_data_set_default_double(settings, "ceiling_db", -35.0);
+	obs_data_set_default_double(settings, "harmonicity", 0.45);
+}
+
+static obs_properties_t *breathFilterProperties(void *)
+{
+	obs_properties_t *props = obs_properties_create();
+	obs_property_t *p = obs_properties_add_float_slider(props, "attenuation", "Breath Attenuation", -40.0, 0.0, 1.0);
+	obs_property_float_set_suffix(p, " dB");
+	p = obs_properties_add_int_slider(props, "lookahead_ms", "Lookahead (adds latency)", 0, MAX_LOOKAHEAD_MS, 1);
+	obs_property_int_set_suffix(p, " ms");
+	p = obs_properties_add_float_slider(props, "floor_db", "Room Noise", -96.0, -20.0, 0.5);
+	obs_property_float_set_suffix(p, " dB");
+	p = obs_properties_add_float_slider(props, "ceiling_db", "Loudest Breath", -80.0, -6.0, 0.5);
+	obs_property_float_set_suffix(p, " dB");
+	obs_properties_add_float_slider(props, "harmonicity", "Voice Harmonicity", 0.1, 0.9, 0.01);
+	return props;
+}
+
+// Settings are pushed again on every profile switch, so only a new rate or
+// lookahead resets the detector or the delay lines (which drops up to the
+// lookahead of audio); new thresholds apply from the next frame
+static void reconfigure(BreathFilter *filter, uint32_t sampleRate)
+{
+	BreathModel model;
+	model.floorDb = filter->floorDb.load();
+	model.ceilingDb = filter->ceilingDb.load();
+	model.harmonicity = filter->harmonicity.load();
+	const int lookahead = std::max(0, std::min(filter->lookaheadMs.load(), MAX_LOOKAHEAD_MS));
+
+	if (sampleRate != filter->sampleRate) {
+		filter->detector.configure(sampleRate, model);
+		filter->attackCoeff = 1.0f - std::exp(-1000.0f / (ATTACK_MS * static_cast<float>(sampleRate)));
+		filter->releaseCoeff = 1.0f - std::exp(-1000.0f / (RELEASE_MS * static_cast<float>(sampleRate)));
+	} else {
+		filter->detector.setModel(model);
+	}
+
+	if (sampleRate != filter->sampleRate || lookahead != filter->appliedLookaheadMs) {
+		filter->delayLength = std::min(MAX_DELAY, static_cast<size_t>(sampleRate) * lookahead / 1000);
+		filter->delayPosition = 0;
+		for (auto &line : filter->delay)
+			std::fill(line, line + MAX_DELAY, 0.0f);
+		filter->appliedLookaheadMs = lookahead;
+	}
+	filter->sampleRate = sampleRate;
+}
+
+static struct obs_audio_data *breathFilterAudio(void *data, struct obs_audio_data *audio)
+{
+	auto *filter = static_cast<BreathFilter *>(data);
+	const DspConfig config = DspConfig::fromAudioOutput();
+	if (config.sampleRate == 0 || config.sampleRate > MAX_SAMPLE_RATE)
+		return audio;
+
+	if (filter->settingsChanged.exchange(false, std::memory_order_acquire) ||
+	    filter->sampleRate != config.sampleRate)
+		reconfigure(filter, config.sampleRate);
+
+	const size_t channels = std::min<size_t>(config.channels, MAX_AUDIO_CHANNELS);
+	float *planes[MAX_AUDIO_CHANNELS] = {};
+	size_t used = 0;
+	for (size_t ch = 0; ch < channels; ch++) {
+		planes[ch] = reinterpret_cast<float *>(audio->data[ch]);
+		if (planes[ch])
+			used++;
+	}
+	if (used == 0)
+		return audio;
+
+	const float cut = std::pow(10.0f, filter->attenuationDb.load(std::memory_order_relaxed) / 20.0f);
+	const float mixScale = 1.0f / static_cast<float>(used);
+	const size_t length = filter->delayLength;
+
+	for (size_t i = 0; i < audio->frames; i++) {
+		float mono = 0.0f;
+		for (size_t ch = 0; ch < channels; ch++) {
+			if (planes[ch])
+				mono += planes[ch][i];
+		}
+
+		const float target = filter->detector.push(mono * mixScale) ? cut : 1.0f;
+		const float coeff = target < filter->gain ? filter->attackCoeff : filter->releaseCoeff;
+		filter->gain += coeff * (target - filter->gain);
+
+		for (size_t ch = 0; ch < channels; ch++) {
+			if (!planes[ch])
+				continue;
+			float sample = planes[ch][i];
+			if (length > 0) {
+				float &slot = filter->delay[ch][filter->delayPosition];
+				std::swap(sample, slot);
+			}
+			planes[ch][i] = sample * filter->gain;
+		}
+		if (length > 0 && ++filter->delayPosition == length)
+			filter->delayPosition = 0;
+	}
+	return audio;
+}
+
+void registerBreathFilter()
+{
+	struct obs_source_info info = {};
+	info.id = BREATH_FILTER_ID;
+	info.type = OBS_SOURCE_TYPE_FILTER;
+	info.output_flags = OBS_SOURCE_AUDIO;
+	info.get_name = breathFilterName;
+	info.create = breathFilterCreate;
+	info.destroy = breathFilterDestroy;
+	info.get_defaults = breathFilterDefaults;
+	info.get_properties = breathFilterProperties;
+	info.update = breathFilterUpdate;
+	info.filter_audio = breathFilterAudio;
+	obs_register_source(&info);
+}
@@ -0,0 +1,14 @@
+/*
+ * Breath Filter - Native OBS audio filter that turns breaths down
+ * Copyright (C) 2025
+ */
+
+#ifndef BREATH_FILTER_HPP
+#define BREATH_FILTER_HPP
+
+static constexpr const char *BREATH_FILTER_ID = "audio_calibrator_breath_filter";
+
+// Registers the filter type with OBS (call from obs_module_load)
+void registerBreathFilter();
+
+#endif // BREATH_FILTER_HPP
@@ -0,0 +1,161 @@
+/*
+ * Calibration Chain Implementation
+ * Copyright (C) 2025
+ */
+
+#include "calibration-chain.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+static float clampf(float value, float minValue, float maxValue)
+{
+	return std::max(minValue, std::min(value, maxValue));
+}
+
+bool CalibrationChain::hasVoiceEq() const
+{
+	return options.voiceEq || highPassHz > 0.0f;
+}
+
+bool CalibrationChain::hasEq() const
+{
+	return std::fabs(eqLowDb) > 0.01f || std::fabs(eqMidDb) > 0.01f || std::fabs(eqHighDb) > 0.01f;
+}
+
+CalibrationChain CalibrationChain::derive(const float *levels, const float *peaks, const ChainOptions &options)
+{
+	CalibrationChain chain;
+	chain.options = options;
+
+	// After the Step-1 shift, "program" voice is steps 4-6 (normal/steady/energetic)
+	const float noiseFloor = levels[0];
+	const float normal = levels[3];
+	const float steady = levels[4];
+	const float energetic = levels[5];
+	const float avgProgram = (normal + steady + energetic) / 3.0f;
+	const float loudPeak = std::max({peaks[3], peaks[4], peaks[5]});
+	const float dynamic = energetic - normal;
+
+	// Target a stable RMS around -18 dB for OBS meters
+	float gainDb = clampf(TARGET_RMS_DB - avgProgram, -18.0f, 18.0f);
+
+	// Prevent obvious clipping by keeping predicted peak under -3 dBFS
+	const float predictedPeakAfterGain = loudPeak + gainDb;
+	if (predictedPeakAfterGain > -3.0f)
+		gainDb -= (predictedPeakAfterGain + 3.0f);
+	chain.gainDb = clampf(gainDb, -18.0f, 18.0f);
+
+	chain.compressorRatio = 4.0f;
+	if (dynamic > 14.0f)
+		chain.compressorRatio = 6.0f;
+	else if (dynamic < 8.0f)
+		chain.compressorRatio = 3.0f;
+
+	// Compressor threshold: slightly under program RMS
+	chain.compressorThresholdDb = clampf(avgProgram - 5.0f, -45.0f, -10.0f);
+
+	// Multiband: each band starts compressing just above its median
+	// speaking level (after gain) and squeezes its loudest 5% into a few
+	// dB above that, so boom and sibilance are held without the rest of the
+	// voice. Low and high bands are held tighter than the body of the voice.
+	static const float BAND_HEADROOM_DB[CompressorBand::BANDS] = {3.0f, 5.0f, 3.0f};
+	static const float BAND_ATTACK_MS[CompressorBand::BANDS] = {15.0f, 8.0f, 2.0f};
+	static const float BAND_RELEASE_MS[CompressorBand::BANDS] = {150.0f, 100.0f, 60.0f};
+	for (int b = 0; b < CompressorBand::BANDS; b++) {
+		CompressorBand &band = chain.multibandBands[b];
+		const BandDynamics &dynamics = options.bandDynamics[b];
+		band.attackMs = BAND_ATTACK_MS[b];
+		band.releaseMs = BAND_RELEASE_MS[b];
+		if (!dynamics.valid()) {
+			band.thresholdDb = chain.compressorThresholdDb;
+			band.ratio = chain.compressorRatio;
+			continue;
+		}
+		band.thresholdDb = clampf(dynamics.medianDb + chain.gainDb + 2.0f, -50.0f, -6.0f);
+		const float spread = dynamics.loudDb + chain.gainDb - band.thresholdDb;
+		band.ratio = clampf(spread / BAND_HEADROOM_DB[b], 1.5f, 8.0f);
+	}
+
+	chain.gateOpenDb = clampf(std::max(noiseFloor + 15.0f, avgProgram - 25.0f), -60.0f, -10.0f);
+	chain.gateCloseDb = clampf(chain.gateOpenDb - 6.0f, -60.0f, -12.0f);
+
+	// In a live room the tail of every word is still audible after the voice
+	// stops. Release over about the time the room takes to fall 30 dB (gate)
+	// or 15 dB (expander) so neither cuts the tail off faster than it decays.
+	const float rt60 = options.roomRt60();
+	if (rt60 > 0.0f) {
+		chain.gateReleaseMs = static_cast<int>(clampf(rt60 * 500.0f, 100.0f, 400.0f));
+		chain.expanderReleaseMs = static_cast<int>(clampf(rt60 * 250.0f, 50.0f, 250.0f));
+	}
+
+	// Typing between words: open the gate and start expanding above the
+	// clicks, as far as quiet speech allows, and keep the gate closed over
+	// them once open. A shorter hold stops the clatter right after a word
+	// from being carried through; it still outlasts a click several times.
+	if (options.hasClicks()) {
+		const float openCeiling = normal - 10.0f;
+		chain.gateOpenDb = clampf(std::max(chain.gateOpenDb, std::min(options.clickPeakDb + 3.0f, openCeiling)),
+					  -60.0f, -10.0f);
+		chain.gateCloseDb = clampf(std::max(chain.gateOpenDb - 6.0f,
+						    std::min(options.clickPeakDb + 1.0f, chain.gateOpenDb - 2.0f)),
+					   -60.0f, -12.0f);
+		chain.gateHoldMs = static_cast<int>(clampf(options.clickMs * 4.0f, 100.0f, 200.0f));
+		chain.expanderThresholdDb =
+			std::max(chain.expanderThresholdDb, std::min(options.clickLevelDb + 3.0f, normal - 15.0f));
+	}
+
+	// Where the gate tuner's simulation over the captured steps moved them
+	if (options.gateOffsetDb != 0.0f || options.gateHysteresisDb > 0.0f) {
+		const float hysteresis =
+			options.gateHysteresisDb > 0.0f ? options.gateHysteresisDb : chain.gateOpenDb - chain.gateCloseDb;
+		chain.gateOpenDb = clampf(chain.gateOpenDb + options.gateOffsetDb, -60.0f, -10.0f);
+		chain.gateCloseDb = clampf(chain.gateOpenDb - hysteresis, -60.0f, -12.0f);
+	}
+
+	switch (options.noiseSuppressionLevel) {
+	case 0: chain.suppressLevelDb = -15; break;
+	case 1: chain.suppressLevelDb = -25; break;
+	case 2: chain.suppressLevelDb = -35; break;
+	default: break;
+	}
+
+	// EQ-based approximations for high-pass/low-pass/de-esser
+	if (options.highPass) {
+		switch (options.highPassIndex) {
+		case 0: chain.eqLowDb -= 4.0f; break;  // 80 Hz (light)
+		case 1: chain.eqLowDb -= 6.0f; break;  // 100 Hz
+		case 2: chain.eqLowDb -= 8.0f; break;  // 120 Hz
+		case 3:
+			// Auto: a 12 dB/octave high-pass at 3/4 of the lowest speaking
+			// pitch is about 1 dB down on it, so a deep voice keeps its
+			// body and a high one loses more rumble
+			if (options.voiceLowHz > 0.0f)
+				chain.highPassHz = std::round(clampf(options.voiceLowHz * 0.75f, 60.0f, 150.0f) / 5.0f) * 5.0f;
+			else
+				chain.eqLowDb -= 6.0f; // not measured: as 100 Hz
+			break;
+		default: break;
+		}
+	}
+
+	if (options.lowPass) {
+		switch (options.lowPassIndex) {
+		case 0: chain.eqHighDb -= 3.0f; break; // 12 kHz (light)
+		case 1: chain.eqHighDb -= 6.0f; break; // 10 kHz
+		case 2: chain.eqHighDb -= 9.0f; break; // 8 kHz
+		default: break;
+		}
+	}
+
+	if (options.deEsser) {
+		switch (options.deEsserIndex) {
+		case 0: chain.eqHighDb -= 2.0f; break;
+		case 1: chain.eqHighDb -= 4.0f; break;
+		case 2: chain.eqHighDb -= 6.0f; break;
+		default: break;
+		}
+	}
+
+	return chain;
+}
@@ -0,0 +1,178 @@
+/*
+ * Calibration Chain - Filter parameters derived from a calibration run
+ * Copyright (C) 2025
+ *
+ * Pure derivation with no OBS or Qt state, so the same numbers drive the
+ * live filters, the offline preview and any re-derivation.
+ */
+
+#ifndef CALIBRATION_CHAIN_HPP
+#define CALIBRATION_CHAIN_HPP
+
+// One peaking band of the voice-matching EQ
+struct VoiceEqBand {
+	static constexpr int MAX_BANDS = 4;
+
+	float hz = 1000.0f;
+	float gainDb = 0.0f;
+	float q = 1.0f;
+};
+
+// Short-term level distribution of one compressor band over the speaking
+// steps, before gain (-100 = not measured)
+struct BandDynamics {
+	float medianDb = -100.0f;
+	float loudDb = -100.0f; // 95th percentile
+
+	bool valid() const { return medianDb > -99.0f; }
+};
+
+// One band of the native multiband compressor
+struct CompressorBand {
+	static constexpr int BANDS = 3; // low / mid / high
+
+	float thresholdDb = -24.0f;
+	float ratio = 2.0f;
+	float attackMs = 10.0f;
+	float releaseMs = 100.0f;
+};
+
+// 95% bootstrap interval of one derived value
+struct ValueInterval {
+	float low = 0.0f;
+	float high = -1.0f;
+
+	bool valid() const { return low <= high; }
+	float halfWidth() const { return valid() ? 0.5f * (high - low) : 0.0f; }
+};
+
+// How far the derived values would move with another take of the same
+// steps (resamples = 0: not estimated)
+struct ChainIntervals {
+	ValueInterval gainDb;
+	ValueInterval compressorThresholdDb;
+	ValueInterval compressorRatio;
+	ValueInterval gateOpenDb;
+	ValueInterval gateCloseDb;
+	int resamples = 0;
+
+	bool valid() const { return resamples > 0; }
+};
+
+// Which filters the user enabled in the dialog, and their presets
+struct ChainOptions {
+	bool noiseSuppression = true;
+	int noiseSuppressionLevel = 1; // 0=Low, 1=Med, 2=High
+	bool noiseGate = true;
+	bool expander = true;
+	bool gain = true;
+	bool compressor = true;
+	bool limiter = true;
+
+	bool highPass = false;
+	int highPassIndex = 0; // 80 / 100 / 120 Hz / Auto (from voiceLowHz)
+	bool lowPass = false;
+	int lowPassIndex = 0; // 12k / 10k / 8k
+	bool deEsser = false;
+	int deEsserIndex = 1; // Light / Med / Strong
+	bool vst = false;
+	bool howlGuard = false; // native feedback notch filter
+	bool breathFilter = false; // native breath attenuation
+
+	// Room reverberation from the optional clap step, seconds (0 = not measured)
+	float roomT20 = 0.0f;
+	float roomT30 = 0.0f;
+
+	float roomRt60() const { return roomT30 > 0.0f ? roomT30 : roomT20; }
+
+	// Keyboard and mouse transients from the optional keyboard step (or
+	// heard leaking through while live), before gain; -100 = not measured
+	float clickPeakDb = -100.0f;
+	float clickLevelDb = -100.0f; // 10 ms RMS, as the expander's detector sees it
+	float clickMs = 0.0f;
+
+	bool hasClicks() const { return clickPeakDb > -99.0f; }
+
+	// Gate thresholds moved by the gate tuner after simulating the gate over
+	// the captured steps: the open threshold is shifted, and the close
+	// threshold sits hysteresis below it (0 = keep the derived spacing)
+	float gateOffsetDb = 0.0f;
+	float gateHysteresisDb = 0.0f;
+
+	// Breath detector trained on the noise and speaking steps; the filter
+	// keeps its defaults while untrained (ceiling -100)
+	float breathFloorDb = -60.0f;
+	float breathCeilingDb = -100.0f;
+	float breathHarmonicity = 0.45f;
+
+	bool hasBreathModel() const { return breathCeilingDb > -99.0f; }
+
+	// Voice-matching EQ fitted to the speaking steps' long-term spectrum
+	bool voiceEq = false;
+	int voiceEqTarget = 0; // Natural / Broadcast / Warm
+	VoiceEqBand voiceEqBands[VoiceEqBand::MAX_BANDS];
+	int voiceEqBandCount = 0;
+
+	// 5th-percentile speaking pitch of steps 4-6 (0 = not measured)
+	float voiceLowHz = 0.0f;
+
+	// Native multiband compressor in place of the broadband one, tuned
+	// from the per-band level distributions of steps 3-8
+	bool multiband = false;
+	BandDynamics bandDynamics[CompressorBand::BANDS];
+};
+
+struct CalibrationChain {
+	// Post-chain speech RMS the gain is derived to reach
+	static constexpr float TARGET_RMS_DB = -18.0f;
+
+	ChainOptions options;
+
+	int suppressLevelDb = -25;
+
+	float gateOpenDb = -40.0f;
+	float gateCloseDb = -46.0f;
+	int gateAttackMs = 25;
+	int gateHoldMs = 200;
+	int gateReleaseMs = 150;
+
+	float expanderRatio = 2.0f;
+	float expanderThresholdDb = -40.0f;
+	int expanderAttackMs = 10;
+	int expanderReleaseMs = 50;
+
+	float gainDb = 0.0f;
+
+	float compressorThresholdDb = -23.0f;
+	float compressorRatio = 4.0f;
+	int compressorAttackMs = 6;
+	int compressorReleaseMs = 60;
+
+	CompressorBand multibandBands[CompressorBand::BANDS];
+
+	float limiterThresholdDb = -3.0f;
+	int limiterReleaseMs = 60;
+
+	// Native high-pass in the Voice EQ filter, placed under the lowest
+	// speaking pitch (0 = none; the fixed presets use the EQ below)
+	float highPassHz = 0.0f;
+
+	// The Voice EQ filter carries the fitted bands and/or the high-pass
+	bool hasVoiceEq() const;
+
+	// basic_eq_filter bands
+	float eqLowDb = 0.0f;
+	float eqMidDb = 0.0f;
+	float eqHighDb = 0.0f;
+
+	bool hasEq() const;
+
+	// Measurement uncertainty of the values above; derive leaves it empty
+	// and the dialog fills it from its bootstrap
+	ChainIntervals intervals;
+
+	// levels/peaks hold the 8 per-step averages (dB), step 1 = noise floor
+	static CalibrationChain derive(const float *levels, const float *peaks, const ChainOptions &options);
+};
+
+#endif // CALIBRATION_CHAIN_HPP
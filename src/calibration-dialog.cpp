@@ -9,6 +9,18 @@
 #include <obs-frontend-api.h>
 
 #include "plugin-support.h"
+#include "chain-bootstrap.hpp"
+#include "chain-settings.hpp"
+#include "filter-models.hpp"
+#include "multiband-compressor.hpp"
+#include "offline-render.hpp"
+#include "pitch-tracker.hpp"
+#include "profile-switcher.hpp"
+#include "retro-capture.hpp"
+#include "room-decay.hpp"
+#include "sweep-measurement.hpp"
+#include "voice-spectrum.hpp"
+#include "worker-pool.hpp"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -21,10 +33,17 @@
 #include <QJsonArray>
 #include <QStandardPaths>
 #include <QDir>
+#include <QDateTime>
+#include <QFileDialog>
+#include <QSignalBlocker>
+#include <QPointer>
+#include <QCoreApplication>
 
 #include <algorithm>
 #include <cmath>
 
+static const char *DUCKING_FILTER = "Audio Calibrator - Ducking";
+
 static int dbToPercent(float db)
 {
 	// Map [-60..0] dB -> [0..100]
@@ -35,18 +54,13 @@ static int dbToPercent(float db)
 	return static_cast<int>(((db + 60.0f) / 60.0f) * 100.0f);
 }
 
-static float clampf(float value, float minValue, float maxValue)
-{
-	return std::max(minValue, std::min(value, maxValue));
-}
-
 CalibrationDialog::CalibrationDialog(QWidget *parent)
 	: QDialog(parent), audioAnalyzer(std::make_unique<AudioAnalyzer>())
 {
 	setWindowTitle("Audio Calibration Wizard");
 	setModal(false);
 	setMinimumWidth(520);
-	setMaximumHeight(400);
+	setMaximumHeight(560);
 
 	currentStep = 0;
 	isRecording = false;
@@ -58,10 +72,12 @@ CalibrationDialog::CalibrationDialog(QWidget *parent)
 	for (int i = 0; i < TOTAL_STEPS; i++)
 		peaks[i] = -100.0f;
 
-	recordingRmsSumLinear = 0.0;
-	recordingRmsSamples = 0;
+	recordingLevel.reset();
 	recordingPeakMaxDb = -100.0f;
 
+	// Compressed, so ten minutes of the tapped source stays cheap to keep
+	audioAnalyzer->setHistorySeconds(HISTORY_SECONDS);
+
 	setupUI();
 	setupStyles();
 	populateAudioSources();
@@ -79,6 +95,10 @@ CalibrationDialog::CalibrationDialog(QWidget *parent)
 
 CalibrationDialog::~CalibrationDialog()
 {
+	duckingCalibrator.reset();
+	endDucking(true);
+	distanceWatch.stop();
+	retroTap.reset();
 	if (audioAnalyzer)
 		audioAnalyzer->stopCapture();
 }
@@ -118,6 +138,17 @@ void CalibrationDialog::setupUI()
 	countdownLabel = new QLabel("");
 	recordTopRow->addWidget(countdownLabel);
 	recordTopRow->addSpacing(10);
+	stepToleranceSpin = new QDoubleSpinBox(this);
+	stepToleranceSpin->setRange(0.5, 3.0);
+	stepToleranceSpin->setSingleStep(0.25);
+	stepToleranceSpin->setDecimals(2);
+	stepToleranceSpin->setValue(DEFAULT_STEP_TOLERANCE_DB);
+	stepToleranceSpin->setPrefix("±");
+	stepToleranceSpin->setSuffix(" dB");
+	stepToleranceSpin->setToolTip("A step ends once its level is known this precisely (95%); smaller records longer");
+	connect(stepToleranceSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this,
+		[this](double) { saveCalibrationData(); });
+	recordTopRow->addWidget(stepToleranceSpin);
 	recordButton = new QPushButton("Record");
 	recordButton->setEnabled(false);
 	recordButton->setMinimumWidth(80);
@@ -131,7 +162,7 @@ void CalibrationDialog::setupUI()
 	recordLayout->addWidget(promptLabel);
 
 	recordingProgress = new QProgressBar(this);
-	recordingProgress->setRange(0, RECORDING_DURATION_MS);
+	recordingProgress->setRange(0, MAX_RECORDING_MS);
 	recordingProgress->setValue(0);
 	recordingProgress->setMaximumHeight(12);
 	recordLayout->addWidget(recordingProgress);
@@ -159,6 +190,13 @@ void CalibrationDialog::setupUI()
 	peakLabel = new QLabel("-∞");
 	peakLabel->setMinimumWidth(50);
 	meterRow->addWidget(peakLabel);
+	meterRow->addSpacing(10);
+	timelineLabel = new QLabel("●");
+	timelineLabel->setToolTip("Audio timeline continuity");
+	meterRow->addWidget(timelineLabel);
+	distanceLabel = new QLabel(QString());
+	distanceLabel->setToolTip("Mic distance compared with step 4 of the applied calibration");
+	meterRow->addWidget(distanceLabel);
 	mainLayout->addLayout(meterRow);
 
 	// Results (compact 2-column grid)
@@ -182,6 +220,8 @@ void CalibrationDialog::setupUI()
 	step8Result = makeResultLabel("8) —");
 	rangeResult = makeResultLabel("Range: —");
 	avgResult = makeResultLabel("Avg: —");
+	intelligibilityLabel = makeResultLabel(QString());
+	gateLabel = makeResultLabel(QString());
 
 	resultsLayout->addWidget(step1Result, 0, 0);
 	resultsLayout->addWidget(step2Result, 0, 1);
@@ -193,6 +233,8 @@ void CalibrationDialog::setupUI()
 	resultsLayout->addWidget(step8Result, 1, 3);
 	resultsLayout->addWidget(rangeResult, 2, 0, 1, 2);
 	resultsLayout->addWidget(avgResult, 2, 2, 1, 2);
+	resultsLayout->addWidget(intelligibilityLabel, 3, 0, 1, 4);
+	resultsLayout->addWidget(gateLabel, 4, 0, 1, 4);
 	mainLayout->addWidget(resultsGroup);
 
 	// Filters (collapsed into two horizontal rows)
@@ -239,10 +281,21 @@ void CalibrationDialog::setupUI()
 	enableLowPassCheck = new QCheckBox("LPF", this);
 	enableDeEsserCheck = new QCheckBox("De-ess", this);
 	enableVSTCheck = new QCheckBox("VST", this);
+	enableHowlGuardCheck = new QCheckBox("Howl", this);
+	enableHowlGuardCheck->setToolTip("Detect monitor feedback and notch it out automatically");
+	enableBreathCheck = new QCheckBox("Breath", this);
+	enableBreathCheck->setToolTip("Turn breaths between phrases down (trained on your speaking steps, 10 ms latency)");
+	enableVoiceEqCheck = new QCheckBox("Voice EQ", this);
+	enableVoiceEqCheck->setToolTip(
+		"Match your voice's long-term spectrum to the target curve (fitted on your speaking steps)");
+	enableMultibandCheck = new QCheckBox("Multiband", this);
+	enableMultibandCheck->setToolTip(
+		"Compress low, mid and high bands separately in place of the compressor (tuned on your speaking steps)");
 
 	highPassFreq = new QComboBox(this);
-	highPassFreq->addItems({"80", "100", "120"});
+	highPassFreq->addItems({"80", "100", "120", "Auto"});
 	highPassFreq->setCurrentIndex(0);
+	highPassFreq->setToolTip("Auto places the cut just under the lowest pitch of your speaking steps");
 
 	lowPassFreq = new QComboBox(this);
 	lowPassFreq->addItems({"12k", "10k", "8k"});
@@ -252,6 +305,12 @@ void CalibrationDialog::setupUI()
 	deEsserIntensity->addItems({"Light", "Med", "Strong"});
 	deEsserIntensity->setCurrentIndex(1);
 
+	voiceEqTarget = new QComboBox(this);
+	voiceEqTarget->addItems({"Natural", "Broadcast", "Warm"});
+	voiceEqTarget->setCurrentIndex(0);
+	connect(voiceEqTarget, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+		[this](int) { fitVoiceEq(); });
+
 	advLayout->addWidget(enableHighPassCheck, 0, 0);
 	advLayout->addWidget(highPassFreq, 0, 1);
 	advLayout->addWidget(enableLowPassCheck, 0, 2);
@@ -259,23 +318,160 @@ void CalibrationDialog::setupUI()
 	advLayout->addWidget(enableDeEsserCheck, 0, 4);
 	advLayout->addWidget(deEsserIntensity, 0, 5);
 	advLayout->addWidget(enableVSTCheck, 0, 6);
+	advLayout->addWidget(enableHowlGuardCheck, 0, 7);
+	advLayout->addWidget(enableBreathCheck, 0, 8);
+	advLayout->addWidget(enableVoiceEqCheck, 1, 0);
+	advLayout->addWidget(voiceEqTarget, 1, 1);
+	advLayout->addWidget(enableMultibandCheck, 1, 2);
 
 	mainLayout->addWidget(advancedFiltersGroup);
 
+	// The predicted intelligibility follows the options that change it
+	for (QCheckBox *check :
+	     {enableNoiseSuppressionCheck, enableHighPassCheck, enableLowPassCheck, enableDeEsserCheck, enableVoiceEqCheck})
+		connect(check, &QCheckBox::toggled, this, [this](bool) { estimateIntelligibility(); });
+	for (QComboBox *combo : {noiseSuppressionLevel, highPassFreq, lowPassFreq, deEsserIntensity})
+		connect(combo, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+			[this](int) { estimateIntelligibility(); });
+
 	// Status + Apply/Reset
 	statusLabel = new QLabel("Ready.");
 	statusLabel->setWordWrap(true);
 	mainLayout->addWidget(statusLabel);
 
+	// Retro capture: freeze and analyse what just happened
+	auto *retroRow = new QHBoxLayout();
+	retroRow->addWidget(new QLabel("Retro:"));
+	retroSecondsSpin = new QSpinBox(this);
+	retroSecondsSpin->setRange(5, 300);
+	retroSecondsSpin->setValue(static_cast<int>(AnalysisWorker::shared().retroSeconds()));
+	retroSecondsSpin->setSuffix(" s");
+
+	// Resizing reallocates the ring and drops what it holds, so only the
+	// value the spin settles on is applied
+	retroResizeTimer = new QTimer(this);
+	retroResizeTimer->setSingleShot(true);
+	retroResizeTimer->setInterval(RETRO_RESIZE_DELAY_MS);
+	auto applyRetroSeconds = [this]() {
+		retroResizeTimer->stop();
+		AnalysisWorker::shared().setRetroSeconds(retroSecondsSpin->value());
+		saveCalibrationData();
+	};
+	connect(retroResizeTimer, &QTimer::timeout, this, applyRetroSeconds);
+	connect(retroSecondsSpin, QOverload<int>::of(&QSpinBox::valueChanged), retroResizeTimer,
+		QOverload<>::of(&QTimer::start));
+	connect(retroSecondsSpin, &QSpinBox::editingFinished, this, [this, applyRetroSeconds]() {
+		if (retroResizeTimer->isActive())
+			applyRetroSeconds();
+	});
+	retroRow->addWidget(retroSecondsSpin);
+	retroButton = new QPushButton("Capture Last");
+	retroButton->setToolTip("Freeze the last seconds of the source and analyse peaks, clipping, gate and compressor");
+	connect(retroButton, &QPushButton::clicked, this, &CalibrationDialog::captureRetro);
+	retroRow->addWidget(retroButton);
+	exportRetroButton = new QPushButton("Export WAV");
+	exportRetroButton->setEnabled(false);
+	connect(exportRetroButton, &QPushButton::clicked, this, &CalibrationDialog::onExportRetroClicked);
+	retroRow->addWidget(exportRetroButton);
+	retroRow->addStretch();
+	mainLayout->addLayout(retroRow);
+
+	// Room: swept-sine response (play the sweep, capture, measure) and the
+	// optional clap step for reverberation time
+	auto *responseRow = new QHBoxLayout();
+	responseRow->addWidget(new QLabel("Room:"));
+	saveSweepButton = new QPushButton("Save Sweep...");
+	saveSweepButton->setToolTip("Write a 10 s sine sweep WAV to play through the speakers near the mic");
+	connect(saveSweepButton, &QPushButton::clicked, this, &CalibrationDialog::onSaveSweepClicked);
+	responseRow->addWidget(saveSweepButton);
+	measureCaptureButton = new QPushButton("Measure Capture");
+	measureCaptureButton->setEnabled(false);
+	measureCaptureButton->setToolTip("Find the sweep in the last retro capture and measure the mic-in-room response");
+	connect(measureCaptureButton, &QPushButton::clicked, this, &CalibrationDialog::onMeasureCaptureClicked);
+	responseRow->addWidget(measureCaptureButton);
+	measureWavButton = new QPushButton("Measure WAV...");
+	measureWavButton->setToolTip("Measure the response from a recording of the sweep");
+	connect(measureWavButton, &QPushButton::clicked, this, &CalibrationDialog::onMeasureWavClicked);
+	responseRow->addWidget(measureWavButton);
+	clapButton = new QPushButton("Clap Test");
+	clapButton->setToolTip("Clap once near the mic to measure reverberation; sets gate and expander release");
+	connect(clapButton, &QPushButton::clicked, this, &CalibrationDialog::onClapClicked);
+	responseRow->addWidget(clapButton);
+	roomLabel = new QLabel(this);
+	responseRow->addWidget(roomLabel);
+	updateRoomLabel();
+	responseRow->addStretch();
+	mainLayout->addLayout(responseRow);
+
+	// Optional keyboard step: what the gate and expander should stay above
+	auto *typingRow = new QHBoxLayout();
+	typingRow->addWidget(new QLabel("Typing:"));
+	keyboardButton = new QPushButton("Keyboard Test");
+	keyboardButton->setToolTip("Type and click the mouse for 8 s without speaking; keeps the gate closed on them");
+	connect(keyboardButton, &QPushButton::clicked, this, &CalibrationDialog::onKeyboardClicked);
+	typingRow->addWidget(keyboardButton);
+	clickLabel = new QLabel(this);
+	typingRow->addWidget(clickLabel);
+	updateClickLabel();
+	typingRow->addStretch();
+	mainLayout->addLayout(typingRow);
+
+	// Ducking: compressor on the music keyed by this mic
+	auto *duckRow = new QHBoxLayout();
+	duckRow->addWidget(new QLabel("Ducking:"));
+	duckMusicCombo = new QComboBox(this);
+	duckMusicCombo->setMinimumWidth(140);
+	duckMusicCombo->setToolTip("Music or desktop source to duck under the voice");
+	duckRow->addWidget(duckMusicCombo);
+	duckTargetSpin = new QSpinBox(this);
+	duckTargetSpin->setRange(3, 30);
+	duckTargetSpin->setValue(DEFAULT_DUCK_TARGET_LU);
+	duckTargetSpin->setPrefix("voice +");
+	duckTargetSpin->setSuffix(" LU");
+	connect(duckTargetSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int) {
+		saveCalibrationData();
+	});
+	duckRow->addWidget(duckTargetSpin);
+	duckButton = new QPushButton("Calibrate Ducking");
+	duckButton->setToolTip("Talk over the playing music; sets a sidechain compressor on the music source");
+	connect(duckButton, &QPushButton::clicked, this, &CalibrationDialog::onDuckClicked);
+	duckRow->addWidget(duckButton);
+	duckRow->addStretch();
+	mainLayout->addLayout(duckRow);
+
+	// Per-scene profiles: switched on scene change without re-creating filters
+	auto *profileRow = new QHBoxLayout();
+	profileRow->addWidget(new QLabel("Profile:"));
+	profileCombo = new QComboBox(this);
+	profileCombo->setEditable(true);
+	profileCombo->setMinimumWidth(140);
+	profileCombo->setToolTip("Name for this calibration, e.g. desk or stage");
+	profileRow->addWidget(profileCombo);
+	saveProfileButton = new QPushButton("Save for Current Scene");
+	saveProfileButton->setToolTip("Store this calibration as a profile and use it whenever the current scene is shown");
+	connect(saveProfileButton, &QPushButton::clicked, this, &CalibrationDialog::onSaveProfileClicked);
+	profileRow->addWidget(saveProfileButton);
+	profileRow->addStretch();
+	mainLayout->addLayout(profileRow);
+
 	auto *buttonsRow = new QHBoxLayout();
 	applyButton = new QPushButton("Apply Filters");
 	applyButton->setEnabled(false);
 	connect(applyButton, &QPushButton::clicked, this, &CalibrationDialog::onApplyClicked);
 
+	previewButton = new QPushButton("Preview");
+	previewButton->setEnabled(false);
+	previewButton->setToolTip("Render the captured steps through the proposed chain to before/after WAV files");
+	connect(previewButton, &QPushButton::clicked, this, &CalibrationDialog::onPreviewClicked);
+
 	resetButton = new QPushButton("Reset");
 	connect(resetButton, &QPushButton::clicked, this, &CalibrationDialog::onResetClicked);
 
+	uncertaintyLabel = new QLabel(this);
+
 	buttonsRow->addWidget(applyButton);
+	buttonsRow->addWidget(uncertaintyLabel);
+	buttonsRow->addWidget(previewButton);
 	buttonsRow->addStretch();
 	buttonsRow->addWidget(resetButton);
 	mainLayout->addLayout(buttonsRow);
@@ -328,6 +524,11 @@ void CalibrationDialog::populateAudioSources()
 			return true;
 		},
 		&ctx);
+
+	duckMusicCombo->clear();
+	duckMusicCombo->addItem("Music source...");
+	for (int i = 1; i < sourceCombo->count(); i++)
+		duckMusicCombo->addItem(sourceCombo->itemText(i));
 }
 
 obs_source_t *CalibrationDialog::getSelectedSource()
@@ -351,8 +552,12 @@ void CalibrationDialog::onSourceChanged(int index)
 		return;
 	}
 
+	refreshProfiles();
+
 	obs_source_t *source = getSelectedSource();
 	if (!source) {
+		distanceWatch.stop();
+		retroTap.reset();
 		audioAnalyzer->stopCapture();
 		statusLabel->setText("Select a valid audio source.");
 		obs_log(LOG_INFO, "[AudioCalibrator] No valid source selected");
@@ -363,6 +568,14 @@ void CalibrationDialog::onSourceChanged(int index)
 	obs_log(LOG_INFO, "[AudioCalibrator] Starting capture on source: %s", srcName ? srcName : "(null)");
 	
 	bool started = audioAnalyzer->startCapture(source);
+	retroTap = AnalysisWorker::shared().tap(source);
+
+	// Only meaningful once this source has an applied calibration
+	CalibrationBaseline baseline;
+	if (srcName && ProfileSwitcher::instance().baseline(srcName, baseline) && baseline.distance.valid())
+		distanceWatch.start(source, baseline.distance);
+	else
+		distanceWatch.stop();
 	obs_source_release(source);
 	
 	if (started) {
@@ -392,11 +605,32 @@ void CalibrationDialog::onStartClicked()
 	startButton->setEnabled(false);
 	recordButton->setEnabled(true);
 	applyButton->setEnabled(false);
+	previewButton->setEnabled(false);
 
 	for (int i = 0; i < TOTAL_STEPS; i++)
 		levels[i] = -100.0f;
 	for (int i = 0; i < TOTAL_STEPS; i++)
 		peaks[i] = -100.0f;
+	for (int i = 0; i < TOTAL_STEPS; i++)
+		stepAudio[i].reset();
+	for (auto &spectrum : stepSpectra)
+		spectrum.reset();
+	for (auto &pitches : stepPitches)
+		pitches.clear();
+	for (auto &step : stepBandLevels)
+		for (auto &band : step)
+			band.clear();
+	chainIntervals = ChainIntervals();
+	updateUncertaintyLabel();
+	noiseBands = IntelligibilityBands();
+	speechBands = IntelligibilityBands();
+	intelligibility = IntelligibilityEstimate();
+	intelligibilityRequest++;
+	updateIntelligibilityLabel();
+	gateOffsetDb = 0.0f;
+	gateHysteresisDb = 0.0f;
+	gateTuning = GateTuning();
+	updateGateLabel();
 
 	updatePromptForStep();
 	updateResultsDisplay();
@@ -421,6 +655,9 @@ void CalibrationDialog::onRecordClicked()
 		return;
 	}
 
+	if (clapCapturing || keyboardCapturing)
+		return;
+
 	startRecording();
 }
 
@@ -445,16 +682,17 @@ void CalibrationDialog::startRecording()
 
 	recordingElapsedMs = 0;
 	recordingFrames = 0;
-	recordingProgress->setRange(0, RECORDING_DURATION_MS);
+	recordingProgress->setRange(0, MAX_RECORDING_MS);
 	recordingProgress->setValue(0);
 
 	// Initialize recording-window accumulators
-	recordingRmsSumLinear = 0.0;
-	recordingRmsSamples = 0;
+	recordingLevel.reset();
 	recordingPeakMaxDb = -100.0f;
 	levels[currentStep - 1] = -100.0f;
 	peaks[currentStep - 1] = -100.0f;
 	audioAnalyzer->resetMaxPeak();
+	audioAnalyzer->beginStepCapture(MAX_RECORDING_MS / 1000.0 + 0.5);
+	recordingDiscontinuities = audioAnalyzer->getTimeline().discontinuities();
 
 	onRecordingTick();
 	recordingTimer->start(RECORDING_TICK_MS);
@@ -472,8 +710,46 @@ void CalibrationDialog::stopRecording()
 	recordButton->setText("Record");
 	recordingTimer->stop();
 
+	if (audioAnalyzer && currentStep >= 1 && currentStep <= TOTAL_STEPS)
+		stepAudio[currentStep - 1] = audioAnalyzer->endStepCapture();
+
+	// Audio went missing or was repeated inside the window: the averages
+	// are not trustworthy, so the step has to be recorded again
+	const uint64_t discontinuities =
+		audioAnalyzer ? audioAnalyzer->getTimeline().discontinuities() - recordingDiscontinuities : 0;
+	if (discontinuities > 0 && currentStep >= 1 && currentStep <= TOTAL_STEPS) {
+		levels[currentStep - 1] = -100.0f;
+		peaks[currentStep - 1] = -100.0f;
+		stepAudio[currentStep - 1].reset();
+		if (currentStep == 1)
+			noiseBands = IntelligibilityBands();
+		if (currentStep >= 4 && currentStep <= 6) {
+			stepSpectra[currentStep - 4].reset();
+			stepPitches[currentStep - 4].clear();
+		}
+		if (currentStep >= 3) {
+			for (auto &band : stepBandLevels[currentStep - 3])
+				band.clear();
+		}
+		updateResultsDisplay();
+		obs_log(LOG_WARNING, "[AudioCalibrator] Step %d invalid: %llu timeline breaks (%s)", currentStep,
+			static_cast<unsigned long long>(discontinuities),
+			audioAnalyzer->getTimeline().counts().summary().c_str());
+		statusLabel->setText(QString("Step %1 was interrupted by an audio dropout. Please record it again.")
+					     .arg(currentStep));
+		return;
+	}
+
 	saveCurrentLevel();
 	updateResultsDisplay();
+	if (currentStep == 1 || (currentStep >= 4 && currentStep <= 6))
+		trainBreathModel();
+	if (currentStep == 1)
+		analyzeNoiseStep();
+	if (currentStep >= 4 && currentStep <= 6)
+		analyzeSpeakingStep(currentStep - 4);
+	if (currentStep >= 3 && currentStep <= TOTAL_STEPS)
+		measureBandLevels(currentStep);
 	advanceStep();
 	saveCalibrationData();  // Persist after step advances (so currentStep reflects completion)
 }
@@ -504,10 +780,12 @@ void CalibrationDialog::advanceStep()
 		currentStep = TOTAL_STEPS + 1;
 		recordButton->setEnabled(false);
 		applyButton->setEnabled(true);
+		previewButton->setEnabled(true);
 		statusLabel->setText("Calibration complete. Review results and click Apply.");
 		stepIndicatorLabel->setText("Complete");
 		promptLabel->setText("Calibration complete.");
 		countdownLabel->setText(" ");
+		tuneGate();
 		return;
 	}
 
@@ -558,7 +836,7 @@ QString CalibrationDialog::getInstructionForStep(int step)
 {
 	switch (step) {
 	case 1:
-		return "Be quiet for 5 seconds so we can measure room noise.";
+		return "Stay quiet until the step ends so we can measure room noise.";
 	case 2:
 		return "Speak very softly, close to the mic.";
 	case 3:
@@ -566,7 +844,7 @@ QString CalibrationDialog::getInstructionForStep(int step)
 	case 4:
 		return "Speak normally like a call/meeting.";
 	case 5:
-		return "Keep a steady normal volume for the full 5 seconds.";
+		return "Keep a steady normal volume until the step ends.";
 	case 6:
 		return "Speak with energy (like streaming), but don’t shout.";
 	case 7:
@@ -584,40 +862,56 @@ void CalibrationDialog::onRecordingTick()
 		return;
 
 	recordingElapsedMs += RECORDING_TICK_MS;
-	if (recordingElapsedMs > RECORDING_DURATION_MS)
-		recordingElapsedMs = RECORDING_DURATION_MS;
+	if (recordingElapsedMs > MAX_RECORDING_MS)
+		recordingElapsedMs = MAX_RECORDING_MS;
 
 	recordingProgress->setValue(recordingElapsedMs);
 
-	const int remainingMs = RECORDING_DURATION_MS - recordingElapsedMs;
-	countdownLabel->setText(QString("Time remaining: %1.%2s")
-					.arg(remainingMs / 1000)
-					.arg((remainingMs % 1000) / 100));
-
 	// Accumulate RMS in linear space for a more stable average.
 	if (audioAnalyzer && audioAnalyzer->isCapturing()) {
 		const float rmsDb = audioAnalyzer->getCurrentRMS();
 		const float peakDb = audioAnalyzer->getCurrentPeak();
 
-		recordingRmsSumLinear += static_cast<double>(AudioAnalyzer::fromDB(rmsDb));
-		recordingRmsSamples++;
+		recordingLevel.add(static_cast<double>(AudioAnalyzer::fromDB(rmsDb)));
 		recordingPeakMaxDb = std::max(recordingPeakMaxDb, peakDb);
 
-		const double avgLinear = recordingRmsSamples > 0
-					? (recordingRmsSumLinear / static_cast<double>(recordingRmsSamples))
-					: 0.0;
-		levels[currentStep - 1] = AudioAnalyzer::toDB(static_cast<float>(avgLinear));
+		levels[currentStep - 1] = AudioAnalyzer::toDB(static_cast<float>(recordingLevel.mean()));
 		peaks[currentStep - 1] = recordingPeakMaxDb;
 	}
 
-	if (recordingElapsedMs >= RECORDING_DURATION_MS) {
+	// Stop as soon as the level has settled; the cap covers steps that
+	// never do (an uneven voice, a noisy room)
+	const double halfWidthDb = recordingLevel.halfWidthDb();
+	const double toleranceDb = stepToleranceSpin->value();
+	const bool converged = recordingElapsedMs >= MIN_RECORDING_MS && halfWidthDb <= toleranceDb;
+	const int remainingMs = MAX_RECORDING_MS - recordingElapsedMs;
+	if (std::isfinite(halfWidthDb)) {
+		countdownLabel->setText(QString("±%1 dB (need ±%2) · at most %3.%4s")
+						.arg(halfWidthDb, 0, 'f', 1)
+						.arg(toleranceDb, 0, 'f', 1)
+						.arg(remainingMs / 1000)
+						.arg((remainingMs % 1000) / 100));
+	} else {
+		countdownLabel->setText(QString("At most %1.%2s").arg(remainingMs / 1000).arg((remainingMs % 1000) / 100));
+	}
+
+	if (converged || recordingElapsedMs >= MAX_RECORDING_MS) {
+		obs_log(LOG_INFO, "[AudioCalibrator] Step %d %s after %d ms: %.1f dB ±%.2f dB (r=%.2f, %zu readings)",
+			currentStep, converged ? "converged" : "hit the time limit", recordingElapsedMs,
+			levels[currentStep - 1], halfWidthDb, recordingLevel.autocorrelation(), recordingLevel.count());
 		stopRecording();
 	}
 }
 
 void CalibrationDialog::updateLevelMeter()
 {
+	if (duckingCalibrator)
+		duckButton->setText(QString("Cancel (%1%)").arg(static_cast<int>(duckingCalibrator->progress() * 100.0)));
+
 	if (!audioAnalyzer || !audioAnalyzer->isCapturing()) {
+		timelineLabel->setStyleSheet(QString());
+		timelineLabel->setToolTip("Audio timeline continuity");
+		distanceLabel->clear();
 		levelMeter->setValue(0);
 		peakMeter->setValue(0);
 		rmsLabel->setText("RMS: -∞ dB");
@@ -625,6 +919,26 @@ void CalibrationDialog::updateLevelMeter()
 		return;
 	}
 
+	// Green while continuous, amber on jitter only, red once audio was
+	// lost or repeated
+	const TimelineCounts timeline = audioAnalyzer->getTimeline().counts();
+	const char *timelineColor = "#50c050";
+	if (timeline.discontinuities() > 0)
+		timelineColor = "#e05050";
+	else if (timeline.jitter > 0)
+		timelineColor = "#e0a030";
+	timelineLabel->setStyleSheet(QString("color: %1;").arg(timelineColor));
+	timelineLabel->setToolTip(QString("Audio timeline: %1").arg(QString::fromStdString(timeline.summary())));
+
+	// Amber while the talker has moved, blank until enough speech was heard
+	const MicDistance distance = distanceWatch.state();
+	distanceLabel->setText(DistanceMonitor::describe(distance));
+	distanceLabel->setStyleSheet(QString("color: %1;").arg(distance == MicDistance::Ok ? "#50c050" : "#e0a030"));
+	if (distance != MicDistance::Unknown)
+		distanceLabel->setToolTip(QString("Tilt %1 dB, level %2 dB against step 4")
+						  .arg(distanceWatch.tiltDeviationDb(), 0, 'f', 1)
+						  .arg(distanceWatch.levelDeviationDb(), 0, 'f', 1));
+
 	const float rms = audioAnalyzer->getCurrentRMS();
 	const float peak = audioAnalyzer->getCurrentPeak();
 
@@ -709,50 +1023,97 @@ void CalibrationDialog::onApplyClicked()
 		}
 	}
 
-	// After the Step-1 shift, "program" voice is steps 4-6 (normal/steady/energetic)
-	const float noiseFloor = levels[0];
-	const float normal = levels[3];
-	const float steady = levels[4];
-	const float energetic = levels[5];
-	const float avgProgram = (normal + steady + energetic) / 3.0f;
-	const float loudPeak = std::max({peaks[3], peaks[4], peaks[5]});
-	const float dynamic = energetic - normal;
+	const CalibrationChain chain = buildChain();
+	const float avgProgram = (levels[3] + levels[4] + levels[5]) / 3.0f;
 
 	obs_log(LOG_INFO, "[AudioCalibrator] Calibration results:");
-	obs_log(LOG_INFO, "[AudioCalibrator]   Noise floor (step 1): %.1f dB", noiseFloor);
-	obs_log(LOG_INFO, "[AudioCalibrator]   Normal voice (step 4): %.1f dB", normal);
-	obs_log(LOG_INFO, "[AudioCalibrator]   Steady voice (step 5): %.1f dB", steady);
-	obs_log(LOG_INFO, "[AudioCalibrator]   Energetic (step 6): %.1f dB", energetic);
-	obs_log(LOG_INFO, "[AudioCalibrator]   Avg program: %.1f dB, dynamic range: %.1f dB", avgProgram, dynamic);
-
-	// Target a stable RMS around -18 dB for OBS meters
-	const float targetRms = -18.0f;
-	float gainDb = clampf(targetRms - avgProgram, -18.0f, 18.0f);
-
-	// Prevent obvious clipping by keeping predicted peak under -3 dBFS
-	const float predictedPeakAfterGain = loudPeak + gainDb;
-	if (predictedPeakAfterGain > -3.0f)
-		gainDb -= (predictedPeakAfterGain + 3.0f);
-	gainDb = clampf(gainDb, -18.0f, 18.0f);
-
-	float ratio = 4.0f;
-	if (dynamic > 14.0f)
-		ratio = 6.0f;
-	else if (dynamic < 8.0f)
-		ratio = 3.0f;
-
-	// Compressor threshold: slightly under program RMS
-	float thresholdDb = clampf(avgProgram - 5.0f, -45.0f, -10.0f);
+	obs_log(LOG_INFO, "[AudioCalibrator]   Noise floor (step 1): %.1f dB", levels[0]);
+	obs_log(LOG_INFO, "[AudioCalibrator]   Normal voice (step 4): %.1f dB", levels[3]);
+	obs_log(LOG_INFO, "[AudioCalibrator]   Steady voice (step 5): %.1f dB", levels[4]);
+	obs_log(LOG_INFO, "[AudioCalibrator]   Energetic (step 6): %.1f dB", levels[5]);
+	obs_log(LOG_INFO, "[AudioCalibrator]   Avg program: %.1f dB, dynamic range: %.1f dB", avgProgram,
+		levels[5] - levels[3]);
 
 	obs_log(LOG_INFO, "[AudioCalibrator] Applying: gain=%.1f dB, threshold=%.1f dB, ratio=%.1f:1",
-			gainDb, thresholdDb, ratio);
+			chain.gainDb, chain.compressorThresholdDb, chain.compressorRatio);
+
+	applyFilters(chain);
+
+	// Freshly created filters belong to no profile until the next switch;
+	// the measurements behind them are kept for live recalibration
+	ProfileSwitcher &switcher = ProfileSwitcher::instance();
+	CalibrationBaseline baseline;
+	std::copy(levels, levels + TOTAL_STEPS, baseline.levels);
+	std::copy(peaks, peaks + TOTAL_STEPS, baseline.peaks);
+	baseline.options = chain.options;
+
+	// Step 4 as the post-filter analysis tap will hear it from now on
+	if (stepAudio[3] && !stepAudio[3]->samples.empty()) {
+		std::vector<float> rendered = stepAudio[3]->samples;
+		ChainModel model(chain, stepAudio[3]->sampleRate);
+		model.process(rendered.data(), rendered.size());
+		baseline.distance =
+			DistanceMonitor::measureReference(rendered.data(), rendered.size(), stepAudio[3]->sampleRate);
+	}
+	switcher.markActive(obs_source_get_name(source), std::string());
+	switcher.setBaseline(obs_source_get_name(source), baseline);
+	switcher.save();
 
-	applyFilters(gainDb, thresholdDb, ratio);
+	if (baseline.distance.valid())
+		distanceWatch.start(source, baseline.distance);
+	else
+		distanceWatch.stop();
 
 	obs_source_release(source);
 	statusLabel->setText("Filters applied successfully!");
 }
 
+void CalibrationDialog::refreshProfiles()
+{
+	const QString current = profileCombo->currentText();
+	profileCombo->clear();
+
+	if (sourceCombo->currentIndex() > 0) {
+		const std::string sourceName = sourceCombo->currentText().toUtf8().constData();
+		for (const std::string &name : ProfileSwitcher::instance().profileNames(sourceName))
+			profileCombo->addItem(QString::fromStdString(name));
+	}
+	profileCombo->setEditText(current);
+}
+
+void CalibrationDialog::onSaveProfileClicked()
+{
+	if (currentStep <= TOTAL_STEPS) {
+		statusLabel->setText("Finish all steps before saving a profile.");
+		return;
+	}
+
+	const QString profileName = profileCombo->currentText().trimmed();
+	if (sourceCombo->currentIndex() <= 0 || profileName.isEmpty()) {
+		statusLabel->setText("Select a source and name the profile first.");
+		return;
+	}
+
+	obs_source_t *scene = obs_frontend_get_current_scene();
+	const char *sceneName = scene ? obs_source_get_name(scene) : nullptr;
+	const std::string sceneText = sceneName ? sceneName : "";
+	obs_source_release(scene);
+
+	const std::string sourceName = sourceCombo->currentText().toUtf8().constData();
+	const std::string name = profileName.toUtf8().constData();
+
+	ProfileSwitcher &switcher = ProfileSwitcher::instance();
+	switcher.setProfile(sourceName, name, buildChain());
+	switcher.bindScene(sceneText, sourceName, name);
+	const bool saved = switcher.save();
+
+	refreshProfiles();
+	statusLabel->setText(QString(saved ? "Profile '%1' will be used in scene '%2'. Apply once so its filters "
+					     "exist; later switches only update them."
+					   : "Could not save profile '%1'.")
+				     .arg(profileName, QString::fromStdString(sceneText)));
+}
+
 void CalibrationDialog::onResetClicked()
 {
 	if (isRecording)
@@ -762,11 +1123,32 @@ void CalibrationDialog::onResetClicked()
 	startButton->setEnabled(true);
 	recordButton->setEnabled(false);
 	applyButton->setEnabled(false);
+	previewButton->setEnabled(false);
 
 	for (int i = 0; i < TOTAL_STEPS; i++)
 		levels[i] = -100.0f;
 	for (int i = 0; i < TOTAL_STEPS; i++)
 		peaks[i] = -100.0f;
+	for (int i = 0; i < TOTAL_STEPS; i++)
+		stepAudio[i].reset();
+	for (auto &spectrum : stepSpectra)
+		spectrum.reset();
+	for (auto &pitches : stepPitches)
+		pitches.clear();
+	for (auto &step : stepBandLevels)
+		for (auto &band : step)
+			band.clear();
+	chainIntervals = ChainIntervals();
+	updateUncertaintyLabel();
+	noiseBands = IntelligibilityBands();
+	speechBands = IntelligibilityBands();
+	intelligibility = IntelligibilityEstimate();
+	intelligibilityRequest++;
+	updateIntelligibilityLabel();
+	gateOffsetDb = 0.0f;
+	gateHysteresisDb = 0.0f;
+	gateTuning = GateTuning();
+	updateGateLabel();
 
 	recordingProgress->setValue(0);
 	stepIndicatorLabel->setText("Step: — / 8");
@@ -799,7 +1181,7 @@ bool CalibrationDialog::removeExistingFilter(obs_source_t *source, const char *f
 }
 
 bool CalibrationDialog::createFilter(obs_source_t *source, const char *filterId, const char *filterName,
-					obs_data_t *settings)
+					obs_data_t *settings, bool enabled)
 {
 	if (!source || !filterId || !filterName)
 		return false;
@@ -815,157 +1197,1026 @@ bool CalibrationDialog::createFilter(obs_source_t *source, const char *filterId,
 		return false;
 	}
 
+	obs_source_set_enabled(filter, enabled);
 	obs_source_filter_add(source, filter);
 	obs_source_release(filter);
 	return true;
 }
 
-void CalibrationDialog::applyFilters(float gain, float threshold, float ratio)
+ChainOptions CalibrationDialog::currentChainOptions() const
+{
+	ChainOptions options;
+	options.noiseSuppression = enableNoiseSuppressionCheck->isChecked();
+	options.noiseSuppressionLevel = noiseSuppressionLevel->currentIndex();
+	options.noiseGate = enableNoiseGateCheck->isChecked();
+	options.expander = enableExpanderCheck->isChecked();
+	options.gain = enableGainCheck->isChecked();
+	options.compressor = enableCompressorCheck->isChecked();
+	options.limiter = enableLimiterCheck->isChecked();
+	options.highPass = enableHighPassCheck->isChecked();
+	options.highPassIndex = highPassFreq->currentIndex();
+	options.lowPass = enableLowPassCheck->isChecked();
+	options.lowPassIndex = lowPassFreq->currentIndex();
+	options.deEsser = enableDeEsserCheck->isChecked();
+	options.deEsserIndex = deEsserIntensity->currentIndex();
+	options.vst = enableVSTCheck->isChecked();
+	options.howlGuard = enableHowlGuardCheck->isChecked();
+	options.breathFilter = enableBreathCheck->isChecked();
+	options.roomT20 = roomT20;
+	options.roomT30 = roomT30;
+	options.clickPeakDb = clickPeakDb;
+	options.clickLevelDb = clickLevelDb;
+	options.clickMs = clickMs;
+	options.breathFloorDb = breathFloorDb;
+	options.breathCeilingDb = breathCeilingDb;
+	options.breathHarmonicity = breathHarmonicity;
+	options.gateOffsetDb = gateOffsetDb;
+	options.gateHysteresisDb = gateHysteresisDb;
+	options.voiceEq = enableVoiceEqCheck->isChecked();
+	options.voiceEqTarget = voiceEqTarget->currentIndex();
+	std::copy(voiceEqBands, voiceEqBands + voiceEqBandCount, options.voiceEqBands);
+	options.voiceEqBandCount = voiceEqBandCount;
+	options.voiceLowHz = voiceLowHz;
+	options.multiband = enableMultibandCheck->isChecked();
+	std::copy(std::begin(bandDynamics), std::end(bandDynamics), options.bandDynamics);
+	return options;
+}
+
+CalibrationChain CalibrationDialog::buildChain() const
+{
+	CalibrationChain chain = CalibrationChain::derive(levels, peaks, currentChainOptions());
+	chain.intervals = chainIntervals;
+	return chain;
+}
+
+void CalibrationDialog::tuneGate()
+{
+	QPointer<CalibrationDialog> self(this);
+	const bool started = GateTuner::start(
+		stepAudio, levels, peaks, CalibrationChain::derive(levels, peaks, currentChainOptions()),
+		[self](const GateTuning &tuning) {
+			QMetaObject::invokeMethod(
+				QCoreApplication::instance(),
+				[self, tuning]() {
+					if (self)
+						self->onGateTuned(tuning);
+				},
+				Qt::QueuedConnection);
+		});
+	if (!started) {
+		estimateUncertainty();
+		return;
+	}
+	gateLabel->setText("Simulating the gate...");
+}
+
+void CalibrationDialog::onGateTuned(const GateTuning &tuning)
+{
+	obs_log(LOG_INFO, "[AudioCalibrator] Gate: %s", tuning.summary().c_str());
+	gateTuning = tuning;
+	gateOffsetDb = tuning.tuned.offsetDb;
+	gateHysteresisDb = tuning.tuned.hysteresisDb;
+	updateGateLabel();
+
+	// The intervals go around the thresholds actually applied
+	estimateUncertainty();
+	saveCalibrationData();
+}
+
+void CalibrationDialog::updateGateLabel()
+{
+	const GateBehaviour &gate = gateTuning.tuned;
+	if (!gate.valid) {
+		gateLabel->clear();
+		gateLabel->setToolTip(QString());
+		return;
+	}
+
+	QString text = QString("Gate: %1 changes/s, %2% of speech cut, %3% of noise let through")
+			       .arg(gate.transitionsPerSecond, 0, 'f', 1)
+			       .arg(gate.cutPercent, 0, 'f', 1)
+			       .arg(gate.leakPercent, 0, 'f', 1);
+	if (gateTuning.changed())
+		text += QString(" (tuned to open %1 / close %2 dB)").arg(gate.openDb, 0, 'f', 1).arg(gate.closeDb, 0, 'f', 1);
+	if (!gateTuning.met)
+		text += " - targets not reachable, check the room noise";
+	gateLabel->setText(text);
+
+	QString tip = QString("Your steps run through a model of the OBS noise gate.\n"
+			      "Targets: at most %1% of speech frames cut, %2% of step 1 noise frames let through.\n"
+			      "Applied: open %3 dB, close %4 dB")
+			      .arg(GateTuner::TARGET_CUT_PERCENT, 0, 'f', 0)
+			      .arg(GateTuner::TARGET_LEAK_PERCENT, 0, 'f', 0)
+			      .arg(gate.openDb, 0, 'f', 1)
+			      .arg(gate.closeDb, 0, 'f', 1);
+	if (gateTuning.derived.valid && gateTuning.changed()) {
+		const GateBehaviour &derived = gateTuning.derived;
+		tip += QString("\nAs derived: open %1 dB, close %2 dB, %3 changes/s, %4% cut, %5% let through")
+			       .arg(derived.openDb, 0, 'f', 1)
+			       .arg(derived.closeDb, 0, 'f', 1)
+			       .arg(derived.transitionsPerSecond, 0, 'f', 1)
+			       .arg(derived.cutPercent, 0, 'f', 1)
+			       .arg(derived.leakPercent, 0, 'f', 1);
+	}
+	gateLabel->setToolTip(tip);
+}
+
+void CalibrationDialog::estimateUncertainty()
+{
+	chainIntervals = ChainIntervals();
+	updateUncertaintyLabel();
+
+	QPointer<CalibrationDialog> self(this);
+	const bool started = ChainBootstrap::start(
+		stepAudio, levels, peaks, CalibrationChain::derive(levels, peaks, currentChainOptions()),
+		ChainBootstrap::RESAMPLES, [self](const BootstrapResult &result) {
+			QMetaObject::invokeMethod(
+				QCoreApplication::instance(),
+				[self, result]() {
+					if (self)
+						self->onUncertaintyEstimated(result);
+				},
+				Qt::QueuedConnection);
+		});
+	if (started)
+		uncertaintyLabel->setText("Estimating uncertainty...");
+}
+
+void CalibrationDialog::onUncertaintyEstimated(const BootstrapResult &result)
+{
+	obs_log(LOG_INFO, "[AudioCalibrator] Uncertainty: %s", result.summary().c_str());
+	chainIntervals = result.intervals;
+	updateUncertaintyLabel();
+	saveCalibrationData();
+}
+
+void CalibrationDialog::updateUncertaintyLabel()
+{
+	const ChainIntervals &intervals = chainIntervals;
+	if (!intervals.valid()) {
+		uncertaintyLabel->clear();
+		uncertaintyLabel->setToolTip(QString());
+		return;
+	}
+
+	const float worstDb = std::max({intervals.gainDb.halfWidth(), intervals.compressorThresholdDb.halfWidth(),
+					intervals.gateOpenDb.halfWidth(), intervals.gateCloseDb.halfWidth()});
+	QString text = QString("±%1 dB gain, ±%2 dB threshold, ±%3 dB gate")
+			       .arg(intervals.gainDb.halfWidth(), 0, 'f', 1)
+			       .arg(intervals.compressorThresholdDb.halfWidth(), 0, 'f', 1)
+			       .arg(std::max(intervals.gateOpenDb.halfWidth(), intervals.gateCloseDb.halfWidth()), 0, 'f', 1);
+	if (worstDb > UNCERTAIN_DB)
+		text += " (noisy, consider re-recording)";
+	uncertaintyLabel->setText(text);
+
+	auto range = [](const ValueInterval &interval, const char *unit) {
+		return QString("%1 to %2%3").arg(interval.low, 0, 'f', 1).arg(interval.high, 0, 'f', 1).arg(unit);
+	};
+	uncertaintyLabel->setToolTip(QString("95% range over %1 resamples of your steps\n"
+					     "Gain: %2\nCompressor threshold: %3\nRatio: %4\nGate open: %5\n"
+					     "Gate close: %6")
+					     .arg(intervals.resamples)
+					     .arg(range(intervals.gainDb, " dB"))
+					     .arg(range(intervals.compressorThresholdDb, " dB"))
+					     .arg(range(intervals.compressorRatio, ":1"))
+					     .arg(range(intervals.gateOpenDb, " dB"))
+					     .arg(range(intervals.gateCloseDb, " dB")));
+}
+
+void CalibrationDialog::applyFilters(const CalibrationChain &chain)
 {
 	obs_source_t *source = getSelectedSource();
 	if (!source)
 		return;
 
-	const float noiseFloor = levels[0];
-	const float avgProgram = (levels[3] + levels[4] + levels[5]) / 3.0f;
-	const float gateOpenDb = clampf(std::max(noiseFloor + 15.0f, avgProgram - 25.0f), -60.0f, -10.0f);
-	const float gateCloseDb = clampf(gateOpenDb - 6.0f, -60.0f, -12.0f);
-
-	// Remove our previously-applied filters first (idempotent)
-	removeExistingFilter(source, "Audio Calibrator - Noise Suppression");
-	removeExistingFilter(source, "Audio Calibrator - Noise Gate");
-	removeExistingFilter(source, "Audio Calibrator - Expander");
-	removeExistingFilter(source, "Audio Calibrator - Gain");
-	removeExistingFilter(source, "Audio Calibrator - Compressor");
-	removeExistingFilter(source, "Audio Calibrator - Limiter");
-	removeExistingFilter(source, "Audio Calibrator - EQ");
-	removeExistingFilter(source, "Audio Calibrator - VST");
-
-	// Noise suppression
-	if (enableNoiseSuppressionCheck->isChecked()) {
-		obs_data_t *settings = obs_data_create();
-		int suppressLevel = -25;
-		switch (noiseSuppressionLevel->currentIndex()) {
-		case 0: suppressLevel = -15; break;
-		case 1: suppressLevel = -25; break;
-		case 2: suppressLevel = -35; break;
-		default: break;
-		}
-		obs_data_set_int(settings, "suppress_level", suppressLevel);
-		obs_data_set_string(settings, "method", "rnnoise");
-		createFilter(source, "noise_suppress_filter", "Audio Calibrator - Noise Suppression", settings);
-		obs_data_release(settings);
+	const ChainOptions &options = chain.options;
+
+	// Remove our previously-applied filters first (idempotent), then
+	// create all of them in chain order with the unused ones disabled, so
+	// a profile switch can turn on any stage without adding filters.
+	// Unavailable filters are only reported when this chain needs them.
+	const ChainSettings settings(chain);
+	for (const ChainFilterSettings &filter : settings.filters())
+		removeExistingFilter(source, filter.name);
+	for (const ChainFilterSettings &filter : settings.filters()) {
+		if (filter.enabled || isFilterAvailable(filter.id))
+			createFilter(source, filter.id, filter.name, filter.settings, filter.enabled);
 	}
 
-	// Noise gate
-	if (enableNoiseGateCheck->isChecked()) {
-		obs_data_t *settings = obs_data_create();
-		obs_data_set_double(settings, "open_threshold", static_cast<double>(gateOpenDb));
-		obs_data_set_double(settings, "close_threshold", static_cast<double>(gateCloseDb));
-		obs_data_set_int(settings, "attack_time", 25);
-		obs_data_set_int(settings, "hold_time", 200);
-		obs_data_set_int(settings, "release_time", 150);
-		createFilter(source, "noise_gate_filter", "Audio Calibrator - Noise Gate", settings);
-		obs_data_release(settings);
+	if (options.vst && !isFilterAvailable("vst_filter")) {
+		statusLabel->setText("VST filter is not available in this OBS build.");
 	}
 
-	// Expander (gentle)
-	if (enableExpanderCheck->isChecked()) {
-		obs_data_t *settings = obs_data_create();
-		obs_data_set_string(settings, "presets", "expander");
-		obs_data_set_double(settings, "ratio", 2.0);
-		obs_data_set_double(settings, "threshold", -40.0);
-		obs_data_set_int(settings, "attack_time", 10);
-		obs_data_set_int(settings, "release_time", 50);
-		obs_data_set_double(settings, "output_gain", 0.0);
-		obs_data_set_string(settings, "detector", "RMS");
-		createFilter(source, "expander_filter", "Audio Calibrator - Expander", settings);
-		obs_data_release(settings);
+	obs_source_release(source);
+}
+
+QString CalibrationDialog::getPreviewDirectory()
+{
+	QString appData = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+	QDir dir(appData);
+	if (!dir.exists("previews"))
+		dir.mkpath("previews");
+	return dir.filePath("previews");
+}
+
+void CalibrationDialog::onPreviewClicked()
+{
+	if (currentStep <= TOTAL_STEPS) {
+		statusLabel->setText("Finish all steps before previewing.");
+		return;
 	}
 
-	// Gain
-	if (enableGainCheck->isChecked()) {
-		obs_data_t *settings = obs_data_create();
-		obs_data_set_double(settings, "db", static_cast<double>(gain));
-		createFilter(source, "gain_filter", "Audio Calibrator - Gain", settings);
-		obs_data_release(settings);
+	std::vector<CapturedAudioPtr> steps(stepAudio, stepAudio + TOTAL_STEPS);
+	const bool hasAudio = std::any_of(steps.begin(), steps.end(),
+					  [](const CapturedAudioPtr &step) { return step && !step->samples.empty(); });
+	if (!hasAudio) {
+		statusLabel->setText("No step audio in this session. Re-record the steps to preview.");
+		return;
 	}
 
-	// Compressor
-	if (enableCompressorCheck->isChecked()) {
-		obs_data_t *settings = obs_data_create();
-		obs_data_set_double(settings, "threshold", static_cast<double>(threshold));
-		obs_data_set_double(settings, "ratio", static_cast<double>(ratio));
-		obs_data_set_int(settings, "attack_time", 6);
-		obs_data_set_int(settings, "release_time", 60);
-		obs_data_set_double(settings, "output_gain", 0.0);
-		obs_data_set_string(settings, "sidechain_source", "none");
-		createFilter(source, "compressor_filter", "Audio Calibrator - Compressor", settings);
-		obs_data_release(settings);
+	const CalibrationChain chain = buildChain();
+	const std::string directory = getPreviewDirectory().toUtf8().constData();
+
+	previewButton->setEnabled(false);
+	statusLabel->setText("Rendering preview...");
+
+	QPointer<CalibrationDialog> self(this);
+	WorkerPool::shared().submit([self, steps, chain, directory]() {
+		const OfflineRenderResult result = OfflineRenderer::render(steps, chain, directory);
+		QMetaObject::invokeMethod(
+			QCoreApplication::instance(),
+			[self, result]() {
+				if (self)
+					self->onPreviewRendered(result);
+			},
+			Qt::QueuedConnection);
+	});
+}
+
+void CalibrationDialog::onPreviewRendered(const OfflineRenderResult &result)
+{
+	previewButton->setEnabled(currentStep > TOTAL_STEPS);
+
+	if (!result.ok) {
+		statusLabel->setText(QString::fromStdString(result.message));
+		return;
 	}
 
-	// Limiter
-	if (enableLimiterCheck->isChecked()) {
-		obs_data_t *settings = obs_data_create();
-		obs_data_set_double(settings, "threshold", -3.0);
-		obs_data_set_int(settings, "release_time", 60);
-		createFilter(source, "limiter_filter", "Audio Calibrator - Limiter", settings);
-		obs_data_release(settings);
+	QString note;
+	if (enableNoiseSuppressionCheck->isChecked() || enableVSTCheck->isChecked())
+		note = " Noise suppression/VST are not included in the preview.";
+
+	statusLabel->setText(QString("Preview (%1 s rendered in %2 ms): %3 and %4.%5")
+				     .arg(result.audioSeconds, 0, 'f', 1)
+				     .arg(result.renderMs, 0, 'f', 0)
+				     .arg(QString::fromStdString(result.beforePath))
+				     .arg(QString::fromStdString(result.afterPath))
+				     .arg(note));
+}
+
+void CalibrationDialog::captureRetro()
+{
+	std::shared_ptr<RetroRing> ring = retroTap ? retroTap->retroRing() : nullptr;
+	if (!ring) {
+		statusLabel->setText("Select a source first; nothing has been captured yet.");
+		return;
 	}
 
-	// Advanced: EQ-based approximations for high-pass/low-pass/de-esser
-	float lowDb = 0.0f;
-	float midDb = 0.0f;
-	float highDb = 0.0f;
+	// Freeze now; copying and analysis happen on the pool
+	const uint64_t end = ring->position();
+	const CalibrationChain chain = currentStep > TOTAL_STEPS ? buildChain() : [this]() {
+		CalibrationChain defaults;
+		defaults.options = currentChainOptions();
+		return defaults;
+	}();
+
+	retroButton->setEnabled(false);
+	statusLabel->setText(QString("Analysing the last %1 s...").arg(ring->seconds(), 0, 'f', 0));
+
+	QPointer<CalibrationDialog> self(this);
+	WorkerPool::shared().submit([self, ring, end, chain]() {
+		RetroSnapshotPtr snapshot = ring->snapshot(end);
+		RetroAnalysis analysis;
+		if (snapshot)
+			analysis = RetroCapture::analyze(*snapshot, chain);
+		QMetaObject::invokeMethod(
+			QCoreApplication::instance(),
+			[self, snapshot, analysis]() {
+				if (self)
+					self->onRetroAnalyzed(snapshot, analysis);
+			},
+			Qt::QueuedConnection);
+	});
+}
 
-	if (enableHighPassCheck->isChecked()) {
-		switch (highPassFreq->currentIndex()) {
-		case 0: lowDb -= 4.0f; break;  // 80 Hz (light)
-		case 1: lowDb -= 6.0f; break;  // 100 Hz
-		case 2: lowDb -= 8.0f; break;  // 120 Hz
-		default: break;
-		}
+void CalibrationDialog::onRetroAnalyzed(RetroSnapshotPtr snapshot, const RetroAnalysis &analysis)
+{
+	retroButton->setEnabled(true);
+	if (!snapshot) {
+		statusLabel->setText("Retro capture failed: no audio in the buffer yet.");
+		return;
 	}
 
-	if (enableLowPassCheck->isChecked()) {
-		switch (lowPassFreq->currentIndex()) {
-		case 0: highDb -= 3.0f; break; // 12 kHz (light)
-		case 1: highDb -= 6.0f; break; // 10 kHz
-		case 2: highDb -= 9.0f; break; // 8 kHz
-		default: break;
-		}
+	lastRetroSnapshot = std::move(snapshot);
+	exportRetroButton->setEnabled(true);
+	measureCaptureButton->setEnabled(true);
+
+	const std::string summary = analysis.summary();
+	obs_log(LOG_INFO, "[AudioCalibrator] Retro capture %s", summary.c_str());
+	statusLabel->setText(QString("Retro %1").arg(QString::fromStdString(summary)));
+}
+
+void CalibrationDialog::onExportRetroClicked()
+{
+	if (!lastRetroSnapshot)
+		return;
+
+	const QString suggested = QDir(getPreviewDirectory())
+					  .filePath(QString("retro-%1.wav")
+							    .arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss")));
+	const QString path = QFileDialog::getSaveFileName(this, "Export Retro Capture", suggested, "WAV (*.wav)");
+	if (path.isEmpty())
+		return;
+
+	RetroSnapshotPtr snapshot = lastRetroSnapshot;
+	const std::string target = path.toUtf8().constData();
+	QPointer<CalibrationDialog> self(this);
+	WorkerPool::shared().submit([self, snapshot, target]() {
+		const bool ok = RetroCapture::exportWav(*snapshot, target);
+		QMetaObject::invokeMethod(
+			QCoreApplication::instance(),
+			[self, ok, target]() {
+				if (self)
+					self->statusLabel->setText(
+						QString(ok ? "Exported %1" : "Export failed: %1")
+							.arg(QString::fromStdString(target)));
+			},
+			Qt::QueuedConnection);
+	});
+}
+
+void CalibrationDialog::onSaveSweepClicked()
+{
+	const QString suggested = QDir(getPreviewDirectory()).filePath("sweep.wav");
+	const QString path = QFileDialog::getSaveFileName(this, "Save Sweep", suggested, "WAV (*.wav)");
+	if (path.isEmpty())
+		return;
+
+	SweepParams params;
+	params.sampleRate = audio_output_get_sample_rate(obs_get_audio());
+	const std::string target = path.toUtf8().constData();
+	QPointer<CalibrationDialog> self(this);
+	WorkerPool::shared().submit([self, params, target]() {
+		const bool ok = ExponentialSweep(params).writeWav(target);
+		QMetaObject::invokeMethod(
+			QCoreApplication::instance(),
+			[self, ok, target]() {
+				if (self)
+					self->statusLabel->setText(
+						QString(ok ? "Saved %1. Play it near the mic, then Capture Last and "
+							     "Measure Capture."
+							   : "Saving the sweep failed: %1")
+							.arg(QString::fromStdString(target)));
+			},
+			Qt::QueuedConnection);
+	});
+}
+
+void CalibrationDialog::onMeasureCaptureClicked()
+{
+	if (!lastRetroSnapshot)
+		return;
+
+	RetroSnapshotPtr snapshot = lastRetroSnapshot;
+	measureCaptureButton->setEnabled(false);
+	measureWavButton->setEnabled(false);
+	statusLabel->setText("Measuring the response...");
+
+	QPointer<CalibrationDialog> self(this);
+	WorkerPool::shared().submit([self, snapshot]() {
+		SweepParams params;
+		params.sampleRate = snapshot->sampleRate;
+		// The sweep was just played, so a long capture is searched from the end
+		const size_t longest =
+			static_cast<size_t>(SweepDeconvolver::MAX_RECORDING_SECONDS * snapshot->sampleRate);
+		const size_t frames = std::min(snapshot->frames(), longest);
+		const float *recording = snapshot->channels[0].data() + (snapshot->frames() - frames);
+		const SweepDeconvolver deconvolver(ExponentialSweep(params), frames);
+		const SweepResult result = deconvolver.deconvolve(recording, frames);
+		QMetaObject::invokeMethod(
+			QCoreApplication::instance(),
+			[self, result]() {
+				if (self)
+					self->onResponseMeasured(result);
+			},
+			Qt::QueuedConnection);
+	});
+}
+
+void CalibrationDialog::onMeasureWavClicked()
+{
+	const QString path =
+		QFileDialog::getOpenFileName(this, "Measure Sweep Recording", getPreviewDirectory(), "WAV (*.wav)");
+	if (path.isEmpty())
+		return;
+
+	measureCaptureButton->setEnabled(false);
+	measureWavButton->setEnabled(false);
+	statusLabel->setText("Measuring the response...");
+
+	const uint32_t sampleRate = audio_output_get_sample_rate(obs_get_audio());
+	const std::string source = path.toUtf8().constData();
+	QPointer<CalibrationDialog> self(this);
+	WorkerPool::shared().submit([self, sampleRate, source]() {
+		SweepParams params;
+		params.sampleRate = sampleRate;
+		const SweepResult result = SweepDeconvolver::measureWav(ExponentialSweep(params), source);
+		QMetaObject::invokeMethod(
+			QCoreApplication::instance(),
+			[self, result]() {
+				if (self)
+					self->onResponseMeasured(result);
+			},
+			Qt::QueuedConnection);
+	});
+}
+
+void CalibrationDialog::onResponseMeasured(const SweepResult &result)
+{
+	measureCaptureButton->setEnabled(lastRetroSnapshot != nullptr);
+	measureWavButton->setEnabled(true);
+
+	const std::string summary = result.summary();
+	if (!result.ok) {
+		obs_log(LOG_WARNING, "[AudioCalibrator] Response measurement failed: %s", summary.c_str());
+		statusLabel->setText(QString("Response measurement failed: %1").arg(QString::fromStdString(summary)));
+		return;
+	}
+
+	obs_log(LOG_INFO, "[AudioCalibrator] Response (%.1f ms to deconvolve): %s", result.deconvolveMs,
+		summary.c_str());
+	for (const ResponsePoint &point : result.response)
+		obs_log(LOG_DEBUG, "[AudioCalibrator] Response %7.1f Hz %6.1f dB", point.hz, point.db);
+	statusLabel->setText(QString("Response: %1").arg(QString::fromStdString(summary)));
+}
+
+void CalibrationDialog::onClapClicked()
+{
+	if (isRecording || clapCapturing || keyboardCapturing)
+		return;
+	if (!audioAnalyzer || !audioAnalyzer->isCapturing()) {
+		statusLabel->setText("Audio capture not active. Select a source first.");
+		return;
+	}
+
+	clapCapturing = true;
+	clapButton->setEnabled(false);
+	audioAnalyzer->beginStepCapture(CLAP_CAPTURE_MS / 1000.0);
+	statusLabel->setText("Clap once, sharply, near the mic, then stay quiet...");
+	QTimer::singleShot(CLAP_CAPTURE_MS, this, &CalibrationDialog::finishClap);
+}
+
+void CalibrationDialog::finishClap()
+{
+	CapturedAudioPtr capture = audioAnalyzer ? audioAnalyzer->endStepCapture() : nullptr;
+	if (!capture) {
+		clapCapturing = false;
+		clapButton->setEnabled(true);
+		statusLabel->setText("Clap test failed: nothing was captured.");
+		return;
+	}
+
+	statusLabel->setText("Measuring the room's decay...");
+	QPointer<CalibrationDialog> self(this);
+	WorkerPool::shared().submit([self, capture]() {
+		const RoomDecayResult result =
+			RoomDecay::analyze(capture->samples.data(), capture->samples.size(), capture->sampleRate);
+		QMetaObject::invokeMethod(
+			QCoreApplication::instance(),
+			[self, result]() {
+				if (self)
+					self->onRoomMeasured(result);
+			},
+			Qt::QueuedConnection);
+	});
+}
+
+void CalibrationDialog::onRoomMeasured(const RoomDecayResult &result)
+{
+	clapCapturing = false;
+	clapButton->setEnabled(true);
+
+	const std::string summary = result.summary();
+	if (!result.ok) {
+		obs_log(LOG_WARNING, "[AudioCalibrator] Clap test failed: %s", summary.c_str());
+		statusLabel->setText(QString("Clap test failed: %1").arg(QString::fromStdString(summary)));
+		return;
+	}
+
+	roomT20 = result.t20;
+	roomT30 = result.t30;
+	updateRoomLabel();
+	saveCalibrationData();
+
+	const CalibrationChain chain = buildChain();
+	obs_log(LOG_INFO, "[AudioCalibrator] Clap at %.2f s: %s; gate release %d ms, expander release %d ms",
+		result.clapSeconds, summary.c_str(), chain.gateReleaseMs, chain.expanderReleaseMs);
+	statusLabel->setText(QString("Room RT60 %1 s: gate release %2 ms, expander release %3 ms (used on the next "
+				     "Apply or profile save).")
+				     .arg(chain.options.roomRt60(), 0, 'f', 2)
+				     .arg(chain.gateReleaseMs)
+				     .arg(chain.expanderReleaseMs));
+}
+
+void CalibrationDialog::updateRoomLabel()
+{
+	const float rt60 = roomT30 > 0.0f ? roomT30 : roomT20;
+	roomLabel->setText(rt60 > 0.0f ? QString("RT60 %1 s").arg(rt60, 0, 'f', 2) : QString("RT60 not measured"));
+}
+
+void CalibrationDialog::onKeyboardClicked()
+{
+	if (isRecording || clapCapturing || keyboardCapturing)
+		return;
+	if (!audioAnalyzer || !audioAnalyzer->isCapturing()) {
+		statusLabel->setText("Audio capture not active. Select a source first.");
+		return;
+	}
+
+	keyboardCapturing = true;
+	keyboardButton->setEnabled(false);
+	audioAnalyzer->beginStepCapture(KEYBOARD_CAPTURE_MS / 1000.0);
+	statusLabel->setText("Type and click the mouse as you normally would, without speaking...");
+	QTimer::singleShot(KEYBOARD_CAPTURE_MS, this, &CalibrationDialog::finishKeyboard);
+}
+
+void CalibrationDialog::finishKeyboard()
+{
+	CapturedAudioPtr capture = audioAnalyzer ? audioAnalyzer->endStepCapture() : nullptr;
+	if (!capture) {
+		keyboardCapturing = false;
+		keyboardButton->setEnabled(true);
+		statusLabel->setText("Keyboard test failed: nothing was captured.");
+		return;
+	}
+
+	QPointer<CalibrationDialog> self(this);
+	WorkerPool::shared().submit([self, capture]() {
+		const TransientProfile profile = TransientDetector::profile(capture->samples.data(),
+									    capture->samples.size(), capture->sampleRate);
+		QMetaObject::invokeMethod(
+			QCoreApplication::instance(),
+			[self, profile]() {
+				if (self)
+					self->onClicksMeasured(profile);
+			},
+			Qt::QueuedConnection);
+	});
+}
+
+void CalibrationDialog::onClicksMeasured(const TransientProfile &profile)
+{
+	keyboardCapturing = false;
+	keyboardButton->setEnabled(true);
+
+	const std::string summary = profile.summary();
+	if (profile.count() < MIN_KEYBOARD_TRANSIENTS) {
+		obs_log(LOG_WARNING, "[AudioCalibrator] Keyboard test: %s", summary.c_str());
+		statusLabel->setText(QString("Keyboard test: only %1 clicks heard; type closer to the mic and try again.")
+					     .arg(profile.count()));
+		return;
+	}
+
+	clickPeakDb = profile.peakDb;
+	clickLevelDb = profile.levelDb;
+	clickMs = profile.durationMs;
+	updateClickLabel();
+	saveCalibrationData();
+
+	const CalibrationChain chain = buildChain();
+	obs_log(LOG_INFO,
+		"[AudioCalibrator] Keyboard test: %s; gate open %.1f / close %.1f dB, hold %d ms, expander %.1f dB",
+		summary.c_str(), chain.gateOpenDb, chain.gateCloseDb, chain.gateHoldMs, chain.expanderThresholdDb);
+	statusLabel->setText(QString("Clicks peak at %1 dB: gate opens at %2 dB with %3 ms hold (used on the next "
+				     "Apply or profile save).")
+				     .arg(clickPeakDb, 0, 'f', 1)
+				     .arg(chain.gateOpenDb, 0, 'f', 1)
+				     .arg(chain.gateHoldMs));
+}
+
+void CalibrationDialog::updateClickLabel()
+{
+	clickLabel->setText(clickPeakDb > -99.0f ? QString("Clicks peak %1 dB").arg(clickPeakDb, 0, 'f', 1)
+						 : QString("Clicks not measured"));
+}
+
+void CalibrationDialog::trainBreathModel()
+{
+	// Noise step plus the three program steps, all from this session
+	const CapturedAudioPtr noise = stepAudio[0];
+	std::vector<CapturedAudioPtr> speech(stepAudio + 3, stepAudio + 6);
+	if (!noise)
+		return;
+	for (const CapturedAudioPtr &clip : speech) {
+		if (!clip || clip->sampleRate != noise->sampleRate)
+			return;
+	}
+
+	QPointer<CalibrationDialog> self(this);
+	WorkerPool::shared().submit([self, noise, speech]() {
+		// The filter's detector hears the mean of all channels
+		std::vector<BreathTrainingClip> clips;
+		for (const CapturedAudioPtr &clip : speech)
+			clips.push_back({clip->channelMean().data(), clip->channelMean().size()});
+		const std::vector<float> &noiseMix = noise->channelMean();
+		const BreathModel model = BreathDetector::train({noiseMix.data(), noiseMix.size()}, clips, noise->sampleRate);
+		QMetaObject::invokeMethod(
+			QCoreApplication::instance(),
+			[self, model]() {
+				if (self)
+					self->onBreathModelTrained(model);
+			},
+			Qt::QueuedConnection);
+	});
+}
+
+void CalibrationDialog::onBreathModelTrained(const BreathModel &model)
+{
+	obs_log(LOG_INFO, "[AudioCalibrator] Breath detector: %s", model.summary().c_str());
+	if (!model.trained)
+		return;
+
+	breathFloorDb = model.floorDb;
+	breathCeilingDb = model.ceilingDb;
+	breathHarmonicity = model.harmonicity;
+	saveCalibrationData();
+}
+
+void CalibrationDialog::analyzeSpeakingStep(int index)
+{
+	const CapturedAudioPtr clip = stepAudio[3 + index];
+	if (!clip)
+		return;
+
+	// Pauses between words sit near the noise floor of step 1
+	const float gateDb = levels[0] > -99.0f ? levels[0] + 10.0f : -60.0f;
+
+	QPointer<CalibrationDialog> self(this);
+	WorkerPool::shared().submit([self, clip, index, gateDb]() {
+		DspConfig config;
+		config.sampleRate = clip->sampleRate;
+		auto spectrum = std::make_shared<LongTermSpectrum>(DspTableCache::instance().acquire(config));
+		spectrum->setGateDb(gateDb);
+		spectrum->add(clip->samples.data(), clip->samples.size());
+		std::shared_ptr<const LongTermSpectrum> result = spectrum;
+
+		PitchTracker tracker(clip->sampleRate);
+		std::vector<float> pitches = tracker.track(clip->samples.data(), clip->samples.size());
+
+		QMetaObject::invokeMethod(
+			QCoreApplication::instance(),
+			[self, index, result, pitches]() {
+				if (!self)
+					return;
+				self->stepSpectra[index] = result;
+				self->stepPitches[index] = pitches;
+				self->fitVoiceEq();
+				self->updateVoicePitch();
+			},
+			Qt::QueuedConnection);
+	});
+}
+
+void CalibrationDialog::updateVoicePitch()
+{
+	std::vector<float> pitches;
+	for (const std::vector<float> &step : stepPitches)
+		pitches.insert(pitches.end(), step.begin(), step.end());
+
+	const F0Distribution distribution = F0Distribution::fromPitches(std::move(pitches));
+	obs_log(LOG_INFO, "[AudioCalibrator] Speaking pitch: %s", distribution.summary().c_str());
+	if (distribution.frames < MIN_PITCH_FRAMES)
+		return;
+
+	voiceLowHz = distribution.lowHz;
+	saveCalibrationData();
+}
+
+void CalibrationDialog::measureBandLevels(int step)
+{
+	const CapturedAudioPtr clip = stepAudio[step - 1];
+	if (!clip)
+		return;
+
+	const float gateDb = levels[0] > -99.0f ? levels[0] + 10.0f : -60.0f;
+
+	QPointer<CalibrationDialog> self(this);
+	WorkerPool::shared().submit([self, clip, step, gateDb]() {
+		std::vector<float> bandLevels[CompressorBand::BANDS];
+		MultibandCompressor::bandLevels(clip->samples.data(), clip->samples.size(), clip->sampleRate, gateDb,
+						bandLevels);
+		QMetaObject::invokeMethod(
+			QCoreApplication::instance(),
+			[self, step, bandLevels]() {
+				if (!self)
+					return;
+				for (int b = 0; b < CompressorBand::BANDS; b++)
+					self->stepBandLevels[step - 3][b] = bandLevels[b];
+				self->updateBandDynamics();
+			},
+			Qt::QueuedConnection);
+	});
+}
+
+void CalibrationDialog::updateBandDynamics()
+{
+	for (int b = 0; b < CompressorBand::BANDS; b++) {
+		std::vector<float> bandLevels;
+		for (const auto &step : stepBandLevels)
+			bandLevels.insert(bandLevels.end(), step[b].begin(), step[b].end());
+		bandDynamics[b] = MultibandCompressor::dynamics(std::move(bandLevels));
+	}
+	obs_log(LOG_INFO, "[AudioCalibrator] Band dynamics (median / p95): low %.1f / %.1f, mid %.1f / %.1f, "
+		"high %.1f / %.1f dB", bandDynamics[0].medianDb, bandDynamics[0].loudDb, bandDynamics[1].medianDb,
+		bandDynamics[1].loudDb, bandDynamics[2].medianDb, bandDynamics[2].loudDb);
+	saveCalibrationData();
+}
+
+void CalibrationDialog::fitVoiceEq()
+{
+	// Each step's frames were summed once when it was recorded; merging is
+	// a per-bin add
+	std::shared_ptr<LongTermSpectrum> merged;
+	for (const auto &spectrum : stepSpectra) {
+		if (!spectrum)
+			continue;
+		if (!merged)
+			merged = std::make_shared<LongTermSpectrum>(*spectrum);
+		else if (spectrum->sampleRate() == merged->sampleRate())
+			merged->merge(*spectrum);
+	}
+	if (!merged)
+		return;
+
+	speechBands = SpeechIntelligibility::bands(*merged);
+	estimateIntelligibility();
+
+	const auto target = static_cast<VoiceTarget>(voiceEqTarget->currentIndex());
+	QPointer<CalibrationDialog> self(this);
+	WorkerPool::shared().submit([self, merged, target]() {
+		const VoiceEqFit fit = VoiceEqFitter::fit(*merged, target);
+		QMetaObject::invokeMethod(
+			QCoreApplication::instance(),
+			[self, fit]() {
+				if (self)
+					self->onVoiceEqFitted(fit);
+			},
+			Qt::QueuedConnection);
+	});
+}
+
+void CalibrationDialog::onVoiceEqFitted(const VoiceEqFit &fit)
+{
+	obs_log(LOG_INFO, "[AudioCalibrator] %s target: %s",
+		VoiceEqFitter::describe(static_cast<VoiceTarget>(voiceEqTarget->currentIndex())), fit.summary().c_str());
+	if (!fit.ok)
+		return;
+
+	std::copy(fit.bands, fit.bands + fit.bandCount, voiceEqBands);
+	voiceEqBandCount = fit.bandCount;
+	enableVoiceEqCheck->setToolTip(QString::fromStdString(fit.summary()));
+	estimateIntelligibility();
+	saveCalibrationData();
+}
+
+void CalibrationDialog::analyzeNoiseStep()
+{
+	const CapturedAudioPtr clip = stepAudio[0];
+	if (!clip)
+		return;
+
+	// Ungated: all of step 1 is the room the voice competes with
+	QPointer<CalibrationDialog> self(this);
+	WorkerPool::shared().submit([self, clip]() {
+		DspConfig config;
+		config.sampleRate = clip->sampleRate;
+		LongTermSpectrum spectrum(DspTableCache::instance().acquire(config));
+		spectrum.add(clip->samples.data(), clip->samples.size());
+		const IntelligibilityBands bands = SpeechIntelligibility::bands(spectrum);
+
+		QMetaObject::invokeMethod(
+			QCoreApplication::instance(),
+			[self, bands]() {
+				if (!self)
+					return;
+				self->noiseBands = bands;
+				self->estimateIntelligibility();
+				self->saveCalibrationData();
+			},
+			Qt::QueuedConnection);
+	});
+}
+
+void CalibrationDialog::estimateIntelligibility()
+{
+	if (!noiseBands.valid || !speechBands.valid)
+		return;
+
+	const uint64_t request = ++intelligibilityRequest;
+	const IntelligibilityBands speech = speechBands;
+	const IntelligibilityBands noise = noiseBands;
+	const CalibrationChain chain = buildChain();
+	QPointer<CalibrationDialog> self(this);
+	WorkerPool::shared().submit([self, request, speech, noise, chain]() {
+		const IntelligibilityEstimate estimate = SpeechIntelligibility::estimate(speech, noise, chain);
+		QMetaObject::invokeMethod(
+			QCoreApplication::instance(),
+			[self, request, estimate]() {
+				if (self && request == self->intelligibilityRequest)
+					self->onIntelligibilityEstimated(estimate);
+			},
+			Qt::QueuedConnection);
+	});
+}
+
+void CalibrationDialog::onIntelligibilityEstimated(const IntelligibilityEstimate &estimate)
+{
+	obs_log(LOG_INFO, "[AudioCalibrator] Intelligibility (SII): %.2f raw, %.2f with chain (%.0f dB suppression, "
+		"limited at %.0f Hz)", estimate.measured, estimate.predicted, estimate.suppressionDb, estimate.limitingHz);
+	intelligibility = estimate;
+	updateIntelligibilityLabel();
+}
+
+void CalibrationDialog::updateIntelligibilityLabel()
+{
+	if (!intelligibility.valid()) {
+		intelligibilityLabel->clear();
+		intelligibilityLabel->setToolTip(QString());
+		return;
+	}
+
+	intelligibilityLabel->setText(QString("Intelligibility: %1 (%2) raw → %3 (%4) with these filters")
+					      .arg(intelligibility.measured, 0, 'f', 2)
+					      .arg(IntelligibilityEstimate::rating(intelligibility.measured))
+					      .arg(intelligibility.predicted, 0, 'f', 2)
+					      .arg(IntelligibilityEstimate::rating(intelligibility.predicted)));
+	intelligibilityLabel->setToolTip(
+		QString("Speech Intelligibility Index (0-1) of your speaking steps against the step 1 room noise.\n"
+			"Above 0.75 is good, below 0.45 is hard to follow.\n"
+			"The prediction applies the EQ and high-pass and assumes %1 dB less noise under speech from\n"
+			"noise suppression. Most is lost around %2 Hz.")
+			.arg(intelligibility.suppressionDb, 0, 'f', 0)
+			.arg(intelligibility.limitingHz, 0, 'f', 0));
+}
+
+void CalibrationDialog::onDuckClicked()
+{
+	if (duckingCalibrator) {
+		duckingCalibrator.reset();
+		endDucking(true);
+		duckButton->setText("Calibrate Ducking");
+		statusLabel->setText("Ducking calibration cancelled.");
+		return;
 	}
 
-	if (enableDeEsserCheck->isChecked()) {
-		switch (deEsserIntensity->currentIndex()) {
-		case 0: highDb -= 2.0f; break;
-		case 1: highDb -= 4.0f; break;
-		case 2: highDb -= 6.0f; break;
-		default: break;
+	obs_source_t *voice = getSelectedSource();
+	obs_source_t *music = duckMusicCombo->currentIndex() > 0
+				      ? obs_get_source_by_name(duckMusicCombo->currentText().toUtf8().constData())
+				      : nullptr;
+
+	// The music tap sits after its filters, so an earlier ducking filter
+	// would be measured as part of the music; it is off until the result
+	// is in
+	if (voice && music && voice != music) {
+		obs_source_t *filter = obs_source_get_filter_by_name(music, DUCKING_FILTER);
+		if (filter && obs_source_enabled(filter)) {
+			obs_source_set_enabled(filter, false);
+			duckFilterSuspended = true;
 		}
+		obs_source_release(filter);
+		duckVoice = obs_source_get_weak_source(voice);
+		duckMusic = obs_source_get_weak_source(music);
 	}
 
-	if (std::fabs(lowDb) > 0.01f || std::fabs(midDb) > 0.01f || std::fabs(highDb) > 0.01f) {
-		obs_data_t *settings = obs_data_create();
-		obs_data_set_double(settings, "low", static_cast<double>(lowDb));
-		obs_data_set_double(settings, "mid", static_cast<double>(midDb));
-		obs_data_set_double(settings, "high", static_cast<double>(highDb));
-		createFilter(source, "basic_eq_filter", "Audio Calibrator - EQ", settings);
-		obs_data_release(settings);
+	auto calibrator = std::make_unique<DuckingCalibrator>();
+	QPointer<CalibrationDialog> self(this);
+	const bool started = voice && music && voice != music &&
+			     calibrator->start(voice, music, DuckingCalibrator::DEFAULT_SECONDS,
+					       [self](const DuckingMeasurement &measurement) {
+						       QMetaObject::invokeMethod(
+							       QCoreApplication::instance(),
+							       [self, measurement]() {
+								       if (self)
+									       self->onDuckingMeasured(measurement);
+							       },
+							       Qt::QueuedConnection);
+					       });
+	obs_source_release(voice);
+	obs_source_release(music);
+
+	if (!started) {
+		endDucking(true);
+		statusLabel->setText("Pick your mic as Source and a different music source for ducking.");
+		return;
 	}
 
-	// Advanced: VST (only if available)
-	if (enableVSTCheck->isChecked()) {
+	duckingCalibrator = std::move(calibrator);
+	statusLabel->setText(QString("Play your music at its usual level and talk normally over it for %1 s...")
+				     .arg(DuckingCalibrator::DEFAULT_SECONDS, 0, 'f', 0));
+}
+
+void CalibrationDialog::onDuckingMeasured(const DuckingMeasurement &measurement)
+{
+	if (!duckingCalibrator)
+		return; // cancelled meanwhile
+	duckingCalibrator.reset();
+	duckButton->setText("Calibrate Ducking");
+
+	if (measurement.speechBlocks < DuckingCalibrator::MIN_SPEECH_BLOCKS) {
+		endDucking(true);
+		statusLabel->setText("Not enough speech heard over the music. Talk more and try again.");
+		return;
+	}
+	if (measurement.musicBlocks < DuckingCalibrator::MIN_MUSIC_BLOCKS) {
+		endDucking(true);
+		statusLabel->setText("The music source was silent. Start playback and try again.");
+		return;
+	}
+
+	// The pair that was measured, whatever the combos show now
+	obs_source_t *voice = obs_weak_source_get_source(duckVoice);
+	obs_source_t *music = obs_weak_source_get_source(duckMusic);
+	if (!voice || !music) {
+		obs_source_release(voice);
+		obs_source_release(music);
+		endDucking(false);
+		statusLabel->setText("Ducking sources are gone.");
+		return;
+	}
+
+	auto faderDb = [](obs_source_t *source) {
+		return 20.0f * std::log10(std::max(obs_source_get_volume(source), 0.00001f));
+	};
+	const DuckingSettings duck = DuckingCalibrator::solve(measurement, static_cast<float>(duckTargetSpin->value()),
+							      faderDb(voice), faderDb(music));
+
+	// Either way the earlier filter goes: it was measured as not needed or
+	// is replaced
+	const bool removed = removeExistingFilter(music, DUCKING_FILTER);
+	endDucking(false);
+
+	if (!duck.needed) {
+		statusLabel->setText(QString("Music already sits %1 LU under your voice; no ducking needed%2.")
+					     .arg(duck.predictedRatioLu, 0, 'f', 1)
+					     .arg(removed ? " (previous ducking filter removed)" : ""));
+	} else {
+
 		obs_data_t *settings = obs_data_create();
-		createFilter(source, "vst_filter", "Audio Calibrator - VST", settings);
+		obs_data_set_double(settings, "threshold", static_cast<double>(duck.thresholdDb));
+		obs_data_set_double(settings, "ratio", static_cast<double>(duck.ratio));
+		obs_data_set_int(settings, "attack_time", duck.attackMs);
+		obs_data_set_int(settings, "release_time", duck.releaseMs);
+		obs_data_set_double(settings, "output_gain", 0.0);
+		obs_data_set_string(settings, "sidechain_source", obs_source_get_name(voice));
+		const bool ok = createFilter(music, "compressor_filter", DUCKING_FILTER, settings);
 		obs_data_release(settings);
-	}
 
-	if (enableVSTCheck->isChecked() && !isFilterAvailable("vst_filter")) {
-		statusLabel->setText("VST filter is not available in this OBS build.");
+		obs_log(LOG_INFO, "[AudioCalibrator] Ducking %s by %.1f dB: threshold %.1f dB, ratio %.1f:1",
+			obs_source_get_name(music), duck.reductionDb, duck.thresholdDb, duck.ratio);
+		if (!ok)
+			statusLabel->setText("Could not create the ducking compressor.");
+		else
+			statusLabel->setText(QString("Ducking: voice %1 LUFS, music %2 LUFS -> threshold %3 dB, ratio "
+						     "%4:1, voice +%5 LU while talking%6")
+						     .arg(measurement.voiceLufs, 0, 'f', 1)
+						     .arg(measurement.musicLufs, 0, 'f', 1)
+						     .arg(duck.thresholdDb, 0, 'f', 1)
+						     .arg(duck.ratio, 0, 'f', 1)
+						     .arg(duck.predictedRatioLu, 0, 'f', 1)
+						     .arg(duck.reachable ? "" : " (target out of reach; lower the music fader)"));
 	}
 
-	obs_source_release(source);
+	obs_source_release(voice);
+	obs_source_release(music);
+}
+
+// Lets go of the measured pair; with restoreFilter, an earlier ducking
+// filter switched off for the measurement is switched back on
+void CalibrationDialog::endDucking(bool restoreFilter)
+{
+	if (restoreFilter && duckFilterSuspended) {
+		obs_source_t *music = obs_weak_source_get_source(duckMusic);
+		obs_source_t *filter = music ? obs_source_get_filter_by_name(music, DUCKING_FILTER) : nullptr;
+		if (filter)
+			obs_source_set_enabled(filter, true);
+		obs_source_release(filter);
+		obs_source_release(music);
+	}
+	duckFilterSuspended = false;
+	obs_weak_source_release(duckVoice);
+	obs_weak_source_release(duckMusic);
+	duckVoice = nullptr;
+	duckMusic = nullptr;
 }
 
 QString CalibrationDialog::getCalibrationFilePath()
@@ -992,6 +2243,69 @@ void CalibrationDialog::saveCalibrationData()
 	root["peaks"] = peaksArray;
 	
 	root["currentStep"] = currentStep;
+	root["retroSeconds"] = retroSecondsSpin->value();
+	root["duckTargetLu"] = duckTargetSpin->value();
+	root["stepToleranceDb"] = stepToleranceSpin->value();
+	root["roomT20"] = static_cast<double>(roomT20);
+	root["roomT30"] = static_cast<double>(roomT30);
+	root["clickPeakDb"] = static_cast<double>(clickPeakDb);
+	root["clickLevelDb"] = static_cast<double>(clickLevelDb);
+	root["clickMs"] = static_cast<double>(clickMs);
+	root["breathFloorDb"] = static_cast<double>(breathFloorDb);
+	root["breathCeilingDb"] = static_cast<double>(breathCeilingDb);
+	root["breathHarmonicity"] = static_cast<double>(breathHarmonicity);
+	root["gateOffsetDb"] = static_cast<double>(gateOffsetDb);
+	root["gateHysteresisDb"] = static_cast<double>(gateHysteresisDb);
+	if (gateTuning.tuned.valid) {
+		QJsonObject gate;
+		gate["openDb"] = static_cast<double>(gateTuning.tuned.openDb);
+		gate["closeDb"] = static_cast<double>(gateTuning.tuned.closeDb);
+		gate["transitionsPerSecond"] = gateTuning.tuned.transitionsPerSecond;
+		gate["cutPercent"] = gateTuning.tuned.cutPercent;
+		gate["leakPercent"] = gateTuning.tuned.leakPercent;
+		gate["met"] = gateTuning.met;
+		root["gateTuning"] = gate;
+	}
+	root["voiceEqTarget"] = voiceEqTarget->currentIndex();
+	QJsonArray voiceEqArray;
+	for (int i = 0; i < voiceEqBandCount; i++) {
+		QJsonObject band;
+		band["hz"] = static_cast<double>(voiceEqBands[i].hz);
+		band["gainDb"] = static_cast<double>(voiceEqBands[i].gainDb);
+		band["q"] = static_cast<double>(voiceEqBands[i].q);
+		voiceEqArray.append(band);
+	}
+	root["voiceEqBands"] = voiceEqArray;
+	root["voiceLowHz"] = static_cast<double>(voiceLowHz);
+	QJsonArray bandDynamicsArray;
+	for (const BandDynamics &band : bandDynamics) {
+		QJsonObject item;
+		item["medianDb"] = static_cast<double>(band.medianDb);
+		item["loudDb"] = static_cast<double>(band.loudDb);
+		bandDynamicsArray.append(item);
+	}
+	root["bandDynamics"] = bandDynamicsArray;
+	auto bandArray = [](const IntelligibilityBands &bands) {
+		QJsonArray array;
+		if (bands.valid) {
+			for (float db : bands.db)
+				array.append(static_cast<double>(db));
+		}
+		return array;
+	};
+	root["noiseBands"] = bandArray(noiseBands);
+	root["speechBands"] = bandArray(speechBands);
+	if (chainIntervals.valid()) {
+		auto interval = [](const ValueInterval &value) { return QJsonArray{value.low, value.high}; };
+		QJsonObject intervals;
+		intervals["resamples"] = chainIntervals.resamples;
+		intervals["gainDb"] = interval(chainIntervals.gainDb);
+		intervals["compressorThresholdDb"] = interval(chainIntervals.compressorThresholdDb);
+		intervals["compressorRatio"] = interval(chainIntervals.compressorRatio);
+		intervals["gateOpenDb"] = interval(chainIntervals.gateOpenDb);
+		intervals["gateCloseDb"] = interval(chainIntervals.gateCloseDb);
+		root["intervals"] = intervals;
+	}
 	root["version"] = "1.0.1";
 	
 	QFile file(getCalibrationFilePath());
@@ -1050,6 +2364,7 @@ void CalibrationDialog::loadCalibrationData()
 			startButton->setEnabled(false);
 			recordButton->setEnabled(false);
 			applyButton->setEnabled(true);
+			previewButton->setEnabled(true);
 			stepIndicatorLabel->setText("Complete");
 			promptLabel->setText("Previous calibration loaded. Click Apply or Reset.");
 			statusLabel->setText("Loaded saved calibration. Ready to Apply.");
@@ -1064,6 +2379,100 @@ void CalibrationDialog::loadCalibrationData()
 		}
 	}
 	
+	if (root.contains("retroSeconds")) {
+		// Not a user edit, so no re-save
+		QSignalBlocker blocker(retroSecondsSpin);
+		retroSecondsSpin->setValue(root["retroSeconds"].toInt(DEFAULT_RETRO_SECONDS));
+		AnalysisWorker::shared().setRetroSeconds(retroSecondsSpin->value());
+	}
+
+	if (root.contains("duckTargetLu")) {
+		QSignalBlocker blocker(duckTargetSpin);
+		duckTargetSpin->setValue(root["duckTargetLu"].toInt(DEFAULT_DUCK_TARGET_LU));
+	}
+	if (root.contains("stepToleranceDb")) {
+		QSignalBlocker blocker(stepToleranceSpin);
+		stepToleranceSpin->setValue(root["stepToleranceDb"].toDouble(DEFAULT_STEP_TOLERANCE_DB));
+	}
+
+	roomT20 = static_cast<float>(root["roomT20"].toDouble(0.0));
+	roomT30 = static_cast<float>(root["roomT30"].toDouble(0.0));
+	updateRoomLabel();
+
+	clickPeakDb = static_cast<float>(root["clickPeakDb"].toDouble(-100.0));
+	clickLevelDb = static_cast<float>(root["clickLevelDb"].toDouble(-100.0));
+	clickMs = static_cast<float>(root["clickMs"].toDouble(0.0));
+	updateClickLabel();
+
+	breathFloorDb = static_cast<float>(root["breathFloorDb"].toDouble(-60.0));
+	breathCeilingDb = static_cast<float>(root["breathCeilingDb"].toDouble(-100.0));
+	breathHarmonicity = static_cast<float>(root["breathHarmonicity"].toDouble(0.45));
+	gateOffsetDb = static_cast<float>(root["gateOffsetDb"].toDouble(0.0));
+	gateHysteresisDb = static_cast<float>(root["gateHysteresisDb"].toDouble(0.0));
+	gateTuning = GateTuning();
+	if (root.contains("gateTuning")) {
+		const QJsonObject gate = root["gateTuning"].toObject();
+		GateBehaviour &tuned = gateTuning.tuned;
+		tuned.openDb = static_cast<float>(gate["openDb"].toDouble(0.0));
+		tuned.closeDb = static_cast<float>(gate["closeDb"].toDouble(0.0));
+		tuned.offsetDb = gateOffsetDb;
+		tuned.hysteresisDb = gateHysteresisDb;
+		tuned.transitionsPerSecond = gate["transitionsPerSecond"].toDouble(0.0);
+		tuned.cutPercent = gate["cutPercent"].toDouble(0.0);
+		tuned.leakPercent = gate["leakPercent"].toDouble(0.0);
+		tuned.valid = true;
+		gateTuning.met = gate["met"].toBool(false);
+	}
+	updateGateLabel();
+
+	if (root.contains("voiceEqTarget")) {
+		QSignalBlocker blocker(voiceEqTarget);
+		voiceEqTarget->setCurrentIndex(root["voiceEqTarget"].toInt(0));
+	}
+	const QJsonArray voiceEqArray = root["voiceEqBands"].toArray();
+	voiceEqBandCount = std::min<int>(voiceEqArray.size(), VoiceEqBand::MAX_BANDS);
+	for (int i = 0; i < voiceEqBandCount; i++) {
+		const QJsonObject band = voiceEqArray[i].toObject();
+		voiceEqBands[i].hz = static_cast<float>(band["hz"].toDouble(1000.0));
+		voiceEqBands[i].gainDb = static_cast<float>(band["gainDb"].toDouble(0.0));
+		voiceEqBands[i].q = static_cast<float>(band["q"].toDouble(1.0));
+	}
+	voiceLowHz = static_cast<float>(root["voiceLowHz"].toDouble(0.0));
+	const QJsonArray bandDynamicsArray = root["bandDynamics"].toArray();
+	for (int b = 0; b < CompressorBand::BANDS; b++) {
+		const QJsonObject band = b < bandDynamicsArray.size() ? bandDynamicsArray[b].toObject() : QJsonObject();
+		bandDynamics[b].medianDb = static_cast<float>(band["medianDb"].toDouble(-100.0));
+		bandDynamics[b].loudDb = static_cast<float>(band["loudDb"].toDouble(-100.0));
+	}
+	const QJsonObject intervals = root["intervals"].toObject();
+	auto interval = [&intervals](const char *name, ValueInterval &value) {
+		const QJsonArray range = intervals[name].toArray();
+		value.low = static_cast<float>(range.at(0).toDouble(0.0));
+		value.high = static_cast<float>(range.at(1).toDouble(-1.0));
+	};
+	chainIntervals = ChainIntervals();
+	chainIntervals.resamples = intervals["resamples"].toInt(0);
+	interval("gainDb", chainIntervals.gainDb);
+	interval("compressorThresholdDb", chainIntervals.compressorThresholdDb);
+	interval("compressorRatio", chainIntervals.compressorRatio);
+	interval("gateOpenDb", chainIntervals.gateOpenDb);
+	interval("gateCloseDb", chainIntervals.gateCloseDb);
+	updateUncertaintyLabel();
+	auto readBands = [&root](const char *name, IntelligibilityBands &bands) {
+		const QJsonArray array = root[name].toArray();
+		bands = IntelligibilityBands();
+		if (array.size() != IntelligibilityBands::BANDS)
+			return;
+		for (int i = 0; i < IntelligibilityBands::BANDS; i++)
+			bands.db[i] = static_cast<float>(array[i].toDouble(-100.0));
+		bands.valid = true;
+	};
+	readBands("noiseBands", noiseBands);
+	readBands("speechBands", speechBands);
+	intelligibility = IntelligibilityEstimate();
+	updateIntelligibilityLabel();
+	estimateIntelligibility();
+
 	updateResultsDisplay();
 	obs_log(LOG_INFO, "[AudioCalibrator] Loaded calibration data (step %d)", currentStep);
 }
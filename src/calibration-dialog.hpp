@@ -20,9 +20,26 @@
 #include <QCheckBox>
 #include <QSlider>
 #include <QSpinBox>
+#include <QDoubleSpinBox>
 #include <memory>
 #include <vector>
+#include "analysis-worker.hpp"
 #include "audio-analyzer.hpp"
+#include "breath-detector.hpp"
+#include "calibration-chain.hpp"
+#include "distance-monitor.hpp"
+#include "ducking-calibrator.hpp"
+#include "gate-tuner.hpp"
+#include "intelligibility.hpp"
+#include "level-estimate.hpp"
+#include "transient-detector.hpp"
+
+struct OfflineRenderResult;
+struct SweepResult;
+struct RoomDecayResult;
+struct VoiceEqFit;
+struct BootstrapResult;
+class LongTermSpectrum;
 
 class CalibrationDialog : public QDialog
 {
@@ -32,14 +49,26 @@ public:
     explicit CalibrationDialog(QWidget *parent = nullptr);
     ~CalibrationDialog();
 
+    // Freeze the last N seconds of the source and analyse them
+    void captureRetro();
+
 private slots:
     void onStartClicked();
     void onRecordClicked();
     void onApplyClicked();
+    void onPreviewClicked();
     void onResetClicked();
     void updateLevelMeter();
     void onSourceChanged(int index);
     void onRecordingTick();
+    void onExportRetroClicked();
+    void onSaveSweepClicked();
+    void onMeasureCaptureClicked();
+    void onMeasureWavClicked();
+    void onClapClicked();
+    void onKeyboardClicked();
+    void onDuckClicked();
+    void onSaveProfileClicked();
 
 private:
     void setupUI();
@@ -49,7 +78,40 @@ private:
     void stopRecording();
     void saveCurrentLevel();
     void advanceStep();
-    void applyFilters(float gain, float threshold, float ratio);
+    void applyFilters(const CalibrationChain &chain);
+    ChainOptions currentChainOptions() const;
+    CalibrationChain buildChain() const;
+    void onPreviewRendered(const OfflineRenderResult &result);
+    QString getPreviewDirectory();
+    void onRetroAnalyzed(RetroSnapshotPtr snapshot, const RetroAnalysis &analysis);
+    void onResponseMeasured(const SweepResult &result);
+    void finishClap();
+    void onRoomMeasured(const RoomDecayResult &result);
+    void updateRoomLabel();
+    void finishKeyboard();
+    void onClicksMeasured(const TransientProfile &profile);
+    void updateClickLabel();
+    void trainBreathModel();
+    void onBreathModelTrained(const BreathModel &model);
+    void analyzeSpeakingStep(int index);
+    void updateVoicePitch();
+    void measureBandLevels(int step);
+    void updateBandDynamics();
+    void fitVoiceEq();
+    void onVoiceEqFitted(const VoiceEqFit &fit);
+    void estimateUncertainty();
+    void onUncertaintyEstimated(const BootstrapResult &result);
+    void updateUncertaintyLabel();
+    void analyzeNoiseStep();
+    void estimateIntelligibility();
+    void onIntelligibilityEstimated(const IntelligibilityEstimate &estimate);
+    void updateIntelligibilityLabel();
+    void tuneGate();
+    void onGateTuned(const GateTuning &tuning);
+    void updateGateLabel();
+    void onDuckingMeasured(const DuckingMeasurement &measurement);
+    void endDucking(bool restoreFilter);
+    void refreshProfiles();
     void updateResultsDisplay();
     void updatePromptForStep();
     obs_source_t* getSelectedSource();
@@ -59,7 +121,7 @@ private:
     // Robust filter application helpers
     bool removeExistingFilter(obs_source_t* source, const char* filterName);
     bool createFilter(obs_source_t* source, const char* filterId, 
-                     const char* filterName, obs_data_t* settings);
+                     const char* filterName, obs_data_t* settings, bool enabled = true);
     bool isFilterAvailable(const char* filterId);
     
     // Persistence
@@ -81,6 +143,8 @@ private:
     QLabel *statusLabel;
     QLabel *peakLabel;
     QLabel *rmsLabel;
+    QLabel *timelineLabel;
+    QLabel *distanceLabel;
     
     // Results labels for 8 steps
     QLabel *step1Result;
@@ -93,10 +157,31 @@ private:
     QLabel *step8Result;
     QLabel *rangeResult;
     QLabel *avgResult;
+    QLabel *intelligibilityLabel;
+    QLabel *gateLabel;
     
     QPushButton *startButton;
     QPushButton *applyButton;
+    QPushButton *previewButton;
     QPushButton *resetButton;
+    QLabel *uncertaintyLabel;
+    QDoubleSpinBox *stepToleranceSpin;
+    QSpinBox *retroSecondsSpin;
+    QTimer *retroResizeTimer;
+    QPushButton *retroButton;
+    QPushButton *exportRetroButton;
+    QPushButton *saveSweepButton;
+    QPushButton *measureCaptureButton;
+    QPushButton *measureWavButton;
+    QPushButton *clapButton;
+    QLabel *roomLabel;
+    QPushButton *keyboardButton;
+    QLabel *clickLabel;
+    QComboBox *duckMusicCombo;
+    QSpinBox *duckTargetSpin;
+    QPushButton *duckButton;
+    QComboBox *profileCombo;
+    QPushButton *saveProfileButton;
     
     QProgressBar *levelMeter;
     QProgressBar *peakMeter;
@@ -122,12 +207,17 @@ private:
     QCheckBox *enableLowPassCheck;
     QCheckBox *enableDeEsserCheck;
     QCheckBox *enableVSTCheck;
+    QCheckBox *enableHowlGuardCheck;
+    QCheckBox *enableBreathCheck;
+    QCheckBox *enableVoiceEqCheck;
+    QCheckBox *enableMultibandCheck;
     
     // Settings
     QComboBox *noiseSuppressionLevel;
     QComboBox *highPassFreq;
     QComboBox *lowPassFreq;
     QComboBox *deEsserIntensity;
+    QComboBox *voiceEqTarget;
 
     // Audio analyzer
     std::unique_ptr<AudioAnalyzer> audioAnalyzer;
@@ -140,18 +230,100 @@ private:
     float levels[8];     // Average RMS dB per step
     float peaks[8];      // Max peak dB per step
 
+    // Raw audio of each step from this session (not persisted)
+    CapturedAudioPtr stepAudio[8];
+
+    // Shared tap of the selected source; Capture Last freezes its retro ring
+    std::shared_ptr<AnalysisTap> retroTap;
+
+    // Most recent retro capture, kept for Export WAV
+    RetroSnapshotPtr lastRetroSnapshot;
+
+    // Mic distance against the applied baseline of the selected source
+    DistanceWatch distanceWatch;
+
+    // Live voice-over-music measurement, while one is running, with the
+    // pair it measures and whether it switched off an earlier ducking
+    // filter (the taps are post-filter)
+    std::unique_ptr<DuckingCalibrator> duckingCalibrator;
+    obs_weak_source_t *duckVoice = nullptr;
+    obs_weak_source_t *duckMusic = nullptr;
+    bool duckFilterSuspended = false;
+
     // Recording window accumulation (for more stable measurements)
-    double recordingRmsSumLinear = 0.0;
-    int recordingRmsSamples = 0;
+    LevelEstimate recordingLevel;
     float recordingPeakMaxDb = -100.0f;
+    uint64_t recordingDiscontinuities = 0;
+
+    // Optional clap step: room reverberation (seconds, 0 = not measured)
+    bool clapCapturing = false;
+    float roomT20 = 0.0f;
+    float roomT30 = 0.0f;
+
+    // Optional keyboard step: typing and mouse transients (dB, -100 = not measured)
+    bool keyboardCapturing = false;
+    float clickPeakDb = -100.0f;
+    float clickLevelDb = -100.0f;
+    float clickMs = 0.0f;
+
+    // Breath detector trained on steps 1 and 4-6 (ceiling -100 = not trained)
+    float breathFloorDb = -60.0f;
+    float breathCeilingDb = -100.0f;
+    float breathHarmonicity = 0.45f;
+
+    // Gate thresholds moved by simulating the gate over this session's
+    // steps when the last one is recorded, and what the simulation found
+    float gateOffsetDb = 0.0f;
+    float gateHysteresisDb = 0.0f;
+    GateTuning gateTuning;
+
+    // Long-term spectrum of steps 4-6 from this session (not persisted) and
+    // the EQ fitted to it
+    std::shared_ptr<const LongTermSpectrum> stepSpectra[3];
+    VoiceEqBand voiceEqBands[VoiceEqBand::MAX_BANDS];
+    int voiceEqBandCount = 0;
+
+    // Speaking pitch of steps 4-6: per-hop F0 from this session (not
+    // persisted) and the 5th percentile the auto high-pass sits under
+    std::vector<float> stepPitches[3];
+    float voiceLowHz = 0.0f;
+
+    // Per-band 10 ms levels of steps 3-8 from this session (not persisted)
+    // and the distributions the multiband compressor is tuned from
+    std::vector<float> stepBandLevels[6][CompressorBand::BANDS];
+    BandDynamics bandDynamics[CompressorBand::BANDS];
+
+    // 95% intervals of the derived values, bootstrapped from this
+    // session's steps when the last one is recorded
+    ChainIntervals chainIntervals;
+
+    // 1/3-octave spectra of step 1 and steps 4-6 (persisted, so options can
+    // still be compared after a restart) and the SII for the current options;
+    // only the latest request's estimate is shown
+    IntelligibilityBands noiseBands;
+    IntelligibilityBands speechBands;
+    IntelligibilityEstimate intelligibility;
+    uint64_t intelligibilityRequest = 0;
     
     // Recording duration - extended for accuracy
     int recordingFrames;
     int recordingElapsedMs;
     
-    static constexpr int RECORDING_DURATION_MS = 5000;  // 5 seconds per sample for accuracy
+    // Steps end once the level's 95% interval is within the tolerance
+    static constexpr int MIN_RECORDING_MS = 2000;       // At least one short phrase
+    static constexpr int MAX_RECORDING_MS = 8000;       // Steps that never settle
+    static constexpr double DEFAULT_STEP_TOLERANCE_DB = 1.5;
     static constexpr int RECORDING_TICK_MS = 100;       // Update every 100ms
     static constexpr int TOTAL_STEPS = 8;               // 8 calibration steps (~5 min total)
+    static constexpr double HISTORY_SECONDS = 600.0;    // Compressed rolling history of the source
+    static constexpr int DEFAULT_RETRO_SECONDS = static_cast<int>(AnalysisWorker::DEFAULT_RETRO_SECONDS);
+    static constexpr int RETRO_RESIZE_DELAY_MS = 600;   // after the last spin step
+    static constexpr int DEFAULT_DUCK_TARGET_LU = 12;   // Voice over ducked music
+    static constexpr int CLAP_CAPTURE_MS = 4000;        // One clap and the room's decay
+    static constexpr int KEYBOARD_CAPTURE_MS = 8000;    // Typing and clicking, no speech
+    static constexpr int MIN_KEYBOARD_TRANSIENTS = 5;
+    static constexpr size_t MIN_PITCH_FRAMES = 100;      // 1 s of voiced speech
+    static constexpr float UNCERTAIN_DB = 2.0f;         // Interval half-width worth re-recording for
 };
 
 #endif // CALIBRATION_DIALOG_HPP
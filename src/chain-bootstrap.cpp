@@ -0,0 +1,203 @@
+/*
+ * Chain Bootstrap Implementation
+ * Copyright (C) 2025
+ */
+
+#include "chain-bootstrap.hpp"
+#include "worker-pool.hpp"
+
+#include <util/platform.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+
+// The derived values tracked, in ChainIntervals order
+static constexpr int PARAMETERS = 5;
+
+static void parameters(const CalibrationChain &chain, float (&values)[PARAMETERS])
+{
+	values[0] = chain.gainDb;
+	values[1] = chain.compressorThresholdDb;
+	values[2] = chain.compressorRatio;
+	values[3] = chain.gateOpenDb;
+	values[4] = chain.gateCloseDb;
+}
+
+static ValueInterval *intervalAt(ChainIntervals &intervals, int index)
+{
+	ValueInterval *all[PARAMETERS] = {&intervals.gainDb, &intervals.compressorThresholdDb,
+					  &intervals.compressorRatio, &intervals.gateOpenDb, &intervals.gateCloseDb};
+	return all[index];
+}
+
+static inline float toDb(double linear)
+{
+	return static_cast<float>(20.0 * std::log10(std::max(linear, 1e-10)));
+}
+
+StepBlocks StepBlocks::measure(const float *samples, size_t count, uint32_t sampleRate)
+{
+	StepBlocks blocks;
+	const size_t block = std::max<size_t>(1, static_cast<size_t>(ChainBootstrap::BLOCK_SECONDS * sampleRate));
+	for (size_t pos = 0; pos + block <= count; pos += block) {
+		double sum = 0.0;
+		float peak = 0.0f;
+		for (size_t i = pos; i < pos + block; i++) {
+			sum += static_cast<double>(samples[i]) * samples[i];
+			peak = std::max(peak, std::fabs(samples[i]));
+		}
+		blocks.rms.push_back(static_cast<float>(std::sqrt(sum / block)));
+		blocks.peak.push_back(peak);
+	}
+	return blocks;
+}
+
+std::string BootstrapResult::summary() const
+{
+	char text[320];
+	snprintf(text, sizeof(text),
+		 "%d resamples of %d steps in %.0f ms: gain %.1f..%.1f dB, threshold %.1f..%.1f dB, ratio %.1f..%.1f, "
+		 "gate open %.1f..%.1f dB, close %.1f..%.1f dB",
+		 intervals.resamples, stepsResampled, elapsedMs, intervals.gainDb.low, intervals.gainDb.high,
+		 intervals.compressorThresholdDb.low, intervals.compressorThresholdDb.high, intervals.compressorRatio.low,
+		 intervals.compressorRatio.high, intervals.gateOpenDb.low, intervals.gateOpenDb.high,
+		 intervals.gateCloseDb.low, intervals.gateCloseDb.high);
+	return text;
+}
+
+namespace {
+
+// Shared by the chunks of one run
+struct BootstrapJob {
+	StepBlocks steps[ChainBootstrap::STEPS];
+	float levels[ChainBootstrap::STEPS] = {};
+	float peaks[ChainBootstrap::STEPS] = {};
+	CalibrationChain chain;
+	float base[PARAMETERS] = {}; // derived from the unresampled blocks
+	int resamples = 0;
+	int stepsResampled = 0;
+	uint64_t startNs = 0;
+
+	std::vector<float> deltas[PARAMETERS]; // per resample; chunks write disjoint ranges
+	ChainBootstrap::Callback done;
+
+	void runChunk(int first, int last, uint32_t seed);
+	void finish();
+};
+
+} // namespace
+
+void BootstrapJob::runChunk(int first, int last, uint32_t seed)
+{
+	std::mt19937 rng(seed);
+	float levels[ChainBootstrap::STEPS];
+	float peaks[ChainBootstrap::STEPS];
+	float values[PARAMETERS];
+
+	for (int r = first; r < last; r++) {
+		for (int s = 0; s < ChainBootstrap::STEPS; s++) {
+			const StepBlocks &step = steps[s];
+			const size_t count = step.rms.size();
+			if (count == 0) {
+				levels[s] = this->levels[s];
+				peaks[s] = this->peaks[s];
+				continue;
+			}
+
+			// Circular runs until the step has its original length
+			std::uniform_int_distribution<size_t> pick(0, count - 1);
+			double sum = 0.0;
+			float peak = 0.0f;
+			for (size_t taken = 0; taken < count;) {
+				const size_t start = pick(rng);
+				for (size_t k = 0; k < ChainBootstrap::RUN_BLOCKS && taken < count; k++, taken++) {
+					const size_t i = (start + k) % count;
+					sum += step.rms[i];
+					peak = std::max(peak, step.peak[i]);
+				}
+			}
+			levels[s] = toDb(sum / static_cast<double>(count));
+			peaks[s] = toDb(peak);
+		}
+
+		parameters(CalibrationChain::derive(levels, peaks, chain.options), values);
+		for (int p = 0; p < PARAMETERS; p++)
+			deltas[p][static_cast<size_t>(r)] = values[p] - base[p];
+	}
+}
+
+void BootstrapJob::finish()
+{
+	BootstrapResult result;
+	float values[PARAMETERS];
+	parameters(chain, values);
+
+	const double last = static_cast<double>(resamples - 1);
+	for (int p = 0; p < PARAMETERS; p++) {
+		std::vector<float> &spread = deltas[p];
+		std::sort(spread.begin(), spread.end());
+		ValueInterval *interval = intervalAt(result.intervals, p);
+		interval->low = values[p] + spread[static_cast<size_t>(std::lround(0.025 * last))];
+		interval->high = values[p] + spread[static_cast<size_t>(std::lround(0.975 * last))];
+	}
+	result.intervals.resamples = resamples;
+	result.stepsResampled = stepsResampled;
+	result.elapsedMs = static_cast<double>(os_gettime_ns() - startNs) / 1e6;
+	done(result);
+}
+
+bool ChainBootstrap::start(const CapturedAudioPtr (&clips)[STEPS], const float *levels, const float *peaks,
+			   const CalibrationChain &chain, int resamples, Callback done)
+{
+	if (resamples < 2 || std::none_of(std::begin(clips), std::end(clips), [](const CapturedAudioPtr &clip) {
+		    return clip && !clip->samples.empty();
+	    }))
+		return false;
+
+	auto job = std::make_shared<BootstrapJob>();
+	std::copy(levels, levels + STEPS, job->levels);
+	std::copy(peaks, peaks + STEPS, job->peaks);
+	job->chain = chain;
+	job->resamples = resamples;
+	job->done = std::move(done);
+	job->startNs = os_gettime_ns();
+
+	std::vector<CapturedAudioPtr> captured(std::begin(clips), std::end(clips));
+	return WorkerPool::shared().submit([job, captured]() {
+		float blockLevels[STEPS];
+		float blockPeaks[STEPS];
+		for (int s = 0; s < STEPS; s++) {
+			const CapturedAudioPtr &clip = captured[static_cast<size_t>(s)];
+			if (clip)
+				job->steps[s] = StepBlocks::measure(clip->samples.data(), clip->samples.size(), clip->sampleRate);
+
+			const StepBlocks &step = job->steps[s];
+			if (step.rms.empty()) {
+				blockLevels[s] = job->levels[s];
+				blockPeaks[s] = job->peaks[s];
+				continue;
+			}
+			double sum = 0.0;
+			for (float rms : step.rms)
+				sum += rms;
+			blockLevels[s] = toDb(sum / static_cast<double>(step.rms.size()));
+			blockPeaks[s] = toDb(*std::max_element(step.peak.begin(), step.peak.end()));
+			job->stepsResampled++;
+		}
+		parameters(CalibrationChain::derive(blockLevels, blockPeaks, job->chain.options), job->base);
+		for (auto &spread : job->deltas)
+			spread.resize(static_cast<size_t>(job->resamples));
+
+		// One chunk per worker, each with its own seed
+		WorkerPool::shared().parallelChunks(
+			static_cast<size_t>(job->resamples),
+			[job](size_t chunk, size_t first, size_t last) {
+				const uint32_t seed = 0x9e3779b9u * static_cast<uint32_t>(chunk + 1);
+				job->runChunk(static_cast<int>(first), static_cast<int>(last), seed);
+			},
+			[job]() { job->finish(); });
+	});
+}
@@ -0,0 +1,59 @@
+/*
+ * Chain Bootstrap - Confidence intervals of the derived chain parameters
+ * Copyright (C) 2025
+ *
+ * Each captured step is cut into 100 ms blocks (linear RMS and peak). A
+ * resample rebuilds every step from randomly placed runs of consecutive
+ * blocks (circular block bootstrap, so syllables and pauses stay together),
+ * takes the step's level as the mean block RMS and its peak as the largest
+ * block peak, and re-runs CalibrationChain::derive. The spread of each
+ * parameter around the derivation from the unresampled blocks is applied
+ * to the chain the dialog actually built. Resamples are split into one
+ * chunk per worker thread and the last chunk to finish reports.
+ */
+
+#ifndef CHAIN_BOOTSTRAP_HPP
+#define CHAIN_BOOTSTRAP_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "audio-analyzer.hpp"
+#include "calibration-chain.hpp"
+
+// 100 ms blocks of one step, linear
+struct StepBlocks {
+	std::vector<float> rms;
+	std::vector<float> peak;
+
+	static StepBlocks measure(const float *samples, size_t count, uint32_t sampleRate);
+};
+
+struct BootstrapResult {
+	ChainIntervals intervals;
+	int stepsResampled = 0; // steps with captured audio; others stay fixed
+	double elapsedMs = 0.0;
+
+	std::string summary() const;
+};
+
+class ChainBootstrap {
+public:
+	static constexpr int STEPS = 8;
+	static constexpr int RESAMPLES = 1000;
+	static constexpr double BLOCK_SECONDS = 0.1;
+	static constexpr size_t RUN_BLOCKS = 5; // 0.5 s runs
+
+	using Callback = std::function<void(const BootstrapResult &)>;
+
+	// chain is the derivation to put intervals around (its options are
+	// reused); clips without audio keep their level and peak. done is
+	// called once, on a worker thread. Returns false if nothing could be
+	// resampled or the pool is shut down.
+	static bool start(const CapturedAudioPtr (&clips)[STEPS], const float *levels, const float *peaks,
+			  const CalibrationChain &chain, int resamples, Callback done);
+};
+
+#endif // CHAIN_BOOTSTRAP_HPP
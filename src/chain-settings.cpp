@@ -0,0 +1,156 @@
+/*
+ * Chain Settings Implementation
+ * Copyright (C) 2025
+ */
+
+#include "chain-settings.hpp"
+
+#include "breath-filter.hpp"
+#include "howl-filter.hpp"
+#include "multiband-compressor.hpp"
+#include "multiband-filter.hpp"
+#include "voice-eq-filter.hpp"
+
+#include <cstdio>
+
+ChainSettings::ChainSettings(const CalibrationChain &chain)
+{
+	const ChainOptions &options = chain.options;
+
+	obs_data_t *settings = obs_data_create();
+	obs_data_set_int(settings, "suppress_level", chain.suppressLevelDb);
+	obs_data_set_string(settings, "method", "rnnoise");
+	add("noise_suppress_filter", "Audio Calibrator - Noise Suppression", options.noiseSuppression, settings);
+
+	// Feedback notches ahead of the dynamics so they never pump on a howl
+	add(HOWL_FILTER_ID, "Audio Calibrator - Howl Guard", options.howlGuard, obs_data_create());
+
+	// Breaths are turned down before the gate and compressor can bring them
+	// up; attenuation and lookahead stay as the user set them
+	settings = obs_data_create();
+	if (options.hasBreathModel()) {
+		obs_data_set_double(settings, "floor_db", static_cast<double>(options.breathFloorDb));
+		obs_data_set_double(settings, "ceiling_db", static_cast<double>(options.breathCeilingDb));
+		obs_data_set_double(settings, "harmonicity", static_cast<double>(options.breathHarmonicity));
+	}
+	add(BREATH_FILTER_ID, "Audio Calibrator - Breath Filter", options.breathFilter, settings);
+
+	settings = obs_data_create();
+	obs_data_set_double(settings, "open_threshold", static_cast<double>(chain.gateOpenDb));
+	obs_data_set_double(settings, "close_threshold", static_cast<double>(chain.gateCloseDb));
+	obs_data_set_int(settings, "attack_time", chain.gateAttackMs);
+	obs_data_set_int(settings, "hold_time", chain.gateHoldMs);
+	obs_data_set_int(settings, "release_time", chain.gateReleaseMs);
+	add("noise_gate_filter", "Audio Calibrator - Noise Gate", options.noiseGate, settings);
+
+	settings = obs_data_create();
+	obs_data_set_string(settings, "presets", "expander");
+	obs_data_set_double(settings, "ratio", static_cast<double>(chain.expanderRatio));
+	obs_data_set_double(settings, "threshold", static_cast<double>(chain.expanderThresholdDb));
+	obs_data_set_int(settings, "attack_time", chain.expanderAttackMs);
+	obs_data_set_int(settings, "release_time", chain.expanderReleaseMs);
+	obs_data_set_double(settings, "output_gain", 0.0);
+	obs_data_set_string(settings, "detector", "RMS");
+	add("expander_filter", "Audio Calibrator - Expander", options.expander, settings);
+
+	// Reshape the voice before the gain and compressor see it. band_count
+	// is always written, so a fit that found nothing to correct, or a
+	// filter only there for the high-pass, clears earlier bands; bands
+	// past it keep their values but are off
+	settings = obs_data_create();
+	obs_data_set_double(settings, "highpass_hz", static_cast<double>(chain.highPassHz));
+	const int voiceEqCount = options.voiceEq ? options.voiceEqBandCount : 0;
+	obs_data_set_int(settings, "band_count", voiceEqCount);
+	if (voiceEqCount > 0) {
+		char key[32];
+		for (int b = 0; b < voiceEqCount; b++) {
+			const VoiceEqBand &band = options.voiceEqBands[b];
+			snprintf(key, sizeof(key), "band%d_hz", b + 1);
+			obs_data_set_double(settings, key, static_cast<double>(band.hz));
+			snprintf(key, sizeof(key), "band%d_gain", b + 1);
+			obs_data_set_double(settings, key, static_cast<double>(band.gainDb));
+			snprintf(key, sizeof(key), "band%d_q", b + 1);
+			obs_data_set_double(settings, key, static_cast<double>(band.q));
+		}
+	}
+	add(VOICE_EQ_FILTER_ID, "Audio Calibrator - Voice EQ", chain.hasVoiceEq(), settings);
+
+	settings = obs_data_create();
+	obs_data_set_double(settings, "db", static_cast<double>(chain.gainDb));
+	add("gain_filter", "Audio Calibrator - Gain", options.gain, settings);
+
+	settings = obs_data_create();
+	obs_data_set_double(settings, "threshold", static_cast<double>(chain.compressorThresholdDb));
+	obs_data_set_double(settings, "ratio", static_cast<double>(chain.compressorRatio));
+	obs_data_set_int(settings, "attack_time", chain.compressorAttackMs);
+	obs_data_set_int(settings, "release_time", chain.compressorReleaseMs);
+	obs_data_set_double(settings, "output_gain", 0.0);
+	obs_data_set_string(settings, "sidechain_source", "none");
+	add("compressor_filter", "Audio Calibrator - Compressor", options.compressor && !options.multiband, settings);
+
+	// Takes the broadband compressor's place when enabled
+	settings = obs_data_create();
+	obs_data_set_double(settings, "low_hz", MultibandCompressor::LOW_CROSSOVER_HZ);
+	obs_data_set_double(settings, "high_hz", MultibandCompressor::HIGH_CROSSOVER_HZ);
+	char key[32];
+	for (int b = 0; b < CompressorBand::BANDS; b++) {
+		const CompressorBand &band = chain.multibandBands[b];
+		snprintf(key, sizeof(key), "band%d_threshold", b + 1);
+		obs_data_set_double(settings, key, static_cast<double>(band.thresholdDb));
+		snprintf(key, sizeof(key), "band%d_ratio", b + 1);
+		obs_data_set_double(settings, key, static_cast<double>(band.ratio));
+		snprintf(key, sizeof(key), "band%d_attack", b + 1);
+		obs_data_set_double(settings, key, static_cast<double>(band.attackMs));
+		snprintf(key, sizeof(key), "band%d_release", b + 1);
+		obs_data_set_double(settings, key, static_cast<double>(band.releaseMs));
+	}
+	add(MULTIBAND_FILTER_ID, "Audio Calibrator - Multiband Compressor", options.multiband, settings);
+
+	settings = obs_data_create();
+	obs_data_set_double(settings, "threshold", static_cast<double>(chain.limiterThresholdDb));
+	obs_data_set_int(settings, "release_time", chain.limiterReleaseMs);
+	add("limiter_filter", "Audio Calibrator - Limiter", options.limiter, settings);
+
+	// EQ-based approximations for high-pass/low-pass/de-esser
+	settings = obs_data_create();
+	obs_data_set_double(settings, "low", static_cast<double>(chain.eqLowDb));
+	obs_data_set_double(settings, "mid", static_cast<double>(chain.eqMidDb));
+	obs_data_set_double(settings, "high", static_cast<double>(chain.eqHighDb));
+	add("basic_eq_filter", "Audio Calibrator - EQ", chain.hasEq(), settings);
+
+	add("vst_filter", "Audio Calibrator - VST", options.vst, obs_data_create());
+}
+
+ChainSettings::~ChainSettings()
+{
+	for (const ChainFilterSettings &entry : entries)
+		obs_data_release(entry.settings);
+}
+
+void ChainSettings::add(const char *id, const char *name, bool enabled, obs_data_t *settings)
+{
+	entries.push_back({id, name, enabled, settings});
+}
+
+int ChainSettings::updateExisting(obs_source_t *source) const
+{
+	if (!source)
+		return 0;
+
+	int missing = 0;
+	for (const ChainFilterSettings &entry : entries) {
+		obs_source_t *filter = obs_source_get_filter_by_name(source, entry.name);
+		if (!filter) {
+			if (entry.enabled)
+				missing++;
+			continue;
+		}
+
+		if (entry.enabled)
+			obs_source_update(filter, entry.settings);
+		if (obs_source_enabled(filter) != entry.enabled)
+			obs_source_set_enabled(filter, entry.enabled);
+		obs_source_release(filter);
+	}
+	return missing;
+}
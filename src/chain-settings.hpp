@@ -0,0 +1,48 @@
+/*
+ * Chain Settings - obs_data for every filter applyFilters manages
+ * Copyright (C) 2025
+ *
+ * Built once per CalibrationChain. Creating the filters and hot-swapping
+ * the parameters of filters that already exist both read from here, so the
+ * two can never drift apart.
+ */
+
+#ifndef CHAIN_SETTINGS_HPP
+#define CHAIN_SETTINGS_HPP
+
+#include <obs.h>
+
+#include <vector>
+
+#include "calibration-chain.hpp"
+
+struct ChainFilterSettings {
+	const char *id;
+	const char *name;
+	bool enabled;         // part of this chain's options
+	obs_data_t *settings; // owned by ChainSettings
+};
+
+class ChainSettings {
+public:
+	explicit ChainSettings(const CalibrationChain &chain);
+	~ChainSettings();
+
+	ChainSettings(const ChainSettings &) = delete;
+	ChainSettings &operator=(const ChainSettings &) = delete;
+
+	// Every managed filter in chain order, enabled or not
+	const std::vector<ChainFilterSettings> &filters() const { return entries; }
+
+	// Update the filters already on the source in place and enable or
+	// disable them to match; nothing is created or removed. Returns the
+	// number of enabled filters that were missing on the source.
+	int updateExisting(obs_source_t *source) const;
+
+private:
+	void add(const char *id, const char *name, bool enabled, obs_data_t *settings);
+
+	std::vector<ChainFilterSettings> entries;
+};
+
+#endif // CHAIN_SETTINGS_HPP
@@ -0,0 +1,190 @@
+/*
+ * Distance Monitor Implementation
+ * Copyright (C) 2025
+ */
+
+#include "distance-monitor.hpp"
+#include "proximity-bands.hpp"
+#include "voice-activity.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+static float powerDb(double power)
+{
+	return power > 1e-12 ? static_cast<float>(10.0 * std::log10(power)) : -120.0f;
+}
+
+void DistanceMonitor::setReference(const DistanceReference &reference)
+{
+	ref = reference;
+	reset();
+}
+
+void DistanceMonitor::reset()
+{
+	lowPower = 0.0;
+	midPower = 0.0;
+	levelPower = 0.0;
+	speechBlocks = 0;
+	tiltDeviation = 0.0f;
+	levelDeviation = 0.0f;
+	current = MicDistance::Unknown;
+}
+
+MicDistance DistanceMonitor::update(const AnalysisBlock &block)
+{
+	if (!ref.valid() || !block.speech)
+		return current;
+
+	// Exponential average over about SMOOTHING_BLOCKS of speech; the first
+	// blocks are a plain mean so the estimate does not start from zero
+	speechBlocks++;
+	const double alpha = 1.0 / std::min(speechBlocks, SMOOTHING_BLOCKS);
+	lowPower += alpha * (block.lowBandPower - lowPower);
+	midPower += alpha * (block.midBandPower - midPower);
+	levelPower += alpha * (std::pow(10.0, block.rmsDb / 10.0) - levelPower);
+
+	tiltDeviation = powerDb(lowPower) - powerDb(midPower) - ref.tiltDb;
+	levelDeviation = powerDb(levelPower) - ref.levelDb;
+	if (speechBlocks < MIN_SPEECH_BLOCKS)
+		return current;
+
+	// Leave a flagged state only once both cues are back past the hysteresis
+	switch (current) {
+	case MicDistance::TooClose:
+		if (tiltDeviation < CLOSE_TILT_DB - HYSTERESIS_DB || levelDeviation < CLOSE_LEVEL_DB - HYSTERESIS_DB)
+			current = MicDistance::Ok;
+		break;
+	case MicDistance::TooFar:
+		if (tiltDeviation > FAR_TILT_DB + HYSTERESIS_DB || levelDeviation > FAR_LEVEL_DB + HYSTERESIS_DB)
+			current = MicDistance::Ok;
+		break;
+	default:
+		current = MicDistance::Ok;
+		break;
+	}
+	if (current == MicDistance::Ok) {
+		if (tiltDeviation > CLOSE_TILT_DB && levelDeviation > CLOSE_LEVEL_DB)
+			current = MicDistance::TooClose;
+		else if (tiltDeviation < FAR_TILT_DB && levelDeviation < FAR_LEVEL_DB)
+			current = MicDistance::TooFar;
+	}
+	return current;
+}
+
+const char *DistanceMonitor::describe(MicDistance distance)
+{
+	switch (distance) {
+	case MicDistance::Ok:
+		return "distance OK";
+	case MicDistance::TooClose:
+		return "too close";
+	case MicDistance::TooFar:
+		return "too far";
+	default:
+		return "";
+	}
+}
+
+DistanceReference DistanceMonitor::measureReference(const float *samples, size_t count, uint32_t sampleRate)
+{
+	DistanceReference reference;
+	if (!samples || sampleRate == 0)
+		return reference;
+
+	// The worker analyses at its own fixed rate
+	std::vector<float> resampled;
+	if (sampleRate != AnalysisTap::ANALYSIS_RATE) {
+		PolyphaseResampler resampler;
+		resampler.configure(DspTableCache::instance().resamplerPlan(sampleRate, AnalysisTap::ANALYSIS_RATE));
+		resampled.reserve(resampler.maxOutput(count));
+		resampler.process(samples, count, resampled);
+		samples = resampled.data();
+		count = resampled.size();
+		sampleRate = AnalysisTap::ANALYSIS_RATE;
+	}
+
+	VoiceActivityDetector vad;
+	vad.configure(sampleRate);
+	ProximityBands bands;
+	bands.configure(sampleRate);
+
+	const size_t blockFrames = static_cast<size_t>(0.1 * sampleRate);
+	const size_t vadFrame = vad.frameSamples();
+	double lowSum = 0.0;
+	double midSum = 0.0;
+	double levelSum = 0.0;
+	size_t speechBlocks = 0;
+
+	for (size_t start = 0; start + blockFrames <= count; start += blockFrames) {
+		const float *block = samples + start;
+
+		size_t voiced = 0;
+		size_t total = 0;
+		for (size_t pos = 0; pos + vadFrame <= blockFrames; pos += vadFrame) {
+			if (vad.process(block + pos, vadFrame))
+				voiced++;
+			total++;
+		}
+
+		double low = 0.0;
+		double mid = 0.0;
+		bands.measure(block, blockFrames, low, mid);
+		if (total == 0 || voiced * 2 < total)
+			continue;
+
+		double sum = 0.0;
+		for (size_t i = 0; i < blockFrames; i++)
+			sum += static_cast<double>(block[i]) * block[i];
+
+		lowSum += low;
+		midSum += mid;
+		levelSum += sum / static_cast<double>(blockFrames);
+		speechBlocks++;
+	}
+
+	if (speechBlocks < static_cast<size_t>(MIN_SPEECH_BLOCKS))
+		return reference;
+
+	reference.tiltDb = powerDb(lowSum) - powerDb(midSum);
+	reference.levelDb = powerDb(levelSum / static_cast<double>(speechBlocks));
+	return reference;
+}
+
+DistanceWatch::~DistanceWatch()
+{
+	stop();
+}
+
+bool DistanceWatch::start(obs_source_t *source, const DistanceReference &reference)
+{
+	stop();
+	if (!source || !reference.valid())
+		return false;
+
+	tap = AnalysisWorker::shared().tap(source);
+	if (!tap)
+		return false;
+
+	// No listener yet, so the monitor is still ours
+	monitor.setReference(reference);
+	current.store(MicDistance::Unknown, std::memory_order_relaxed);
+	listenerId = tap->addListener([this](const AnalysisBlock &block) {
+		current.store(monitor.update(block), std::memory_order_relaxed);
+		tilt.store(monitor.tiltDeviationDb(), std::memory_order_relaxed);
+		level.store(monitor.levelDeviationDb(), std::memory_order_relaxed);
+	});
+	return true;
+}
+
+void DistanceWatch::stop()
+{
+	if (!tap)
+		return;
+	tap->removeListener(listenerId);
+	tap.reset();
+	listenerId = 0;
+	current.store(MicDistance::Unknown, std::memory_order_relaxed);
+}
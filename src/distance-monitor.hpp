@@ -0,0 +1,97 @@
+/*
+ * Distance Monitor - Talker-to-mic distance from level and proximity effect
+ * Copyright (C) 2025
+ *
+ * Moving closer to a directional mic raises the level and, through the
+ * proximity effect, the low band more than the presence band; moving away
+ * does the opposite. Speaking louder raises the level but tilts the voice
+ * towards the presence band, so requiring both to move together separates
+ * distance from vocal effort. Live input is the 100 ms low/mid band
+ * energies of the analysis worker (on a ~12 kHz decimated copy of the
+ * first channel) compared with the same measurement of calibration step 4
+ * rendered through the applied chain.
+ */
+
+#ifndef DISTANCE_MONITOR_HPP
+#define DISTANCE_MONITOR_HPP
+
+#include <obs.h>
+
+#include <atomic>
+#include <memory>
+
+#include "analysis-worker.hpp"
+
+// Step 4 as the analysis worker would see it after the chain
+struct DistanceReference {
+	float tiltDb = 0.0f;    // low band over mid band, speech blocks
+	float levelDb = -100.0f; // first-channel RMS, speech blocks
+
+	bool valid() const { return levelDb > -90.0f; }
+};
+
+enum class MicDistance { Unknown, Ok, TooClose, TooFar };
+
+class DistanceMonitor {
+public:
+	static constexpr float CLOSE_TILT_DB = 4.0f;
+	static constexpr float CLOSE_LEVEL_DB = 2.0f;
+	static constexpr float FAR_TILT_DB = -3.0f;
+	static constexpr float FAR_LEVEL_DB = -3.0f;
+	static constexpr float HYSTERESIS_DB = 1.5f;
+	static constexpr int SMOOTHING_BLOCKS = 20; // 2 s of speech
+	static constexpr int MIN_SPEECH_BLOCKS = 10;
+
+	void setReference(const DistanceReference &reference);
+	void reset();
+
+	// Feed every block; only speech blocks move the estimate
+	MicDistance update(const AnalysisBlock &block);
+
+	MicDistance state() const { return current; }
+	float tiltDeviationDb() const { return tiltDeviation; }
+	float levelDeviationDb() const { return levelDeviation; }
+
+	static const char *describe(MicDistance distance);
+
+	// Same blocks, bands and voice activity as the analysis worker
+	static DistanceReference measureReference(const float *samples, size_t count, uint32_t sampleRate);
+
+private:
+	DistanceReference ref;
+	double lowPower = 0.0;
+	double midPower = 0.0;
+	double levelPower = 0.0;
+	int speechBlocks = 0;
+	float tiltDeviation = 0.0f;
+	float levelDeviation = 0.0f;
+	MicDistance current = MicDistance::Unknown;
+};
+
+// A DistanceMonitor on a source's analysis tap, readable from the UI thread
+class DistanceWatch {
+public:
+	DistanceWatch() = default;
+	~DistanceWatch();
+
+	DistanceWatch(const DistanceWatch &) = delete;
+	DistanceWatch &operator=(const DistanceWatch &) = delete;
+
+	bool start(obs_source_t *source, const DistanceReference &reference);
+	void stop();
+
+	bool isRunning() const { return tap != nullptr; }
+	MicDistance state() const { return current.load(std::memory_order_relaxed); }
+	float tiltDeviationDb() const { return tilt.load(std::memory_order_relaxed); }
+	float levelDeviationDb() const { return level.load(std::memory_order_relaxed); }
+
+private:
+	DistanceMonitor monitor; // worker thread while attached
+	std::shared_ptr<AnalysisTap> tap;
+	int listenerId = 0;
+	std::atomic<MicDistance> current{MicDistance::Unknown};
+	std::atomic<float> tilt{0.0f};
+	std::atomic<float> level{0.0f};
+};
+
+#endif // DISTANCE_MONITOR_HPP
@@ -0,0 +1,254 @@
+/*
+ * DSP Tables Implementation
+ * Copyright (C) 2025
+ */
+
+#include "dsp-tables.hpp"
+#include "worker-pool.hpp"
+#include <plugin-support.h>
+
+#include <obs.h>
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr double PI = 3.14159265358979323846;
+
+DspConfig DspConfig::fromAudioOutput()
+{
+	DspConfig config;
+	audio_t *audio = obs_get_audio();
+	if (!audio)
+		return config;
+
+	config.sampleRate = audio_output_get_sample_rate(audio);
+	config.channels = static_cast<uint32_t>(audio_output_get_channels(audio));
+	config.blockSize = AUDIO_OUTPUT_FRAMES;
+	return config;
+}
+
+// BS.1770 channel weights in OBS channel order: LFE is excluded and the
+// surround pair(s) get +1.5 dB.
+static std::vector<float> channelWeightsFor(uint32_t channels)
+{
+	switch (channels) {
+	case 1:
+		return {1.0f};
+	case 2:
+		return {1.0f, 1.0f};
+	case 3: // 2.1
+		return {1.0f, 1.0f, 0.0f};
+	case 4: // 4.0
+		return {1.0f, 1.0f, 1.0f, 1.41f};
+	case 5: // 4.1
+		return {1.0f, 1.0f, 1.0f, 0.0f, 1.41f};
+	case 6: // 5.1
+		return {1.0f, 1.0f, 1.0f, 0.0f, 1.41f, 1.41f};
+	case 8: // 7.1
+		return {1.0f, 1.0f, 1.0f, 0.0f, 1.41f, 1.41f, 1.41f, 1.41f};
+	default:
+		return std::vector<float>(channels, 1.0f);
+	}
+}
+
+DspTableCache &DspTableCache::instance()
+{
+	static DspTableCache cache;
+	return cache;
+}
+
+std::shared_ptr<const DspTables> DspTableCache::build(const DspConfig &config)
+{
+	auto tables = std::make_shared<DspTables>();
+	tables->config = config;
+
+	const double sampleRate = static_cast<double>(config.sampleRate);
+	tables->frameSize = FftPlan::nextPowerOfTwo(static_cast<size_t>(sampleRate * 0.021));
+	tables->fft = instance().fftPlan(tables->frameSize);
+
+	tables->window.resize(tables->frameSize);
+	double power = 0.0;
+	for (size_t i = 0; i < tables->frameSize; i++) {
+		const double w = 0.5 - 0.5 * std::cos(2.0 * PI * static_cast<double>(i) /
+						      static_cast<double>(tables->frameSize));
+		tables->window[i] = static_cast<float>(w);
+		power += w * w;
+	}
+	tables->windowPower = static_cast<float>(power);
+
+	tables->kShelf = BiquadCoeffs::kWeightingShelf(sampleRate);
+	tables->kHighPass = BiquadCoeffs::kWeightingHighPass(sampleRate);
+	tables->channelWeights = channelWeightsFor(config.channels);
+
+	tables->dcBlockPole = static_cast<float>(std::exp(-2.0 * PI * 10.0 / sampleRate));
+	tables->momentaryAlpha =
+		static_cast<float>(1.0 - std::exp(-static_cast<double>(config.blockSize) / (0.4 * sampleRate)));
+
+	const double binHz = sampleRate / static_cast<double>(tables->frameSize);
+	const double nyquist = sampleRate / 2.0;
+	const uint32_t maxBin = static_cast<uint32_t>(tables->frameSize / 2);
+	for (int k = -16; k <= 13; k++) {
+		const double center = 1000.0 * std::pow(2.0, k / 3.0);
+		const double lo = center * std::pow(2.0, -1.0 / 6.0);
+		const double hi = center * std::pow(2.0, 1.0 / 6.0);
+		if (hi >= nyquist)
+			break;
+
+		BandRange band;
+		band.centerHz = static_cast<float>(center);
+		band.firstBin = static_cast<uint32_t>(std::ceil(lo / binHz));
+		band.lastBin = static_cast<uint32_t>(std::floor(hi / binHz));
+		if (band.lastBin < band.firstBin) {
+			// Band narrower than one bin at this resolution
+			band.firstBin = band.lastBin = static_cast<uint32_t>(std::lround(center / binHz));
+		}
+		band.firstBin = std::max(1u, std::min(band.firstBin, maxBin));
+		band.lastBin = std::max(band.firstBin, std::min(band.lastBin, maxBin));
+		tables->thirdOctaveBands.push_back(band);
+	}
+
+	return tables;
+}
+
+std::shared_ptr<const DspTables> DspTableCache::acquire(const DspConfig &config)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = tables.find(config);
+		if (it != tables.end())
+			return it->second;
+	}
+
+	// Build outside the lock so a slow plan does not stall other lookups
+	auto built = build(config);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	auto inserted = tables.emplace(config, built);
+	if (inserted.second) {
+		obs_log(LOG_INFO, "[DspTables] Planned tables for %u Hz, %u ch, %u frames (FFT %zu)",
+			config.sampleRate, config.channels, config.blockSize, built->frameSize);
+	}
+	return inserted.first->second;
+}
+
+std::shared_ptr<const FftPlan> DspTableCache::fftPlan(size_t size)
+{
+	size = FftPlan::nextPowerOfTwo(size);
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = fftPlans.find(size);
+		if (it != fftPlans.end())
+			return it->second;
+	}
+
+	auto plan = std::make_shared<const FftPlan>(size);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	return fftPlans.emplace(size, plan).first->second;
+}
+
+std::shared_ptr<const PolyphasePlan> DspTableCache::resamplerPlan(uint32_t inputRate, uint32_t outputRate)
+{
+	const std::pair<uint32_t, uint32_t> key(inputRate, outputRate);
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = resamplerPlans.find(key);
+		if (it != resamplerPlans.end())
+			return it->second;
+	}
+
+	auto plan = std::make_shared<const PolyphasePlan>(inputRate, outputRate);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	return resamplerPlans.emplace(key, plan).first->second;
+}
+
+void DspTableCache::prewarm(const DspConfig &config)
+{
+	WorkerPool::shared().submit([config]() { instance().acquire(config); });
+}
+
+void DspTableCache::clear()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	tables.clear();
+	fftPlans.clear();
+	resamplerPlans.clear();
+}
+
+std::shared_ptr<DspTableHandle> DspTableHandle::create(const DspConfig &config)
+{
+	std::shared_ptr<DspTableHandle> handle(new DspTableHandle());
+	handle->install(DspTableCache::instance().acquire(config));
+
+	std::weak_ptr<DspTableHandle> weak = handle;
+	handle->pollerId = WorkerPool::shared().addPoller([weak]() {
+		if (std::shared_ptr<DspTableHandle> self = weak.lock())
+			self->replan();
+	});
+	return handle;
+}
+
+DspTableHandle::~DspTableHandle()
+{
+	WorkerPool::shared().removePoller(pollerId);
+}
+
+void DspTableHandle::install(std::shared_ptr<const DspTables> next)
+{
+	if (!next)
+		return;
+
+	std::lock_guard<std::mutex> lock(ownedMutex);
+	active.store(next.get(), std::memory_order_release);
+	const uint64_t retiredAt = generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+	for (OwnedTables &entry : owned) {
+		if (entry.retiredAt == 0)
+			entry.retiredAt = retiredAt;
+	}
+	owned.push_back({std::move(next), 0});
+
+	// The consumer loads the generation before the active pointer, so once
+	// it has acknowledged a generation it no longer reads anything retired
+	// at or before it
+	const uint64_t seen = acknowledged.load(std::memory_order_acquire);
+	owned.erase(std::remove_if(owned.begin(), owned.end(),
+				   [seen](const OwnedTables &entry) {
+					   return entry.retiredAt != 0 && entry.retiredAt <= seen;
+				   }),
+		    owned.end());
+}
+
+const DspTables *DspTableHandle::tablesFor(const DspConfig &config)
+{
+	// Entering again means the tables returned last time are no longer used
+	acknowledged.store(generation.load(std::memory_order_acquire), std::memory_order_release);
+	const DspTables *current = active.load(std::memory_order_acquire);
+	if (current && current->config == config)
+		return current;
+
+	// One request at a time: a change made while one is pending is asked
+	// for again once the planned tables arrive and do not match
+	if (!replanPending.load(std::memory_order_acquire)) {
+		requestedRate.store(config.sampleRate, std::memory_order_relaxed);
+		requestedChannels.store(config.channels, std::memory_order_relaxed);
+		requestedBlockSize.store(config.blockSize, std::memory_order_relaxed);
+		replanPending.store(true, std::memory_order_release);
+	}
+	return nullptr;
+}
+
+void DspTableHandle::replan()
+{
+	if (!replanPending.load(std::memory_order_acquire))
+		return;
+
+	// Planning only happens on an audio reset and takes milliseconds, so it
+	// runs right here rather than as a separate task
+	DspConfig config;
+	config.sampleRate = requestedRate.load(std::memory_order_relaxed);
+	config.channels = requestedChannels.load(std::memory_order_relaxed);
+	config.blockSize = requestedBlockSize.load(std::memory_order_relaxed);
+	install(DspTableCache::instance().acquire(config));
+	replanPending.store(false, std::memory_order_release);
+}
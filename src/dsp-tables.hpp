@@ -0,0 +1,159 @@
+/*
+ * DSP Tables - Process-wide cache of precomputed analysis tables
+ * Copyright (C) 2025
+ *
+ * FFT plans, windows, filter coefficients and band maps depend only on the
+ * audio configuration, so they are built once per (sample rate, channel
+ * count, block size) and shared read-only by every analyzer and native
+ * filter. Resampling plans are shared the same way, keyed by rate pair.
+ */
+
+#ifndef DSP_TABLES_HPP
+#define DSP_TABLES_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "biquad.hpp"
+#include "fft.hpp"
+#include "polyphase-resampler.hpp"
+
+struct DspConfig {
+	uint32_t sampleRate = 48000;
+	uint32_t channels = 2;
+	uint32_t blockSize = 1024; // OBS mix block (AUDIO_OUTPUT_FRAMES)
+
+	bool operator==(const DspConfig &other) const
+	{
+		return sampleRate == other.sampleRate && channels == other.channels && blockSize == other.blockSize;
+	}
+	bool operator!=(const DspConfig &other) const { return !(*this == other); }
+	bool operator<(const DspConfig &other) const
+	{
+		return std::tie(sampleRate, channels, blockSize) <
+		       std::tie(other.sampleRate, other.channels, other.blockSize);
+	}
+
+	// Current configuration of the OBS audio output
+	static DspConfig fromAudioOutput();
+};
+
+struct BandRange {
+	uint32_t firstBin;
+	uint32_t lastBin; // inclusive
+	float centerHz;
+};
+
+struct DspTables {
+	DspConfig config;
+
+	// Analysis frame (~21 ms, power of two)
+	size_t frameSize = 0;
+	std::shared_ptr<const FftPlan> fft;
+	std::vector<float> window; // Hann, frameSize entries
+	float windowPower = 1.0f;  // sum of squared window, for PSD scaling
+
+	// BS.1770 K-weighting and per-channel weights for this speaker layout
+	BiquadCoeffs kShelf;
+	BiquadCoeffs kHighPass;
+	std::vector<float> channelWeights;
+
+	// One-pole DC blocker (~10 Hz corner)
+	float dcBlockPole = 0.999f;
+
+	// Per-block smoothing for the 400 ms momentary window
+	float momentaryAlpha = 0.1f;
+
+	// ISO 1/3-octave bands mapped onto FFT bins, below Nyquist
+	std::vector<BandRange> thirdOctaveBands;
+
+	float binHz() const { return static_cast<float>(config.sampleRate) / static_cast<float>(frameSize); }
+};
+
+class DspTableCache {
+public:
+	static DspTableCache &instance();
+
+	// Returns shared tables for config, building them on a miss. Never call
+	// from the audio thread.
+	std::shared_ptr<const DspTables> acquire(const DspConfig &config);
+
+	// Shared FFT plan of any power-of-two size (offline analysis uses large
+	// plans that are not tied to an audio configuration).
+	std::shared_ptr<const FftPlan> fftPlan(size_t size);
+
+	// Shared resampling plan from one rate to another
+	std::shared_ptr<const PolyphasePlan> resamplerPlan(uint32_t inputRate, uint32_t outputRate);
+
+	// Build tables for config on the worker pool.
+	void prewarm(const DspConfig &config);
+
+	void clear();
+
+private:
+	DspTableCache() = default;
+
+	static std::shared_ptr<const DspTables> build(const DspConfig &config);
+
+	std::mutex mutex;
+	std::map<DspConfig, std::shared_ptr<const DspTables>> tables;
+	std::map<size_t, std::shared_ptr<const FftPlan>> fftPlans;
+	std::map<std::pair<uint32_t, uint32_t>, std::shared_ptr<const PolyphasePlan>> resamplerPlans;
+};
+
+// Per-consumer view of the cache that is safe to read from the audio thread.
+// On a configuration change the consumer only records the new configuration
+// and raises a flag; the pool's poll thread plans the tables and installs
+// them. Until they arrive tablesFor() returns nullptr and the caller skips
+// the table-dependent work for that block.
+class DspTableHandle {
+public:
+	static std::shared_ptr<DspTableHandle> create(const DspConfig &config);
+	~DspTableHandle();
+
+	const DspTables *tables() const { return active.load(std::memory_order_acquire); }
+
+	// Audio-thread safe: no allocation or locking, also when the
+	// configuration changed. Each handle has one consumer thread, and the
+	// returned tables stay valid until its next call.
+	const DspTables *tablesFor(const DspConfig &config);
+
+private:
+	DspTableHandle() = default;
+
+	void install(std::shared_ptr<const DspTables> next);
+
+	// Poll thread
+	void replan();
+
+	std::atomic<const DspTables *> active{nullptr};
+	int pollerId = 0;
+
+	// Configuration the consumer asked for; written only while
+	// replanPending is clear, read by the poll thread once it is set
+	std::atomic<bool> replanPending{false};
+	std::atomic<uint32_t> requestedRate{0};
+	std::atomic<uint32_t> requestedChannels{0};
+	std::atomic<uint32_t> requestedBlockSize{0};
+
+	// Installed table sets with the generation that superseded them (0 for
+	// the active one). A superseded set is released by a later install once
+	// the consumer has called tablesFor() after the swap, as until then it
+	// may still be reading it.
+	struct OwnedTables {
+		std::shared_ptr<const DspTables> tables;
+		uint64_t retiredAt = 0;
+	};
+	std::atomic<uint64_t> generation{0};
+	std::atomic<uint64_t> acknowledged{0};
+	std::mutex ownedMutex;
+	std::vector<OwnedTables> owned;
+};
+
+#endif // DSP_TABLES_HPP
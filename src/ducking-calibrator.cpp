@@ -0,0 +1,231 @@
+/*
+ * Ducking Calibrator Implementation
+ * Copyright (C) 2025
+ */
+
+#include "ducking-calibrator.hpp"
+#include <plugin-support.h>
+
+#include <algorithm>
+#include <cmath>
+
+// BS.1770 absolute gate, used to ignore gaps between tracks
+static constexpr double MUSIC_GATE_LUFS = -70.0;
+
+// With a 400 ms release the sidechain envelope sags this far below the
+// block peaks between syllables
+static constexpr float ENVELOPE_SAG_DB = 2.0f;
+
+// Keep the threshold this far above mic idle so room noise and bleed never
+// duck the music
+static constexpr float IDLE_MARGIN_DB = 6.0f;
+
+// Widest span between threshold and speech envelope we design for
+static constexpr float MAX_SPAN_DB = 18.0f;
+
+// Below this the music is already quiet enough under the voice
+static constexpr float MIN_REDUCTION_DB = 1.0f;
+
+static float powerToLufs(double power)
+{
+	return power > 1e-10 ? static_cast<float>(-0.691 + 10.0 * std::log10(power)) : -100.0f;
+}
+
+static float percentile(std::vector<float> values, double fraction)
+{
+	if (values.empty())
+		return -100.0f;
+	const size_t index = std::min(values.size() - 1, static_cast<size_t>(fraction * values.size()));
+	std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+	return values[index];
+}
+
+DuckingCalibrator::~DuckingCalibrator()
+{
+	stop();
+}
+
+bool DuckingCalibrator::start(obs_source_t *voiceSource, obs_source_t *musicSource, double seconds,
+			      CompletionCallback onComplete)
+{
+	stop();
+
+	if (!voiceSource || !musicSource || voiceSource == musicSource)
+		return false;
+
+	std::shared_ptr<AnalysisTap> voice = AnalysisWorker::shared().tap(voiceSource);
+	std::shared_ptr<AnalysisTap> music = AnalysisWorker::shared().tap(musicSource);
+	if (!voice || !music)
+		return false;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		voiceTap = voice;
+		musicTap = music;
+		targetSeconds = std::max(1.0, seconds);
+		completion = std::move(onComplete);
+		completed = false;
+		voiceSeconds = 0.0;
+		musicSeconds = 0.0;
+		speechPower = 0.0;
+		musicPower = 0.0;
+		speechPeaks.clear();
+		idlePeaks.clear();
+		speechBlocks = 0;
+		musicBlocks = 0;
+		discontinuities = 0;
+	}
+
+	// Both taps are drained in the same worker tick, so the two streams
+	// stay within one block of each other
+	voiceListener = voice->addListener([this](const AnalysisBlock &block) { onVoiceBlock(block); });
+	musicListener = music->addListener([this](const AnalysisBlock &block) { onMusicBlock(block); });
+
+	obs_log(LOG_INFO, "[Ducking] Measuring %s over %s for %.0f s", voice->name().c_str(), music->name().c_str(),
+		targetSeconds);
+	return true;
+}
+
+void DuckingCalibrator::stop()
+{
+	std::shared_ptr<AnalysisTap> voice;
+	std::shared_ptr<AnalysisTap> music;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		voice.swap(voiceTap);
+		music.swap(musicTap);
+		completion = nullptr;
+	}
+
+	// Outside our lock: a listener may be waiting on it
+	if (voice)
+		voice->removeListener(voiceListener);
+	if (music)
+		music->removeListener(musicListener);
+}
+
+double DuckingCalibrator::progress() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return std::min(1.0, std::min(voiceSeconds, musicSeconds) / targetSeconds);
+}
+
+void DuckingCalibrator::onVoiceBlock(const AnalysisBlock &block)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (completed)
+			return;
+		voiceSeconds += block.seconds;
+		if (!block.continuous) {
+			discontinuities++;
+			return;
+		}
+		if (block.speech) {
+			speechPower += block.kPower;
+			speechPeaks.push_back(block.peakDb);
+			speechBlocks++;
+		} else {
+			idlePeaks.push_back(block.peakDb);
+		}
+	}
+	checkComplete();
+}
+
+void DuckingCalibrator::onMusicBlock(const AnalysisBlock &block)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (completed)
+			return;
+		musicSeconds += block.seconds;
+		if (!block.continuous) {
+			discontinuities++;
+			return;
+		}
+		if (block.loudnessLufs() > MUSIC_GATE_LUFS) {
+			musicPower += block.kPower;
+			musicBlocks++;
+		}
+	}
+	checkComplete();
+}
+
+void DuckingCalibrator::checkComplete()
+{
+	CompletionCallback callback;
+	DuckingMeasurement measurement;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (completed || voiceSeconds < targetSeconds || musicSeconds < targetSeconds)
+			return;
+		completed = true;
+		measurement = measure();
+		callback = completion;
+	}
+
+	obs_log(LOG_INFO,
+		"[Ducking] Voice %.1f LUFS (peak %.1f dBFS, idle %.1f) over music %.1f LUFS, %d/%d blocks, %d skipped "
+		"at timeline breaks",
+		measurement.voiceLufs, measurement.voicePeakDb, measurement.voiceIdlePeakDb, measurement.musicLufs,
+		measurement.speechBlocks, measurement.musicBlocks, measurement.discontinuities);
+
+	if (callback)
+		callback(measurement);
+}
+
+DuckingMeasurement DuckingCalibrator::measure() const
+{
+	DuckingMeasurement measurement;
+	measurement.seconds = std::min(voiceSeconds, musicSeconds);
+	measurement.speechBlocks = speechBlocks;
+	measurement.musicBlocks = musicBlocks;
+	measurement.discontinuities = discontinuities;
+	if (speechBlocks > 0)
+		measurement.voiceLufs = powerToLufs(speechPower / speechBlocks);
+	if (musicBlocks > 0)
+		measurement.musicLufs = powerToLufs(musicPower / musicBlocks);
+	measurement.voicePeakDb = percentile(speechPeaks, 0.5);
+
+	// Blocks next to speech are often not voiced enough to count as speech
+	// but still carry its peaks; the quiet end is the room
+	measurement.voiceIdlePeakDb = percentile(idlePeaks, 0.2);
+	return measurement;
+}
+
+DuckingSettings DuckingCalibrator::solve(const DuckingMeasurement &measurement, float targetRatioLu, float voiceFaderDb,
+					 float musicFaderDb)
+{
+	DuckingSettings settings;
+
+	const float current = (measurement.voiceLufs + voiceFaderDb) - (measurement.musicLufs + musicFaderDb);
+	settings.predictedRatioLu = current;
+	settings.reductionDb = targetRatioLu - current;
+	if (settings.reductionDb < MIN_REDUCTION_DB) {
+		settings.reductionDb = 0.0f;
+		return settings;
+	}
+	settings.needed = true;
+
+	// Sidechain level while talking, and the lowest threshold that room
+	// noise cannot reach
+	const float envelope = measurement.voicePeakDb - ENVELOPE_SAG_DB;
+	const float floor = measurement.voiceIdlePeakDb + IDLE_MARGIN_DB;
+	float threshold = std::min(std::max(floor, envelope - MAX_SPAN_DB), envelope - 3.0f);
+
+	// GR = (envelope - threshold) * (1 - 1/ratio)
+	const float maxSlope = 1.0f - 1.0f / MAX_RATIO;
+	float slope = settings.reductionDb / (envelope - threshold);
+	if (slope > maxSlope) {
+		// Widen the span before giving up on the target
+		const float wanted = envelope - settings.reductionDb / maxSlope;
+		threshold = std::max(wanted, std::min(floor, envelope - 3.0f));
+		slope = std::min(maxSlope, settings.reductionDb / (envelope - threshold));
+		settings.reachable = threshold <= wanted + 0.01f;
+	}
+
+	settings.thresholdDb = threshold;
+	settings.ratio = std::min(MAX_RATIO, 1.0f / (1.0f - slope));
+	settings.predictedRatioLu = current + slope * (envelope - threshold);
+	return settings;
+}
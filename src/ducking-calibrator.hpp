@@ -0,0 +1,103 @@
+/*
+ * Ducking Calibrator - Sets up music ducking from measured voice and music
+ * Copyright (C) 2025
+ *
+ * The mic and the music source are tapped on the shared analysis worker at
+ * the same time while the host talks over the music. From the voice's
+ * speech loudness and sidechain level and the music's gated loudness it
+ * solves threshold and ratio for a compressor on the music source, keyed by
+ * the mic, so that music sits a chosen number of LU under the voice while
+ * the host speaks.
+ */
+
+#ifndef DUCKING_CALIBRATOR_HPP
+#define DUCKING_CALIBRATOR_HPP
+
+#include <obs.h>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "analysis-worker.hpp"
+
+// What was heard during the measurement (pre-fader, post-filters, which is
+// also what the sidechain sees)
+struct DuckingMeasurement {
+	double seconds = 0.0;
+	int speechBlocks = 0;
+	int musicBlocks = 0;
+	float voiceLufs = -100.0f;      // speech blocks only
+	float voicePeakDb = -100.0f;    // median speech block peak
+	float voiceIdlePeakDb = -100.0f; // quiet non-speech block peak
+	float musicLufs = -100.0f;      // -70 LUFS gated
+	int discontinuities = 0;        // blocks skipped at timeline breaks
+};
+
+struct DuckingSettings {
+	bool needed = false;         // music already far enough under the voice
+	bool reachable = true;       // false if the ratio had to be capped
+	float reductionDb = 0.0f;    // gain reduction asked of the compressor
+	float thresholdDb = -30.0f;
+	float ratio = 1.0f;
+	int attackMs = 10;
+	int releaseMs = 400;
+	float predictedRatioLu = 0.0f; // voice over music while speaking
+};
+
+class DuckingCalibrator {
+public:
+	static constexpr double DEFAULT_SECONDS = 15.0;
+	static constexpr int MIN_SPEECH_BLOCKS = 20; // 2 s of talking
+	static constexpr int MIN_MUSIC_BLOCKS = 20;
+	static constexpr float MAX_RATIO = 20.0f;
+
+	// Called on the worker thread once enough audio has been heard
+	using CompletionCallback = std::function<void(const DuckingMeasurement &)>;
+
+	DuckingCalibrator() = default;
+	~DuckingCalibrator();
+
+	DuckingCalibrator(const DuckingCalibrator &) = delete;
+	DuckingCalibrator &operator=(const DuckingCalibrator &) = delete;
+
+	bool start(obs_source_t *voiceSource, obs_source_t *musicSource, double seconds, CompletionCallback onComplete);
+
+	// Must not be called from the completion callback
+	void stop();
+
+	double progress() const;
+
+	// voiceFaderDb/musicFaderDb are the sources' current volumes in dB
+	static DuckingSettings solve(const DuckingMeasurement &measurement, float targetRatioLu, float voiceFaderDb,
+				     float musicFaderDb);
+
+private:
+	void onVoiceBlock(const AnalysisBlock &block);
+	void onMusicBlock(const AnalysisBlock &block);
+	void checkComplete();
+	DuckingMeasurement measure() const;
+
+	mutable std::mutex mutex;
+	std::shared_ptr<AnalysisTap> voiceTap;
+	std::shared_ptr<AnalysisTap> musicTap;
+	int voiceListener = 0;
+	int musicListener = 0;
+	double targetSeconds = DEFAULT_SECONDS;
+	CompletionCallback completion;
+	bool completed = false;
+
+	double voiceSeconds = 0.0;
+	double musicSeconds = 0.0;
+	double speechPower = 0.0;
+	double musicPower = 0.0;
+	std::vector<float> speechPeaks;
+	std::vector<float> idlePeaks;
+	int speechBlocks = 0;
+	int musicBlocks = 0;
+	int discontinuities = 0;
+};
+
+#endif // DUCKING_CALIBRATOR_HPP
@@ -0,0 +1,128 @@
+/*
+ * FFT Implementation
+ * Copyright (C) 2025
+ */
+
+#include "fft.hpp"
+
+#include <cmath>
+#include <utility>
+
+static constexpr double PI = 3.14159265358979323846;
+
+// std::complex operator* checks for NaN/inf per IEEE Annex G and ends up in a
+// library call; inputs here are always finite
+static inline std::complex<float> multiply(std::complex<float> a, std::complex<float> b)
+{
+	return {a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+}
+
+size_t FftPlan::nextPowerOfTwo(size_t value)
+{
+	size_t result = 4;
+	while (result < value)
+		result <<= 1;
+	return result;
+}
+
+FftPlan::FftPlan(size_t size) : n(isPowerOfTwo(size) && size >= 4 ? size : nextPowerOfTwo(size))
+{
+	const size_t half = n / 2;
+
+	twiddles.resize(half);
+	for (size_t k = 0; k < half; k++) {
+		const double phase = -2.0 * PI * static_cast<double>(k) / static_cast<double>(n);
+		twiddles[k] = std::complex<float>(static_cast<float>(std::cos(phase)),
+						  static_cast<float>(std::sin(phase)));
+	}
+
+	stageTwiddles.resize(half > 1 ? half - 1 : 0);
+	for (size_t mid = 1; mid < half; mid <<= 1) {
+		const size_t stride = n / (2 * mid);
+		for (size_t j = 0; j < mid; j++)
+			stageTwiddles[mid - 1 + j] = twiddles[j * stride];
+	}
+
+	unsigned bits = 0;
+	while ((size_t(1) << bits) < half)
+		bits++;
+
+	bitReverse.resize(half);
+	for (size_t i = 0; i < half; i++) {
+		uint32_t reversed = 0;
+		for (unsigned b = 0; b < bits; b++) {
+			if (i & (size_t(1) << b))
+				reversed |= 1u << (bits - 1 - b);
+		}
+		bitReverse[i] = reversed;
+	}
+}
+
+void FftPlan::transformHalf(std::complex<float> *data, bool inverse) const
+{
+	const size_t half = n / 2;
+
+	for (size_t i = 0; i < half; i++) {
+		const size_t j = bitReverse[i];
+		if (j > i)
+			std::swap(data[i], data[j]);
+	}
+
+	const float sign = inverse ? -1.0f : 1.0f;
+	for (size_t len = 2; len <= half; len <<= 1) {
+		const size_t mid = len / 2;
+		// Twiddle for index j at this stage is exp(-2*pi*i*j/len)
+		const std::complex<float> *stage = stageTwiddles.data() + (mid - 1);
+		for (size_t start = 0; start < half; start += len) {
+			for (size_t j = 0; j < mid; j++) {
+				const std::complex<float> w(stage[j].real(), sign * stage[j].imag());
+				const std::complex<float> a = data[start + j];
+				const std::complex<float> b = multiply(data[start + j + mid], w);
+				data[start + j] = a + b;
+				data[start + j + mid] = a - b;
+			}
+		}
+	}
+}
+
+void FftPlan::forwardReal(const float *in, std::complex<float> *out, std::complex<float> *scratch) const
+{
+	const size_t half = n / 2;
+
+	// Pack even/odd samples into one half-length complex sequence
+	for (size_t k = 0; k < half; k++)
+		scratch[k] = std::complex<float>(in[2 * k], in[2 * k + 1]);
+
+	transformHalf(scratch, false);
+
+	out[0] = std::complex<float>(scratch[0].real() + scratch[0].imag(), 0.0f);
+	out[half] = std::complex<float>(scratch[0].real() - scratch[0].imag(), 0.0f);
+
+	const std::complex<float> minusHalfI(0.0f, -0.5f);
+	for (size_t k = 1; k < half; k++) {
+		const std::complex<float> zk = scratch[k];
+		const std::complex<float> zc = std::conj(scratch[half - k]);
+		const std::complex<float> even = 0.5f * (zk + zc);
+		const std::complex<float> odd = multiply(minusHalfI, zk - zc);
+		out[k] = even + multiply(twiddles[k], odd);
+	}
+}
+
+void FftPlan::inverseReal(const std::complex<float> *in, float *out, std::complex<float> *scratch) const
+{
+	const size_t half = n / 2;
+	for (size_t k = 0; k < half; k++) {
+		const std::complex<float> xk = in[k];
+		const std::complex<float> xc = std::conj(in[half - k]);
+		const std::complex<float> even = xk + xc;
+		const std::complex<float> odd = multiply(xk - xc, std::conj(twiddles[k]));
+		scratch[k] = even + std::complex<float>(-odd.imag(), odd.real());
+	}
+
+	transformHalf(scratch, true);
+
+	for (size_t k = 0; k < half; k++) {
+		out[2 * k] = scratch[k].real();
+		out[2 * k + 1] = scratch[k].imag();
+	}
+}
@@ -0,0 +1,46 @@
+/*
+ * FFT - Radix-2 real/complex transforms with precomputed plans
+ * Copyright (C) 2025
+ */
+
+#ifndef FFT_HPP
+#define FFT_HPP
+
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+class FftPlan {
+public:
+	// size must be a power of two, at least 4
+	explicit FftPlan(size_t size);
+
+	size_t size() const { return n; }
+	size_t bins() const { return n / 2 + 1; }
+
+	// Real forward transform: in holds size() samples, out receives bins()
+	// values. scratch must hold size() / 2 values.
+	void forwardReal(const float *in, std::complex<float> *out, std::complex<float> *scratch) const;
+
+	// Inverse of forwardReal, unnormalised (output is scaled by size()).
+	// scratch must hold size() / 2 values.
+	void inverseReal(const std::complex<float> *in, float *out, std::complex<float> *scratch) const;
+
+	static bool isPowerOfTwo(size_t value) { return value >= 2 && (value & (value - 1)) == 0; }
+	static size_t nextPowerOfTwo(size_t value);
+
+private:
+	// In-place complex transform of length size() / 2
+	void transformHalf(std::complex<float> *data, bool inverse) const;
+
+	size_t n;
+	// exp(-2*pi*i*k/n) for k in [0, n/2); the half-length transform
+	// uses every second entry.
+	std::vector<std::complex<float>> twiddles;
+	// The same twiddles laid out per butterfly stage so each stage reads
+	// them contiguously: the stage with half-width m starts at m - 1.
+	std::vector<std::complex<float>> stageTwiddles;
+	std::vector<uint32_t> bitReverse;
+};
+
+#endif // FFT_HPP
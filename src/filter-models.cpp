@@ -0,0 +1,287 @@
+/*
+ * Filter Models Implementation
+ * Copyright (C) 2025
+ */
+
+#include "filter-models.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+static constexpr double PI = 3.14159265358979323846;
+
+static inline float dbToMul(float db)
+{
+	return std::isfinite(db) ? std::pow(10.0f, db / 20.0f) : 0.0f;
+}
+
+static inline float mulToDb(float mul)
+{
+	return mul > 0.0f ? 20.0f * std::log10(mul) : -INFINITY;
+}
+
+static inline float gainCoefficient(uint32_t sampleRate, float seconds)
+{
+	return static_cast<float>(std::exp(-1.0 / (static_cast<double>(sampleRate) * seconds)));
+}
+
+void GainModel::configure(float db)
+{
+	mul = dbToMul(db);
+}
+
+void GainModel::process(float *samples, size_t count) const
+{
+	for (size_t i = 0; i < count; i++)
+		samples[i] *= mul;
+}
+
+void NoiseGateModel::configure(uint32_t sampleRate, float openDb, float closeDb, int attackMs, int holdMs,
+			       int releaseMs)
+{
+	const float rate = static_cast<float>(sampleRate);
+	sampleRateInv = 1.0f / rate;
+	openThreshold = dbToMul(openDb);
+	closeThreshold = dbToMul(closeDb);
+	attackRate = 1.0f / (static_cast<float>(attackMs) / 1000.0f * rate);
+	releaseRate = 1.0f / (static_cast<float>(releaseMs) / 1000.0f * rate);
+	holdTime = static_cast<float>(holdMs) / 1000.0f;
+
+	// The detector may fall from open to close threshold in 1/75 s at most
+	const float minDecayPeriod = (1.0f / 75.0f) * rate;
+	decayRate = (openThreshold - closeThreshold) / minDecayPeriod;
+}
+
+void NoiseGateModel::reset()
+{
+	open = false;
+	gain = 0.0f;
+	level = 0.0f;
+	heldTime = 0.0f;
+	changes = 0;
+}
+
+void NoiseGateModel::process(float *samples, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		const float current = std::fabs(samples[i]);
+
+		if (current > openThreshold && !open) {
+			open = true;
+			changes++;
+		}
+		if (level < closeThreshold && open) {
+			heldTime = 0.0f;
+			open = false;
+			changes++;
+		}
+
+		level = std::max(level, current) - decayRate;
+
+		if (open) {
+			gain = std::min(1.0f, gain + attackRate);
+		} else {
+			heldTime += sampleRateInv;
+			if (heldTime > holdTime)
+				gain = std::max(0.0f, gain - releaseRate);
+		}
+
+		samples[i] *= gain;
+	}
+}
+
+void CompressorModel::configure(uint32_t sampleRate, float ratio, float thresholdDb, float attackMs, float releaseMs,
+				float outputGainDb)
+{
+	attackGain = gainCoefficient(sampleRate, attackMs / 1000.0f);
+	releaseGain = gainCoefficient(sampleRate, releaseMs / 1000.0f);
+	threshold = thresholdDb;
+	slope = 1.0f - (1.0f / std::max(ratio, 1.0f));
+	outputGain = dbToMul(outputGainDb);
+}
+
+void CompressorModel::configureLimiter(uint32_t sampleRate, float thresholdDb, float releaseMs)
+{
+	// limiter_filter uses a fixed 1 ms attack and an infinite ratio
+	attackGain = gainCoefficient(sampleRate, 0.001f);
+	releaseGain = gainCoefficient(sampleRate, releaseMs / 1000.0f);
+	threshold = thresholdDb;
+	slope = 1.0f;
+	outputGain = 1.0f;
+}
+
+void CompressorModel::process(float *samples, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		const float in = std::fabs(samples[i]);
+		const float coeff = envelope < in ? attackGain : releaseGain;
+		envelope = in + coeff * (envelope - in);
+
+		const float gainDb = std::min(0.0f, slope * (threshold - mulToDb(envelope)));
+		lastGain = gainDb;
+		samples[i] *= dbToMul(gainDb) * outputGain;
+	}
+}
+
+void ExpanderModel::configure(uint32_t sampleRate, float ratio, float thresholdDb, float attackMs, float releaseMs)
+{
+	// 10 ms RMS window as in expander_filter's RMS detector
+	rmsCoeff = static_cast<float>(std::exp2(-100.0 / static_cast<double>(sampleRate)));
+	attackGain = gainCoefficient(sampleRate, attackMs / 1000.0f);
+	releaseGain = gainCoefficient(sampleRate, releaseMs / 1000.0f);
+	threshold = thresholdDb;
+	slope = 1.0f - ratio;
+}
+
+void ExpanderModel::reset()
+{
+	runningMeanSquare = 0.0f;
+	envelopeDb = -100.0f;
+}
+
+void ExpanderModel::process(float *samples, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		const float x = samples[i];
+		runningMeanSquare = rmsCoeff * runningMeanSquare + (1.0f - rmsCoeff) * x * x;
+		const float levelDb = std::max(mulToDb(std::sqrt(runningMeanSquare)), -100.0f);
+
+		const float coeff = envelopeDb < levelDb ? attackGain : releaseGain;
+		envelopeDb = levelDb + coeff * (envelopeDb - levelDb);
+
+		const float diff = threshold - envelopeDb;
+		const float gainDb = diff > 0.0f ? std::max(slope * diff, -60.0f) : 0.0f;
+		samples[i] *= dbToMul(gainDb);
+	}
+}
+
+void BasicEqModel::configure(uint32_t sampleRate, float lowDb, float midDb, float highDb)
+{
+	const double rate = static_cast<double>(sampleRate);
+	lf = static_cast<float>(2.0 * std::sin(PI * 800.0 / rate));
+	hf = static_cast<float>(2.0 * std::sin(PI * 5000.0 / rate));
+	lowGain = dbToMul(lowDb);
+	midGain = dbToMul(midDb);
+	highGain = dbToMul(highDb);
+}
+
+void BasicEqModel::reset()
+{
+	std::fill(std::begin(f1), std::end(f1), 0.0f);
+	std::fill(std::begin(f2), std::end(f2), 0.0f);
+	std::fill(std::begin(sdm), std::end(sdm), 0.0f);
+}
+
+void BasicEqModel::process(float *samples, size_t count)
+{
+	// Tiny offset keeps the poles out of the denormal range
+	const float vsa = 1.0f / 4294967295.0f;
+
+	for (size_t i = 0; i < count; i++) {
+		const float sample = samples[i];
+
+		f1[0] += lf * (sample - f1[0]) + vsa;
+		f1[1] += lf * (f1[0] - f1[1]);
+		f1[2] += lf * (f1[1] - f1[2]);
+		f1[3] += lf * (f1[2] - f1[3]);
+		const float l = f1[3];
+
+		f2[0] += hf * (sample - f2[0]) + vsa;
+		f2[1] += hf * (f2[0] - f2[1]);
+		f2[2] += hf * (f2[1] - f2[2]);
+		f2[3] += hf * (f2[2] - f2[3]);
+		const float h = sdm[2] - f2[3];
+		const float m = sdm[2] - (h + l);
+
+		sdm[2] = sdm[1];
+		sdm[1] = sdm[0];
+		sdm[0] = sample;
+
+		samples[i] = l * lowGain + m * midGain + h * highGain;
+	}
+}
+
+void VoiceEqModel::configure(uint32_t sampleRate, float highPassHz, const VoiceEqBand *bands, int count)
+{
+	highPassActive = highPassHz >= 10.0f;
+	if (highPassActive)
+		highPass = BiquadCoeffs::highPass(sampleRate, highPassHz, 0.7071);
+	bandCount = std::max(0, std::min(count, VoiceEqBand::MAX_BANDS));
+	for (int b = 0; b < bandCount; b++)
+		coeffs[b] = BiquadCoeffs::peaking(sampleRate, bands[b].hz, bands[b].q, bands[b].gainDb);
+	reset();
+}
+
+void VoiceEqModel::reset()
+{
+	highPassState.reset();
+	for (BiquadState &section : state)
+		section.reset();
+}
+
+void VoiceEqModel::process(float *samples, size_t count)
+{
+	if (highPassActive) {
+		for (size_t i = 0; i < count; i++)
+			samples[i] = highPassState.process(highPass, samples[i]);
+	}
+	for (int b = 0; b < bandCount; b++) {
+		for (size_t i = 0; i < count; i++)
+			samples[i] = state[b].process(coeffs[b], samples[i]);
+	}
+}
+
+ChainModel::ChainModel(const CalibrationChain &chain, uint32_t sampleRate) : chain(chain)
+{
+	gate.configure(sampleRate, chain.gateOpenDb, chain.gateCloseDb, chain.gateAttackMs, chain.gateHoldMs,
+		       chain.gateReleaseMs);
+	expander.configure(sampleRate, chain.expanderRatio, chain.expanderThresholdDb,
+			   static_cast<float>(chain.expanderAttackMs), static_cast<float>(chain.expanderReleaseMs));
+	voiceEq.configure(sampleRate, chain.highPassHz, chain.options.voiceEqBands,
+			  chain.options.voiceEq ? chain.options.voiceEqBandCount : 0);
+	gain.configure(chain.gainDb);
+	compressor.configure(sampleRate, chain.compressorRatio, chain.compressorThresholdDb,
+			     static_cast<float>(chain.compressorAttackMs), static_cast<float>(chain.compressorReleaseMs),
+			     0.0f);
+	MultibandSettings bands;
+	std::copy(std::begin(chain.multibandBands), std::end(chain.multibandBands), bands.bands);
+	multiband.configure(sampleRate, 1, bands);
+	limiter.configureLimiter(sampleRate, chain.limiterThresholdDb, static_cast<float>(chain.limiterReleaseMs));
+	eq.configure(sampleRate, chain.eqLowDb, chain.eqMidDb, chain.eqHighDb);
+}
+
+void ChainModel::reset()
+{
+	gate.reset();
+	expander.reset();
+	voiceEq.reset();
+	compressor.reset();
+	multiband.reset();
+	limiter.reset();
+	eq.reset();
+}
+
+void ChainModel::process(float *samples, size_t count)
+{
+	const ChainOptions &options = chain.options;
+
+	if (options.noiseGate)
+		gate.process(samples, count);
+	if (options.expander)
+		expander.process(samples, count);
+	if (chain.hasVoiceEq())
+		voiceEq.process(samples, count);
+	if (options.gain)
+		gain.process(samples, count);
+	if (options.multiband) {
+		float *planes[1] = {samples};
+		multiband.process(planes, count);
+	} else if (options.compressor) {
+		compressor.process(samples, count);
+	}
+	if (options.limiter)
+		limiter.process(samples, count);
+	if (chain.hasEq())
+		eq.process(samples, count);
+}
@@ -0,0 +1,160 @@
+/*
+ * Filter Models - Native re-implementations of the stock OBS audio filters
+ * Copyright (C) 2025
+ *
+ * These follow the per-sample math of obs-filters (gain, noise gate,
+ * expander, compressor, limiter, 3-band EQ) closely enough to preview a
+ * proposed chain offline, alongside the plugin's own voice EQ and
+ * multiband compressor. Noise suppression (RNNoise/Speex) and VST are not modelled.
+ */
+
+#ifndef FILTER_MODELS_HPP
+#define FILTER_MODELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "biquad.hpp"
+#include "calibration-chain.hpp"
+#include "multiband-compressor.hpp"
+
+class GainModel {
+public:
+	void configure(float db);
+	void process(float *samples, size_t count) const;
+
+private:
+	float mul = 1.0f;
+};
+
+// noise_gate_filter: peak level with linear decay, open/close hysteresis,
+// hold, and linear attack/release of the applied attenuation
+class NoiseGateModel {
+public:
+	void configure(uint32_t sampleRate, float openDb, float closeDb, int attackMs, int holdMs, int releaseMs);
+	void reset();
+	void process(float *samples, size_t count);
+
+	bool isOpen() const { return open; }
+	float attenuation() const { return gain; }
+
+	// Opens plus closes since the last reset
+	uint64_t transitions() const { return changes; }
+
+private:
+	float sampleRateInv = 1.0f / 48000.0f;
+	float openThreshold = 0.01f;
+	float closeThreshold = 0.005f;
+	float attackRate = 0.0f;
+	float releaseRate = 0.0f;
+	float decayRate = 0.0f;
+	float holdTime = 0.2f;
+
+	bool open = false;
+	float gain = 0.0f;
+	float level = 0.0f;
+	float heldTime = 0.0f;
+	uint64_t changes = 0;
+};
+
+// compressor_filter / limiter_filter: peak envelope with exponential
+// attack/release, static curve applied per sample
+class CompressorModel {
+public:
+	void configure(uint32_t sampleRate, float ratio, float thresholdDb, float attackMs, float releaseMs,
+		       float outputGainDb);
+	void configureLimiter(uint32_t sampleRate, float thresholdDb, float releaseMs);
+	void reset() { envelope = 0.0f; }
+	void process(float *samples, size_t count);
+
+	// Gain reduction applied to the last processed sample (dB, <= 0)
+	float lastGainDb() const { return lastGain; }
+
+private:
+	float attackGain = 0.0f;
+	float releaseGain = 0.0f;
+	float threshold = -18.0f;
+	float slope = 0.75f;
+	float outputGain = 1.0f;
+	float envelope = 0.0f;
+	float lastGain = 0.0f;
+};
+
+// expander_filter with the RMS detector
+class ExpanderModel {
+public:
+	void configure(uint32_t sampleRate, float ratio, float thresholdDb, float attackMs, float releaseMs);
+	void reset();
+	void process(float *samples, size_t count);
+
+private:
+	float rmsCoeff = 0.0f;
+	float attackGain = 0.0f;
+	float releaseGain = 0.0f;
+	float threshold = -40.0f;
+	float slope = -1.0f;
+	float runningMeanSquare = 0.0f;
+	float envelopeDb = -100.0f;
+};
+
+// basic_eq_filter: 800 Hz / 5 kHz 4-pole crossovers
+class BasicEqModel {
+public:
+	void configure(uint32_t sampleRate, float lowDb, float midDb, float highDb);
+	void reset();
+	void process(float *samples, size_t count);
+
+private:
+	float lf = 0.0f;
+	float hf = 0.0f;
+	float lowGain = 1.0f;
+	float midGain = 1.0f;
+	float highGain = 1.0f;
+	float f1[4] = {};
+	float f2[4] = {};
+	float sdm[3] = {};
+};
+
+// audio_calibrator_voice_eq: the same sections as the native filter
+class VoiceEqModel {
+public:
+	void configure(uint32_t sampleRate, float highPassHz, const VoiceEqBand *bands, int count);
+	void reset();
+	void process(float *samples, size_t count);
+
+private:
+	BiquadCoeffs highPass;
+	BiquadState highPassState;
+	bool highPassActive = false;
+	BiquadCoeffs coeffs[VoiceEqBand::MAX_BANDS];
+	BiquadState state[VoiceEqBand::MAX_BANDS];
+	int bandCount = 0;
+};
+
+// The stages of ChainSettings that are modelled, in chain order: gate,
+// expander, voice EQ, gain, multiband or broadband compressor, limiter,
+// 3-band EQ. Noise suppression, howl guard and breath filter (ahead of the
+// gate) and VST (last) are passed over.
+class ChainModel {
+public:
+	ChainModel(const CalibrationChain &chain, uint32_t sampleRate);
+
+	void reset();
+	void process(float *samples, size_t count);
+
+	const NoiseGateModel &noiseGate() const { return gate; }
+	const CompressorModel &compressorStage() const { return compressor; }
+
+private:
+	CalibrationChain chain;
+	NoiseGateModel gate;
+	ExpanderModel expander;
+	VoiceEqModel voiceEq;
+	GainModel gain;
+	CompressorModel compressor;
+	MultibandCompressor multiband;
+	CompressorModel limiter;
+	BasicEqModel eq;
+};
+
+#endif // FILTER_MODELS_HPP
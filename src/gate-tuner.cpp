@@ -0,0 +1,254 @@
+/*
+ * Gate Tuner Implementation
+ * Copyright (C) 2025
+ */
+
+#include "gate-tuner.hpp"
+#include "filter-models.hpp"
+#include "worker-pool.hpp"
+
+#include <util/platform.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+// Close thresholds tried below each open threshold (0 = derived spacing)
+static const float HYSTERESIS_DB[] = {0.0f, 4.0f, 8.0f, 12.0f};
+
+// The whisper step (index 1) is not simulated
+static constexpr int NOISE_STEP = 0;
+static constexpr int FIRST_VOICE_STEP = 2;
+
+enum FrameLabel : uint8_t { FRAME_IGNORED, FRAME_NOISE, FRAME_VOICE };
+
+std::string GateTuning::summary() const
+{
+	auto describe = [](const GateBehaviour &gate) {
+		char text[160];
+		snprintf(text, sizeof(text), "open %.1f / close %.1f dB: %.1f changes/s, %.1f%% voice cut, %.1f%% noise passed",
+			 gate.openDb, gate.closeDb, gate.transitionsPerSecond, gate.cutPercent, gate.leakPercent);
+		return std::string(text);
+	};
+
+	char text[512];
+	snprintf(text, sizeof(text), "derived %s; %s %s (%s); %d candidates x %.1f s in %.0f ms (%.0fx realtime)",
+		 describe(derived).c_str(), changed() ? "tuned" : "kept", describe(tuned).c_str(),
+		 met ? "targets met" : "targets not reachable", candidates, audioSeconds, elapsedMs,
+		 elapsedMs > 0.0 ? audioSeconds * candidates * 1000.0 / elapsedMs : 0.0);
+	return text;
+}
+
+namespace {
+
+struct Candidate {
+	float offsetDb = 0.0f;
+	float hysteresisDb = 0.0f;
+};
+
+// Shared by the chunks of one run
+struct TuningJob {
+	CapturedAudioPtr clips[GateTuner::STEPS];
+	std::vector<uint8_t> labels[GateTuner::STEPS]; // per frame
+	float levels[GateTuner::STEPS] = {};
+	float peaks[GateTuner::STEPS] = {};
+	ChainOptions options;
+	int voiceFrames = 0;
+	int noiseFrames = 0;
+	double audioSeconds = 0.0;
+	uint64_t startNs = 0;
+
+	std::vector<Candidate> candidates;   // the derived thresholds first
+	std::vector<GateBehaviour> behaviour; // per candidate; chunks write disjoint ranges
+	GateTuner::Callback done;
+
+	static size_t frameLength(const CapturedAudio &clip)
+	{
+		return std::max<size_t>(1, static_cast<size_t>(clip.sampleRate * GateTuner::FRAME_MS / 1000.0f));
+	}
+
+	void label();
+	GateBehaviour simulate(const Candidate &candidate) const;
+	void runChunk(size_t first, size_t last);
+	void finish();
+};
+
+} // namespace
+
+void TuningJob::label()
+{
+	const double voiceMeanSquare = std::pow(10.0, (levels[NOISE_STEP] + GateTuner::VOICED_MARGIN_DB) / 10.0);
+	for (int s = 0; s < GateTuner::STEPS; s++) {
+		const CapturedAudioPtr &clip = clips[s];
+		if (!clip)
+			continue;
+
+		const size_t length = frameLength(*clip);
+		for (size_t pos = 0; pos + length <= clip->samples.size(); pos += length) {
+			uint8_t label = FRAME_NOISE;
+			if (s != NOISE_STEP) {
+				double sum = 0.0;
+				for (size_t i = pos; i < pos + length; i++)
+					sum += static_cast<double>(clip->samples[i]) * clip->samples[i];
+				label = sum / static_cast<double>(length) >= voiceMeanSquare ? FRAME_VOICE : FRAME_IGNORED;
+			}
+			labels[s].push_back(label);
+			if (label == FRAME_VOICE)
+				voiceFrames++;
+			else if (label == FRAME_NOISE)
+				noiseFrames++;
+		}
+		audioSeconds += clip->seconds();
+	}
+}
+
+GateBehaviour TuningJob::simulate(const Candidate &candidate) const
+{
+	ChainOptions tried = options;
+	tried.gateOffsetDb = candidate.offsetDb;
+	tried.gateHysteresisDb = candidate.hysteresisDb;
+	const CalibrationChain chain = CalibrationChain::derive(levels, peaks, tried);
+
+	GateBehaviour result;
+	result.openDb = chain.gateOpenDb;
+	result.closeDb = chain.gateCloseDb;
+	result.offsetDb = candidate.offsetDb;
+	result.hysteresisDb = candidate.hysteresisDb;
+
+	uint64_t transitions = 0;
+	int cut = 0;
+	int leaked = 0;
+	std::vector<float> frame;
+	for (int s = 0; s < GateTuner::STEPS; s++) {
+		const CapturedAudioPtr &clip = clips[s];
+		if (!clip)
+			continue;
+
+		// Each step was a separate take, so the gate starts closed
+		NoiseGateModel gate;
+		gate.configure(clip->sampleRate, chain.gateOpenDb, chain.gateCloseDb, chain.gateAttackMs,
+			       chain.gateHoldMs, chain.gateReleaseMs);
+		const size_t length = frameLength(*clip);
+		frame.resize(length);
+		for (size_t f = 0; f < labels[s].size(); f++) {
+			const float *input = clip->samples.data() + f * length;
+			std::copy(input, input + length, frame.begin());
+			gate.process(frame.data(), length);
+			if (labels[s][f] == FRAME_IGNORED)
+				continue;
+
+			double in = 0.0;
+			double out = 0.0;
+			for (size_t i = 0; i < length; i++) {
+				in += static_cast<double>(input[i]) * input[i];
+				out += static_cast<double>(frame[i]) * frame[i];
+			}
+			const bool passed = in > 0.0 && out >= GateTuner::PASS_RATIO * in;
+			if (labels[s][f] == FRAME_VOICE && !passed)
+				cut++;
+			else if (labels[s][f] == FRAME_NOISE && passed)
+				leaked++;
+		}
+		transitions += gate.transitions();
+	}
+
+	result.transitionsPerSecond = audioSeconds > 0.0 ? static_cast<double>(transitions) / audioSeconds : 0.0;
+	result.cutPercent = voiceFrames > 0 ? 100.0 * cut / voiceFrames : 0.0;
+	result.leakPercent = noiseFrames > 0 ? 100.0 * leaked / noiseFrames : 0.0;
+	result.valid = true;
+	return result;
+}
+
+void TuningJob::runChunk(size_t first, size_t last)
+{
+	for (size_t c = first; c < last; c++)
+		behaviour[c] = simulate(candidates[c]);
+}
+
+void TuningJob::finish()
+{
+	auto meets = [](const GateBehaviour &gate) {
+		return gate.cutPercent <= GateTuner::TARGET_CUT_PERCENT &&
+		       gate.leakPercent <= GateTuner::TARGET_LEAK_PERCENT;
+	};
+
+	// Nearest to the derived thresholds among those accepted, then fewest
+	// transitions; lower is better for the fallback measures
+	auto pick = [this](auto accept, auto measure) {
+		const GateBehaviour *best = nullptr;
+		for (const GateBehaviour &gate : behaviour) {
+			if (!accept(gate))
+				continue;
+			if (!best || measure(gate) < measure(*best) ||
+			    (measure(gate) == measure(*best) && gate.transitionsPerSecond < best->transitionsPerSecond))
+				best = &gate;
+		}
+		return best;
+	};
+	auto distance = [](const GateBehaviour &gate) { return std::fabs(gate.offsetDb); };
+
+	GateTuning result;
+	result.derived = behaviour.front();
+	result.tuned = result.derived;
+	result.met = meets(result.derived);
+	if (!result.met) {
+		// Cutting words is worse than letting some noise through, so if
+		// both targets cannot be met the voice target is kept first
+		const GateBehaviour *best = pick(meets, distance);
+		result.met = best != nullptr;
+		if (!best) {
+			best = pick([](const GateBehaviour &gate) { return gate.cutPercent <= GateTuner::TARGET_CUT_PERCENT; },
+				    [](const GateBehaviour &gate) { return gate.leakPercent; });
+		}
+		if (!best) {
+			best = pick([](const GateBehaviour &) { return true; },
+				    [](const GateBehaviour &gate) { return gate.cutPercent; });
+		}
+		result.tuned = *best;
+	}
+
+	result.candidates = static_cast<int>(candidates.size());
+	result.voiceFrames = voiceFrames;
+	result.noiseFrames = noiseFrames;
+	result.audioSeconds = audioSeconds;
+	result.elapsedMs = static_cast<double>(os_gettime_ns() - startNs) / 1e6;
+	done(result);
+}
+
+bool GateTuner::start(const CapturedAudioPtr (&clips)[STEPS], const float *levels, const float *peaks,
+		      const CalibrationChain &chain, Callback done)
+{
+	auto usable = [](const CapturedAudioPtr &clip) { return clip && clip->sampleRate > 0 && !clip->samples.empty(); };
+	if (!usable(clips[NOISE_STEP]) || std::none_of(clips + FIRST_VOICE_STEP, clips + STEPS, usable))
+		return false;
+
+	auto job = std::make_shared<TuningJob>();
+	for (int s = 0; s < STEPS; s++) {
+		if (usable(clips[s]) && (s == NOISE_STEP || s >= FIRST_VOICE_STEP))
+			job->clips[s] = clips[s];
+	}
+	std::copy(levels, levels + STEPS, job->levels);
+	std::copy(peaks, peaks + STEPS, job->peaks);
+	job->options = chain.options;
+	job->done = std::move(done);
+	job->startNs = os_gettime_ns();
+
+	job->candidates.push_back(Candidate());
+	const float lowest = chain.options.hasClicks() ? 0.0f : -SEARCH_DB;
+	for (float hysteresis : HYSTERESIS_DB) {
+		for (float offset = lowest; offset <= SEARCH_DB; offset += SEARCH_STEP_DB) {
+			if (offset != 0.0f || hysteresis != 0.0f)
+				job->candidates.push_back({offset, hysteresis});
+		}
+	}
+	job->behaviour.resize(job->candidates.size());
+
+	return WorkerPool::shared().submit([job]() {
+		job->label();
+		WorkerPool::shared().parallelChunks(
+			job->candidates.size(), [job](size_t, size_t first, size_t last) { job->runChunk(first, last); },
+			[job]() { job->finish(); });
+	});
+}
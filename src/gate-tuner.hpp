@@ -0,0 +1,84 @@
+/*
+ * Gate Tuner - Chatter and false triggers of the derived noise gate
+ * Copyright (C) 2025
+ *
+ * The captured steps are run through NoiseGateModel, which follows the
+ * noise_gate_filter state machine sample by sample (peak detector with
+ * linear decay, open/close hysteresis, attack, hold, release). Every
+ * 10 ms frame is labelled from its input level: all of step 1 is room
+ * noise, and frames of steps 3-8 standing VOICED_MARGIN_DB above the step 1
+ * level are voice (the whisper step is left out, as the derivation does
+ * not aim the gate at it). A frame counts as passed when the gate keeps at
+ * least half of its energy.
+ *
+ * The thresholds are then searched as offsets and hysteresis applied by
+ * CalibrationChain::derive, so what is simulated is exactly what Apply
+ * creates. Candidates are split into one chunk per worker thread and the
+ * last chunk to finish picks: the derived thresholds if they already meet
+ * both targets, else the feasible candidate nearest to them (fewest
+ * transitions on a tie). If none is feasible the voice target wins: the
+ * least noise among candidates within it, else the least voice cut.
+ * Noise suppression runs before the gate live but is not modelled, so
+ * the noise figures are pessimistic with it enabled.
+ */
+
+#ifndef GATE_TUNER_HPP
+#define GATE_TUNER_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "audio-analyzer.hpp"
+#include "calibration-chain.hpp"
+
+// The gate over the captured steps with one pair of thresholds
+struct GateBehaviour {
+	float openDb = 0.0f;
+	float closeDb = 0.0f;
+	float offsetDb = 0.0f;     // as ChainOptions::gateOffsetDb
+	float hysteresisDb = 0.0f; // as ChainOptions::gateHysteresisDb
+	double transitionsPerSecond = 0.0;
+	double cutPercent = 0.0;  // voice frames attenuated
+	double leakPercent = 0.0; // noise frames passed
+	bool valid = false;
+};
+
+struct GateTuning {
+	GateBehaviour derived; // thresholds as derived
+	GateBehaviour tuned;   // the pick (same as derived if it met the targets)
+	bool met = false;      // tuned meets both targets
+	int candidates = 0;
+	int voiceFrames = 0;
+	int noiseFrames = 0;
+	double audioSeconds = 0.0; // simulated per candidate
+	double elapsedMs = 0.0;
+
+	bool changed() const { return tuned.offsetDb != 0.0f || tuned.hysteresisDb != 0.0f; }
+	std::string summary() const;
+};
+
+class GateTuner {
+public:
+	static constexpr int STEPS = 8;
+	static constexpr float FRAME_MS = 10.0f;
+	static constexpr float VOICED_MARGIN_DB = 10.0f;
+	static constexpr float PASS_RATIO = 0.5f; // of the frame's energy
+	static constexpr double TARGET_CUT_PERCENT = 2.0;
+	static constexpr double TARGET_LEAK_PERCENT = 1.0;
+	static constexpr float SEARCH_DB = 12.0f; // offsets either side of the derived open threshold
+	static constexpr float SEARCH_STEP_DB = 1.0f;
+
+	using Callback = std::function<void(const GateTuning &)>;
+
+	// chain gives the options and timing to tune (its gate offsets are
+	// ignored); levels/peaks are the per-step averages derive takes. With
+	// clicks measured the open threshold is not lowered, as the keyboard
+	// test is not among the simulated steps. done is called once, on a
+	// worker thread. Returns false without step 1 and a speaking step, or
+	// if the pool is shut down.
+	static bool start(const CapturedAudioPtr (&clips)[STEPS], const float *levels, const float *peaks,
+			  const CalibrationChain &chain, Callback done);
+};
+
+#endif // GATE_TUNER_HPP
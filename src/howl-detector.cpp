@@ -0,0 +1,318 @@
+/*
+ * Howl Detector Implementation
+ * Copyright (C) 2025
+ */
+
+#include "howl-detector.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+// Analysed range: below 100 Hz is rumble, above 16 kHz rarely feeds back
+static constexpr float MIN_HOWL_HZ = 100.0f;
+static constexpr float MAX_HOWL_HZ = 16000.0f;
+
+// A feedback peak is a single partial: Hann leakage stays within two bins,
+// so three bins out it must have dropped this far
+static constexpr float MIN_NARROWNESS_DB = 10.0f;
+static constexpr float MIN_PEAK_DB = -70.0f;
+
+// Frame-to-frame drop tolerated before growth counts as broken
+static constexpr float GROWTH_TOLERANCE_DB = 1.0f;
+
+// A notch is only deepened this often, so one howl cannot slam it
+static constexpr float DEEPEN_INTERVAL_SECONDS = 0.2f;
+
+HowlDetector::HowlDetector()
+	: input(MAX_FRAME, 0.0f),
+	  windowed(MAX_FRAME, 0.0f),
+	  spectrum(MAX_FRAME / 2 + 1),
+	  scratch(MAX_FRAME / 2),
+	  levelDb(MAX_FRAME / 2 + 1, -120.0f)
+{
+	setSensitivity(0.5f);
+}
+
+void HowlDetector::setSensitivity(float sensitivity)
+{
+	const float s = std::max(0.0f, std::min(sensitivity, 1.0f));
+	minProminenceDb = 25.0f - 15.0f * s;
+	minGrowthDb = 9.0f - 6.0f * s;
+	minFrames = static_cast<int>(std::lround(8.0f - 4.0f * s));
+}
+
+void HowlDetector::reset()
+{
+	filled = 0;
+	for (Track &track : tracks)
+		track = Track();
+}
+
+int HowlDetector::process(const DspTables &tables, const float *samples, size_t count, HowlEvent *events,
+			  int maxEvents)
+{
+	const size_t frameSize = tables.frameSize;
+	if (frameSize > MAX_FRAME || !tables.fft)
+		return 0;
+
+	if (&tables != lastTables) {
+		reset();
+		lastTables = &tables;
+	}
+
+	const size_t hop = frameSize / 2;
+	int found = 0;
+	while (count > 0) {
+		const size_t take = std::min(count, frameSize - filled);
+		std::memcpy(input.data() + filled, samples, take * sizeof(float));
+		filled += take;
+		samples += take;
+		count -= take;
+
+		if (filled < frameSize)
+			break;
+
+		const int frameEvents = analyzeFrame(tables, events + found, maxEvents - found);
+		found += frameEvents;
+
+		std::memmove(input.data(), input.data() + hop, (frameSize - hop) * sizeof(float));
+		filled = frameSize - hop;
+	}
+	return found;
+}
+
+int HowlDetector::analyzeFrame(const DspTables &tables, HowlEvent *events, int maxEvents)
+{
+	const size_t frameSize = tables.frameSize;
+	const size_t bins = tables.fft->bins();
+	const float binHz = tables.binHz();
+
+	for (size_t i = 0; i < frameSize; i++)
+		windowed[i] = input[i] * tables.window[i];
+	tables.fft->forwardReal(windowed.data(), spectrum.data(), scratch.data());
+
+	// A full-scale sine peaks near 0 dB: Hann's coherent gain is N/2, and
+	// the real transform holds half the energy in the positive bin
+	const float norm = 4.0f / static_cast<float>(frameSize);
+	const size_t firstBin = std::max<size_t>(3, static_cast<size_t>(std::ceil(MIN_HOWL_HZ / binHz)));
+	const size_t lastBin = std::min(bins - 4, static_cast<size_t>(MAX_HOWL_HZ / binHz));
+	if (firstBin >= lastBin)
+		return 0;
+
+	double sumDb = 0.0;
+	double totalPower = 0.0;
+	for (size_t k = firstBin - 3; k <= lastBin + 3; k++) {
+		const float magnitude = std::abs(spectrum[k]) * norm;
+		levelDb[k] = magnitude > 1e-6f ? 20.0f * std::log10(magnitude) : -120.0f;
+		if (k >= firstBin && k <= lastBin) {
+			sumDb += levelDb[k];
+			totalPower += static_cast<double>(magnitude) * magnitude;
+		}
+	}
+	const float meanDb = static_cast<float>(sumDb / static_cast<double>(lastBin - firstBin + 1));
+
+	// Strongest narrow, prominent peaks of this frame
+	struct Peak {
+		float bin;
+		float db;
+		float relativeDb; // against everything outside the peak
+	};
+	Peak peaks[MAX_PEAKS_PER_FRAME];
+	int peakCount = 0;
+	for (size_t k = firstBin; k <= lastBin; k++) {
+		const float db = levelDb[k];
+		if (db < MIN_PEAK_DB || db - meanDb < minProminenceDb)
+			continue;
+		if (db <= levelDb[k - 1] || db < levelDb[k + 1])
+			continue;
+		if (db - levelDb[k - 3] < MIN_NARROWNESS_DB || db - levelDb[k + 3] < MIN_NARROWNESS_DB)
+			continue;
+
+		// Parabolic interpolation of the true peak position
+		const float a = levelDb[k - 1];
+		const float c = levelDb[k + 1];
+		const float denom = a - 2.0f * db + c;
+		const float offset = denom < 0.0f ? 0.5f * (a - c) / denom : 0.0f;
+
+		double peakPower = 0.0;
+		for (size_t j = k - 3; j <= k + 3; j++) {
+			const double magnitude = std::pow(10.0, levelDb[j] / 20.0);
+			peakPower += magnitude * magnitude;
+		}
+		const double restPower = std::max(totalPower - peakPower, 1e-12);
+		const float relativeDb = db - static_cast<float>(10.0 * std::log10(restPower));
+
+		const Peak peak = {static_cast<float>(k) + offset, db, relativeDb};
+
+		if (peakCount < MAX_PEAKS_PER_FRAME) {
+			peaks[peakCount++] = peak;
+		} else {
+			Peak *weakest = std::min_element(peaks, peaks + peakCount,
+							 [](const Peak &x, const Peak &y) { return x.db < y.db; });
+			if (weakest->db < peak.db)
+				*weakest = peak;
+		}
+	}
+
+	// Follow peaks from frame to frame
+	bool matched[MAX_TRACKS] = {};
+	for (int p = 0; p < peakCount; p++) {
+		const Peak &peak = peaks[p];
+		int match = -1;
+		for (int t = 0; t < MAX_TRACKS; t++) {
+			if (tracks[t].active && !matched[t] && std::fabs(tracks[t].bin - peak.bin) <= 1.5f) {
+				match = t;
+				break;
+			}
+		}
+
+		if (match < 0) {
+			// Take a free slot, or replace the quietest track
+			match = 0;
+			for (int t = 0; t < MAX_TRACKS; t++) {
+				if (!tracks[t].active) {
+					match = t;
+					break;
+				}
+				if (tracks[t].lastDb < tracks[match].lastDb)
+					match = t;
+			}
+			tracks[match] = Track();
+			tracks[match].active = true;
+			tracks[match].startDb = peak.relativeDb;
+			tracks[match].lastDb = peak.relativeDb;
+		}
+
+		// Growth is measured against the rest of the spectrum, so a voice
+		// getting louder as a whole does not count; a howl does
+		Track &track = tracks[match];
+		matched[match] = true;
+		if (peak.relativeDb < track.lastDb - GROWTH_TOLERANCE_DB) {
+			// Fell back: not feedback, or already notched; start over
+			track.frames = 0;
+			track.startDb = peak.relativeDb;
+		}
+		track.frames++;
+		track.bin = peak.bin;
+		track.lastDb = peak.relativeDb;
+		track.levelDb = peak.db;
+		track.prominenceDb = peak.db - meanDb;
+		track.misses = 0;
+	}
+
+	int found = 0;
+	for (int t = 0; t < MAX_TRACKS; t++) {
+		Track &track = tracks[t];
+		if (!track.active)
+			continue;
+		if (!matched[t]) {
+			if (++track.misses > 1)
+				track.active = false;
+			continue;
+		}
+
+		const float growth = track.lastDb - track.startDb;
+		if (track.frames >= minFrames && growth >= minGrowthDb && found < maxEvents) {
+			HowlEvent &event = events[found++];
+			event.frequencyHz = track.bin * binHz;
+			event.levelDb = track.levelDb;
+			event.prominenceDb = track.prominenceDb;
+			event.growthDb = growth;
+		}
+	}
+	return found;
+}
+
+void NotchBank::reset()
+{
+	for (Notch &notch : notches)
+		notch = Notch();
+}
+
+void NotchBank::design(uint32_t sampleRate, Notch &notch)
+{
+	notch.coeffs = BiquadCoeffs::peaking(sampleRate, notch.frequencyHz, NOTCH_Q, notch.depthDb);
+	notch.designedDepthDb = notch.depthDb;
+}
+
+bool NotchBank::engage(uint32_t sampleRate, float frequencyHz)
+{
+	if (frequencyHz <= 0.0f || frequencyHz >= 0.45f * static_cast<float>(sampleRate))
+		return false;
+
+	// Retune and deepen a notch already near this frequency
+	const float sixthOctave = std::exp2(1.0f / 6.0f);
+	for (Notch &notch : notches) {
+		if (!notch.active)
+			continue;
+		const float ratio = frequencyHz / notch.frequencyHz;
+		if (ratio < sixthOctave && ratio > 1.0f / sixthOctave) {
+			if (notch.holdLeft < HOLD_SECONDS - DEEPEN_INTERVAL_SECONDS) {
+				notch.frequencyHz = frequencyHz;
+				notch.depthDb = std::max(maxDepthDb, std::min(notch.depthDb, INITIAL_DEPTH_DB) + DEPTH_STEP_DB);
+				notch.holdLeft = HOLD_SECONDS;
+				design(sampleRate, notch);
+			}
+			return false;
+		}
+	}
+
+	// Free slot, else the shallowest notch
+	Notch *slot = &notches[0];
+	for (Notch &notch : notches) {
+		if (!notch.active) {
+			slot = &notch;
+			break;
+		}
+		if (notch.depthDb > slot->depthDb)
+			slot = &notch;
+	}
+
+	*slot = Notch();
+	slot->active = true;
+	slot->frequencyHz = frequencyHz;
+	slot->depthDb = std::max(maxDepthDb, INITIAL_DEPTH_DB);
+	slot->holdLeft = HOLD_SECONDS;
+	design(sampleRate, *slot);
+	return true;
+}
+
+void NotchBank::process(uint32_t sampleRate, float **channels, size_t channelCount, size_t frames)
+{
+	const float seconds = static_cast<float>(frames) / static_cast<float>(sampleRate);
+	channelCount = std::min<size_t>(channelCount, MAX_AUDIO_CHANNELS);
+
+	for (Notch &notch : notches) {
+		if (!notch.active)
+			continue;
+
+		// Hold, then relax slowly towards flat
+		notch.holdLeft -= seconds;
+		if (notch.holdLeft <= 0.0f) {
+			notch.depthDb += RELEASE_DB_PER_SECOND * seconds;
+			if (notch.depthDb > -1.0f) {
+				notch = Notch();
+				continue;
+			}
+			if (notch.depthDb - notch.designedDepthDb > 0.25f)
+				design(sampleRate, notch);
+		}
+
+		for (size_t ch = 0; ch < channelCount; ch++) {
+			float *samples = channels[ch];
+			if (!samples)
+				continue;
+			BiquadState &state = notch.state[ch];
+			for (size_t i = 0; i < frames; i++)
+				samples[i] = state.process(notch.coeffs, samples[i]);
+		}
+	}
+}
+
+int NotchBank::activeCount() const
+{
+	return static_cast<int>(std::count_if(std::begin(notches), std::end(notches),
+					      [](const Notch &notch) { return notch.active; }));
+}
@@ -0,0 +1,118 @@
+/*
+ * Howl Detector - Feedback detection and adaptive notch filtering
+ * Copyright (C) 2025
+ *
+ * Feedback shows up as a narrow spectral peak that keeps growing from one
+ * frame to the next, unlike voice harmonics which move and fade. The
+ * detector tracks prominent peaks across half-overlapped FFT frames and
+ * reports those that grow steadily; the notch bank then cuts them with
+ * narrow peaking filters that deepen while the howl persists and relax
+ * once it is gone. Everything is preallocated, so both are safe on the
+ * audio thread.
+ */
+
+#ifndef HOWL_DETECTOR_HPP
+#define HOWL_DETECTOR_HPP
+
+#include <obs.h>
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "biquad.hpp"
+#include "dsp-tables.hpp"
+
+struct HowlEvent {
+	float frequencyHz = 0.0f;
+	float levelDb = 0.0f;      // peak bin level, dBFS
+	float prominenceDb = 0.0f; // above the frame's mean level
+	float growthDb = 0.0f;     // over the rest of the spectrum, since growth began
+};
+
+class HowlDetector {
+public:
+	static constexpr size_t MAX_FRAME = 4096;
+	static constexpr int MAX_TRACKS = 8;
+	static constexpr int MAX_PEAKS_PER_FRAME = 4;
+
+	HowlDetector();
+
+	// Lower sensitivity (0..1) needs more growth and prominence
+	void setSensitivity(float sensitivity);
+	void reset();
+
+	// Feed mono samples; returns the number of howls written to events
+	// (current howls are re-reported every frame while they last)
+	int process(const DspTables &tables, const float *samples, size_t count, HowlEvent *events, int maxEvents);
+
+private:
+	struct Track {
+		bool active = false;
+		float bin = 0.0f;
+		float startDb = 0.0f; // relative level when growth began
+		float lastDb = 0.0f;  // relative level in the last frame
+		float levelDb = 0.0f;
+		float prominenceDb = 0.0f;
+		int frames = 0;
+		int misses = 0;
+	};
+
+	int analyzeFrame(const DspTables &tables, HowlEvent *events, int maxEvents);
+
+	std::vector<float> input; // last frameSize samples, oldest first
+	size_t filled = 0;
+	const DspTables *lastTables = nullptr;
+
+	std::vector<float> windowed;
+	std::vector<std::complex<float>> spectrum;
+	std::vector<std::complex<float>> scratch;
+	std::vector<float> levelDb;
+
+	Track tracks[MAX_TRACKS];
+
+	float minProminenceDb = 15.0f;
+	float minGrowthDb = 6.0f;
+	int minFrames = 6;
+};
+
+class NotchBank {
+public:
+	static constexpr int MAX_NOTCHES = 6;
+	static constexpr float NOTCH_Q = 30.0f;
+	static constexpr float INITIAL_DEPTH_DB = -9.0f;
+	static constexpr float DEPTH_STEP_DB = -3.0f;
+	static constexpr float HOLD_SECONDS = 20.0f;
+	static constexpr float RELEASE_DB_PER_SECOND = 1.0f;
+
+	void setMaxDepth(float db) { maxDepthDb = db; }
+	void reset();
+
+	// Cut at frequencyHz, or deepen and retune an existing notch within a
+	// sixth of an octave. Returns true if a new notch was engaged.
+	bool engage(uint32_t sampleRate, float frequencyHz);
+
+	// In place on planar channels; also runs hold/release timing
+	void process(uint32_t sampleRate, float **channels, size_t channelCount, size_t frames);
+
+	int activeCount() const;
+
+private:
+	struct Notch {
+		bool active = false;
+		float frequencyHz = 0.0f;
+		float depthDb = 0.0f;
+		float designedDepthDb = 0.0f;
+		float holdLeft = 0.0f;
+		BiquadCoeffs coeffs;
+		BiquadState state[MAX_AUDIO_CHANNELS];
+	};
+
+	static void design(uint32_t sampleRate, Notch &notch);
+
+	Notch notches[MAX_NOTCHES];
+	float maxDepthDb = -24.0f;
+};
+
+#endif // HOWL_DETECTOR_HPP
@@ -0,0 +1,205 @@
+/*
+ * Howl Filter Implementation
+ * Copyright (C) 2025
+ *
+ * Detection and notching both run inside filter_audio on the audio thread:
+ * one FFT per half frame plus a few biquads, with nothing allocated after
+ * creation. Settings arrive from the UI thread through atomics, and each
+ * notch engaged goes out through a small lock-free ring that a poller on
+ * the worker pool logs from.
+ */
+
+#include "howl-filter.hpp"
+#include "dsp-tables.hpp"
+#include "howl-detector.hpp"
+#include "worker-pool.hpp"
+
+#include <obs-module.h>
+#include <plugin-support.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+// Engaged notches, posted by the audio thread and logged on the poll thread.
+// Shared with the poller so that it can outlive the filter by one poll.
+struct HowlLog {
+	static constexpr uint32_t SLOTS = 8;
+
+	obs_weak_source_t *filterSource = nullptr;
+	HowlEvent events[SLOTS];
+	std::atomic<uint32_t> written{0};
+	std::atomic<uint32_t> read{0};
+	std::atomic<uint32_t> dropped{0};
+
+	~HowlLog() { obs_weak_source_release(filterSource); }
+
+	// Audio thread
+	void post(const HowlEvent &event)
+	{
+		const uint32_t position = written.load(std::memory_order_relaxed);
+		if (position - read.load(std::memory_order_acquire) >= SLOTS) {
+			dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		events[position % SLOTS] = event;
+		written.store(position + 1, std::memory_order_release);
+	}
+
+	// Poll thread
+	void flush();
+};
+
+void HowlLog::flush()
+{
+	const uint32_t end = written.load(std::memory_order_acquire);
+	uint32_t position = read.load(std::memory_order_relaxed);
+	const uint32_t lost = dropped.exchange(0, std::memory_order_relaxed);
+	if (position == end && lost == 0)
+		return;
+
+	obs_source_t *filter = obs_weak_source_get_source(filterSource);
+	obs_source_t *parent = filter ? obs_filter_get_parent(filter) : nullptr;
+	const char *name = parent ? obs_source_get_name(parent) : nullptr;
+	for (; position != end; position++) {
+		const HowlEvent &event = events[position % SLOTS];
+		obs_log(LOG_INFO, "[HowlGuard] %s: feedback at %.0f Hz (%.1f dBFS, +%.1f dB), notch engaged",
+			name ? name : "(unattached)", event.frequencyHz, event.levelDb, event.growthDb);
+		read.store(position + 1, std::memory_order_release);
+	}
+	if (lost > 0)
+		obs_log(LOG_INFO, "[HowlGuard] %s: %u more notches engaged", name ? name : "(unattached)", lost);
+	obs_source_release(filter);
+}
+
+struct HowlFilter {
+	std::shared_ptr<DspTableHandle> tableHandle;
+	std::shared_ptr<HowlLog> log;
+	int logPoller = 0;
+	HowlDetector detector;
+	NotchBank notches;
+	float mono[AUDIO_OUTPUT_FRAMES] = {};
+
+	std::atomic<float> sensitivity{0.5f};
+	std::atomic<float> maxDepthDb{-24.0f};
+	std::atomic<bool> settingsChanged{true};
+};
+
+static const char *howlFilterName(void *)
+{
+	return "Audio Calibrator Howl Guard";
+}
+
+static void howlFilterUpdate(void *data, obs_data_t *settings)
+{
+	auto *filter = static_cast<HowlFilter *>(data);
+	filter->sensitivity.store(static_cast<float>(obs_data_get_double(settings, "sensitivity")));
+	filter->maxDepthDb.store(static_cast<float>(obs_data_get_double(settings, "max_depth")));
+	filter->settingsChanged.store(true, std::memory_order_release);
+}
+
+static void *howlFilterCreate(obs_data_t *settings, obs_source_t *source)
+{
+	auto *filter = new HowlFilter();
+	filter->tableHandle = DspTableHandle::create(DspConfig::fromAudioOutput());
+	filter->log = std::make_shared<HowlLog>();
+	filter->log->filterSource = obs_source_get_weak_source(source);
+
+	std::weak_ptr<HowlLog> weak = filter->log;
+	filter->logPoller = WorkerPool::shared().addPoller([weak]() {
+		if (std::shared_ptr<HowlLog> log = weak.lock())
+			log->flush();
+	});
+	howlFilterUpdate(filter, settings);
+	return filter;
+}
+
+static void howlFilterDestroy(void *data)
+{
+	auto *filter = static_cast<HowlFilter *>(data);
+	WorkerPool::shared().removePoller(filter->logPoller);
+	delete filter;
+}
+
+static void howlFilterDefaults(obs_data_t *settings)
+{
+	obs_data_set_default_double(settings, "sensitivity", 0.5);
+	obs_data_set_default_double(settings, "max_depth", -24.0);
+}
+
+static obs_properties_t *howlFilterProperties(void *)
+{
+	obs_properties_t *props = obs_properties_create();
+	obs_properties_add_float_slider(props, "sensitivity", "Sensitivity", 0.0, 1.0, 0.05);
+	obs_property_t *depth = obs_properties_add_float_slider(props, "max_depth", "Maximum Notch Depth", -36.0,
+								 -6.0, 1.0);
+	obs_property_float_set_suffix(depth, " dB");
+	return props;
+}
+
+static struct obs_audio_data *howlFilterAudio(void *data, struct obs_audio_data *audio)
+{
+	auto *filter = static_cast<HowlFilter *>(data);
+	const DspConfig config = DspConfig::fromAudioOutput();
+
+	if (filter->settingsChanged.exchange(false, std::memory_order_acquire)) {
+		filter->detector.setSensitivity(filter->sensitivity.load());
+		filter->notches.setMaxDepth(filter->maxDepthDb.load());
+	}
+
+	const size_t channels = std::min<size_t>(config.channels, MAX_AUDIO_CHANNELS);
+	float *planes[MAX_AUDIO_CHANNELS] = {};
+	for (size_t ch = 0; ch < channels; ch++)
+		planes[ch] = reinterpret_cast<float *>(audio->data[ch]);
+
+	// Notch first and detect on the result, so a notch that is not deep
+	// enough shows up as continued growth and gets deepened
+	filter->notches.process(config.sampleRate, planes, channels, audio->frames);
+
+	const DspTables *tables = filter->tableHandle->tablesFor(config);
+	if (!tables)
+		return audio;
+
+	for (size_t pos = 0; pos < audio->frames; pos += AUDIO_OUTPUT_FRAMES) {
+		const size_t count = std::min<size_t>(AUDIO_OUTPUT_FRAMES, audio->frames - pos);
+		size_t used = 0;
+		std::fill(filter->mono, filter->mono + count, 0.0f);
+		for (size_t ch = 0; ch < channels; ch++) {
+			if (!planes[ch])
+				continue;
+			for (size_t i = 0; i < count; i++)
+				filter->mono[i] += planes[ch][pos + i];
+			used++;
+		}
+		if (used > 1) {
+			const float scale = 1.0f / static_cast<float>(used);
+			for (size_t i = 0; i < count; i++)
+				filter->mono[i] *= scale;
+		}
+
+		HowlEvent events[NotchBank::MAX_NOTCHES];
+		const int found =
+			filter->detector.process(*tables, filter->mono, count, events, NotchBank::MAX_NOTCHES);
+		for (int e = 0; e < found; e++) {
+			if (filter->notches.engage(config.sampleRate, events[e].frequencyHz))
+				filter->log->post(events[e]);
+		}
+	}
+	return audio;
+}
+
+void registerHowlFilter()
+{
+	struct obs_source_info info = {};
+	info.id = HOWL_FILTER_ID;
+	info.type = OBS_SOURCE_TYPE_FILTER;
+	info.output_flags = OBS_SOURCE_AUDIO;
+	info.get_name = howlFilterName;
+	info.create = howlFilterCreate;
+	info.destroy = howlFilterDestroy;
+	info.get_defaults = howlFilterDefaults;
+	info.get_properties = howlFilterProperties;
+	info.update = howlFilterUpdate;
+	info.filter_audio = howlFilterAudio;
+	obs_register_source(&info);
+}
@@ -0,0 +1,14 @@
+/*
+ * Howl Filter - Native OBS audio filter that notches detected feedback
+ * Copyright (C) 2025
+ */
+
+#ifndef HOWL_FILTER_HPP
+#define HOWL_FILTER_HPP
+
+static constexpr const char *HOWL_FILTER_ID = "audio_calibrator_howl_guard";
+
+// Registers the filter type with OBS (call from obs_module_load)
+void registerHowlFilter();
+
+#endif // HOWL_FILTER_HPP
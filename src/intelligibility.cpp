@@ -0,0 +1,184 @@
+/*
+ * Intelligibility Implementation
+ * Copyright (C) 2025
+ */
+
+#include "intelligibility.hpp"
+#include "filter-models.hpp"
+#include "voice-spectrum.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+static constexpr double PI = 3.14159265358979323846;
+static constexpr uint32_t MODEL_RATE = 48000;
+static constexpr double TONE_SECONDS = 0.2;
+
+const float SpeechIntelligibility::CENTER_HZ[BANDS] = {160,  200,  250,  315,  400,  500,  630,  800,  1000,
+						       1250, 1600, 2000, 2500, 3150, 4000, 5000, 6300, 8000};
+
+// ANSI S3.5-1997 table 3: band importance (average speech), standard speech
+// spectrum level at normal vocal effort and equivalent internal noise, dB
+static const float IMPORTANCE[SpeechIntelligibility::BANDS] = {
+	0.0083f, 0.0095f, 0.0150f, 0.0289f, 0.0440f, 0.0578f, 0.0653f, 0.0711f, 0.0818f,
+	0.0844f, 0.0882f, 0.0898f, 0.0868f, 0.0844f, 0.0771f, 0.0527f, 0.0364f, 0.0185f};
+static const float NORMAL_SPEECH_DB[SpeechIntelligibility::BANDS] = {
+	32.41f, 34.48f, 34.75f, 33.98f, 34.59f, 34.27f, 32.06f, 28.30f, 25.01f,
+	23.00f, 20.15f, 17.32f, 13.18f, 11.55f, 9.33f,  5.31f,  2.59f,  1.13f};
+static const float INTERNAL_NOISE_DB[SpeechIntelligibility::BANDS] = {
+	0.6f,   -1.7f,  -3.9f,  -6.1f,  -8.2f,  -9.7f,  -10.8f, -11.9f, -12.5f,
+	-13.5f, -15.4f, -17.7f, -21.2f, -24.2f, -25.9f, -23.6f, -15.8f, -7.1f};
+
+// One-third octave bandwidth relative to the centre frequency
+static const double BANDWIDTH = std::pow(2.0, 1.0 / 6.0) - std::pow(2.0, -1.0 / 6.0);
+
+static double toPower(double db)
+{
+	return std::pow(10.0, db / 10.0);
+}
+
+static double toDb(double power)
+{
+	return power > 1e-30 ? 10.0 * std::log10(power) : -300.0;
+}
+
+// Overall level of a set of spectrum levels, dB
+static double overallDb(const float *db)
+{
+	double sum = 0.0;
+	for (int i = 0; i < SpeechIntelligibility::BANDS; i++)
+		sum += toPower(db[i]) * BANDWIDTH * SpeechIntelligibility::CENTER_HZ[i];
+	return toDb(sum);
+}
+
+const char *IntelligibilityEstimate::rating(float sii)
+{
+	if (sii >= 0.75f)
+		return "good";
+	if (sii >= 0.45f)
+		return "fair";
+	return "poor";
+}
+
+IntelligibilityBands SpeechIntelligibility::bands(const LongTermSpectrum &spectrum)
+{
+	IntelligibilityBands result;
+	const std::vector<ResponsePoint> points = spectrum.thirdOctaveBands();
+
+	// The tables use exact base-2 centres; match each nominal one within
+	// a sixth of an octave
+	int found = 0;
+	for (int i = 0; i < BANDS; i++) {
+		for (const ResponsePoint &point : points) {
+			if (std::fabs(std::log2(point.hz / CENTER_HZ[i])) < 1.0 / 6.0) {
+				result.db[i] = point.db;
+				found++;
+				break;
+			}
+		}
+	}
+	result.valid = found == BANDS;
+	return result;
+}
+
+float SpeechIntelligibility::index(const IntelligibilityBands &speech, const IntelligibilityBands &noise, float *loss)
+{
+	if (!speech.valid || !noise.valid)
+		return -1.0f;
+
+	// Place the speech at normal vocal effort; the noise keeps its SNR
+	const double shift = overallDb(NORMAL_SPEECH_DB) - overallDb(speech.db);
+	double e[BANDS];
+	double n[BANDS];
+	for (int i = 0; i < BANDS; i++) {
+		e[i] = speech.db[i] + shift;
+		n[i] = noise.db[i] + shift;
+	}
+
+	// Self-speech masking and the upward spread of masking from lower bands
+	double b[BANDS];
+	double c[BANDS];
+	for (int i = 0; i < BANDS; i++) {
+		b[i] = std::max(n[i], e[i] - 24.0);
+		c[i] = -80.0 + 0.6 * (b[i] + 10.0 * std::log10(BANDWIDTH * CENTER_HZ[i]));
+	}
+
+	double sii = 0.0;
+	for (int i = 0; i < BANDS; i++) {
+		double z = b[i];
+		if (i > 0) {
+			double sum = toPower(n[i]);
+			for (int k = 0; k < i; k++)
+				sum += toPower(b[k] + 3.32 * c[k] * std::log10(0.89 * CENTER_HZ[i] / CENTER_HZ[k]));
+			z = toDb(sum);
+		}
+		const double disturbance = std::max(z, static_cast<double>(INTERNAL_NOISE_DB[i]));
+		const double distortion = std::min(1.0, 1.0 - (e[i] - NORMAL_SPEECH_DB[i] - 10.0) / 160.0);
+		const double audibility = std::clamp((e[i] - disturbance + 15.0) / 30.0, 0.0, 1.0);
+		const double contribution = audibility * distortion;
+		sii += IMPORTANCE[i] * contribution;
+		if (loss)
+			loss[i] = static_cast<float>(IMPORTANCE[i] * (1.0 - contribution));
+	}
+	return static_cast<float>(std::clamp(sii, 0.0, 1.0));
+}
+
+void SpeechIntelligibility::chainGains(const CalibrationChain &chain, float *gainDb)
+{
+	const size_t count = static_cast<size_t>(TONE_SECONDS * MODEL_RATE);
+	std::vector<float> tone(count);
+
+	for (int i = 0; i < BANDS; i++) {
+		const double w = 2.0 * PI * CENTER_HZ[i] / MODEL_RATE;
+		for (size_t n = 0; n < count; n++)
+			tone[n] = static_cast<float>(0.1 * std::sin(w * static_cast<double>(n)));
+
+		if (chain.hasVoiceEq()) {
+			VoiceEqModel voiceEq;
+			voiceEq.configure(MODEL_RATE, chain.highPassHz, chain.options.voiceEqBands,
+					  chain.options.voiceEq ? chain.options.voiceEqBandCount : 0);
+			voiceEq.process(tone.data(), count);
+		}
+		if (chain.hasEq()) {
+			BasicEqModel eq;
+			eq.configure(MODEL_RATE, chain.eqLowDb, chain.eqMidDb, chain.eqHighDb);
+			eq.process(tone.data(), count);
+		}
+
+		// Second half only, once the filters have settled
+		double sum = 0.0;
+		for (size_t n = count / 2; n < count; n++)
+			sum += static_cast<double>(tone[n]) * tone[n];
+		const double rms = std::sqrt(sum / static_cast<double>(count - count / 2));
+		gainDb[i] = static_cast<float>(20.0 * std::log10(std::max(rms, 1e-12) / (0.1 / std::sqrt(2.0))));
+	}
+}
+
+IntelligibilityEstimate SpeechIntelligibility::estimate(const IntelligibilityBands &speech,
+							const IntelligibilityBands &noise, const CalibrationChain &chain)
+{
+	IntelligibilityEstimate result;
+	result.measured = index(speech, noise);
+	if (result.measured < 0.0f)
+		return result;
+
+	if (chain.options.noiseSuppression)
+		result.suppressionDb = SUPPRESSION_UNDER_SPEECH * static_cast<float>(-chain.suppressLevelDb);
+
+	float gains[BANDS];
+	chainGains(chain, gains);
+
+	IntelligibilityBands speechOut = speech;
+	IntelligibilityBands noiseOut = noise;
+	for (int i = 0; i < BANDS; i++) {
+		speechOut.db[i] += gains[i];
+		noiseOut.db[i] += gains[i] - result.suppressionDb;
+	}
+
+	float loss[BANDS];
+	result.predicted = index(speechOut, noiseOut, loss);
+	const int worst = static_cast<int>(std::max_element(loss, loss + BANDS) - loss);
+	result.limitingHz = CENTER_HZ[worst];
+	return result;
+}
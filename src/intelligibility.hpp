@@ -0,0 +1,73 @@
+/*
+ * Intelligibility - Speech Intelligibility Index from band speech and noise
+ * Copyright (C) 2025
+ *
+ * ANSI S3.5 one-third octave procedure (18 bands, 160 Hz - 8 kHz) with
+ * average-speech band importances and normal hearing. Speech comes from the
+ * gated long-term spectrum of the speaking steps, noise from the ungated
+ * spectrum of step 1. Without a calibrated SPL reference the speech is taken
+ * to be at normal vocal effort (62.35 dB SPL overall) and the noise is
+ * shifted with it, so the index reflects the recorded SNR and spectra, not
+ * how loudly the listener plays it back.
+ *
+ * The prediction applies the chain's EQ (measured by running a tone at each
+ * band centre through the same models the preview uses) to both spectra and
+ * lowers the noise by the suppressor's attenuation. RNNoise and Speex are
+ * not modelled sample by sample; under speech they reach only part of their
+ * configured depth, so SUPPRESSION_UNDER_SPEECH scales it.
+ */
+
+#ifndef INTELLIGIBILITY_HPP
+#define INTELLIGIBILITY_HPP
+
+#include <string>
+
+#include "calibration-chain.hpp"
+
+class LongTermSpectrum;
+
+struct IntelligibilityBands {
+	static constexpr int BANDS = 18;
+
+	float db[BANDS] = {}; // spectrum level (PSD) per band, any common reference
+	bool valid = false;
+};
+
+struct IntelligibilityEstimate {
+	float measured = -1.0f;  // 0-1, as recorded (-1 = not estimated)
+	float predicted = -1.0f; // 0-1, after the chain's suppression and EQ
+	float suppressionDb = 0.0f; // noise reduction assumed under speech
+	float limitingHz = 0.0f; // band losing the most weighted audibility after the chain
+
+	bool valid() const { return measured >= 0.0f && predicted >= 0.0f; }
+
+	// "good" / "fair" / "poor"
+	static const char *rating(float sii);
+};
+
+class SpeechIntelligibility {
+public:
+	static constexpr int BANDS = IntelligibilityBands::BANDS;
+	static constexpr float SUPPRESSION_UNDER_SPEECH = 0.4f;
+
+	static const float CENTER_HZ[BANDS];
+
+	// Bands of a long-term spectrum; invalid if the spectrum is empty or its
+	// sample rate does not reach 8 kHz
+	static IntelligibilityBands bands(const LongTermSpectrum &spectrum);
+
+	// SII (0-1). loss, if given, receives each band's share of what is
+	// missing: importance x (1 - audibility x level distortion)
+	static float index(const IntelligibilityBands &speech, const IntelligibilityBands &noise,
+			   float *loss = nullptr);
+
+	// Gain of the chain's voice EQ, high-pass and 3-band EQ at each band
+	// centre, dB
+	static void chainGains(const CalibrationChain &chain, float *gainDb);
+
+	// Raw and predicted index for a chain (any thread)
+	static IntelligibilityEstimate estimate(const IntelligibilityBands &speech, const IntelligibilityBands &noise,
+						const CalibrationChain &chain);
+};
+
+#endif // INTELLIGIBILITY_HPP
@@ -0,0 +1,63 @@
+/*
+ * Level Estimate Implementation
+ * Copyright (C) 2025
+ */
+
+#include "level-estimate.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Fewer readings than this give no usable variance
+static constexpr size_t MIN_READINGS = 5;
+
+void LevelEstimate::reset()
+{
+	*this = LevelEstimate();
+}
+
+void LevelEstimate::add(double value)
+{
+	if (n == 0)
+		first = value;
+	else
+		lagSum += value * last;
+	last = value;
+	sum += value;
+
+	n++;
+	const double delta = value - average;
+	average += delta / static_cast<double>(n);
+	m2 += delta * (value - average);
+}
+
+double LevelEstimate::autocorrelation() const
+{
+	if (n < MIN_READINGS || m2 <= 0.0)
+		return 0.0;
+
+	// sum over i >= 1 of (x[i] - mean)(x[i - 1] - mean)
+	const double pairs = static_cast<double>(n - 1);
+	const double covariance = lagSum - average * ((sum - first) + (sum - last)) + pairs * average * average;
+	return std::clamp(covariance / m2, 0.0, 0.95);
+}
+
+double LevelEstimate::effectiveCount() const
+{
+	const double r = autocorrelation();
+	return static_cast<double>(n) * (1.0 - r) / (1.0 + r);
+}
+
+double LevelEstimate::halfWidthDb() const
+{
+	if (n < MIN_READINGS || average <= 0.0)
+		return std::numeric_limits<double>::infinity();
+
+	const double variance = m2 / static_cast<double>(n - 1);
+	const double halfWidth = Z * std::sqrt(variance / std::max(effectiveCount(), 1.0));
+
+	// Wider side of the interval once converted to dB
+	const double lower = std::max(average - halfWidth, average * 1e-3);
+	return 20.0 * std::log10(average / lower);
+}
@@ -0,0 +1,51 @@
+/*
+ * Level Estimate - Running mean level of a recording step and its confidence
+ * Copyright (C) 2025
+ *
+ * A step's level is the mean of the linear RMS readings taken every tick.
+ * The readings are smoothed by the analyzer and follow the syllables, so
+ * neighbours are far from independent: the variance (Welford) is paired
+ * with the lag-1 autocorrelation, and the interval uses the effective
+ * number of readings n (1 - r) / (1 + r) of a first-order process. The
+ * half-width is returned in dB so it can be compared with a tolerance
+ * directly.
+ */
+
+#ifndef LEVEL_ESTIMATE_HPP
+#define LEVEL_ESTIMATE_HPP
+
+#include <cstddef>
+
+class LevelEstimate {
+public:
+	// Two-sided 95 %
+	static constexpr double Z = 1.96;
+
+	void reset();
+
+	// One linear RMS reading
+	void add(double value);
+
+	size_t count() const { return n; }
+	double mean() const { return average; }
+
+	// Lag-1 autocorrelation of the readings, clamped to [0, 0.95]
+	double autocorrelation() const;
+
+	double effectiveCount() const;
+
+	// 95 % half-width of the mean in dB (infinite until there are a few
+	// readings)
+	double halfWidthDb() const;
+
+private:
+	size_t n = 0;
+	double average = 0.0;
+	double m2 = 0.0;
+	double sum = 0.0;
+	double lagSum = 0.0; // sum of x[i] * x[i - 1]
+	double first = 0.0;
+	double last = 0.0;
+};
+
+#endif // LEVEL_ESTIMATE_HPP
@@ -0,0 +1,520 @@
+/*
+ * Live Recalibrator Implementation
+ * Copyright (C) 2025
+ */
+
+#include "live-recalibrator.hpp"
+#include <plugin-support.h>
+
+#include "calibration-chain.hpp"
+#include "filter-models.hpp"
+#include "worker-pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static constexpr double PI = 3.14159265358979323846;
+
+static const char *HOTKEY_NAME = "audio_calibrator_recalibrate";
+static const char *GAIN_FILTER = "Audio Calibrator - Gain";
+static const char *COMPRESSOR_FILTER = "Audio Calibrator - Compressor";
+static const char *GATE_FILTER = "Audio Calibrator - Noise Gate";
+static const char *LIMITER_FILTER = "Audio Calibrator - Limiter";
+static const char *EXPANDER_FILTER = "Audio Calibrator - Expander";
+
+static bool isAudioInput(obs_source_t *source)
+{
+	return source && obs_source_get_type(source) == OBS_SOURCE_TYPE_INPUT &&
+	       (obs_source_get_output_flags(source) & OBS_SOURCE_AUDIO) != 0;
+}
+
+// Current value of a numeric setting on one of our filters; Apply also
+// adds the stages a chain does not use, disabled, and those are skipped
+static bool readFilterSetting(obs_source_t *source, const char *filterName, const char *key, double &value)
+{
+	obs_source_t *filter = obs_source_get_filter_by_name(source, filterName);
+	if (!filter)
+		return false;
+	if (!obs_source_enabled(filter)) {
+		obs_source_release(filter);
+		return false;
+	}
+	obs_data_t *settings = obs_source_get_settings(filter);
+	value = obs_data_get_double(settings, key);
+	obs_data_release(settings);
+	obs_source_release(filter);
+	return true;
+}
+
+static void updateFilter(obs_source_t *source, const char *filterName, obs_data_t *changes)
+{
+	obs_source_t *filter = obs_source_get_filter_by_name(source, filterName);
+	if (!filter)
+		return;
+	obs_source_update(filter, changes);
+	obs_source_release(filter);
+}
+
+static float percentile90(std::vector<float> values)
+{
+	const size_t index = std::min(values.size() - 1, values.size() * 9 / 10);
+	std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+	return values[index];
+}
+
+CalibrationChain LiveRecalibrator::appliedChain(obs_source_t *source, const CalibrationBaseline &baseline)
+{
+	CalibrationChain chain = CalibrationChain::derive(baseline.levels, baseline.peaks, baseline.options);
+	ChainOptions &options = chain.options;
+
+	double value = 0.0;
+	double other = 0.0;
+	options.gain = readFilterSetting(source, GAIN_FILTER, "db", value);
+	if (options.gain)
+		chain.gainDb = static_cast<float>(value);
+	options.compressor = readFilterSetting(source, COMPRESSOR_FILTER, "threshold", value) &&
+			     readFilterSetting(source, COMPRESSOR_FILTER, "ratio", other);
+	if (options.compressor) {
+		chain.compressorThresholdDb = static_cast<float>(value);
+		chain.compressorRatio = static_cast<float>(other);
+	}
+	options.limiter = readFilterSetting(source, LIMITER_FILTER, "threshold", value);
+	if (options.limiter)
+		chain.limiterThresholdDb = static_cast<float>(value);
+	options.noiseGate = readFilterSetting(source, GATE_FILTER, "open_threshold", value) &&
+			    readFilterSetting(source, GATE_FILTER, "close_threshold", other);
+	if (options.noiseGate) {
+		chain.gateOpenDb = static_cast<float>(value);
+		chain.gateCloseDb = static_cast<float>(other);
+	}
+	options.expander = readFilterSetting(source, EXPANDER_FILTER, "threshold", value);
+	if (options.expander)
+		chain.expanderThresholdDb = static_cast<float>(value);
+	return chain;
+}
+
+// Mean linear RMS of the 100 ms blocks from first on, dB
+static float meanBlockDb(const std::vector<float> &samples, size_t first, size_t block)
+{
+	double sum = 0.0;
+	int blocks = 0;
+	for (size_t pos = first; pos + block <= samples.size(); pos += block) {
+		double power = 0.0;
+		for (size_t i = pos; i < pos + block; i++)
+			power += static_cast<double>(samples[i]) * samples[i];
+		sum += std::sqrt(power / static_cast<double>(block));
+		blocks++;
+	}
+	return blocks > 0 ? static_cast<float>(20.0 * std::log10(std::max(sum / blocks, 1e-10))) : -200.0f;
+}
+
+// Move towards the derived value by at most MAX_CORRECTION_DB
+static float corrected(double current, float derived)
+{
+	const float step = std::max(-LiveRecalibrator::MAX_CORRECTION_DB,
+				    std::min(derived - static_cast<float>(current), LiveRecalibrator::MAX_CORRECTION_DB));
+	return static_cast<float>(current) + step;
+}
+
+LiveRecalibrator &LiveRecalibrator::instance()
+{
+	static LiveRecalibrator recalibrator;
+	return recalibrator;
+}
+
+void LiveRecalibrator::attach()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (attached)
+			return;
+		attached = true;
+	}
+
+	signal_handler_t *handler = obs_get_signal_handler();
+	signal_handler_connect(handler, "source_create", sourceCreated, this);
+	signal_handler_connect(handler, "source_destroy", sourceDestroyed, this);
+
+	obs_enum_sources(
+		[](void *param, obs_source_t *source) {
+			static_cast<LiveRecalibrator *>(param)->registerHotkey(source);
+			return true;
+		},
+		this);
+}
+
+void LiveRecalibrator::detach()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!attached)
+			return;
+		attached = false;
+	}
+
+	signal_handler_t *handler = obs_get_signal_handler();
+	signal_handler_disconnect(handler, "source_create", sourceCreated, this);
+	signal_handler_disconnect(handler, "source_destroy", sourceDestroyed, this);
+
+	std::vector<std::unique_ptr<HotkeyTarget>> releasing;
+	std::map<std::string, std::unique_ptr<Session>> stopping;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		releasing.swap(targets);
+		stopping.swap(sessions);
+	}
+
+	for (auto &target : releasing) {
+		obs_hotkey_unregister(target->id);
+		obs_weak_source_release(target->weak);
+	}
+	for (auto &entry : stopping)
+		entry.second->tap->removeListener(entry.second->listenerId);
+}
+
+void LiveRecalibrator::registerHotkey(obs_source_t *source)
+{
+	if (!isAudioInput(source))
+		return;
+
+	auto target = std::make_unique<HotkeyTarget>();
+	target->weak = obs_source_get_weak_source(source);
+
+	// Source hotkeys are saved and restored with the source by OBS
+	target->id = obs_hotkey_register_source(source, HOTKEY_NAME,
+						"Audio Calibrator: Recalibrate from the next 10 s of speech",
+						hotkeyPressed, target.get());
+	if (target->id == OBS_INVALID_HOTKEY_ID) {
+		obs_weak_source_release(target->weak);
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	targets.push_back(std::move(target));
+}
+
+void LiveRecalibrator::forgetSource(obs_source_t *source)
+{
+	std::unique_ptr<HotkeyTarget> removed;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = std::find_if(targets.begin(), targets.end(), [source](const auto &target) {
+			return obs_weak_source_references_source(target->weak, source);
+		});
+		if (it == targets.end())
+			return;
+		removed = std::move(*it);
+		targets.erase(it);
+	}
+
+	// Unregister before the target goes away so a press cannot reach it
+	obs_hotkey_unregister(removed->id);
+	obs_weak_source_release(removed->weak);
+}
+
+void LiveRecalibrator::sourceCreated(void *data, calldata_t *cd)
+{
+	auto *source = static_cast<obs_source_t *>(calldata_ptr(cd, "source"));
+	static_cast<LiveRecalibrator *>(data)->registerHotkey(source);
+}
+
+void LiveRecalibrator::sourceDestroyed(void *data, calldata_t *cd)
+{
+	auto *source = static_cast<obs_source_t *>(calldata_ptr(cd, "source"));
+	static_cast<LiveRecalibrator *>(data)->forgetSource(source);
+}
+
+void LiveRecalibrator::hotkeyPressed(void *data, obs_hotkey_id, obs_hotkey_t *, bool pressed)
+{
+	if (!pressed)
+		return;
+
+	auto *target = static_cast<HotkeyTarget *>(data);
+	obs_source_t *source = obs_weak_source_get_source(target->weak);
+	if (!source)
+		return;
+	const char *name = obs_source_get_name(source);
+	auto *sourceName = new std::string(name ? name : "");
+	obs_source_release(source);
+
+	// Hotkeys fire on the hotkey thread; lookups and filter updates belong
+	// on the UI thread with the wizard and the profile switcher
+	obs_queue_task(OBS_TASK_UI, startTask, sourceName, false);
+}
+
+void LiveRecalibrator::applyTask(void *param)
+{
+	std::unique_ptr<ProgramLevel> level(static_cast<ProgramLevel *>(param));
+	instance().apply(*level);
+}
+
+void LiveRecalibrator::startTask(void *param)
+{
+	std::unique_ptr<std::string> sourceName(static_cast<std::string *>(param));
+	instance().start(*sourceName);
+}
+
+void LiveRecalibrator::finishTask(void *param)
+{
+	std::unique_ptr<std::string> sourceName(static_cast<std::string *>(param));
+	instance().finish(*sourceName);
+}
+
+void LiveRecalibrator::start(const std::string &sourceName)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!attached)
+			return;
+		if (sessions.count(sourceName)) {
+			obs_log(LOG_INFO, "[Recalibrate] %s: already listening", sourceName.c_str());
+			return;
+		}
+	}
+
+	auto session = std::make_unique<Session>();
+	session->sourceName = sourceName;
+	if (!ProfileSwitcher::instance().baseline(sourceName, session->baseline)) {
+		obs_log(LOG_WARNING, "[Recalibrate] %s: run the Audio Calibration Wizard and Apply once first",
+			sourceName.c_str());
+		return;
+	}
+
+	obs_source_t *source = obs_get_source_by_name(sourceName.c_str());
+	if (!source)
+		return;
+
+	session->tap = AnalysisWorker::shared().tap(source);
+	obs_source_release(source);
+	if (!session->tap)
+		return;
+
+	Session *raw = session.get();
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		sessions[sourceName] = std::move(session);
+	}
+	raw->listenerId = raw->tap->addListener([this, raw](const AnalysisBlock &block) { onBlock(raw, block); });
+
+	obs_log(LOG_INFO, "[Recalibrate] %s: listening for %.0f s of speech", sourceName.c_str(), SPEECH_SECONDS);
+}
+
+void LiveRecalibrator::onBlock(Session *session, const AnalysisBlock &block)
+{
+	if (session->done)
+		return;
+
+	session->elapsed += block.seconds;
+	if (!block.continuous) {
+		session->discontinuities++;
+	} else if (block.speech) {
+		session->speechSeconds += block.seconds;
+		session->speechAmplitudeSum += std::pow(10.0, block.rmsDb / 20.0);
+		session->speechBlocks++;
+	}
+	if (block.transients > 0) {
+		session->transientPeaks.push_back(block.transientPeakDb);
+		session->transientLevels.push_back(block.transientLevelDb);
+	}
+
+	if (session->speechSeconds >= SPEECH_SECONDS || session->elapsed >= TIMEOUT_SECONDS) {
+		session->done = true;
+		obs_queue_task(OBS_TASK_UI, finishTask, new std::string(session->sourceName), false);
+	}
+}
+
+float LiveRecalibrator::programBeforeChain(const CalibrationChain &applied, float outputDb)
+{
+	const uint32_t rate = AnalysisTap::ANALYSIS_RATE;
+	const size_t block = rate / 10;
+	const size_t settle = rate / 2; // envelopes and the gate reach steady state
+	const size_t count = static_cast<size_t>(MODEL_SECONDS * rate);
+
+	// Gliding harmonic voice with a syllable-rate envelope, so the
+	// compressor and limiter work on peaks as they do on speech
+	std::vector<float> voice(count);
+	double phase = 0.0;
+	for (size_t i = 0; i < count; i++) {
+		const double t = static_cast<double>(i) / rate;
+		phase += 2.0 * PI * (140.0 + 40.0 * std::sin(2.0 * PI * 0.5 * t)) / rate;
+		const double envelope = 0.6 + 0.4 * std::sin(2.0 * PI * 4.0 * t);
+		voice[i] = static_cast<float>(envelope * (0.5 * std::sin(phase) + 0.25 * std::sin(2.0 * phase) +
+							 0.12 * std::sin(3.0 * phase) + 0.06 * std::sin(5.0 * phase)));
+	}
+	const float voiceDb = meanBlockDb(voice, settle, block);
+
+	std::vector<float> work(count);
+	auto outputAt = [&](float inputDb) {
+		const float scale = static_cast<float>(std::pow(10.0, (inputDb - voiceDb) / 20.0));
+		for (size_t i = 0; i < count; i++)
+			work[i] = voice[i] * scale;
+		ChainModel model(applied, rate);
+		model.process(work.data(), count);
+		return meanBlockDb(work, settle, block);
+	};
+
+	// The output rises with the input, so bisect between silence and full
+	// scale
+	float low = -100.0f;
+	float high = 0.0f;
+	if (outputAt(high) <= outputDb)
+		return high;
+	for (int i = 0; i < MODEL_ITERATIONS; i++) {
+		const float middle = 0.5f * (low + high);
+		if (outputAt(middle) < outputDb)
+			low = middle;
+		else
+			high = middle;
+	}
+	return 0.5f * (low + high);
+}
+
+void LiveRecalibrator::finish(const std::string &sourceName)
+{
+	Session *session = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = sessions.find(sourceName);
+		if (it == sessions.end())
+			return;
+		session = it->second.get();
+	}
+	session->tap->removeListener(session->listenerId);
+
+	obs_source_t *source = obs_get_source_by_name(sourceName.c_str());
+	if (source && session->speechSeconds >= MIN_SPEECH_SECONDS)
+		session->applied = appliedChain(source, session->baseline);
+	obs_source_release(source);
+
+	if (!source || session->speechSeconds < MIN_SPEECH_SECONDS) {
+		if (source)
+			obs_log(LOG_WARNING, "[Recalibrate] %s: only %.1f s of speech in %.0f s, nothing changed",
+				sourceName.c_str(), session->speechSeconds, session->elapsed);
+		std::lock_guard<std::mutex> lock(mutex);
+		sessions.erase(sourceName);
+		return;
+	}
+
+	// Level heard after the chain, same averaging as a wizard step (mean
+	// linear RMS); the model runs off the UI thread. The session stays
+	// listed meanwhile, so another press is refused as already listening.
+	const double meanAmplitude = session->speechAmplitudeSum / session->speechBlocks;
+	const float outputDb = static_cast<float>(20.0 * std::log10(std::max(meanAmplitude, 1e-5)));
+	const CalibrationChain applied = session->applied;
+	const bool queued = WorkerPool::shared().submit([sourceName, applied, outputDb]() {
+		auto *level = new ProgramLevel{sourceName, programBeforeChain(applied, outputDb)};
+		obs_queue_task(OBS_TASK_UI, applyTask, level, false);
+	});
+	if (!queued) {
+		std::lock_guard<std::mutex> lock(mutex);
+		sessions.erase(sourceName);
+	}
+}
+
+void LiveRecalibrator::apply(const ProgramLevel &level)
+{
+	const std::string &sourceName = level.sourceName;
+	std::unique_ptr<Session> session;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = sessions.find(sourceName);
+		if (it == sessions.end())
+			return; // detached meanwhile
+		session = std::move(it->second);
+		sessions.erase(it);
+	}
+	const float programNow = level.db;
+
+	// Shift the program steps of the baseline; the noise floor stays
+	CalibrationBaseline adjusted = session->baseline;
+	const float programThen = (adjusted.levels[3] + adjusted.levels[4] + adjusted.levels[5]) / 3.0f;
+	const float drift = programNow - programThen;
+	for (int step = 3; step <= 5; step++) {
+		adjusted.levels[step] += drift;
+		adjusted.peaks[step] += drift;
+	}
+
+	// Transients at the output made it through the gate; derive against
+	// them (before our gain) if they are louder than the keyboard step's.
+	// They are over before the compressor attack, so only the gain is
+	// backed out.
+	ChainOptions &options = adjusted.options;
+	const size_t leaked = session->transientPeaks.size();
+	const float appliedGainDb = session->applied.options.gain ? session->applied.gainDb : 0.0f;
+	if (leaked >= MIN_LEAKED_TRANSIENTS) {
+		const float leakedPeak = percentile90(session->transientPeaks) - appliedGainDb;
+		if (leakedPeak > options.clickPeakDb) {
+			options.clickPeakDb = leakedPeak;
+			options.clickLevelDb = std::max(options.clickLevelDb,
+							percentile90(session->transientLevels) - appliedGainDb);
+			if (options.clickMs <= 0.0f)
+				options.clickMs = 25.0f;
+		}
+	}
+	const CalibrationChain chain = CalibrationChain::derive(adjusted.levels, adjusted.peaks, adjusted.options);
+
+	obs_source_t *source = obs_get_source_by_name(sourceName.c_str());
+	if (!source)
+		return;
+
+	std::string changes;
+	auto note = [&changes](const char *what, double before, float after) {
+		char text[96];
+		snprintf(text, sizeof(text), "%s%s %.1f -> %.1f dB", changes.empty() ? "" : ", ", what, before, after);
+		changes += text;
+	};
+
+	double current = 0.0;
+	if (readFilterSetting(source, GAIN_FILTER, "db", current)) {
+		const float value = corrected(current, chain.gainDb);
+		obs_data_t *update = obs_data_create();
+		obs_data_set_double(update, "db", value);
+		updateFilter(source, GAIN_FILTER, update);
+		obs_data_release(update);
+		note("gain", current, value);
+	}
+
+	if (readFilterSetting(source, COMPRESSOR_FILTER, "threshold", current)) {
+		const float value = corrected(current, chain.compressorThresholdDb);
+		obs_data_t *update = obs_data_create();
+		obs_data_set_double(update, "threshold", value);
+		updateFilter(source, COMPRESSOR_FILTER, update);
+		obs_data_release(update);
+		note("compressor threshold", current, value);
+	}
+
+	double closeCurrent = 0.0;
+	if (readFilterSetting(source, GATE_FILTER, "open_threshold", current) &&
+	    readFilterSetting(source, GATE_FILTER, "close_threshold", closeCurrent)) {
+		const float open = corrected(current, chain.gateOpenDb);
+		const float close = std::min(corrected(closeCurrent, chain.gateCloseDb), open);
+		obs_data_t *update = obs_data_create();
+		obs_data_set_double(update, "open_threshold", open);
+		obs_data_set_double(update, "close_threshold", close);
+		if (options.hasClicks())
+			obs_data_set_int(update, "hold_time", chain.gateHoldMs);
+		updateFilter(source, GATE_FILTER, update);
+		obs_data_release(update);
+		note("gate open", current, open);
+		note("gate close", closeCurrent, close);
+	}
+
+	if (options.hasClicks() && readFilterSetting(source, EXPANDER_FILTER, "threshold", current)) {
+		const float value = corrected(current, chain.expanderThresholdDb);
+		obs_data_t *update = obs_data_create();
+		obs_data_set_double(update, "threshold", value);
+		updateFilter(source, EXPANDER_FILTER, update);
+		obs_data_release(update);
+		note("expander threshold", current, value);
+	}
+	obs_source_release(source);
+
+	obs_log(LOG_INFO,
+		"[Recalibrate] %s: speech %.1f dB before the chain (%+.1f dB since the wizard, %.1f s heard, %d blocks "
+		"skipped at timeline breaks, %zu with transients): %s",
+		sourceName.c_str(), programNow, drift, session->speechSeconds, session->discontinuities, leaked,
+		changes.empty() ? "no Audio Calibrator filters to adjust" : changes.c_str());
+}
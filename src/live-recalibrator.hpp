@@ -0,0 +1,121 @@
+/*
+ * Live Recalibrator - Hotkey-driven touch-up of a source's filters mid-show
+ * Copyright (C) 2025
+ *
+ * Every audio input gets an "Audio Calibrator: Recalibrate" hotkey. When
+ * pressed, the source is tapped on the shared analysis worker until 10 s of
+ * speech have been heard. The tap sits after the filters, so the speech
+ * level is taken back through a model of the chain as it stands
+ * (filter-models.hpp): on a worker, a synthetic voice is run through
+ * ChainModel at the input level that reproduces the heard level, so gain,
+ * compressor, limiter and gate are all backed out. That level replaces the
+ * program steps of the source's stored wizard baseline; the chain is
+ * re-derived against the stored noise floor and only the gain, compressor
+ * threshold and gate thresholds of the existing filters are updated, by a
+ * bounded amount. Keyboard and desk transients heard in the same window got
+ * through the gate, so they also raise the gate and expander thresholds and
+ * shorten the gate hold. Nothing runs on the audio thread and the UI thread
+ * only does lookups and obs_source_update.
+ */
+
+#ifndef LIVE_RECALIBRATOR_HPP
+#define LIVE_RECALIBRATOR_HPP
+
+#include <obs.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "analysis-worker.hpp"
+#include "calibration-chain.hpp"
+#include "profile-switcher.hpp"
+
+class LiveRecalibrator {
+public:
+	static constexpr double SPEECH_SECONDS = 10.0;
+	static constexpr double TIMEOUT_SECONDS = 60.0;
+	static constexpr double MIN_SPEECH_SECONDS = 3.0;
+	static constexpr float MAX_CORRECTION_DB = 6.0f; // per press
+	static constexpr size_t MIN_LEAKED_TRANSIENTS = 5;
+	static constexpr double MODEL_SECONDS = 2.0; // per level tried
+	static constexpr int MODEL_ITERATIONS = 14;  // bisection steps, ~0.01 dB
+
+	static LiveRecalibrator &instance();
+
+	// Speech level before the chain that comes out at outputDb (mean
+	// linear block RMS, as a wizard step averages). Noise suppression and
+	// VST are not modelled. Any thread; runs ChainModel over
+	// MODEL_ITERATIONS x MODEL_SECONDS of audio.
+	static float programBeforeChain(const CalibrationChain &applied, float outputDb);
+
+	// The chain the filters run now: what Apply derived from the baseline,
+	// with the settings that profiles and earlier presses change read back.
+	// Stages that are missing or disabled are left out. UI thread.
+	static CalibrationChain appliedChain(obs_source_t *source, const CalibrationBaseline &baseline);
+
+	// Register hotkeys on existing and future audio inputs
+	void attach();
+	void detach();
+
+private:
+	LiveRecalibrator() = default;
+
+	struct HotkeyTarget {
+		obs_weak_source_t *weak = nullptr;
+		obs_hotkey_id id = OBS_INVALID_HOTKEY_ID;
+	};
+
+	struct Session {
+		std::string sourceName;
+		std::shared_ptr<AnalysisTap> tap;
+		int listenerId = 0;
+		CalibrationBaseline baseline;
+
+		// Worker thread until done
+		double elapsed = 0.0;
+		double speechSeconds = 0.0;
+		double speechAmplitudeSum = 0.0;
+		int speechBlocks = 0;
+		int discontinuities = 0;
+		std::vector<float> transientPeaks;  // per block with transients, after the chain
+		std::vector<float> transientLevels;
+		bool done = false;
+
+		// UI thread, once the window is over
+		CalibrationChain applied;
+	};
+
+	// Handed from the model back to the UI thread
+	struct ProgramLevel {
+		std::string sourceName;
+		float db = -100.0f;
+	};
+
+	void registerHotkey(obs_source_t *source);
+	void forgetSource(obs_source_t *source);
+
+	static void sourceCreated(void *data, calldata_t *cd);
+	static void sourceDestroyed(void *data, calldata_t *cd);
+	static void hotkeyPressed(void *data, obs_hotkey_id id, obs_hotkey_t *hotkey, bool pressed);
+
+	// UI thread (queued with obs_queue_task)
+	static void startTask(void *param);
+	static void finishTask(void *param);
+	static void applyTask(void *param);
+	void start(const std::string &sourceName);
+	void finish(const std::string &sourceName);
+	void apply(const ProgramLevel &level);
+
+	// Worker thread
+	void onBlock(Session *session, const AnalysisBlock &block);
+
+	std::mutex mutex;
+	bool attached = false;
+	std::vector<std::unique_ptr<HotkeyTarget>> targets;
+	std::map<std::string, std::unique_ptr<Session>> sessions;
+};
+
+#endif // LIVE_RECALIBRATOR_HPP
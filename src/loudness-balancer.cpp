@@ -0,0 +1,190 @@
+/*
+ * Loudness Balancer Implementation
+ * Copyright (C) 2025
+ */
+
+#include "loudness-balancer.hpp"
+#include "profile-switcher.hpp"
+#include <plugin-support.h>
+
+#include <util/platform.h>
+
+#include <algorithm>
+#include <cmath>
+
+LoudnessBalancer &LoudnessBalancer::instance()
+{
+	static LoudnessBalancer balancer;
+	return balancer;
+}
+
+bool LoudnessBalancer::start(const std::vector<std::string> &sourceNames)
+{
+	stop();
+
+	std::vector<std::unique_ptr<Host>> created;
+	for (const std::string &name : sourceNames) {
+		obs_source_t *source = obs_get_source_by_name(name.c_str());
+		if (!source)
+			continue;
+
+		auto host = std::make_unique<Host>();
+		host->tap = AnalysisWorker::shared().tap(source);
+		host->baseVolume = obs_source_get_volume(source);
+		host->appliedVolume = host->baseVolume;
+		obs_source_release(source);
+
+		CalibrationBaseline baseline;
+		if (ProfileSwitcher::instance().baseline(name, baseline))
+			host->distance.setReference(baseline.distance);
+
+		if (host->tap)
+			created.push_back(std::move(host));
+	}
+
+	if (created.size() < 2) {
+		obs_log(LOG_WARNING, "[LoudnessBalancer] Need at least two audio sources, got %zu", created.size());
+		return false;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		hosts = std::move(created);
+		lastUpdateNs = os_gettime_ns();
+	}
+
+	// Listeners last: from here on blocks arrive on the worker thread
+	for (auto &host : hosts) {
+		Host *raw = host.get();
+		host->listenerId = host->tap->addListener([this, raw](const AnalysisBlock &block) { onBlock(raw, block); });
+		obs_log(LOG_INFO, "[LoudnessBalancer] Balancing %s (fader %.1f dB)", host->tap->name().c_str(),
+			20.0f * std::log10(std::max(host->baseVolume, 1e-5f)));
+	}
+	return true;
+}
+
+void LoudnessBalancer::stop()
+{
+	// Detach outside our lock: a listener may be waiting on it right now
+	std::vector<std::pair<std::shared_ptr<AnalysisTap>, int>> detach;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (const auto &host : hosts)
+			detach.emplace_back(host->tap, host->listenerId);
+	}
+	for (auto &entry : detach)
+		entry.first->removeListener(entry.second);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	for (const auto &host : hosts) {
+		followFader(*host);
+		obs_source_set_volume(host->tap->source(), host->baseVolume);
+		obs_log(LOG_INFO, "[LoudnessBalancer] Restored %s (was %+.1f dB)", host->tap->name().c_str(),
+			host->offsetDb);
+	}
+	hosts.clear();
+}
+
+bool LoudnessBalancer::isRunning() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return !hosts.empty();
+}
+
+float LoudnessBalancer::shortTermLufs(const Host &host)
+{
+	if (host.speechPower.empty())
+		return -100.0f;
+	double sum = 0.0;
+	for (double power : host.speechPower)
+		sum += power;
+	const double mean = sum / static_cast<double>(host.speechPower.size());
+	return mean > 1e-10 ? static_cast<float>(-0.691 + 10.0 * std::log10(mean)) : -100.0f;
+}
+
+void LoudnessBalancer::onBlock(Host *host, const AnalysisBlock &block)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	host->lastBlock = block.index;
+	host->distance.update(block);
+	if (block.speech) {
+		host->speechPower.push_back(block.kPower);
+		if (host->speechPower.size() > SHORT_TERM_BLOCKS)
+			host->speechPower.pop_front();
+		host->lastSpeechBlock = block.index;
+		host->spoke = true;
+	}
+
+	const uint64_t now = os_gettime_ns();
+	if (static_cast<double>(now - lastUpdateNs) / 1e9 >= UPDATE_SECONDS) {
+		lastUpdateNs = now;
+		rebalance();
+	}
+}
+
+void LoudnessBalancer::followFader(Host &host)
+{
+	const float current = obs_source_get_volume(host.tap->source());
+	if (std::fabs(current - host.appliedVolume) <= 1e-4f * std::max(host.appliedVolume, 1e-5f))
+		return;
+
+	// Not what we set last, so the operator moved the fader on top of our
+	// offset; divide the offset out to get their new base
+	host.baseVolume = current / std::pow(10.0f, host.offsetDb / 20.0f);
+	host.appliedVolume = current;
+	obs_log(LOG_INFO, "[LoudnessBalancer] %s fader moved to %.1f dB", host.tap->name().c_str(),
+		20.0f * std::log10(std::max(host.baseVolume, 1e-5f)));
+}
+
+void LoudnessBalancer::rebalance()
+{
+	// Effective loudness of each active talker, including fader and offset
+	std::vector<std::pair<Host *, float>> active;
+	for (const auto &host : hosts) {
+		followFader(*host);
+		const bool talking = host->spoke && host->lastBlock - host->lastSpeechBlock <= ACTIVE_BLOCKS;
+		if (!talking || host->speechPower.size() < MIN_SPEECH_BLOCKS)
+			continue;
+		const float faderDb = 20.0f * std::log10(std::max(host->baseVolume, 1e-5f));
+		active.emplace_back(host.get(), shortTermLufs(*host) + faderDb + host->offsetDb);
+	}
+	if (active.size() < 2)
+		return;
+
+	float target = 0.0f;
+	for (const auto &entry : active)
+		target += entry.second;
+	target /= static_cast<float>(active.size());
+
+	for (const auto &entry : active) {
+		Host *host = entry.first;
+		const float error = target - entry.second;
+		if (std::fabs(error) <= DEADBAND_LU)
+			continue;
+
+		const bool moved = host->distance.state() == MicDistance::TooClose ||
+				   host->distance.state() == MicDistance::TooFar;
+		const float maxStep = moved ? MOVED_STEP_DB : MAX_STEP_DB;
+		const float step = std::max(-maxStep, std::min(error * (moved ? 0.5f : 0.25f), maxStep));
+		host->offsetDb = std::max(-MAX_OFFSET_DB, std::min(host->offsetDb + step, MAX_OFFSET_DB));
+		host->appliedVolume = host->baseVolume * std::pow(10.0f, host->offsetDb / 20.0f);
+		obs_source_set_volume(host->tap->source(), host->appliedVolume);
+	}
+}
+
+std::vector<BalanceHostStatus> LoudnessBalancer::status() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	std::vector<BalanceHostStatus> result;
+	for (const auto &host : hosts) {
+		BalanceHostStatus entry;
+		entry.name = host->tap->name();
+		entry.loudnessLufs = shortTermLufs(*host);
+		entry.offsetDb = host->offsetDb;
+		entry.active = host->spoke && host->lastBlock - host->lastSpeechBlock <= ACTIVE_BLOCKS;
+		entry.distance = host->distance.state();
+		result.push_back(entry);
+	}
+	return result;
+}
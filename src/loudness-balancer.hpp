@@ -0,0 +1,89 @@
+/*
+ * Loudness Balancer - Keeps several hosts at the same loudness during a show
+ * Copyright (C) 2025
+ *
+ * Each host's source is tapped on the shared analysis worker. Speech-only
+ * blocks feed a 3 s short-term loudness per host; every half second the
+ * hosts that are currently talking are nudged a fraction of a dB towards
+ * their common mean via obs_source_set_volume, so active talkers end up
+ * within +/-1 LU of each other without audible steps. A host whose
+ * calibration baseline has a distance reference also gets a distance
+ * monitor; while they are too close to or too far from the mic, their
+ * steps are larger so the level follows the move instead of trailing it.
+ */
+
+#ifndef LOUDNESS_BALANCER_HPP
+#define LOUDNESS_BALANCER_HPP
+
+#include <obs.h>
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "analysis-worker.hpp"
+#include "distance-monitor.hpp"
+
+struct BalanceHostStatus {
+	std::string name;
+	float loudnessLufs = -100.0f; // speech short-term, pre-fader
+	float offsetDb = 0.0f;        // applied on top of the user's fader
+	bool active = false;          // talking in the last few seconds
+	MicDistance distance = MicDistance::Unknown;
+};
+
+class LoudnessBalancer {
+public:
+	static constexpr float DEADBAND_LU = 0.5f;  // half the allowed spread
+	static constexpr float MAX_STEP_DB = 0.2f;  // per update
+	static constexpr float MOVED_STEP_DB = 0.6f; // per update while off the calibrated distance
+	static constexpr float MAX_OFFSET_DB = 9.0f;
+	static constexpr double UPDATE_SECONDS = 0.5;
+	static constexpr size_t SHORT_TERM_BLOCKS = 30; // 3 s of speech
+	static constexpr size_t MIN_SPEECH_BLOCKS = 10;
+	static constexpr uint64_t ACTIVE_BLOCKS = 20; // spoke within 2 s
+
+	static LoudnessBalancer &instance();
+
+	// UI thread. Takes each source's current volume as its base; moving a
+	// fader while running makes that the new base, and stop() puts the
+	// latest base back.
+	bool start(const std::vector<std::string> &sourceNames);
+	void stop();
+	bool isRunning() const;
+
+	std::vector<BalanceHostStatus> status() const;
+
+private:
+	LoudnessBalancer() = default;
+
+	struct Host {
+		std::shared_ptr<AnalysisTap> tap;
+		int listenerId = 0;
+		float baseVolume = 1.0f;    // the operator's fader
+		float appliedVolume = 1.0f; // base and offset as last set
+
+		std::deque<double> speechPower;
+		uint64_t lastBlock = 0;
+		uint64_t lastSpeechBlock = 0;
+		bool spoke = false;
+		float offsetDb = 0.0f;
+		DistanceMonitor distance;
+	};
+
+	// Worker thread
+	void onBlock(Host *host, const AnalysisBlock &block);
+	void rebalance();
+	static void followFader(Host &host);
+
+	static float shortTermLufs(const Host &host);
+
+	mutable std::mutex mutex;
+	std::vector<std::unique_ptr<Host>> hosts;
+	uint64_t lastUpdateNs = 0;
+};
+
+#endif // LOUDNESS_BALANCER_HPP
@@ -0,0 +1,297 @@
+/*
+ * Meter Bridge Widget Implementation
+ * Copyright (C) 2025
+ */
+
+#include "meter-bridge-widget.hpp"
+#include "calibration-chain.hpp"
+
+#include <obs-module.h>
+#include <util/platform.h>
+
+#include "plugin-support.h"
+
+#include <QFontMetrics>
+#include <QPainter>
+
+#include <algorithm>
+
+static constexpr int MARGIN = 4;
+static constexpr int MAX_ROW_HEIGHT = 20;
+static constexpr int MIN_ROW_HEIGHT = 4;
+static constexpr int NAME_WIDTH = 140;
+static constexpr int READOUT_WIDTH = 64;
+
+static const QColor TRACK_COLOR(38, 38, 38);
+static const QColor ZONE_COLOR(30, 70, 40);
+
+// In Batch order
+static const QColor BATCH_COLORS[] = {
+	QColor(70, 120, 170),  // below the target window
+	QColor(70, 190, 90),   // on target
+	QColor(230, 170, 50),  // above the target window
+	QColor(140, 140, 140), // no calibration to compare with
+	QColor(220, 220, 220), // peak hold
+	QColor(230, 60, 50),   // peak hold at clip
+	QColor(255, 255, 255), // target
+};
+
+MeterBridgeWidget::MeterBridgeWidget(QWidget *parent) : QWidget(parent)
+{
+	setMinimumSize(160, 40);
+	setAttribute(Qt::WA_OpaquePaintEvent);
+
+	frameTimer = new QTimer(this);
+	frameTimer->setInterval(FRAME_MS);
+	connect(frameTimer, &QTimer::timeout, this, &MeterBridgeWidget::onFrame);
+
+	refreshTimer = new QTimer(this);
+	refreshTimer->setInterval(REFRESH_MS);
+	connect(refreshTimer, &QTimer::timeout, this, &MeterBridgeWidget::refreshSources);
+}
+
+void MeterBridgeWidget::detach()
+{
+	frameTimer->stop();
+	refreshTimer->stop();
+	bridge.clear();
+	readings.clear();
+	rows.clear();
+	backgroundDirty = true;
+}
+
+QSize MeterBridgeWidget::sizeHint() const
+{
+	const int count = std::max<int>(4, static_cast<int>(rows.size()));
+	return QSize(300, count * MAX_ROW_HEIGHT + 2 * MARGIN);
+}
+
+void MeterBridgeWidget::showEvent(QShowEvent *event)
+{
+	QWidget::showEvent(event);
+	refreshSources();
+	lastFrameNs = os_gettime_ns();
+	statsStartNs = lastFrameNs;
+	busyNs = 0;
+	frames = 0;
+	frameTimer->start();
+	refreshTimer->start();
+}
+
+void MeterBridgeWidget::hideEvent(QHideEvent *event)
+{
+	QWidget::hideEvent(event);
+	detach();
+}
+
+void MeterBridgeWidget::resizeEvent(QResizeEvent *event)
+{
+	QWidget::resizeEvent(event);
+	backgroundDirty = true;
+}
+
+void MeterBridgeWidget::refreshSources()
+{
+	// Rows follow the bridge's order, which changes with the set
+	if (bridge.refresh()) {
+		rows.clear();
+		backgroundDirty = true;
+		updateGeometry();
+	}
+}
+
+void MeterBridgeWidget::updateLayout()
+{
+	const int count = std::max<int>(1, static_cast<int>(rows.size()));
+	layout.rowHeight = std::max(MIN_ROW_HEIGHT, std::min(MAX_ROW_HEIGHT, (height() - 2 * MARGIN) / count));
+	layout.barHeight = std::max(2, layout.rowHeight - 4);
+	layout.showText = layout.rowHeight >= fontMetrics().height();
+	layout.textOffset = (layout.rowHeight - fontMetrics().height()) / 2;
+	layout.barLeft = layout.showText ? std::min(NAME_WIDTH, width() / 3) : MARGIN;
+	layout.barRight = width() - MARGIN - (layout.showText ? READOUT_WIDTH : 0);
+}
+
+int MeterBridgeWidget::rowTop(size_t row) const
+{
+	return MARGIN + static_cast<int>(row) * layout.rowHeight + (layout.rowHeight - layout.barHeight) / 2;
+}
+
+float MeterBridgeWidget::position(float db) const
+{
+	const float t = (std::max(MIN_DB, std::min(db, 0.0f)) - MIN_DB) / -MIN_DB;
+	return static_cast<float>(layout.barLeft) + t * static_cast<float>(layout.barRight - layout.barLeft);
+}
+
+// Everything that does not move with the level: names, tracks and target
+// zones, plus the readouts as of now
+void MeterBridgeWidget::paintBackground()
+{
+	updateLayout();
+
+	const qreal ratio = devicePixelRatioF();
+	background = QPixmap(size() * ratio);
+	background.setDevicePixelRatio(ratio);
+	background.fill(palette().window().color());
+
+	QPainter painter(&background);
+	painter.setPen(palette().windowText().color());
+	if (rows.empty()) {
+		painter.drawText(rect(), Qt::AlignCenter, "No audio sources");
+		backgroundDirty = false;
+		return;
+	}
+
+	const float target = CalibrationChain::TARGET_RMS_DB;
+	const float lowX = position(target - TARGET_WINDOW_DB);
+	const float highX = position(target + TARGET_WINDOW_DB);
+	const QFontMetrics metrics = fontMetrics();
+	for (size_t i = 0; i < rows.size(); i++) {
+		const int top = rowTop(i);
+		painter.fillRect(layout.barLeft, top, layout.barRight - layout.barLeft, layout.barHeight, TRACK_COLOR);
+		if (readings[i].calibrated)
+			painter.fillRect(QRectF(lowX, top, highX - lowX, layout.barHeight), ZONE_COLOR);
+
+		if (layout.showText) {
+			const int y = MARGIN + static_cast<int>(i) * layout.rowHeight;
+			const QString name = metrics.elidedText(QString::fromStdString(rows[i].name), Qt::ElideRight,
+								layout.barLeft - 2 * MARGIN);
+			painter.drawText(MARGIN, y + layout.textOffset + metrics.ascent(), name);
+			paintReadout(painter, i);
+		}
+	}
+	backgroundDirty = false;
+}
+
+void MeterBridgeWidget::paintReadout(QPainter &painter, size_t row)
+{
+	const int y = MARGIN + static_cast<int>(row) * layout.rowHeight;
+	painter.fillRect(layout.barRight + MARGIN, y, READOUT_WIDTH - MARGIN, layout.rowHeight,
+			 palette().window().color());
+	painter.drawStaticText(layout.barRight + MARGIN, y + layout.textOffset, rows[row].readoutText);
+}
+
+void MeterBridgeWidget::onFrame()
+{
+	const uint64_t now = os_gettime_ns();
+	const float dt = static_cast<float>(static_cast<double>(now - lastFrameNs) / 1e9);
+	lastFrameNs = now;
+
+	bridge.snapshot(readings);
+	advance(now, dt);
+
+	busyNs += os_gettime_ns() - now;
+	update();
+}
+
+void MeterBridgeWidget::advance(uint64_t now, float dt)
+{
+	if (rows.size() != readings.size()) {
+		rows.resize(readings.size());
+		backgroundDirty = true;
+	}
+
+	bool readoutsChanged = false;
+	for (size_t i = 0; i < rows.size(); i++) {
+		Row &row = rows[i];
+		const MeterReading &reading = readings[i];
+
+		if (row.name != reading.name) {
+			row.name = reading.name;
+			backgroundDirty = true;
+		}
+
+		// Text is laid out only when a new block arrives, not every frame
+		if (row.blocks != reading.blocks) {
+			row.blocks = reading.blocks;
+			row.readoutText.setText(reading.momentaryLufs > -99.0f
+							? QString::asprintf("%.1f LUFS", reading.momentaryLufs)
+							: QStringLiteral("-"));
+			row.readoutText.prepare(QTransform(), font());
+			row.readoutDirty = true;
+			readoutsChanged = true;
+		}
+
+		// Instant rise, steady fall; peaks hold, then fall the same way
+		row.levelDb = std::max(reading.rmsDb, row.levelDb - FALL_DB_PER_SECOND * dt);
+		if (reading.peakDb >= row.holdDb) {
+			row.holdDb = reading.peakDb;
+			row.holdUntilNs = now + static_cast<uint64_t>(HOLD_SECONDS * 1e9);
+		} else if (now > row.holdUntilNs) {
+			row.holdDb = std::max(reading.peakDb, row.holdDb - FALL_DB_PER_SECOND * dt);
+		}
+	}
+
+	if (backgroundDirty) {
+		paintBackground();
+	} else if (readoutsChanged && layout.showText) {
+		QPainter painter(&background);
+		painter.setPen(palette().windowText().color());
+		for (size_t i = 0; i < rows.size(); i++) {
+			if (rows[i].readoutDirty)
+				paintReadout(painter, i);
+		}
+	}
+	for (Row &row : rows)
+		row.readoutDirty = false;
+}
+
+void MeterBridgeWidget::paintEvent(QPaintEvent *)
+{
+	const uint64_t start = os_gettime_ns();
+	if (backgroundDirty)
+		paintBackground();
+
+	QPainter painter(this);
+	painter.drawPixmap(0, 0, background);
+
+	for (auto &batch : batches)
+		batch.clear();
+	const float target = CalibrationChain::TARGET_RMS_DB;
+	const float targetX = position(target);
+	for (size_t i = 0; i < rows.size() && i < readings.size(); i++) {
+		const Row &row = rows[i];
+		const bool calibrated = readings[i].calibrated;
+		const qreal top = rowTop(i);
+		const qreal barHeight = layout.barHeight;
+
+		const float levelX = position(row.levelDb);
+		if (levelX > layout.barLeft) {
+			Batch fill = BATCH_UNCALIBRATED;
+			if (calibrated && row.levelDb > target + TARGET_WINDOW_DB)
+				fill = BATCH_HIGH;
+			else if (calibrated && row.levelDb >= target - TARGET_WINDOW_DB)
+				fill = BATCH_ON_TARGET;
+			else if (calibrated)
+				fill = BATCH_LOW;
+			batches[fill].emplace_back(layout.barLeft, top, levelX - layout.barLeft, barHeight);
+		}
+		if (row.holdDb > MIN_DB) {
+			const Batch hold = row.holdDb >= CLIP_DB ? BATCH_CLIP : BATCH_HOLD;
+			batches[hold].emplace_back(position(row.holdDb) - 1.0f, top, 2.0, barHeight);
+		}
+		if (calibrated)
+			batches[BATCH_TARGET].emplace_back(targetX, top, 1.0, barHeight);
+	}
+
+	// One call per colour for the whole bridge
+	painter.setPen(Qt::NoPen);
+	for (int b = 0; b < BATCH_COUNT; b++) {
+		if (batches[b].empty())
+			continue;
+		painter.setBrush(BATCH_COLORS[b]);
+		painter.drawRects(batches[b].data(), static_cast<int>(batches[b].size()));
+	}
+
+	const uint64_t now = os_gettime_ns();
+	busyNs += now - start;
+	frames++;
+	const double elapsed = static_cast<double>(now - statsStartNs) / 1e9;
+	if (elapsed >= STATS_SECONDS && frames > 0) {
+		obs_log(LOG_DEBUG, "[MeterBridge] %zu sources, %.3f ms per frame, %.2f%% of the UI thread",
+			rows.size(), static_cast<double>(busyNs) / 1e6 / static_cast<double>(frames),
+			100.0 * static_cast<double>(busyNs) / 1e9 / elapsed);
+		statsStartNs = now;
+		busyNs = 0;
+		frames = 0;
+	}
+}
@@ -0,0 +1,127 @@
+/*
+ * Meter Bridge Widget Header
+ * Copyright (C) 2025
+ *
+ * Dock with one horizontal meter per audio source: post-chain RMS with
+ * falling ballistics, a peak-hold tick and, for calibrated sources, the
+ * wizard's target level and window. The whole bridge is painted by one
+ * paintEvent from one MeterBridge snapshot per frame; rows shrink to fit
+ * the dock instead of scrolling. Sources are only tapped while the dock is
+ * visible.
+ *
+ * Per-call overhead, not pixels, dominates QPainter cost at this size, so
+ * everything that changes at most at the 10 Hz block rate (names, tracks,
+ * target zones, readouts) lives in a cached pixmap, and each frame is one
+ * blit plus one drawRects() call per bar colour for all rows together.
+ */
+
+#ifndef METER_BRIDGE_WIDGET_HPP
+#define METER_BRIDGE_WIDGET_HPP
+
+#include <QPixmap>
+#include <QRectF>
+#include <QStaticText>
+#include <QTimer>
+#include <QWidget>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "meter-bridge.hpp"
+
+class MeterBridgeWidget : public QWidget
+{
+	Q_OBJECT
+
+public:
+	static constexpr const char *DOCK_ID = "audio_calibrator_meter_bridge";
+
+	static constexpr int FRAME_MS = 16; // ~60 fps
+	static constexpr int REFRESH_MS = 2000; // source list
+	static constexpr float MIN_DB = -60.0f;
+	static constexpr float TARGET_WINDOW_DB = 3.0f; // green either side of the target
+	static constexpr float CLIP_DB = -1.0f;
+	static constexpr float FALL_DB_PER_SECOND = 24.0f;
+	static constexpr double HOLD_SECONDS = 1.5;
+
+	explicit MeterBridgeWidget(QWidget *parent = nullptr);
+
+	// Stops metering and releases the taps (module unload)
+	void detach();
+
+	QSize sizeHint() const override;
+
+protected:
+	void paintEvent(QPaintEvent *event) override;
+	void resizeEvent(QResizeEvent *event) override;
+	void showEvent(QShowEvent *event) override;
+	void hideEvent(QHideEvent *event) override;
+
+private slots:
+	void onFrame();
+	void refreshSources();
+
+private:
+	friend class Benchmarks; // paints the widget offscreen with synthetic readings
+
+	struct Row {
+		std::string name;
+		QStaticText readoutText;
+		uint64_t blocks = UINT64_MAX;
+		bool readoutDirty = false; // not yet in the background
+		float levelDb = -100.0f; // RMS after ballistics
+		float holdDb = -100.0f;
+		uint64_t holdUntilNs = 0;
+	};
+
+	// Geometry shared by the background and the bars
+	struct Layout {
+		int rowHeight = 0;
+		int barHeight = 0;
+		int barLeft = 0;
+		int barRight = 0;
+		int textOffset = 0;
+		bool showText = false;
+	};
+
+	enum Batch {
+		BATCH_LOW,
+		BATCH_ON_TARGET,
+		BATCH_HIGH,
+		BATCH_UNCALIBRATED,
+		BATCH_HOLD,
+		BATCH_CLIP,
+		BATCH_TARGET, // drawn last, over the level
+		BATCH_COUNT
+	};
+
+	// Ballistics and background for readings; no repaint is scheduled
+	void advance(uint64_t now, float dt);
+	void updateLayout();
+	void paintBackground();
+	void paintReadout(QPainter &painter, size_t row);
+	int rowTop(size_t row) const;
+	float position(float db) const;
+
+	MeterBridge bridge;
+	std::vector<MeterReading> readings;
+	std::vector<Row> rows;
+	Layout layout;
+	QPixmap background;
+	bool backgroundDirty = true;
+	std::vector<QRectF> batches[BATCH_COUNT]; // reused every frame
+
+	QTimer *frameTimer;
+	QTimer *refreshTimer;
+	uint64_t lastFrameNs = 0;
+
+	// UI-thread cost per frame (snapshot, ballistics and paint), logged
+	// every STATS_SECONDS at debug level
+	static constexpr double STATS_SECONDS = 10.0;
+	uint64_t busyNs = 0;
+	uint64_t frames = 0;
+	uint64_t statsStartNs = 0;
+};
+
+#endif // METER_BRIDGE_WIDGET_HPP
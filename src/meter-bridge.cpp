@@ -0,0 +1,132 @@
+/*
+ * Meter Bridge Implementation
+ * Copyright (C) 2025
+ */
+
+#include "meter-bridge.hpp"
+#include "profile-switcher.hpp"
+#include <plugin-support.h>
+
+#include <algorithm>
+#include <cmath>
+
+MeterBridge::~MeterBridge()
+{
+	clear();
+}
+
+// Removes the listeners; must be called without our lock held, because a
+// listener may be waiting on it
+void MeterBridge::detach(std::vector<std::unique_ptr<Meter>> &meters)
+{
+	for (auto &meter : meters)
+		meter->tap->removeListener(meter->listenerId);
+	meters.clear();
+}
+
+bool MeterBridge::refresh()
+{
+	std::vector<obs_source_t *> current;
+	obs_enum_sources(
+		[](void *param, obs_source_t *source) {
+			if (!source || (obs_source_get_output_flags(source) & OBS_SOURCE_AUDIO) == 0)
+				return true;
+			const char *name = obs_source_get_name(source);
+			if (name && *name && !obs_source_removed(source))
+				static_cast<std::vector<obs_source_t *> *>(param)->push_back(source);
+			return true;
+		},
+		&current);
+
+	std::vector<std::unique_ptr<Meter>> dropped;
+	std::vector<obs_source_t *> added;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (auto it = meters.begin(); it != meters.end();) {
+			if (std::find(current.begin(), current.end(), (*it)->tap->source()) == current.end()) {
+				dropped.push_back(std::move(*it));
+				it = meters.erase(it);
+			} else {
+				++it;
+			}
+		}
+		for (obs_source_t *source : current) {
+			const bool known = std::any_of(meters.begin(), meters.end(), [source](const auto &meter) {
+				return meter->tap->source() == source;
+			});
+			if (!known)
+				added.push_back(source);
+		}
+
+		// A source calibrated since the last refresh gets its target
+		CalibrationBaseline baseline;
+		for (auto &meter : meters)
+			meter->reading.calibrated = ProfileSwitcher::instance().baseline(meter->reading.name, baseline);
+	}
+	detach(dropped);
+
+	for (obs_source_t *source : added) {
+		auto meter = std::make_unique<Meter>();
+		meter->tap = AnalysisWorker::shared().tap(source);
+		if (!meter->tap)
+			continue;
+		meter->reading.name = meter->tap->name();
+		CalibrationBaseline baseline;
+		meter->reading.calibrated = ProfileSwitcher::instance().baseline(meter->reading.name, baseline);
+
+		// Listener last: from here on blocks arrive on the worker thread
+		Meter *raw = meter.get();
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			meters.push_back(std::move(meter));
+		}
+		raw->listenerId = raw->tap->addListener([this, raw](const AnalysisBlock &block) { onBlock(raw, block); });
+	}
+
+	if (!added.empty() || !dropped.empty())
+		obs_log(LOG_DEBUG, "[MeterBridge] Metering %zu sources", size());
+	return !added.empty() || !dropped.empty();
+}
+
+void MeterBridge::clear()
+{
+	std::vector<std::unique_ptr<Meter>> released;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		released.swap(meters);
+	}
+	detach(released);
+}
+
+size_t MeterBridge::size() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return meters.size();
+}
+
+void MeterBridge::snapshot(std::vector<MeterReading> &readings) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	readings.resize(meters.size());
+	for (size_t i = 0; i < meters.size(); i++)
+		readings[i] = meters[i]->reading;
+}
+
+void MeterBridge::onBlock(Meter *meter, const AnalysisBlock &block)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	meter->kPower[meter->kPosition] = block.kPower;
+	meter->kPosition = (meter->kPosition + 1) % MOMENTARY_BLOCKS;
+	double sum = 0.0;
+	for (double power : meter->kPower)
+		sum += power;
+	const double mean = sum / static_cast<double>(MOMENTARY_BLOCKS);
+
+	MeterReading &reading = meter->reading;
+	reading.rmsDb = block.rmsDb;
+	reading.peakDb = block.peakDb;
+	reading.momentaryLufs = mean > 1e-10 ? static_cast<float>(-0.691 + 10.0 * std::log10(mean)) : -100.0f;
+	reading.speech = block.speech;
+	reading.blocks++;
+}
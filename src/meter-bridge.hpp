@@ -0,0 +1,77 @@
+/*
+ * Meter Bridge - Live levels of every audio source against the calibration
+ * Copyright (C) 2025
+ *
+ * While the meter dock is visible, every audio source is tapped on the
+ * shared analysis worker (taps other features already hold are shared).
+ * Each 100 ms block updates the source's reading under one mutex, and the
+ * dock copies all readings out with a single snapshot() per frame, so the
+ * UI thread never touches the worker's state directly. Taps sit after the
+ * source's filters, so the readings are what the calibrated chain produces.
+ */
+
+#ifndef METER_BRIDGE_HPP
+#define METER_BRIDGE_HPP
+
+#include <obs.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "analysis-worker.hpp"
+
+struct MeterReading {
+	std::string name;
+	float rmsDb = -100.0f;  // first channel, last block
+	float peakDb = -100.0f; // first channel, last block
+	float momentaryLufs = -100.0f;
+	bool speech = false;
+	bool calibrated = false; // has a wizard baseline, so the target applies
+	uint64_t blocks = 0;     // blocks seen; unchanged means no new data
+};
+
+class MeterBridge {
+public:
+	static constexpr size_t MOMENTARY_BLOCKS = 4; // 400 ms
+
+	MeterBridge() = default;
+	~MeterBridge();
+
+	MeterBridge(const MeterBridge &) = delete;
+	MeterBridge &operator=(const MeterBridge &) = delete;
+
+	// UI thread. Taps audio sources that appeared since the last call and
+	// lets go of removed ones; returns true if the set changed.
+	bool refresh();
+
+	// UI thread. Releases every tap.
+	void clear();
+
+	size_t size() const;
+
+	// Any thread. Overwrites readings in place, so a reused vector does not
+	// allocate once it has grown to the source count.
+	void snapshot(std::vector<MeterReading> &readings) const;
+
+private:
+	struct Meter {
+		std::shared_ptr<AnalysisTap> tap;
+		int listenerId = 0;
+		MeterReading reading;
+		double kPower[MOMENTARY_BLOCKS] = {};
+		size_t kPosition = 0;
+	};
+
+	// Worker thread
+	void onBlock(Meter *meter, const AnalysisBlock &block);
+
+	static void detach(std::vector<std::unique_ptr<Meter>> &meters);
+
+	mutable std::mutex mutex;
+	std::vector<std::unique_ptr<Meter>> meters;
+};
+
+#endif // METER_BRIDGE_HPP
@@ -0,0 +1,236 @@
+/*
+ * Multiband Compressor Implementation
+ * Copyright (C) 2025
+ */
+
+#include "multiband-compressor.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// Butterworth sections; two in series make a Linkwitz-Riley filter
+static constexpr double SECTION_Q = 0.7071067811865476;
+
+static constexpr double LEVEL_FRAME_SECONDS = 0.01;
+
+template<size_t LANES>
+void MultibandCompressor::Sections<LANES>::set(size_t first, size_t count, const BiquadCoeffs &coeffs)
+{
+	for (size_t l = first; l < first + count; l++) {
+		b0[l] = coeffs.b0;
+		b1[l] = coeffs.b1;
+		b2[l] = coeffs.b2;
+		a1[l] = coeffs.a1;
+		a2[l] = coeffs.a2;
+	}
+}
+
+template<size_t LANES> void MultibandCompressor::Sections<LANES>::clear()
+{
+	std::fill(z1, z1 + LANES, 0.0f);
+	std::fill(z2, z2 + LANES, 0.0f);
+}
+
+// One transposed direct form II step on the first `count` lanes; lanes are
+// independent, so the loop vectorises
+template<size_t LANES, size_t COUNT>
+static inline void runSections(float *x, const float *b0, const float *b1, const float *b2, const float *a1,
+			       const float *a2, float *z1, float *z2)
+{
+	static_assert(COUNT <= LANES, "lane count exceeds the section arrays");
+	for (size_t l = 0; l < COUNT; l++) {
+		const float y = b0[l] * x[l] + z1[l];
+		z1[l] = b1[l] * x[l] - a1[l] * y + z2[l];
+		z2[l] = b2[l] * x[l] - a2[l] * y;
+		x[l] = y;
+	}
+}
+
+void MultibandCompressor::configure(uint32_t sampleRate, size_t channelCount, const MultibandSettings &settings)
+{
+	channelCount = std::max<size_t>(1, std::min(channelCount, MAX_CHANNELS));
+	const size_t lanes = channelCount == 1 ? 1 : channelCount == 2 ? 2 : MAX_CHANNELS;
+	const bool layoutChanged = sampleRate != rate || channelCount != channels;
+	rate = sampleRate;
+	channels = channelCount;
+	laneChannels = lanes;
+
+	const double nyquist = sampleRate * 0.5;
+	const double lowHz = std::max(20.0, std::min(static_cast<double>(settings.lowHz), nyquist * 0.4));
+	const double highHz = std::max(lowHz * 2.0, std::min(static_cast<double>(settings.highHz), nyquist * 0.8));
+	const BiquadCoeffs lowPass = BiquadCoeffs::lowPass(sampleRate, lowHz, SECTION_Q);
+	const BiquadCoeffs lowHighPass = BiquadCoeffs::highPass(sampleRate, lowHz, SECTION_Q);
+	const BiquadCoeffs highLowPass = BiquadCoeffs::lowPass(sampleRate, highHz, SECTION_Q);
+	const BiquadCoeffs highPass = BiquadCoeffs::highPass(sampleRate, highHz, SECTION_Q);
+
+	for (auto &sections : split) {
+		sections.set(0, lanes, lowPass);
+		sections.set(lanes, lanes, lowHighPass);
+	}
+	for (auto &sections : bandSplit) {
+		sections.set(0, lanes, highLowPass); // low band: allpass = LP + HP
+		sections.set(lanes, lanes, highPass);
+		sections.set(2 * lanes, lanes, highLowPass); // mid
+		sections.set(3 * lanes, lanes, highPass);    // high
+	}
+
+	const float ms = static_cast<float>(sampleRate) / 1000.0f;
+	for (int b = 0; b < BANDS; b++) {
+		const CompressorBand &band = settings.bands[b];
+		threshold[b] = band.thresholdDb;
+		slope[b] = 1.0f / std::max(1.0f, band.ratio) - 1.0f;
+		const float attackCoeff = 1.0f - std::exp(-1.0f / (std::max(0.1f, band.attackMs) * ms));
+		const float releaseCoeff = 1.0f - std::exp(-1.0f / (std::max(1.0f, band.releaseMs) * ms));
+		std::fill(attack + b * lanes, attack + (b + 1) * lanes, attackCoeff);
+		std::fill(release + b * lanes, release + (b + 1) * lanes, releaseCoeff);
+	}
+
+	if (layoutChanged)
+		reset();
+}
+
+void MultibandCompressor::reset()
+{
+	for (auto &sections : split)
+		sections.clear();
+	for (auto &sections : bandSplit)
+		sections.clear();
+	std::fill(std::begin(envelope), std::end(envelope), 0.0f);
+	std::fill(std::begin(gain), std::end(gain), 1.0f);
+	std::fill(std::begin(gainStep), std::end(gainStep), 0.0f);
+	controlPosition = 0;
+}
+
+void MultibandCompressor::process(float *const *planes, size_t frames)
+{
+	if (rate == 0)
+		return;
+	switch (laneChannels) {
+	case 1: run<1>(planes, frames); break;
+	case 2: run<2>(planes, frames); break;
+	default: run<MAX_CHANNELS>(planes, frames); break;
+	}
+}
+
+template<size_t CH> void MultibandCompressor::updateGains()
+{
+	for (size_t l = 0; l < BANDS * CH; l++) {
+		const size_t band = l / CH;
+		const float levelDb = 20.0f * std::log10(std::max(envelope[l], 1e-6f));
+		const float over = levelDb - threshold[band];
+		const float reduction = over > 0.0f ? over * slope[band] : 0.0f;
+		gainStep[l] = (std::pow(10.0f, reduction / 20.0f) - gain[l]) / static_cast<float>(CONTROL_FRAMES);
+	}
+}
+
+template<size_t CH> void MultibandCompressor::run(float *const *planes, size_t frames)
+{
+	constexpr size_t SPLIT = 2 * CH;
+	constexpr size_t SPLIT_BANDS = 4 * CH;
+	constexpr size_t GAINS = BANDS * CH;
+
+	float *outputs[CH] = {};
+	for (size_t c = 0; c < CH && c < channels; c++)
+		outputs[c] = planes[c];
+
+	float low[SPLIT];
+	float bands[SPLIT_BANDS];
+	float voice[GAINS];
+
+	for (size_t i = 0; i < frames; i++) {
+		for (size_t c = 0; c < CH; c++) {
+			const float x = outputs[c] ? outputs[c][i] : 0.0f;
+			low[c] = x;
+			low[CH + c] = x;
+		}
+		for (auto &s : split)
+			runSections<SPLIT_LANES, SPLIT>(low, s.b0, s.b1, s.b2, s.a1, s.a2, s.z1, s.z2);
+
+		for (size_t c = 0; c < CH; c++) {
+			bands[c] = low[c];
+			bands[CH + c] = low[c];
+			bands[2 * CH + c] = low[CH + c];
+			bands[3 * CH + c] = low[CH + c];
+		}
+		for (auto &s : bandSplit)
+			runSections<BAND_LANES, SPLIT_BANDS>(bands, s.b0, s.b1, s.b2, s.a1, s.a2, s.z1, s.z2);
+
+		for (size_t c = 0; c < CH; c++) {
+			voice[c] = bands[c] + bands[CH + c];
+			voice[CH + c] = bands[2 * CH + c];
+			voice[2 * CH + c] = bands[3 * CH + c];
+		}
+
+		// Peak envelopes and gain ramps for every band of every channel
+		for (size_t l = 0; l < GAINS; l++) {
+			const float level = std::fabs(voice[l]);
+			const float rising = static_cast<float>(level > envelope[l]); // select without a branch
+			const float coeff = release[l] + rising * (attack[l] - release[l]);
+			envelope[l] += coeff * (level - envelope[l]);
+			gain[l] += gainStep[l];
+			voice[l] *= gain[l];
+		}
+
+		for (size_t c = 0; c < CH; c++) {
+			if (outputs[c])
+				outputs[c][i] = voice[c] + voice[CH + c] + voice[2 * CH + c];
+		}
+
+		if (++controlPosition == CONTROL_FRAMES) {
+			controlPosition = 0;
+			updateGains<CH>();
+		}
+	}
+}
+
+void MultibandCompressor::bandLevels(const float *samples, size_t count, uint32_t sampleRate, float gateDb,
+				     std::vector<float> (&levels)[BANDS])
+{
+	const BiquadCoeffs lowPass = BiquadCoeffs::lowPass(sampleRate, LOW_CROSSOVER_HZ, SECTION_Q);
+	const BiquadCoeffs lowHighPass = BiquadCoeffs::highPass(sampleRate, LOW_CROSSOVER_HZ, SECTION_Q);
+	const BiquadCoeffs highLowPass = BiquadCoeffs::lowPass(sampleRate, HIGH_CROSSOVER_HZ, SECTION_Q);
+	const BiquadCoeffs highPass = BiquadCoeffs::highPass(sampleRate, HIGH_CROSSOVER_HZ, SECTION_Q);
+	BiquadState state[8];
+
+	const size_t frame = std::max<size_t>(1, static_cast<size_t>(LEVEL_FRAME_SECONDS * sampleRate));
+	const double gate = std::pow(10.0, gateDb / 10.0);
+	double broadband = 0.0;
+	double power[BANDS] = {};
+	size_t position = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		const float x = samples[i];
+		const float low = state[1].process(lowPass, state[0].process(lowPass, x));
+		const float rest = state[3].process(lowHighPass, state[2].process(lowHighPass, x));
+		const float mid = state[5].process(highLowPass, state[4].process(highLowPass, rest));
+		const float high = state[7].process(highPass, state[6].process(highPass, rest));
+
+		broadband += static_cast<double>(x) * x;
+		power[0] += static_cast<double>(low) * low;
+		power[1] += static_cast<double>(mid) * mid;
+		power[2] += static_cast<double>(high) * high;
+
+		if (++position < frame)
+			continue;
+		if (broadband / frame >= gate) {
+			for (int b = 0; b < BANDS; b++)
+				levels[b].push_back(static_cast<float>(10.0 * std::log10(std::max(power[b] / frame, 1e-12))));
+		}
+		broadband = 0.0;
+		std::fill(power, power + BANDS, 0.0);
+		position = 0;
+	}
+}
+
+BandDynamics MultibandCompressor::dynamics(std::vector<float> levels)
+{
+	BandDynamics result;
+	if (levels.empty())
+		return result;
+
+	std::sort(levels.begin(), levels.end());
+	const double last = static_cast<double>(levels.size() - 1);
+	result.medianDb = levels[static_cast<size_t>(std::lround(0.5 * last))];
+	result.loudDb = levels[static_cast<size_t>(std::lround(0.95 * last))];
+	return result;
+}
@@ -0,0 +1,176 @@
+/*
+ * Multiband Filter Implementation
+ * Copyright (C) 2025
+ *
+ * Wraps MultibandCompressor. Settings arrive from the UI thread through
+ * atomics and are applied at the start of the next audio block; the
+ * compressor keeps its state unless the sample rate or channel count
+ * changed.
+ */
+
+#include "multiband-filter.hpp"
+#include "dsp-tables.hpp"
+#include "multiband-compressor.hpp"
+
+#include <obs-module.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+
+static constexpr int BANDS = MultibandCompressor::BANDS;
+
+static const char *BAND_NAMES[BANDS] = {"Low", "Mid", "High"};
+
+// Boom and plosives are slow, sibilance is fast
+static const CompressorBand DEFAULT_BANDS[BANDS] = {
+	{-24.0f, 3.0f, 15.0f, 150.0f},
+	{-24.0f, 2.0f, 8.0f, 100.0f},
+	{-30.0f, 3.0f, 2.0f, 60.0f},
+};
+
+struct MultibandFilter {
+	MultibandCompressor compressor;
+
+	std::atomic<float> lowHz{MultibandCompressor::LOW_CROSSOVER_HZ};
+	std::atomic<float> highHz{MultibandCompressor::HIGH_CROSSOVER_HZ};
+	std::atomic<float> thresholdDb[BANDS];
+	std::atomic<float> ratio[BANDS];
+	std::atomic<float> attackMs[BANDS];
+	std::atomic<float> releaseMs[BANDS];
+	std::atomic<bool> settingsChanged{true};
+};
+
+static void bandKey(char *key, size_t size, int band, const char *name)
+{
+	snprintf(key, size, "band%d_%s", band + 1, name);
+}
+
+static const char *multibandFilterName(void *)
+{
+	return "Audio Calibrator Multiband Compressor";
+}
+
+static void multibandFilterUpdate(void *data, obs_data_t *settings)
+{
+	auto *filter = static_cast<MultibandFilter *>(data);
+	filter->lowHz.store(static_cast<float>(obs_data_get_double(settings, "low_hz")));
+	filter->highHz.store(static_cast<float>(obs_data_get_double(settings, "high_hz")));
+	char key[32];
+	for (int b = 0; b < BANDS; b++) {
+		bandKey(key, sizeof(key), b, "threshold");
+		filter->thresholdDb[b].store(static_cast<float>(obs_data_get_double(settings, key)));
+		bandKey(key, sizeof(key), b, "ratio");
+		filter->ratio[b].store(static_cast<float>(obs_data_get_double(settings, key)));
+		bandKey(key, sizeof(key), b, "attack");
+		filter->attackMs[b].store(static_cast<float>(obs_data_get_double(settings, key)));
+		bandKey(key, sizeof(key), b, "release");
+		filter->releaseMs[b].store(static_cast<float>(obs_data_get_double(settings, key)));
+	}
+	filter->settingsChanged.store(true, std::memory_order_release);
+}
+
+static void *multibandFilterCreate(obs_data_t *settings, obs_source_t *)
+{
+	auto *filter = new MultibandFilter();
+	multibandFilterUpdate(filter, settings);
+	return filter;
+}
+
+static void multibandFilterDestroy(void *data)
+{
+	delete static_cast<MultibandFilter *>(data);
+}
+
+static void multibandFilterDefaults(obs_data_t *settings)
+{
+	obs_data_set_default_double(settings, "low_hz", MultibandCompressor::LOW_CROSSOVER_HZ);
+	obs_data_set_default_double(settings, "high_hz", MultibandCompressor::HIGH_CROSSOVER_HZ);
+	char key[32];
+	for (int b = 0; b < BANDS; b++) {
+		bandKey(key, sizeof(key), b, "threshold");
+		obs_data_set_default_double(settings, key, DEFAULT_BANDS[b].thresholdDb);
+		bandKey(key, sizeof(key), b, "ratio");
+		obs_data_set_default_double(settings, key, DEFAULT_BANDS[b].ratio);
+		bandKey(key, sizeof(key), b, "attack");
+		obs_data_set_default_double(settings, key, DEFAULT_BANDS[b].attackMs);
+		bandKey(key, sizeof(key), b, "release");
+		obs_data_set_default_double(settings, key, DEFAULT_BANDS[b].releaseMs);
+	}
+}
+
+static obs_properties_t *multibandFilterProperties(void *)
+{
+	obs_properties_t *props = obs_properties_create();
+	obs_property_t *p = obs_properties_add_float_slider(props, "low_hz", "Low / Mid Crossover", 80.0, 600.0, 1.0);
+	obs_property_float_set_suffix(p, " Hz");
+	p = obs_properties_add_float_slider(props, "high_hz", "Mid / High Crossover", 1500.0, 10000.0, 10.0);
+	obs_property_float_set_suffix(p, " Hz");
+
+	char key[32];
+	char label[48];
+	for (int b = 0; b < BANDS; b++) {
+		bandKey(key, sizeof(key), b, "threshold");
+		snprintf(label, sizeof(label), "%s Threshold", BAND_NAMES[b]);
+		p = obs_properties_add_float_slider(props, key, label, -60.0, 0.0, 0.5);
+		obs_property_float_set_suffix(p, " dB");
+		bandKey(key, sizeof(key), b, "ratio");
+		snprintf(label, sizeof(label), "%s Ratio", BAND_NAMES[b]);
+		p = obs_properties_add_float_slider(props, key, label, 1.0, 20.0, 0.1);
+		obs_property_float_set_suffix(p, ":1");
+		bandKey(key, sizeof(key), b, "attack");
+		snprintf(label, sizeof(label), "%s Attack", BAND_NAMES[b]);
+		p = obs_properties_add_float_slider(props, key, label, 0.5, 100.0, 0.5);
+		obs_property_float_set_suffix(p, " ms");
+		bandKey(key, sizeof(key), b, "release");
+		snprintf(label, sizeof(label), "%s Release", BAND_NAMES[b]);
+		p = obs_properties_add_float_slider(props, key, label, 10.0, 1000.0, 1.0);
+		obs_property_float_set_suffix(p, " ms");
+	}
+	return props;
+}
+
+static struct obs_audio_data *multibandFilterAudio(void *data, struct obs_audio_data *audio)
+{
+	auto *filter = static_cast<MultibandFilter *>(data);
+	const DspConfig config = DspConfig::fromAudioOutput();
+	if (config.sampleRate == 0)
+		return audio;
+
+	const size_t channels = std::min<size_t>(config.channels, MultibandCompressor::MAX_CHANNELS);
+	if (filter->settingsChanged.exchange(false, std::memory_order_acquire) ||
+	    filter->compressor.sampleRate() != config.sampleRate || filter->compressor.channelCount() != channels) {
+		MultibandSettings settings;
+		settings.lowHz = filter->lowHz.load();
+		settings.highHz = filter->highHz.load();
+		for (int b = 0; b < BANDS; b++) {
+			settings.bands[b].thresholdDb = filter->thresholdDb[b].load();
+			settings.bands[b].ratio = filter->ratio[b].load();
+			settings.bands[b].attackMs = filter->attackMs[b].load();
+			settings.bands[b].releaseMs = filter->releaseMs[b].load();
+		}
+		filter->compressor.configure(config.sampleRate, channels, settings);
+	}
+
+	float *planes[MultibandCompressor::MAX_CHANNELS] = {};
+	for (size_t ch = 0; ch < channels; ch++)
+		planes[ch] = reinterpret_cast<float *>(audio->data[ch]);
+	filter->compressor.process(planes, audio->frames);
+	return audio;
+}
+
+void registerMultibandFilter()
+{
+	struct obs_source_info info = {};
+	info.id = MULTIBAND_FILTER_ID;
+	info.type = OBS_SOURCE_TYPE_FILTER;
+	info.output_flags = OBS_SOURCE_AUDIO;
+	info.get_name = multibandFilterName;
+	info.create = multibandFilterCreate;
+	info.destroy = multibandFilterDestroy;
+	info.get_defaults = multibandFilterDefaults;
+	info.get_properties = multibandFilterProperties;
+	info.update = multibandFilterUpdate;
+	info.filter_audio = multibandFilterAudio;
+	obs_register_source(&info);
+}
@@ -0,0 +1,14 @@
+/*
+ * Multiband Filter - Native OBS three-band compressor filter
+ * Copyright (C) 2025
+ */
+
+#ifndef MULTIBAND_FILTER_HPP
+#define MULTIBAND_FILTER_HPP
+
+static constexpr const char *MULTIBAND_FILTER_ID = "audio_calibrator_multiband_compressor";
+
+// Registers the filter type with OBS (call from obs_module_load)
+void registerMultibandFilter();
+
+#endif // MULTIBAND_FILTER_HPP
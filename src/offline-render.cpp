@@ -0,0 +1,89 @@
+/*
+ * Offline Render Implementation
+ * Copyright (C) 2025
+ */
+
+#include "offline-render.hpp"
+#include "filter-models.hpp"
+#include "wav-file.hpp"
+#include <plugin-support.h>
+
+#include <util/platform.h>
+
+#include <algorithm>
+#include <memory>
+
+OfflineRenderResult OfflineRenderer::render(const std::vector<CapturedAudioPtr> &steps, const CalibrationChain &chain,
+					    const std::string &directory)
+{
+	OfflineRenderResult result;
+
+	uint32_t sampleRate = 0;
+	for (const auto &step : steps) {
+		if (step && !step->samples.empty()) {
+			sampleRate = step->sampleRate;
+			break;
+		}
+	}
+	if (sampleRate == 0) {
+		result.message = "No captured step audio to render.";
+		return result;
+	}
+
+	result.beforePath = directory + "/calibration-preview-before.wav";
+	result.afterPath = directory + "/calibration-preview-after.wav";
+
+	WavWriter before;
+	WavWriter after;
+	if (!before.open(result.beforePath, sampleRate, 1) || !after.open(result.afterPath, sampleRate, 1)) {
+		result.message = "Could not create preview files.";
+		return result;
+	}
+
+	const uint64_t startNs = os_gettime_ns();
+
+	// One model instance across all steps, as the live chain would run
+	ChainModel model(chain, sampleRate);
+	std::vector<float> block(BLOCK_FRAMES);
+	const std::vector<float> gap(static_cast<size_t>(STEP_GAP_SECONDS * sampleRate), 0.0f);
+	bool ok = true;
+	size_t frames = 0;
+
+	for (const auto &step : steps) {
+		if (!step || step->samples.empty())
+			continue;
+		if (step->sampleRate != sampleRate) {
+			obs_log(LOG_WARNING, "[OfflineRender] Skipping step captured at %u Hz (expected %u Hz)",
+				step->sampleRate, sampleRate);
+			continue;
+		}
+
+		const std::vector<float> &samples = step->samples;
+		for (size_t offset = 0; offset < samples.size() && ok; offset += BLOCK_FRAMES) {
+			const size_t count = std::min(BLOCK_FRAMES, samples.size() - offset);
+			ok = before.write(samples.data() + offset, count);
+
+			std::copy(samples.begin() + offset, samples.begin() + offset + count, block.begin());
+			model.process(block.data(), count);
+			ok = ok && after.write(block.data(), count);
+			frames += count;
+		}
+
+		std::vector<float> tail(gap);
+		model.process(tail.data(), tail.size());
+		ok = ok && before.write(gap.data(), gap.size()) && after.write(tail.data(), tail.size());
+		frames += gap.size();
+	}
+
+	ok = before.close() && ok;
+	ok = after.close() && ok;
+
+	result.renderMs = static_cast<double>(os_gettime_ns() - startNs) / 1e6;
+	result.audioSeconds = static_cast<double>(frames) / sampleRate;
+	result.ok = ok;
+	result.message = ok ? "Preview rendered." : "Writing preview files failed.";
+
+	obs_log(LOG_INFO, "[OfflineRender] Rendered %.1f s of audio in %.1f ms (%s)", result.audioSeconds,
+		result.renderMs, ok ? "ok" : "write error");
+	return result;
+}
@@ -0,0 +1,37 @@
+/*
+ * Offline Render - Preview a proposed chain on captured calibration audio
+ * Copyright (C) 2025
+ */
+
+#ifndef OFFLINE_RENDER_HPP
+#define OFFLINE_RENDER_HPP
+
+#include <string>
+#include <vector>
+
+#include "audio-analyzer.hpp"
+#include "calibration-chain.hpp"
+
+struct OfflineRenderResult {
+	bool ok = false;
+	std::string message;
+	std::string beforePath;
+	std::string afterPath;
+	double audioSeconds = 0.0;
+	double renderMs = 0.0;
+};
+
+class OfflineRenderer {
+public:
+	// Runs the captured steps back to back (with a short gap) through the
+	// native chain model and streams before/after WAVs into directory.
+	// Steps without audio are skipped. Safe to call from a worker thread.
+	static OfflineRenderResult render(const std::vector<CapturedAudioPtr> &steps, const CalibrationChain &chain,
+					  const std::string &directory);
+
+private:
+	static constexpr size_t BLOCK_FRAMES = 1024;
+	static constexpr double STEP_GAP_SECONDS = 0.25;
+};
+
+#endif // OFFLINE_RENDER_HPP
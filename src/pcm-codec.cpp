@@ -0,0 +1,444 @@
+/*
+ * PCM Codec Implementation
+ * Copyright (C) 2025
+ *
+ * Block layout (MSB-first bit stream, byte aligned at the end):
+ *   16  sample count
+ *    8  method: 0-3 fixed predictor order, 0x10 + n quantised LPC order n
+ *   LPC only: 5 coefficient shift, then n x 16 signed coefficients
+ *   order x 24 warm-up samples (two's complement)
+ *   per partition: 5 Rice parameter k, then one code per residual
+ * A Rice code is q zeros, a one and k low bits; quotients of RICE_ESCAPE or
+ * more are sent as RICE_ESCAPE zeros followed by the raw 32-bit value.
+ */
+
+#include "pcm-codec.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+static constexpr int RICE_ESCAPE = 32;
+static constexpr int LPC_PRECISION = 14;
+static constexpr uint8_t METHOD_LPC = 0x10;
+
+static inline int countLeadingZeros(uint64_t value)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanReverse64(&index, value);
+	return 63 - static_cast<int>(index);
+#else
+	return __builtin_clzll(value);
+#endif
+}
+
+static inline uint32_t zigzag(int64_t value)
+{
+	return static_cast<uint32_t>((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+static inline int64_t unzigzag(uint32_t value)
+{
+	return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+class BitWriter {
+public:
+	explicit BitWriter(std::vector<uint8_t> &out) : out(out) {}
+
+	void put(uint32_t value, int bits)
+	{
+		const uint64_t mask = bits >= 32 ? 0xffffffffull : ((1ull << bits) - 1);
+		acc = (acc << bits) | (value & mask);
+		pending += bits;
+		while (pending >= 8) {
+			pending -= 8;
+			out.push_back(static_cast<uint8_t>(acc >> pending));
+		}
+	}
+
+	void putZeros(int count)
+	{
+		while (count > 0) {
+			const int n = std::min(count, 32);
+			put(0, n);
+			count -= n;
+		}
+	}
+
+	void putRice(uint32_t value, int k)
+	{
+		const uint32_t quotient = value >> k;
+		if (quotient < static_cast<uint32_t>(RICE_ESCAPE)) {
+			putZeros(static_cast<int>(quotient));
+			put(1, 1);
+			if (k > 0)
+				put(value, k);
+		} else {
+			putZeros(RICE_ESCAPE);
+			put(value, 32);
+		}
+	}
+
+	void flush()
+	{
+		if (pending > 0)
+			out.push_back(static_cast<uint8_t>(acc << (8 - pending)));
+		pending = 0;
+	}
+
+private:
+	std::vector<uint8_t> &out;
+	uint64_t acc = 0;
+	int pending = 0;
+};
+
+class BitReader {
+public:
+	BitReader(const uint8_t *data, size_t size) : begin(data), cursor(data), end(data + size) {}
+
+	uint32_t get(int bits)
+	{
+		if (available < bits)
+			refill();
+		const uint32_t value = static_cast<uint32_t>(cache >> (64 - bits));
+		skip(bits);
+		return value;
+	}
+
+	// Zeros before the next one (which is consumed), capped at limit; at the
+	// cap the zeros are consumed but nothing else.
+	int zeros(int limit)
+	{
+		int total = 0;
+		for (;;) {
+			refill();
+			if (cache != 0) {
+				const int lz = countLeadingZeros(cache);
+				if (total + lz >= limit) {
+					skip(limit - total);
+					return limit;
+				}
+				skip(lz + 1);
+				return total + lz;
+			}
+			const int take = std::min(available, limit - total);
+			skip(take);
+			total += take;
+			if (total >= limit || padding > 8)
+				return limit;
+		}
+	}
+
+	uint32_t getRice(int k)
+	{
+		// Fast path: the whole code is already in the cache
+		if (available < 48)
+			refill();
+		if (cache != 0) {
+			const int lz = countLeadingZeros(cache);
+			if (lz < RICE_ESCAPE && lz + 1 + k <= available) {
+				skip(lz + 1);
+				const uint32_t low = k > 0 ? static_cast<uint32_t>(cache >> (64 - k)) : 0;
+				skip(k);
+				return (static_cast<uint32_t>(lz) << k) | low;
+			}
+		}
+
+		const int quotient = zeros(RICE_ESCAPE);
+		if (quotient >= RICE_ESCAPE)
+			return get(32);
+		const uint32_t low = k > 0 ? get(k) : 0;
+		return (static_cast<uint32_t>(quotient) << k) | low;
+	}
+
+	// True if no bits past the end of the data were consumed
+	bool ok() const
+	{
+		const size_t consumedBits = static_cast<size_t>(cursor - begin + padding) * 8 - available;
+		return consumedBits <= static_cast<size_t>(end - begin) * 8;
+	}
+
+private:
+	void refill()
+	{
+		if (available <= 56 && end - cursor >= 8) {
+			uint64_t word = 0;
+			for (int i = 0; i < 8; i++)
+				word = (word << 8) | cursor[i];
+			const int bytes = (64 - available) / 8;
+			cache |= (word >> (64 - bytes * 8)) << (64 - bytes * 8 - available);
+			cursor += bytes;
+			available += bytes * 8;
+			return;
+		}
+		while (available <= 56) {
+			uint64_t byte = 0;
+			if (cursor < end)
+				byte = *cursor++;
+			else
+				padding++;
+			cache |= byte << (56 - available);
+			available += 8;
+		}
+	}
+
+	void skip(int bits)
+	{
+		cache = bits >= 64 ? 0 : cache << bits;
+		available -= bits;
+	}
+
+	const uint8_t *begin;
+	const uint8_t *cursor;
+	const uint8_t *end;
+	uint64_t cache = 0;
+	int available = 0;
+	size_t padding = 0;
+};
+
+int32_t PcmCodec::quantize(float sample)
+{
+	if (!(sample == sample))
+		return 0;
+	const float clamped = std::max(-1.0f, std::min(sample, 8388607.0f / 8388608.0f));
+	return static_cast<int32_t>(std::lrint(clamped * 8388608.0f));
+}
+
+static inline int64_t fixedPrediction(const int32_t *x, size_t i, int order)
+{
+	switch (order) {
+	case 1:
+		return x[i - 1];
+	case 2:
+		return 2 * static_cast<int64_t>(x[i - 1]) - x[i - 2];
+	case 3:
+		return 3 * static_cast<int64_t>(x[i - 1]) - 3 * static_cast<int64_t>(x[i - 2]) + x[i - 3];
+	default:
+		return 0;
+	}
+}
+
+static inline int64_t lpcPrediction(const int32_t *x, size_t i, const int32_t *coeffs, int order, int shift)
+{
+	int64_t sum = 0;
+	for (int j = 0; j < order; j++)
+		sum += static_cast<int64_t>(coeffs[j]) * x[i - 1 - j];
+	return sum >> shift;
+}
+
+// Quantised LPC coefficients for the block, or false if LPC does not apply
+static bool computeLpc(const int32_t *x, size_t count, int order, int32_t *coeffs, int &shift)
+{
+	if (count <= static_cast<size_t>(order) * 4)
+		return false;
+
+	// Welch-windowed autocorrelation
+	std::vector<double> windowed(count);
+	const double half = (static_cast<double>(count) - 1.0) / 2.0;
+	const double width = (static_cast<double>(count) + 1.0) / 2.0;
+	for (size_t i = 0; i < count; i++) {
+		const double t = (static_cast<double>(i) - half) / width;
+		windowed[i] = static_cast<double>(x[i]) * (1.0 - t * t);
+	}
+
+	double autoc[PcmCodec::MAX_LPC_ORDER + 1] = {};
+	for (int lag = 0; lag <= order; lag++) {
+		double sum = 0.0;
+		for (size_t i = static_cast<size_t>(lag); i < count; i++)
+			sum += windowed[i] * windowed[i - lag];
+		autoc[lag] = sum;
+	}
+	if (autoc[0] <= 0.0)
+		return false;
+
+	// Levinson-Durbin
+	double lpc[PcmCodec::MAX_LPC_ORDER] = {};
+	double error = autoc[0] * (1.0 + 1e-9);
+	for (int i = 0; i < order; i++) {
+		double r = -autoc[i + 1];
+		for (int j = 0; j < i; j++)
+			r -= lpc[j] * autoc[i - j];
+		r /= error;
+
+		lpc[i] = r;
+		for (int j = 0; j < i / 2; j++) {
+			const double tmp = lpc[j];
+			lpc[j] += r * lpc[i - 1 - j];
+			lpc[i - 1 - j] += r * tmp;
+		}
+		if (i % 2)
+			lpc[i / 2] += lpc[i / 2] * r;
+
+		error *= 1.0 - r * r;
+		if (error <= 0.0)
+			return false;
+	}
+
+	double maxCoeff = 0.0;
+	for (int j = 0; j < order; j++)
+		maxCoeff = std::max(maxCoeff, std::fabs(lpc[j]));
+	if (maxCoeff <= 0.0)
+		return false;
+
+	int exponent = 0;
+	std::frexp(maxCoeff, &exponent);
+	shift = (LPC_PRECISION - 1) - exponent;
+	if (shift < 0)
+		return false;
+	shift = std::min(shift, 31);
+
+	// Quantise with error feedback; predictor is x[n] ~ sum(-lpc[j] * x[n-1-j])
+	double carry = 0.0;
+	for (int j = 0; j < order; j++) {
+		carry += -lpc[j] * static_cast<double>(1 << shift);
+		const long q = std::lround(carry);
+		coeffs[j] = static_cast<int32_t>(std::max(-32768L, std::min(q, 32767L)));
+		carry -= static_cast<double>(coeffs[j]);
+	}
+	return true;
+}
+
+void PcmCodec::encodeBlock(const float *samples, size_t count, std::vector<uint8_t> &out)
+{
+	count = std::min(count, BLOCK_SAMPLES);
+
+	int32_t x[BLOCK_SAMPLES];
+	for (size_t i = 0; i < count; i++)
+		x[i] = quantize(samples[i]);
+
+	// Pick the predictor with the smallest residual magnitude
+	int bestOrder = 0;
+	bool useLpc = false;
+	uint64_t bestCost = UINT64_MAX;
+	for (int order = 0; order <= 3; order++) {
+		if (count <= static_cast<size_t>(order))
+			break;
+		uint64_t cost = 0;
+		for (size_t i = static_cast<size_t>(order); i < count; i++)
+			cost += static_cast<uint64_t>(std::llabs(x[i] - fixedPrediction(x, i, order)));
+		if (cost < bestCost) {
+			bestCost = cost;
+			bestOrder = order;
+		}
+	}
+
+	int32_t coeffs[MAX_LPC_ORDER] = {};
+	int shift = 0;
+	if (computeLpc(x, count, MAX_LPC_ORDER, coeffs, shift)) {
+		uint64_t cost = 0;
+		bool fits = true;
+		for (size_t i = MAX_LPC_ORDER; i < count && fits; i++) {
+			const int64_t residual = x[i] - lpcPrediction(x, i, coeffs, MAX_LPC_ORDER, shift);
+			fits = std::llabs(residual) < (1ll << 30);
+			cost += static_cast<uint64_t>(std::llabs(residual));
+		}
+		// Coefficients cost a little; require a clear win
+		if (fits && cost + cost / 64 < bestCost) {
+			useLpc = true;
+			bestOrder = MAX_LPC_ORDER;
+		}
+	}
+
+	BitWriter writer(out);
+	writer.put(static_cast<uint32_t>(count), 16);
+	if (useLpc) {
+		writer.put(METHOD_LPC + static_cast<uint32_t>(bestOrder), 8);
+		writer.put(static_cast<uint32_t>(shift), 5);
+		for (int j = 0; j < bestOrder; j++)
+			writer.put(static_cast<uint32_t>(coeffs[j]) & 0xffffu, 16);
+	} else {
+		writer.put(static_cast<uint32_t>(bestOrder), 8);
+	}
+
+	const size_t warmup = std::min(count, static_cast<size_t>(bestOrder));
+	for (size_t i = 0; i < warmup; i++)
+		writer.put(static_cast<uint32_t>(x[i]) & 0xffffffu, 24);
+
+	uint32_t residuals[BLOCK_SAMPLES];
+	for (size_t i = warmup; i < count; i++) {
+		const int64_t prediction = useLpc ? lpcPrediction(x, i, coeffs, bestOrder, shift)
+						  : fixedPrediction(x, i, bestOrder);
+		residuals[i - warmup] = zigzag(x[i] - prediction);
+	}
+
+	const size_t residualCount = count - warmup;
+	for (size_t start = 0; start < residualCount; start += PARTITION_SAMPLES) {
+		const size_t n = std::min(PARTITION_SAMPLES, residualCount - start);
+		uint64_t sum = 0;
+		for (size_t i = 0; i < n; i++)
+			sum += residuals[start + i];
+
+		int k = 0;
+		while (k < 30 && (static_cast<uint64_t>(n) << (k + 1)) <= sum)
+			k++;
+
+		writer.put(static_cast<uint32_t>(k), 5);
+		for (size_t i = 0; i < n; i++)
+			writer.putRice(residuals[start + i], k);
+	}
+
+	writer.flush();
+}
+
+size_t PcmCodec::decodeBlock(const uint8_t *data, size_t size, float *out, size_t maxCount)
+{
+	if (!data || size < 3)
+		return 0;
+
+	BitReader reader(data, size);
+	const size_t count = reader.get(16);
+	const uint32_t method = reader.get(8);
+	if (count == 0 || count > maxCount || count > BLOCK_SAMPLES)
+		return 0;
+
+	bool useLpc = false;
+	int order = 0;
+	int shift = 0;
+	int32_t coeffs[MAX_LPC_ORDER] = {};
+	if (method >= METHOD_LPC && method <= METHOD_LPC + MAX_LPC_ORDER) {
+		useLpc = true;
+		order = static_cast<int>(method - METHOD_LPC);
+		shift = static_cast<int>(reader.get(5));
+		for (int j = 0; j < order; j++)
+			coeffs[j] = static_cast<int16_t>(reader.get(16));
+	} else if (method <= 3) {
+		order = static_cast<int>(method);
+	} else {
+		return 0;
+	}
+
+	int32_t x[BLOCK_SAMPLES];
+	const size_t warmup = std::min(count, static_cast<size_t>(order));
+	for (size_t i = 0; i < warmup; i++) {
+		const uint32_t raw = reader.get(24);
+		x[i] = static_cast<int32_t>(raw << 8) >> 8;
+	}
+
+	for (size_t start = warmup; start < count; start += PARTITION_SAMPLES) {
+		const size_t end = std::min(count, start + PARTITION_SAMPLES);
+		const int k = static_cast<int>(reader.get(5));
+		if (useLpc) {
+			for (size_t i = start; i < end; i++) {
+				const int64_t residual = unzigzag(reader.getRice(k));
+				x[i] = static_cast<int32_t>(residual + lpcPrediction(x, i, coeffs, order, shift));
+			}
+		} else {
+			for (size_t i = start; i < end; i++) {
+				const int64_t residual = unzigzag(reader.getRice(k));
+				x[i] = static_cast<int32_t>(residual + fixedPrediction(x, i, order));
+			}
+		}
+		if (!reader.ok())
+			return 0;
+	}
+
+	for (size_t i = 0; i < count; i++)
+		out[i] = dequantize(x[i]);
+	return count;
+}
@@ -0,0 +1,36 @@
+/*
+ * PCM Codec - Lossless block coding of 24-bit-quantised audio
+ * Copyright (C) 2025
+ *
+ * Each block is independent (no state carries across blocks), so any
+ * block can be decoded on its own for random access. Samples are quantised
+ * to 24 bits, predicted with a fixed polynomial or quantised LPC predictor,
+ * and the residual is Rice coded in partitions of PARTITION_SAMPLES.
+ */
+
+#ifndef PCM_CODEC_HPP
+#define PCM_CODEC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class PcmCodec {
+public:
+	static constexpr size_t BLOCK_SAMPLES = 4096;
+	static constexpr int MAX_LPC_ORDER = 8;
+	static constexpr size_t PARTITION_SAMPLES = 256;
+
+	// 24-bit quantisation shared by encoder and decoder
+	static int32_t quantize(float sample);
+	static float dequantize(int32_t value) { return static_cast<float>(value) * (1.0f / 8388608.0f); }
+
+	// Append one encoded block of count (<= BLOCK_SAMPLES) samples to out
+	static void encodeBlock(const float *samples, size_t count, std::vector<uint8_t> &out);
+
+	// Decode a block written by encodeBlock. Returns the sample count, or 0
+	// if the data is corrupt or does not fit in maxCount.
+	static size_t decodeBlock(const uint8_t *data, size_t size, float *out, size_t maxCount);
+};
+
+#endif // PCM_CODEC_HPP
@@ -0,0 +1,156 @@
+/*
+ * PCM History Implementation
+ * Copyright (C) 2025
+ */
+
+#include "pcm-history.hpp"
+#include "pcm-codec.hpp"
+#include "worker-pool.hpp"
+
+#include <util/platform.h>
+
+#include <algorithm>
+
+// Staging must absorb poll latency; two seconds is far more than a block
+static constexpr double STAGING_SECONDS = 2.0;
+
+std::shared_ptr<PcmHistory> PcmHistory::create(uint32_t sampleRate, double maxSeconds)
+{
+	std::shared_ptr<PcmHistory> history(new PcmHistory(sampleRate, maxSeconds));
+
+	std::weak_ptr<PcmHistory> weak = history;
+	history->pollerId = WorkerPool::shared().addPoller([weak]() {
+		if (std::shared_ptr<PcmHistory> self = weak.lock())
+			self->encodePending();
+	});
+	return history;
+}
+
+PcmHistory::PcmHistory(uint32_t sampleRate, double maxSeconds)
+	: rate(sampleRate),
+	  maxSamples(static_cast<uint64_t>(std::max(maxSeconds, 0.0) * sampleRate)),
+	  staging(std::max<size_t>(static_cast<size_t>(STAGING_SECONDS * sampleRate), 4 * PcmCodec::BLOCK_SAMPLES))
+{
+}
+
+PcmHistory::~PcmHistory()
+{
+	WorkerPool::shared().removePoller(pollerId);
+}
+
+bool PcmHistory::hasPendingBlock() const
+{
+	return staging.written() - encodedEnd.load(std::memory_order_relaxed) >= PcmCodec::BLOCK_SAMPLES;
+}
+
+void PcmHistory::push(const float *samples, size_t count)
+{
+	staging.write(samples, count);
+}
+
+void PcmHistory::encodePending()
+{
+	float block[PcmCodec::BLOCK_SAMPLES];
+	std::vector<uint8_t> data;
+
+	while (hasPendingBlock()) {
+		uint64_t position = encodedEnd.load(std::memory_order_relaxed);
+		uint64_t dropped = 0;
+
+		if (position < staging.oldest()) {
+			// The audio thread lapped us; skip to what is still there
+			const uint64_t resume = staging.oldest();
+			dropped = resume - position;
+			position = resume;
+			encodedEnd.store(position, std::memory_order_release);
+			if (!hasPendingBlock())
+				break;
+		}
+
+		// Lapped while copying: the next pass skips ahead
+		if (!staging.read(position, block, PcmCodec::BLOCK_SAMPLES))
+			continue;
+
+		const uint64_t start = os_gettime_ns();
+		data.clear();
+		PcmCodec::encodeBlock(block, PcmCodec::BLOCK_SAMPLES, data);
+		const uint64_t elapsed = os_gettime_ns() - start;
+
+		{
+			std::lock_guard<std::mutex> lock(blockMutex);
+			blocks.push_back({position, static_cast<uint32_t>(PcmCodec::BLOCK_SAMPLES), data});
+			counters.encodedSamples += PcmCodec::BLOCK_SAMPLES;
+			counters.encodedBytes += data.size();
+			counters.encodeNs += elapsed;
+			counters.droppedSamples += dropped;
+			counters.storedBytes += data.size();
+
+			const uint64_t end = position + PcmCodec::BLOCK_SAMPLES;
+			while (!blocks.empty() && end - blocks.front().position > maxSamples) {
+				counters.storedBytes -= blocks.front().data.size();
+				blocks.pop_front();
+			}
+		}
+
+		encodedEnd.store(position + PcmCodec::BLOCK_SAMPLES, std::memory_order_release);
+	}
+}
+
+uint64_t PcmHistory::beginPosition() const
+{
+	std::lock_guard<std::mutex> lock(blockMutex);
+	if (!blocks.empty())
+		return blocks.front().position;
+	return std::max(encodedEnd.load(std::memory_order_acquire), staging.oldest());
+}
+
+bool PcmHistory::read(uint64_t position, float *out, size_t count) const
+{
+	const uint64_t end = position + count;
+	const uint64_t encoded = encodedEnd.load(std::memory_order_acquire);
+
+	// Encoded part from the blocks
+	if (position < encoded) {
+		const uint64_t blockEnd = std::min(end, encoded);
+		float decoded[PcmCodec::BLOCK_SAMPLES];
+
+		std::lock_guard<std::mutex> lock(blockMutex);
+		auto it = std::upper_bound(blocks.begin(), blocks.end(), position,
+					   [](uint64_t pos, const Block &block) { return pos < block.position; });
+		if (it == blocks.begin())
+			return false;
+		--it;
+
+		while (position < blockEnd) {
+			if (it == blocks.end() || it->position > position || it->position + it->count <= position)
+				return false;
+
+			const size_t offset = static_cast<size_t>(position - it->position);
+			const size_t take = static_cast<size_t>(std::min<uint64_t>(it->count - offset, blockEnd - position));
+
+			// Whole blocks decode straight into the output
+			float *target = (offset == 0 && take == it->count) ? out : decoded;
+			if (PcmCodec::decodeBlock(it->data.data(), it->data.size(), target, it->count) != it->count)
+				return false;
+			if (target == decoded)
+				std::copy(decoded + offset, decoded + offset + take, out);
+
+			out += take;
+			position += take;
+			++it;
+		}
+	}
+
+	// Tail that is still waiting in staging
+	if (position < end)
+		return staging.read(position, out, static_cast<size_t>(end - position));
+	return true;
+}
+
+PcmHistory::Stats PcmHistory::stats() const
+{
+	std::lock_guard<std::mutex> lock(blockMutex);
+	Stats result = counters;
+	result.storedBlocks = blocks.size();
+	return result;
+}
@@ -0,0 +1,85 @@
+/*
+ * PCM History - Compressed rolling history of one audio channel
+ * Copyright (C) 2025
+ *
+ * The audio thread only copies into a short staging ring. A poller on the
+ * worker pool's poll thread, registered for the history's lifetime, picks
+ * up full blocks and losslessly encodes them into independently decodable
+ * blocks, so minutes of audio fit in a fraction of the raw size and any
+ * range can be read back by absolute sample position.
+ */
+
+#ifndef PCM_HISTORY_HPP
+#define PCM_HISTORY_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "sample-ring.hpp"
+
+class PcmHistory {
+public:
+	struct Stats {
+		uint64_t encodedSamples = 0; // total ever encoded
+		uint64_t encodedBytes = 0;   // total ever produced by the encoder
+		uint64_t encodeNs = 0;       // time spent encoding on the poll thread
+		uint64_t droppedSamples = 0; // lapped in staging before encoding
+		size_t storedBlocks = 0;
+		size_t storedBytes = 0;
+
+		// Compression ratio against 32-bit float
+		double ratio() const
+		{
+			return encodedBytes ? static_cast<double>(encodedSamples * sizeof(float)) / encodedBytes : 0.0;
+		}
+	};
+
+	static std::shared_ptr<PcmHistory> create(uint32_t sampleRate, double maxSeconds);
+	~PcmHistory();
+
+	uint32_t sampleRate() const { return rate; }
+
+	// Audio thread: copy into staging (no locking or allocation)
+	void push(const float *samples, size_t count);
+
+	// Readable range [beginPosition, endPosition) in absolute samples
+	uint64_t beginPosition() const;
+	uint64_t endPosition() const { return staging.written(); }
+
+	// Decode [position, position + count). False if any part has been
+	// evicted, dropped or not captured yet.
+	bool read(uint64_t position, float *out, size_t count) const;
+
+	Stats stats() const;
+
+private:
+	PcmHistory(uint32_t sampleRate, double maxSeconds);
+
+	void encodePending();
+	bool hasPendingBlock() const;
+
+	struct Block {
+		uint64_t position;
+		uint32_t count;
+		std::vector<uint8_t> data;
+	};
+
+	const uint32_t rate;
+	const uint64_t maxSamples;
+
+	SampleRing staging;
+	int pollerId = 0;
+
+	// Only advanced by the poller
+	std::atomic<uint64_t> encodedEnd{0};
+
+	mutable std::mutex blockMutex;
+	std::deque<Block> blocks;
+	Stats counters;
+};
+
+#endif // PCM_HISTORY_HPP
@@ -0,0 +1,139 @@
+/*
+ * Pitch Tracker Implementation
+ * Copyright (C) 2025
+ */
+
+#include "pitch-tracker.hpp"
+#include "dsp-tables.hpp"
+#include "voice-activity.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+PitchTracker::PitchTracker(uint32_t sampleRate) : rate(std::max<uint32_t>(sampleRate, 8000))
+{
+	maxLag = static_cast<size_t>(std::ceil(rate / MIN_HZ));
+	minLag = static_cast<size_t>(std::floor(rate / MAX_HZ));
+	window = maxLag; // at least one period of the lowest voice
+	plan = DspTableCache::instance().fftPlan(FftPlan::nextPowerOfTwo(window + maxLag));
+
+	const size_t n = plan->size();
+	padded.assign(n, 0.0f);
+	leading.resize(plan->bins());
+	whole.resize(plan->bins());
+	scratch.resize(n / 2);
+	correlation.resize(n);
+	energy.resize(window + maxLag + 1);
+	difference.resize(maxLag + 1);
+}
+
+double PitchTracker::estimate(const float *samples)
+{
+	const size_t length = window + maxLag;
+	energy[0] = 0.0;
+	for (size_t i = 0; i < length; i++)
+		energy[i + 1] = energy[i] + static_cast<double>(samples[i]) * samples[i];
+	if (energy[window] <= 1e-12)
+		return 0.0;
+
+	// r(tau) = sum over the window of x[j] x[j + tau]: the frame's spectrum
+	// times the conjugate of its leading window's. The transform is long
+	// enough that no lag up to maxLag wraps around.
+	std::fill(padded.begin(), padded.end(), 0.0f);
+	std::copy(samples, samples + window, padded.begin());
+	plan->forwardReal(padded.data(), leading.data(), scratch.data());
+	std::copy(samples + window, samples + length, padded.begin() + static_cast<std::ptrdiff_t>(window));
+	plan->forwardReal(padded.data(), whole.data(), scratch.data());
+	for (size_t k = 0; k < whole.size(); k++)
+		whole[k] *= std::conj(leading[k]);
+	plan->inverseReal(whole.data(), correlation.data(), scratch.data());
+	const double scale = 1.0 / static_cast<double>(plan->size());
+
+	// Cumulative-mean-normalised difference d'(tau)
+	difference[0] = 1.0;
+	double running = 0.0;
+	for (size_t tau = 1; tau <= maxLag; tau++) {
+		const double d = energy[window] + (energy[window + tau] - energy[tau]) - 2.0 * correlation[tau] * scale;
+		running += std::max(d, 0.0);
+		difference[tau] = running > 0.0 ? std::max(d, 0.0) * static_cast<double>(tau) / running : 1.0;
+	}
+
+	// First dip under the threshold, followed down to its minimum
+	size_t tau = minLag;
+	while (tau < maxLag && difference[tau] >= THRESHOLD)
+		tau++;
+	if (tau >= maxLag)
+		return 0.0;
+	while (tau + 1 < maxLag && difference[tau + 1] < difference[tau])
+		tau++;
+
+	// Parabolic interpolation between lags
+	double period = static_cast<double>(tau);
+	const double a = difference[tau - 1];
+	const double b = difference[tau];
+	const double c = difference[tau + 1];
+	const double curvature = a - 2.0 * b + c;
+	if (curvature > 0.0)
+		period += 0.5 * (a - c) / curvature;
+	return static_cast<double>(rate) / period;
+}
+
+std::vector<float> PitchTracker::track(const float *samples, size_t count)
+{
+	std::vector<float> pitches;
+	VoiceActivityDetector vad;
+	vad.configure(rate);
+	const size_t hop = vad.frameSamples();
+	const size_t length = frameSamples();
+
+	for (size_t start = 0; start + length <= count; start += hop) {
+		vad.process(samples + start, hop);
+
+		// Speech proper, not the hangover after it
+		if (!vad.isSpeech() ||
+		    vad.lastFrameDb() < vad.noiseFloorDb() + VoiceActivityDetector::SPEECH_MARGIN_DB)
+			continue;
+
+		const double f0 = estimate(samples + start);
+		if (f0 >= MIN_HZ && f0 <= MAX_HZ)
+			pitches.push_back(static_cast<float>(f0));
+	}
+	return pitches;
+}
+
+F0Distribution F0Distribution::fromPitches(std::vector<float> pitches)
+{
+	F0Distribution distribution;
+	if (pitches.empty())
+		return distribution;
+
+	std::sort(pitches.begin(), pitches.end());
+	const float median = pitches[pitches.size() / 2];
+	const auto first = std::lower_bound(pitches.begin(), pitches.end(), median * 0.5f);
+	const auto last = std::upper_bound(pitches.begin(), pitches.end(), median * 2.0f);
+	const size_t count = static_cast<size_t>(last - first);
+	if (count == 0)
+		return distribution;
+
+	auto percentile = [&](double p) {
+		return *(first + static_cast<std::ptrdiff_t>(std::lround(p * static_cast<double>(count - 1))));
+	};
+	distribution.frames = count;
+	distribution.lowHz = percentile(0.05);
+	distribution.p10Hz = percentile(0.10);
+	distribution.medianHz = percentile(0.50);
+	distribution.highHz = percentile(0.95);
+	return distribution;
+}
+
+std::string F0Distribution::summary() const
+{
+	if (!valid())
+		return "No voiced speech found";
+
+	char text[160];
+	snprintf(text, sizeof(text), "F0 %.0f Hz median (5%% %.0f Hz, 10%% %.0f Hz, 95%% %.0f Hz; %zu voiced frames)",
+		 medianHz, lowHz, p10Hz, highHz, frames);
+	return text;
+}
@@ -0,0 +1,78 @@
+/*
+ * Pitch Tracker - Speaking fundamental frequency (YIN)
+ * Copyright (C) 2025
+ *
+ * YIN's squared-difference function is expanded into two energy terms and
+ * an autocorrelation; the energies come from prefix sums and the
+ * autocorrelation from one forward transform per frame against the
+ * transform of the frame's leading window, so each 10 ms hop costs
+ * O(n log n) instead of O(n * lags). Only hops the voice activity
+ * detector calls speech and that have a clear period are kept.
+ */
+
+#ifndef PITCH_TRACKER_HPP
+#define PITCH_TRACKER_HPP
+
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "fft.hpp"
+
+struct F0Distribution {
+	size_t frames = 0;    // voiced hops
+	float lowHz = 0.0f;   // 5th percentile
+	float p10Hz = 0.0f;
+	float medianHz = 0.0f;
+	float highHz = 0.0f;  // 95th percentile
+
+	bool valid() const { return frames > 0; }
+
+	// Percentiles of a set of per-hop estimates (octave-down errors below
+	// half the median are dropped first)
+	static F0Distribution fromPitches(std::vector<float> pitches);
+
+	std::string summary() const;
+};
+
+class PitchTracker {
+public:
+	static constexpr double MIN_HZ = 50.0;
+	static constexpr double MAX_HZ = 500.0;
+	static constexpr double HOP_MS = 10.0;
+
+	// Cumulative-mean-normalised difference below this counts as periodic
+	static constexpr double THRESHOLD = 0.15;
+
+	explicit PitchTracker(uint32_t sampleRate);
+
+	uint32_t sampleRate() const { return rate; }
+
+	// F0 of the frame starting at samples (frameSamples() long), or 0 if
+	// it has no clear period
+	double estimate(const float *samples);
+
+	size_t frameSamples() const { return window + maxLag; }
+
+	// F0 of every voiced hop of a mono clip; safe on a worker thread
+	std::vector<float> track(const float *samples, size_t count);
+
+private:
+	uint32_t rate;
+	size_t window;
+	size_t minLag;
+	size_t maxLag;
+	std::shared_ptr<const FftPlan> plan;
+
+	std::vector<float> padded;
+	std::vector<std::complex<float>> leading;
+	std::vector<std::complex<float>> whole;
+	std::vector<std::complex<float>> scratch;
+	std::vector<float> correlation;
+	std::vector<double> energy; // prefix sums of x^2 over the frame
+	std::vector<double> difference;
+};
+
+#endif // PITCH_TRACKER_HPP
@@ -11,12 +11,33 @@
 #include <obs-module.h>
 #include <obs-frontend-api.h>
 #include <plugin-support.h>
+#include "analysis-worker.hpp"
+#include "balance-dialog.hpp"
+#ifdef ENABLE_BENCHMARKS
+#include "benchmarks.hpp"
+#endif
+#include "breath-filter.hpp"
 #include "calibration-dialog.hpp"
+#include "dsp-tables.hpp"
+#include "howl-filter.hpp"
+#include "live-recalibrator.hpp"
+#include "loudness-balancer.hpp"
+#include "meter-bridge-widget.hpp"
+#include "multiband-filter.hpp"
+#include "profile-switcher.hpp"
+#include "retro-recorder.hpp"
+#include "voice-eq-filter.hpp"
+#include "worker-pool.hpp"
 
 OBS_DECLARE_MODULE()
 OBS_MODULE_USE_DEFAULT_LOCALE(PLUGIN_NAME, "en-US")
 
 static CalibrationDialog *calibrationDialog = nullptr;
+static BalanceDialog *balanceDialog = nullptr;
+static MeterBridgeWidget *meterBridge = nullptr;
+static obs_hotkey_id retroHotkey = OBS_INVALID_HOTKEY_ID;
+static const char *RETRO_HOTKEY_NAME = "audio_calibrator_retro_capture";
+static const char *RETRO_SECONDS_KEY = "audio_calibrator_retro_seconds";
 
 static void showCalibrationWizard()
 {
@@ -40,9 +61,84 @@ static void menuCallback(void *)
     showCalibrationWizard();
 }
 
+static void balanceMenuCallback(void *)
+{
+    if (!balanceDialog) {
+        QWidget *parent = static_cast<QWidget*>(obs_frontend_get_main_window());
+        balanceDialog = new BalanceDialog(parent);
+        balanceDialog->setAttribute(Qt::WA_DeleteOnClose);
+
+        QObject::connect(balanceDialog, &QDialog::destroyed, []() {
+            balanceDialog = nullptr;
+        });
+    }
+
+    balanceDialog->show();
+    balanceDialog->raise();
+    balanceDialog->activateWindow();
+}
+
+static void retroHotkeyCallback(void *, obs_hotkey_id, obs_hotkey_t *, bool pressed)
+{
+    if (!pressed)
+        return;
+
+    // Hotkeys fire off the UI thread, where the profile lookups belong
+    obs_queue_task(OBS_TASK_UI, [](void *) { RetroRecorder::instance().capture(); }, nullptr, false);
+}
+
+static void saveHotkeys(obs_data_t *saveData, bool saving, void *)
+{
+    if (saving) {
+        obs_data_array_t *bindings = obs_hotkey_save(retroHotkey);
+        obs_data_set_array(saveData, RETRO_HOTKEY_NAME, bindings);
+        obs_data_array_release(bindings);
+        obs_data_set_double(saveData, RETRO_SECONDS_KEY, AnalysisWorker::shared().retroSeconds());
+    } else {
+        obs_data_array_t *bindings = obs_data_get_array(saveData, RETRO_HOTKEY_NAME);
+        obs_hotkey_load(retroHotkey, bindings);
+        obs_data_array_release(bindings);
+
+        // The hotkey works without the wizard, so the ring length it set
+        // is restored here too
+        if (obs_data_has_user_value(saveData, RETRO_SECONDS_KEY))
+            AnalysisWorker::shared().setRetroSeconds(obs_data_get_double(saveData, RETRO_SECONDS_KEY));
+    }
+}
+
+static void frontendEvent(enum obs_frontend_event event, void *)
+{
+    if (event != OBS_FRONTEND_EVENT_SCENE_CHANGED)
+        return;
+
+    obs_source_t *scene = obs_frontend_get_current_scene();
+    if (!scene)
+        return;
+    ProfileSwitcher::instance().onSceneChanged(obs_source_get_name(scene));
+    obs_source_release(scene);
+}
+
+#ifdef ENABLE_BENCHMARKS
+static void benchmarksMenuCallback(void *)
+{
+    // Widgets paint on this thread, so the window stalls for the paint
+    // benchmark; the DSP benchmarks go to a worker
+    Benchmarks::meterBridgePaint();
+
+    if (!WorkerPool::shared().submit(Benchmarks::runAll))
+        obs_log(LOG_WARNING, "Could not start benchmarks");
+    else
+        obs_log(LOG_INFO, "Benchmarks running in the background; results follow in this log");
+}
+#endif
+
 bool obs_module_load(void)
 {
     obs_log(LOG_INFO, "OBS Audio Calibrator plugin loaded (version %s)", PLUGIN_VERSION);
+
+    // Before anything that plans tables or registers pollers, so the audio
+    // thread never has to start it
+    WorkerPool::shared().start();
     
     // Add menu item to Tools menu
     obs_frontend_add_tools_menu_item(
@@ -52,6 +148,60 @@ bool obs_module_load(void)
     );
     
     obs_log(LOG_INFO, "Added 'Audio Calibration Wizard' to Tools menu");
+
+    obs_frontend_add_tools_menu_item(
+        "Audio Calibrator Live Balance",
+        balanceMenuCallback,
+        nullptr
+    );
+
+#ifdef ENABLE_BENCHMARKS
+    // Developer builds only (-DENABLE_BENCHMARKS=ON)
+    obs_frontend_add_tools_menu_item(
+        "Audio Calibrator Benchmarks",
+        benchmarksMenuCallback,
+        nullptr
+    );
+#endif
+
+    // Meters for every audio source, as a dock OBS keeps and restores
+    QWidget *mainWindow = static_cast<QWidget*>(obs_frontend_get_main_window());
+    meterBridge = new MeterBridgeWidget(mainWindow);
+    QObject::connect(meterBridge, &QObject::destroyed, []() {
+        meterBridge = nullptr;
+    });
+    if (!obs_frontend_add_dock_by_id(MeterBridgeWidget::DOCK_ID, "Calibrated Meters", meterBridge)) {
+        obs_log(LOG_WARNING, "Could not add the meter dock");
+        delete meterBridge;
+        meterBridge = nullptr;
+    }
+
+    registerHowlFilter();
+    registerBreathFilter();
+    registerVoiceEqFilter();
+    registerMultibandFilter();
+
+    retroHotkey = obs_hotkey_register_frontend(
+        RETRO_HOTKEY_NAME,
+        "Audio Calibrator: Capture, analyse and save the last seconds of every audio input",
+        retroHotkeyCallback,
+        nullptr
+    );
+    obs_frontend_add_save_callback(saveHotkeys, nullptr);
+
+    // Per-scene profiles: filter settings are built here, once
+    ProfileSwitcher::instance().load();
+    obs_frontend_add_event_callback(frontendEvent, nullptr);
+
+    // Per-source "recalibrate now" hotkeys, also for sources loaded later
+    LiveRecalibrator::instance().attach();
+
+    // Retro rings on every audio input, for the hotkey
+    RetroRecorder::instance().attach();
+
+    // Plan analysis tables for the current audio configuration up front so
+    // attaching analyzers never has to compute them
+    DspTableCache::instance().prewarm(DspConfig::fromAudioOutput());
     
     return true;
 }
@@ -62,6 +212,31 @@ void obs_module_unload(void)
         calibrationDialog->close();
         calibrationDialog = nullptr;
     }
+    if (balanceDialog) {
+        balanceDialog->close();
+        balanceDialog = nullptr;
+    }
+
+    // The dock itself belongs to OBS; only its taps are ours
+    if (meterBridge)
+        meterBridge->detach();
+
+    RetroRecorder::instance().detach();
+
+    // Puts the hosts' faders back before the taps go away
+    LoudnessBalancer::instance().stop();
+    AnalysisWorker::shared().shutdown();
+
+    LiveRecalibrator::instance().detach();
+    obs_frontend_remove_event_callback(frontendEvent, nullptr);
+    ProfileSwitcher::instance().clear();
+
+    obs_frontend_remove_save_callback(saveHotkeys, nullptr);
+    obs_hotkey_unregister(retroHotkey);
+    retroHotkey = OBS_INVALID_HOTKEY_ID;
+
+    WorkerPool::shared().shutdown();
+    DspTableCache::instance().clear();
     
     obs_log(LOG_INFO, "OBS Audio Calibrator plugin unloaded");
 }
@@ -0,0 +1,149 @@
+/*
+ * Polyphase Resampler Implementation
+ * Copyright (C) 2025
+ */
+
+#include "polyphase-resampler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+static constexpr double PI = 3.14159265358979323846;
+
+// Zeroth-order modified Bessel function of the first kind (power series)
+static double besselI0(double x)
+{
+	double sum = 1.0;
+	double term = 1.0;
+	const double quarter = 0.25 * x * x;
+	for (int k = 1; k < 50; k++) {
+		term *= quarter / (static_cast<double>(k) * k);
+		sum += term;
+		if (term < sum * 1e-12)
+			break;
+	}
+	return sum;
+}
+
+PolyphasePlan::PolyphasePlan(uint32_t inputRate, uint32_t outputRate) : inRate(inputRate), outRate(outputRate)
+{
+	if (inputRate == 0 || outputRate == 0 || inputRate == outputRate)
+		return;
+
+	const uint32_t divisor = std::gcd(inputRate, outputRate);
+	upFactor = outputRate / divisor;
+	downFactor = inputRate / divisor;
+	if (upFactor > MAX_PHASES) {
+		downFactor = static_cast<uint32_t>(
+			std::lround(static_cast<double>(inputRate) * MAX_PHASES / static_cast<double>(outputRate)));
+		upFactor = MAX_PHASES;
+	}
+
+	// Kaiser design: the transition band sets the length, which in input
+	// samples is the same for every phase count
+	const double nyquist = 0.5 * std::min(inputRate, outputRate);
+	const double transitionHz = (1.0 - PASSBAND) * nyquist;
+	const double length = (STOPBAND_DB - 8.0) * inputRate / (2.285 * 2.0 * PI * transitionHz);
+	tapCount = (static_cast<size_t>(std::ceil(length)) + LANES - 1) / LANES * LANES;
+
+	const double upRate = static_cast<double>(inputRate) * upFactor;
+	const double cutoff = 0.5 * (1.0 + PASSBAND) * nyquist / upRate; // cycles per upsampled sample
+	const double beta = 0.1102 * (STOPBAND_DB - 8.7);
+	const size_t total = tapCount * upFactor;
+	const double center = 0.5 * static_cast<double>(total - 1);
+	const double norm = besselI0(beta);
+
+	coeffs.assign(total, 0.0f);
+	for (uint32_t p = 0; p < upFactor; p++) {
+		float *taps = coeffs.data() + static_cast<size_t>(p) * tapCount;
+		double sum = 0.0;
+		for (size_t j = 0; j < tapCount; j++) {
+			const double t = static_cast<double>(p + j * upFactor) - center;
+			const double x = 2.0 * cutoff * t;
+			const double sinc = std::fabs(x) < 1e-12 ? 1.0 : std::sin(PI * x) / (PI * x);
+			const double r = t / center;
+			const double window = besselI0(beta * std::sqrt(std::max(0.0, 1.0 - r * r))) / norm;
+			const double h = 2.0 * cutoff * sinc * window;
+			taps[tapCount - 1 - j] = static_cast<float>(h); // oldest sample first
+			sum += h;
+		}
+		// Unity DC gain in every phase, so a constant stays constant
+		if (sum > 0.0) {
+			for (size_t j = 0; j < tapCount; j++)
+				taps[j] = static_cast<float>(taps[j] / sum);
+		}
+	}
+}
+
+void PolyphaseResampler::configure(std::shared_ptr<const PolyphasePlan> next)
+{
+	plan = std::move(next);
+	reset();
+}
+
+void PolyphaseResampler::reset()
+{
+	history.clear();
+	phase = 0;
+	position = 0;
+	if (!plan || plan->identity())
+		return;
+
+	history.assign(plan->taps() - 1, 0.0f);
+	position = plan->taps() - 1;
+}
+
+size_t PolyphaseResampler::maxOutput(size_t count) const
+{
+	if (!plan || plan->identity())
+		return count;
+	const uint64_t scaled = static_cast<uint64_t>(count + 1) * plan->phases();
+	return static_cast<size_t>(scaled / plan->step() + 1);
+}
+
+size_t PolyphaseResampler::process(const float *input, size_t count, std::vector<float> &output)
+{
+	if (!plan || !input)
+		return 0;
+	if (plan->identity()) {
+		output.insert(output.end(), input, input + count);
+		return count;
+	}
+
+	constexpr size_t LANES = PolyphasePlan::LANES;
+	const size_t taps = plan->taps();
+	const uint32_t phases = plan->phases();
+	const uint32_t step = plan->step();
+
+	history.insert(history.end(), input, input + count);
+	const size_t start = output.size();
+	output.resize(start + maxOutput(count));
+	float *out = output.data() + start;
+	size_t produced = 0;
+
+	while (position < history.size()) {
+		const float *x = history.data() + position + 1 - taps;
+		const float *c = plan->phase(phase);
+		float acc[LANES] = {};
+		for (size_t k = 0; k < taps; k += LANES) {
+			for (size_t l = 0; l < LANES; l++)
+				acc[l] += c[k + l] * x[k + l];
+		}
+		float sum = 0.0f;
+		for (size_t l = 0; l < LANES; l++)
+			sum += acc[l];
+		out[produced++] = sum;
+
+		phase += step;
+		position += phase / phases;
+		phase %= phases;
+	}
+	output.resize(start + produced);
+
+	// Keep the window behind the next output position
+	const size_t consumed = position + 1 - taps;
+	history.erase(history.begin(), history.begin() + static_cast<std::ptrdiff_t>(consumed));
+	position -= consumed;
+	return produced;
+}
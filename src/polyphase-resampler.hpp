@@ -0,0 +1,82 @@
+/*
+ * Polyphase Resampler - Rational-ratio sample-rate conversion for analysis
+ * Copyright (C) 2025
+ *
+ * A Kaiser-windowed sinc low-pass at the common multiple of the two rates
+ * is split into one short filter per output phase (the plan), so each
+ * output sample is a single dot product of consecutive input samples with
+ * one phase's taps. Taps are stored time-reversed and padded to a multiple
+ * of LANES, and the dot product accumulates into LANES independent sums,
+ * which the compiler vectorises without intrinsics. Plans depend only on
+ * the two rates and are shared through DspTableCache.
+ */
+
+#ifndef POLYPHASE_RESAMPLER_HPP
+#define POLYPHASE_RESAMPLER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class PolyphasePlan {
+public:
+	static constexpr size_t LANES = 8;
+
+	// Ratios that need more phases are approximated (rate error below 0.1%)
+	static constexpr uint32_t MAX_PHASES = 1024;
+
+	// Passband to 85% of the lower Nyquist frequency, 80 dB stopband from
+	// the lower Nyquist frequency up
+	static constexpr double PASSBAND = 0.85;
+	static constexpr double STOPBAND_DB = 80.0;
+
+	PolyphasePlan(uint32_t inputRate, uint32_t outputRate);
+
+	uint32_t inputRate() const { return inRate; }
+	uint32_t outputRate() const { return outRate; }
+
+	// Output = input * phases() / step()
+	uint32_t phases() const { return upFactor; }
+	uint32_t step() const { return downFactor; }
+	size_t taps() const { return tapCount; }
+	bool identity() const { return upFactor == downFactor; }
+
+	// taps() coefficients, oldest input sample first
+	const float *phase(uint32_t index) const { return coeffs.data() + static_cast<size_t>(index) * tapCount; }
+
+private:
+	uint32_t inRate;
+	uint32_t outRate;
+	uint32_t upFactor = 1;
+	uint32_t downFactor = 1;
+	size_t tapCount = 0;
+	std::vector<float> coeffs; // phases x taps
+};
+
+// Streaming converter for one channel. Not thread-safe; allocates while the
+// history grows, so keep it off the audio thread.
+class PolyphaseResampler {
+public:
+	void configure(std::shared_ptr<const PolyphasePlan> plan);
+	void reset();
+
+	bool isConfigured() const { return plan != nullptr; }
+
+	// Appends the output for count input samples; returns how many were
+	// appended (the count varies by one between calls for most ratios)
+	size_t process(const float *input, size_t count, std::vector<float> &output);
+
+	// Upper bound on what process() appends for count input samples
+	size_t maxOutput(size_t count) const;
+
+private:
+	std::shared_ptr<const PolyphasePlan> plan;
+
+	// taps() - 1 samples of history followed by the unconsumed input
+	std::vector<float> history;
+	size_t position = 0; // newest input sample of the next output
+	uint32_t phase = 0;
+};
+
+#endif // POLYPHASE_RESAMPLER_HPP
@@ -0,0 +1,540 @@
+/*
+ * Profile Switcher Implementation
+ * Copyright (C) 2025
+ */
+
+#include "profile-switcher.hpp"
+
+#include <obs-module.h>
+#include <plugin-support.h>
+#include <util/platform.h>
+
+#include "dsp-tables.hpp"
+
+#include <algorithm>
+
+static const char *PROFILES_FILE = "profiles.json";
+
+static double getDouble(obs_data_t *data, const char *name, double fallback)
+{
+	return obs_data_has_user_value(data, name) ? obs_data_get_double(data, name) : fallback;
+}
+
+static int getInt(obs_data_t *data, const char *name, int fallback)
+{
+	return obs_data_has_user_value(data, name) ? static_cast<int>(obs_data_get_int(data, name)) : fallback;
+}
+
+static bool getBool(obs_data_t *data, const char *name, bool fallback)
+{
+	return obs_data_has_user_value(data, name) ? obs_data_get_bool(data, name) : fallback;
+}
+
+static void intervalToData(obs_data_t *data, const char *name, const ValueInterval &interval)
+{
+	const std::string key(name);
+	obs_data_set_double(data, (key + "_low").c_str(), interval.low);
+	obs_data_set_double(data, (key + "_high").c_str(), interval.high);
+}
+
+static void intervalFromData(obs_data_t *data, const char *name, ValueInterval &interval)
+{
+	const std::string key(name);
+	interval.low = static_cast<float>(getDouble(data, (key + "_low").c_str(), interval.low));
+	interval.high = static_cast<float>(getDouble(data, (key + "_high").c_str(), interval.high));
+}
+
+static obs_data_t *chainToData(const CalibrationChain &chain)
+{
+	const ChainOptions &options = chain.options;
+	obs_data_t *data = obs_data_create();
+
+	obs_data_set_bool(data, "noise_suppression", options.noiseSuppression);
+	obs_data_set_int(data, "noise_suppression_level", options.noiseSuppressionLevel);
+	obs_data_set_bool(data, "noise_gate", options.noiseGate);
+	obs_data_set_bool(data, "expander", options.expander);
+	obs_data_set_bool(data, "gain", options.gain);
+	obs_data_set_bool(data, "compressor", options.compressor);
+	obs_data_set_bool(data, "limiter", options.limiter);
+	obs_data_set_bool(data, "high_pass", options.highPass);
+	obs_data_set_int(data, "high_pass_index", options.highPassIndex);
+	obs_data_set_bool(data, "low_pass", options.lowPass);
+	obs_data_set_int(data, "low_pass_index", options.lowPassIndex);
+	obs_data_set_bool(data, "de_esser", options.deEsser);
+	obs_data_set_int(data, "de_esser_index", options.deEsserIndex);
+	obs_data_set_bool(data, "vst", options.vst);
+	obs_data_set_bool(data, "howl_guard", options.howlGuard);
+	obs_data_set_bool(data, "breath_filter", options.breathFilter);
+	obs_data_set_double(data, "room_t20", options.roomT20);
+	obs_data_set_double(data, "room_t30", options.roomT30);
+	obs_data_set_double(data, "click_peak_db", options.clickPeakDb);
+	obs_data_set_double(data, "click_level_db", options.clickLevelDb);
+	obs_data_set_double(data, "click_ms", options.clickMs);
+	obs_data_set_double(data, "gate_offset_db", options.gateOffsetDb);
+	obs_data_set_double(data, "gate_hysteresis_db", options.gateHysteresisDb);
+	obs_data_set_double(data, "breath_floor_db", options.breathFloorDb);
+	obs_data_set_double(data, "breath_ceiling_db", options.breathCeilingDb);
+	obs_data_set_double(data, "breath_harmonicity", options.breathHarmonicity);
+	obs_data_set_bool(data, "voice_eq", options.voiceEq);
+	obs_data_set_int(data, "voice_eq_target", options.voiceEqTarget);
+	obs_data_array_t *bands = obs_data_array_create();
+	for (int i = 0; i < options.voiceEqBandCount; i++) {
+		obs_data_t *band = obs_data_create();
+		obs_data_set_double(band, "hz", options.voiceEqBands[i].hz);
+		obs_data_set_double(band, "gain_db", options.voiceEqBands[i].gainDb);
+		obs_data_set_double(band, "q", options.voiceEqBands[i].q);
+		obs_data_array_push_back(bands, band);
+		obs_data_release(band);
+	}
+	obs_data_set_array(data, "voice_eq_bands", bands);
+	obs_data_array_release(bands);
+	obs_data_set_double(data, "voice_low_hz", options.voiceLowHz);
+	obs_data_set_bool(data, "multiband", options.multiband);
+	obs_data_array_t *dynamics = obs_data_array_create();
+	for (const BandDynamics &band : options.bandDynamics) {
+		obs_data_t *item = obs_data_create();
+		obs_data_set_double(item, "median_db", band.medianDb);
+		obs_data_set_double(item, "loud_db", band.loudDb);
+		obs_data_array_push_back(dynamics, item);
+		obs_data_release(item);
+	}
+	obs_data_set_array(data, "band_dynamics", dynamics);
+	obs_data_array_release(dynamics);
+
+	obs_data_set_int(data, "suppress_level_db", chain.suppressLevelDb);
+	obs_data_set_double(data, "gate_open_db", chain.gateOpenDb);
+	obs_data_set_double(data, "gate_close_db", chain.gateCloseDb);
+	obs_data_set_int(data, "gate_attack_ms", chain.gateAttackMs);
+	obs_data_set_int(data, "gate_hold_ms", chain.gateHoldMs);
+	obs_data_set_int(data, "gate_release_ms", chain.gateReleaseMs);
+	obs_data_set_double(data, "expander_ratio", chain.expanderRatio);
+	obs_data_set_double(data, "expander_threshold_db", chain.expanderThresholdDb);
+	obs_data_set_int(data, "expander_attack_ms", chain.expanderAttackMs);
+	obs_data_set_int(data, "expander_release_ms", chain.expanderReleaseMs);
+	obs_data_set_double(data, "gain_db", chain.gainDb);
+	obs_data_set_double(data, "compressor_threshold_db", chain.compressorThresholdDb);
+	obs_data_set_double(data, "compressor_ratio", chain.compressorRatio);
+	obs_data_set_int(data, "compressor_attack_ms", chain.compressorAttackMs);
+	obs_data_set_int(data, "compressor_release_ms", chain.compressorReleaseMs);
+	obs_data_array_t *multiband = obs_data_array_create();
+	for (const CompressorBand &band : chain.multibandBands) {
+		obs_data_t *item = obs_data_create();
+		obs_data_set_double(item, "threshold_db", band.thresholdDb);
+		obs_data_set_double(item, "ratio", band.ratio);
+		obs_data_set_double(item, "attack_ms", band.attackMs);
+		obs_data_set_double(item, "release_ms", band.releaseMs);
+		obs_data_array_push_back(multiband, item);
+		obs_data_release(item);
+	}
+	obs_data_set_array(data, "multiband_bands", multiband);
+	obs_data_array_release(multiband);
+	obs_data_set_double(data, "limiter_threshold_db", chain.limiterThresholdDb);
+	obs_data_set_int(data, "limiter_release_ms", chain.limiterReleaseMs);
+	obs_data_set_double(data, "high_pass_hz", chain.highPassHz);
+	obs_data_set_double(data, "eq_low_db", chain.eqLowDb);
+	obs_data_set_double(data, "eq_mid_db", chain.eqMidDb);
+	obs_data_set_double(data, "eq_high_db", chain.eqHighDb);
+
+	// Bootstrap intervals of the values above, when they were estimated
+	if (chain.intervals.valid()) {
+		obs_data_t *intervals = obs_data_create();
+		obs_data_set_int(intervals, "resamples", chain.intervals.resamples);
+		intervalToData(intervals, "gain_db", chain.intervals.gainDb);
+		intervalToData(intervals, "compressor_threshold_db", chain.intervals.compressorThresholdDb);
+		intervalToData(intervals, "compressor_ratio", chain.intervals.compressorRatio);
+		intervalToData(intervals, "gate_open_db", chain.intervals.gateOpenDb);
+		intervalToData(intervals, "gate_close_db", chain.intervals.gateCloseDb);
+		obs_data_set_obj(data, "intervals", intervals);
+		obs_data_release(intervals);
+	}
+	return data;
+}
+
+static CalibrationChain chainFromData(obs_data_t *data)
+{
+	CalibrationChain chain;
+	ChainOptions &options = chain.options;
+
+	options.noiseSuppression = getBool(data, "noise_suppression", options.noiseSuppression);
+	options.noiseSuppressionLevel = getInt(data, "noise_suppression_level", options.noiseSuppressionLevel);
+	options.noiseGate = getBool(data, "noise_gate", options.noiseGate);
+	options.expander = getBool(data, "expander", options.expander);
+	options.gain = getBool(data, "gain", options.gain);
+	options.compressor = getBool(data, "compressor", options.compressor);
+	options.limiter = getBool(data, "limiter", options.limiter);
+	options.highPass = getBool(data, "high_pass", options.highPass);
+	options.highPassIndex = getInt(data, "high_pass_index", options.highPassIndex);
+	options.lowPass = getBool(data, "low_pass", options.lowPass);
+	options.lowPassIndex = getInt(data, "low_pass_index", options.lowPassIndex);
+	options.deEsser = getBool(data, "de_esser", options.deEsser);
+	options.deEsserIndex = getInt(data, "de_esser_index", options.deEsserIndex);
+	options.vst = getBool(data, "vst", options.vst);
+	options.howlGuard = getBool(data, "howl_guard", options.howlGuard);
+	options.breathFilter = getBool(data, "breath_filter", options.breathFilter);
+	options.roomT20 = static_cast<float>(getDouble(data, "room_t20", options.roomT20));
+	options.roomT30 = static_cast<float>(getDouble(data, "room_t30", options.roomT30));
+	options.clickPeakDb = static_cast<float>(getDouble(data, "click_peak_db", options.clickPeakDb));
+	options.clickLevelDb = static_cast<float>(getDouble(data, "click_level_db", options.clickLevelDb));
+	options.clickMs = static_cast<float>(getDouble(data, "click_ms", options.clickMs));
+	options.gateOffsetDb = static_cast<float>(getDouble(data, "gate_offset_db", options.gateOffsetDb));
+	options.gateHysteresisDb = static_cast<float>(getDouble(data, "gate_hysteresis_db", options.gateHysteresisDb));
+	options.breathFloorDb = static_cast<float>(getDouble(data, "breath_floor_db", options.breathFloorDb));
+	options.breathCeilingDb = static_cast<float>(getDouble(data, "breath_ceiling_db", options.breathCeilingDb));
+	options.breathHarmonicity =
+		static_cast<float>(getDouble(data, "breath_harmonicity", options.breathHarmonicity));
+	options.voiceEq = getBool(data, "voice_eq", options.voiceEq);
+	options.voiceEqTarget = getInt(data, "voice_eq_target", options.voiceEqTarget);
+	obs_data_array_t *bands = obs_data_get_array(data, "voice_eq_bands");
+	const size_t bandCount = bands ? obs_data_array_count(bands) : 0;
+	options.voiceEqBandCount = static_cast<int>(std::min<size_t>(bandCount, VoiceEqBand::MAX_BANDS));
+	for (int i = 0; i < options.voiceEqBandCount; i++) {
+		obs_data_t *band = obs_data_array_item(bands, static_cast<size_t>(i));
+		options.voiceEqBands[i].hz = static_cast<float>(getDouble(band, "hz", 1000.0));
+		options.voiceEqBands[i].gainDb = static_cast<float>(getDouble(band, "gain_db", 0.0));
+		options.voiceEqBands[i].q = static_cast<float>(getDouble(band, "q", 1.0));
+		obs_data_release(band);
+	}
+	obs_data_array_release(bands);
+	options.voiceLowHz = static_cast<float>(getDouble(data, "voice_low_hz", options.voiceLowHz));
+	options.multiband = getBool(data, "multiband", options.multiband);
+	obs_data_array_t *dynamics = obs_data_get_array(data, "band_dynamics");
+	const size_t dynamicsCount = dynamics ? obs_data_array_count(dynamics) : 0;
+	for (size_t i = 0; i < std::min<size_t>(dynamicsCount, CompressorBand::BANDS); i++) {
+		obs_data_t *item = obs_data_array_item(dynamics, i);
+		BandDynamics &band = options.bandDynamics[i];
+		band.medianDb = static_cast<float>(getDouble(item, "median_db", band.medianDb));
+		band.loudDb = static_cast<float>(getDouble(item, "loud_db", band.loudDb));
+		obs_data_release(item);
+	}
+	obs_data_array_release(dynamics);
+
+	chain.suppressLevelDb = getInt(data, "suppress_level_db", chain.suppressLevelDb);
+	chain.gateOpenDb = static_cast<float>(getDouble(data, "gate_open_db", chain.gateOpenDb));
+	chain.gateCloseDb = static_cast<float>(getDouble(data, "gate_close_db", chain.gateCloseDb));
+	chain.gateAttackMs = getInt(data, "gate_attack_ms", chain.gateAttackMs);
+	chain.gateHoldMs = getInt(data, "gate_hold_ms", chain.gateHoldMs);
+	chain.gateReleaseMs = getInt(data, "gate_release_ms", chain.gateReleaseMs);
+	chain.expanderRatio = static_cast<float>(getDouble(data, "expander_ratio", chain.expanderRatio));
+	chain.expanderThresholdDb =
+		static_cast<float>(getDouble(data, "expander_threshold_db", chain.expanderThresholdDb));
+	chain.expanderAttackMs = getInt(data, "expander_attack_ms", chain.expanderAttackMs);
+	chain.expanderReleaseMs = getInt(data, "expander_release_ms", chain.expanderReleaseMs);
+	chain.gainDb = static_cast<float>(getDouble(data, "gain_db", chain.gainDb));
+	chain.compressorThresholdDb =
+		static_cast<float>(getDouble(data, "compressor_threshold_db", chain.compressorThresholdDb));
+	chain.compressorRatio = static_cast<float>(getDouble(data, "compressor_ratio", chain.compressorRatio));
+	chain.compressorAttackMs = getInt(data, "compressor_attack_ms", chain.compressorAttackMs);
+	chain.compressorReleaseMs = getInt(data, "compressor_release_ms", chain.compressorReleaseMs);
+	obs_data_array_t *multiband = obs_data_get_array(data, "multiband_bands");
+	const size_t multibandCount = multiband ? obs_data_array_count(multiband) : 0;
+	for (size_t i = 0; i < std::min<size_t>(multibandCount, CompressorBand::BANDS); i++) {
+		obs_data_t *item = obs_data_array_item(multiband, i);
+		CompressorBand &band = chain.multibandBands[i];
+		band.thresholdDb = static_cast<float>(getDouble(item, "threshold_db", band.thresholdDb));
+		band.ratio = static_cast<float>(getDouble(item, "ratio", band.ratio));
+		band.attackMs = static_cast<float>(getDouble(item, "attack_ms", band.attackMs));
+		band.releaseMs = static_cast<float>(getDouble(item, "release_ms", band.releaseMs));
+		obs_data_release(item);
+	}
+	obs_data_array_release(multiband);
+	chain.limiterThresholdDb = static_cast<float>(getDouble(data, "limiter_threshold_db", chain.limiterThresholdDb));
+	chain.limiterReleaseMs = getInt(data, "limiter_release_ms", chain.limiterReleaseMs);
+	chain.highPassHz = static_cast<float>(getDouble(data, "high_pass_hz", chain.highPassHz));
+	chain.eqLowDb = static_cast<float>(getDouble(data, "eq_low_db", chain.eqLowDb));
+	chain.eqMidDb = static_cast<float>(getDouble(data, "eq_mid_db", chain.eqMidDb));
+	chain.eqHighDb = static_cast<float>(getDouble(data, "eq_high_db", chain.eqHighDb));
+
+	obs_data_t *intervals = obs_data_get_obj(data, "intervals");
+	if (intervals) {
+		chain.intervals.resamples = getInt(intervals, "resamples", 0);
+		intervalFromData(intervals, "gain_db", chain.intervals.gainDb);
+		intervalFromData(intervals, "compressor_threshold_db", chain.intervals.compressorThresholdDb);
+		intervalFromData(intervals, "compressor_ratio", chain.intervals.compressorRatio);
+		intervalFromData(intervals, "gate_open_db", chain.intervals.gateOpenDb);
+		intervalFromData(intervals, "gate_close_db", chain.intervals.gateCloseDb);
+		obs_data_release(intervals);
+	}
+	return chain;
+}
+
+static obs_data_t *baselineToData(const CalibrationBaseline &baseline)
+{
+	// Options in the same keys as a profile's chain; the steps alongside
+	CalibrationChain optionsOnly;
+	optionsOnly.options = baseline.options;
+	obs_data_t *data = chainToData(optionsOnly);
+	obs_data_array_t *levels = obs_data_array_create();
+	for (size_t i = 0; i < 8; i++) {
+		obs_data_t *step = obs_data_create();
+		obs_data_set_double(step, "level", baseline.levels[i]);
+		obs_data_set_double(step, "peak", baseline.peaks[i]);
+		obs_data_array_push_back(levels, step);
+		obs_data_release(step);
+	}
+	obs_data_set_array(data, "steps", levels);
+	obs_data_array_release(levels);
+	obs_data_set_double(data, "distance_tilt_db", baseline.distance.tiltDb);
+	obs_data_set_double(data, "distance_level_db", baseline.distance.levelDb);
+	return data;
+}
+
+static CalibrationBaseline baselineFromData(obs_data_t *data)
+{
+	CalibrationBaseline baseline;
+	baseline.options = chainFromData(data).options;
+
+	obs_data_array_t *levels = obs_data_get_array(data, "steps");
+	const size_t count = levels ? obs_data_array_count(levels) : 0;
+	for (size_t i = 0; i < 8; i++) {
+		baseline.levels[i] = -100.0f;
+		baseline.peaks[i] = -100.0f;
+		if (i >= count)
+			continue;
+		obs_data_t *step = obs_data_array_item(levels, i);
+		baseline.levels[i] = static_cast<float>(obs_data_get_double(step, "level"));
+		baseline.peaks[i] = static_cast<float>(obs_data_get_double(step, "peak"));
+		obs_data_release(step);
+	}
+	obs_data_array_release(levels);
+
+	baseline.distance.tiltDb = static_cast<float>(getDouble(data, "distance_tilt_db", 0.0));
+	baseline.distance.levelDb = static_cast<float>(getDouble(data, "distance_level_db", -100.0));
+	return baseline;
+}
+
+ProfileSwitcher &ProfileSwitcher::instance()
+{
+	static ProfileSwitcher switcher;
+	return switcher;
+}
+
+std::string ProfileSwitcher::configPath()
+{
+	char *path = obs_module_config_path(PROFILES_FILE);
+	if (!path)
+		return std::string();
+	std::string result(path);
+	bfree(path);
+	return result;
+}
+
+bool ProfileSwitcher::load()
+{
+	clear();
+
+	const std::string path = configPath();
+	obs_data_t *root = path.empty() ? nullptr : obs_data_create_from_json_file_safe(path.c_str(), "bak");
+	if (!root)
+		return false;
+
+	obs_data_array_t *sourceArray = obs_data_get_array(root, "sources");
+	const size_t sourceCount = sourceArray ? obs_data_array_count(sourceArray) : 0;
+	for (size_t i = 0; i < sourceCount; i++) {
+		obs_data_t *sourceData = obs_data_array_item(sourceArray, i);
+		const std::string sourceName = obs_data_get_string(sourceData, "name");
+
+		obs_data_array_t *profileArray = obs_data_get_array(sourceData, "profiles");
+		const size_t profileCount = profileArray ? obs_data_array_count(profileArray) : 0;
+		for (size_t j = 0; j < profileCount; j++) {
+			obs_data_t *profileData = obs_data_array_item(profileArray, j);
+			obs_data_t *chainData = obs_data_get_obj(profileData, "chain");
+			if (chainData) {
+				setProfile(sourceName, obs_data_get_string(profileData, "name"),
+					   chainFromData(chainData));
+				obs_data_release(chainData);
+			}
+			obs_data_release(profileData);
+		}
+		obs_data_array_release(profileArray);
+
+		obs_data_t *baselineData = obs_data_get_obj(sourceData, "baseline");
+		if (baselineData) {
+			setBaseline(sourceName, baselineFromData(baselineData));
+			obs_data_release(baselineData);
+		}
+		obs_data_release(sourceData);
+	}
+	obs_data_array_release(sourceArray);
+
+	obs_data_array_t *sceneArray = obs_data_get_array(root, "scenes");
+	const size_t sceneCount = sceneArray ? obs_data_array_count(sceneArray) : 0;
+	for (size_t i = 0; i < sceneCount; i++) {
+		obs_data_t *binding = obs_data_array_item(sceneArray, i);
+		bindScene(obs_data_get_string(binding, "scene"), obs_data_get_string(binding, "source"),
+			  obs_data_get_string(binding, "profile"));
+		obs_data_release(binding);
+	}
+	obs_data_array_release(sceneArray);
+	obs_data_release(root);
+
+	obs_log(LOG_INFO, "[ProfileSwitcher] Loaded profiles for %zu sources, %zu scenes", sources.size(),
+		bindings.size());
+	return true;
+}
+
+bool ProfileSwitcher::save() const
+{
+	const std::string path = configPath();
+	if (path.empty())
+		return false;
+
+	const std::string directory = path.substr(0, path.find_last_of("/\\"));
+	os_mkdirs(directory.c_str());
+
+	obs_data_t *root = obs_data_create();
+
+	obs_data_array_t *sourceArray = obs_data_array_create();
+	for (const auto &source : sources) {
+		obs_data_t *sourceData = obs_data_create();
+		obs_data_set_string(sourceData, "name", source.first.c_str());
+
+		obs_data_array_t *profileArray = obs_data_array_create();
+		for (const auto &profile : source.second.profiles) {
+			obs_data_t *profileData = obs_data_create();
+			obs_data_t *chainData = chainToData(profile.second.chain);
+			obs_data_set_string(profileData, "name", profile.first.c_str());
+			obs_data_set_obj(profileData, "chain", chainData);
+			obs_data_array_push_back(profileArray, profileData);
+			obs_data_release(chainData);
+			obs_data_release(profileData);
+		}
+		obs_data_set_array(sourceData, "profiles", profileArray);
+		obs_data_array_release(profileArray);
+
+		if (source.second.hasBaseline) {
+			obs_data_t *baselineData = baselineToData(source.second.baseline);
+			obs_data_set_obj(sourceData, "baseline", baselineData);
+			obs_data_release(baselineData);
+		}
+
+		obs_data_array_push_back(sourceArray, sourceData);
+		obs_data_release(sourceData);
+	}
+	obs_data_set_array(root, "sources", sourceArray);
+	obs_data_array_release(sourceArray);
+
+	obs_data_array_t *sceneArray = obs_data_array_create();
+	for (const auto &scene : bindings) {
+		for (const auto &binding : scene.second) {
+			obs_data_t *bindingData = obs_data_create();
+			obs_data_set_string(bindingData, "scene", scene.first.c_str());
+			obs_data_set_string(bindingData, "source", binding.first.c_str());
+			obs_data_set_string(bindingData, "profile", binding.second.c_str());
+			obs_data_array_push_back(sceneArray, bindingData);
+			obs_data_release(bindingData);
+		}
+	}
+	obs_data_set_array(root, "scenes", sceneArray);
+	obs_data_array_release(sceneArray);
+
+	const bool ok = obs_data_save_json_safe(root, path.c_str(), "tmp", "bak");
+	obs_data_release(root);
+	if (!ok)
+		obs_log(LOG_WARNING, "[ProfileSwitcher] Failed to save %s", path.c_str());
+	return ok;
+}
+
+void ProfileSwitcher::clear()
+{
+	sources.clear();
+	bindings.clear();
+}
+
+void ProfileSwitcher::setProfile(const std::string &sourceName, const std::string &profileName,
+				 const CalibrationChain &chain)
+{
+	if (sourceName.empty() || profileName.empty())
+		return;
+
+	Profile &profile = sources[sourceName].profiles[profileName];
+	profile.chain = chain;
+	profile.settings = std::make_unique<ChainSettings>(chain);
+}
+
+void ProfileSwitcher::bindScene(const std::string &sceneName, const std::string &sourceName,
+				const std::string &profileName)
+{
+	if (sceneName.empty() || sourceName.empty() || profileName.empty())
+		return;
+	bindings[sceneName][sourceName] = profileName;
+}
+
+std::vector<std::string> ProfileSwitcher::profileNames(const std::string &sourceName) const
+{
+	std::vector<std::string> names;
+	auto it = sources.find(sourceName);
+	if (it == sources.end())
+		return names;
+	for (const auto &profile : it->second.profiles)
+		names.push_back(profile.first);
+	return names;
+}
+
+void ProfileSwitcher::setBaseline(const std::string &sourceName, const CalibrationBaseline &baseline)
+{
+	if (sourceName.empty())
+		return;
+	SourceProfiles &entry = sources[sourceName];
+	entry.baseline = baseline;
+	entry.hasBaseline = true;
+}
+
+bool ProfileSwitcher::baseline(const std::string &sourceName, CalibrationBaseline &out) const
+{
+	auto it = sources.find(sourceName);
+	if (it == sources.end() || !it->second.hasBaseline)
+		return false;
+	out = it->second.baseline;
+	return true;
+}
+
+void ProfileSwitcher::markActive(const std::string &sourceName, const std::string &profileName)
+{
+	auto it = sources.find(sourceName);
+	if (it != sources.end())
+		it->second.active = profileName;
+}
+
+void ProfileSwitcher::onSceneChanged(const char *sceneName)
+{
+	if (!sceneName)
+		return;
+
+	auto scene = bindings.find(sceneName);
+	if (scene == bindings.end())
+		return;
+
+	const DspConfig config = DspConfig::fromAudioOutput();
+	const double bufferMs = 1000.0 * config.blockSize / std::max<uint32_t>(1, config.sampleRate);
+
+	for (const auto &binding : scene->second) {
+		auto sourceIt = sources.find(binding.first);
+		if (sourceIt == sources.end())
+			continue;
+		SourceProfiles &entry = sourceIt->second;
+		if (entry.active == binding.second)
+			continue;
+
+		auto profileIt = entry.profiles.find(binding.second);
+		if (profileIt == entry.profiles.end())
+			continue;
+
+		obs_source_t *source = obs_get_source_by_name(binding.first.c_str());
+		if (!source)
+			continue;
+
+		const uint64_t start = os_gettime_ns();
+		const int missing = profileIt->second.settings->updateExisting(source);
+		const double elapsedMs = static_cast<double>(os_gettime_ns() - start) / 1e6;
+		obs_source_release(source);
+
+		entry.active = binding.second;
+		obs_log(LOG_INFO, "[ProfileSwitcher] Scene %s: %s -> '%s' in %.3f ms (audio buffer %.1f ms)", sceneName,
+			binding.first.c_str(), binding.second.c_str(), elapsedMs, bufferMs);
+		if (missing > 0)
+			obs_log(LOG_WARNING,
+				"[ProfileSwitcher] %d filter(s) of '%s' are not on %s; Apply from the wizard recreates "
+				"them",
+				missing, binding.second.c_str(), binding.first.c_str());
+	}
+}
@@ -0,0 +1,85 @@
+/*
+ * Profile Switcher - Per-scene calibration profiles for a source
+ * Copyright (C) 2025
+ *
+ * A source can keep several calibrated chains ("desk", "stage", ...), and
+ * each scene can name the profile it wants for that source. The filter
+ * settings of every profile are built when profiles are loaded or saved, so
+ * a scene switch only pushes ready obs_data into the filters that are
+ * already on the source: no filter is created, removed or re-derived.
+ */
+
+#ifndef PROFILE_SWITCHER_HPP
+#define PROFILE_SWITCHER_HPP
+
+#include <obs.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "calibration-chain.hpp"
+#include "chain-settings.hpp"
+#include "distance-monitor.hpp"
+
+// The wizard measurements a source's live filters were last derived from
+struct CalibrationBaseline {
+	float levels[8];
+	float peaks[8];
+	ChainOptions options;
+	DistanceReference distance; // step 4 through the chain; invalid if too little speech
+};
+
+// All methods run on the UI thread (dialog and frontend events)
+class ProfileSwitcher {
+public:
+	static ProfileSwitcher &instance();
+
+	bool load();
+	bool save() const;
+	void clear();
+
+	// Store (or replace) a profile and precompute its filter settings
+	void setProfile(const std::string &sourceName, const std::string &profileName,
+			const CalibrationChain &chain);
+
+	// Use this source's profile whenever the scene becomes current
+	void bindScene(const std::string &sceneName, const std::string &sourceName, const std::string &profileName);
+
+	std::vector<std::string> profileNames(const std::string &sourceName) const;
+
+	// Recorded on Apply; live recalibration re-derives from it
+	void setBaseline(const std::string &sourceName, const CalibrationBaseline &baseline);
+	bool baseline(const std::string &sourceName, CalibrationBaseline &out) const;
+
+	// Filters were just (re)created from this profile's chain
+	void markActive(const std::string &sourceName, const std::string &profileName);
+
+	// OBS_FRONTEND_EVENT_SCENE_CHANGED
+	void onSceneChanged(const char *sceneName);
+
+private:
+	ProfileSwitcher() = default;
+
+	struct Profile {
+		CalibrationChain chain;
+		std::unique_ptr<ChainSettings> settings;
+	};
+
+	struct SourceProfiles {
+		std::map<std::string, Profile> profiles;
+		std::string active;
+		bool hasBaseline = false;
+		CalibrationBaseline baseline;
+	};
+
+	static std::string configPath();
+
+	std::map<std::string, SourceProfiles> sources;
+
+	// scene -> source -> profile
+	std::map<std::string, std::map<std::string, std::string>> bindings;
+};
+
+#endif // PROFILE_SWITCHER_HPP
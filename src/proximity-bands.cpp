@@ -0,0 +1,61 @@
+/*
+ * Proximity Bands Implementation
+ * Copyright (C) 2025
+ */
+
+#include "proximity-bands.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void ProximityBands::configure(uint32_t sampleRate)
+{
+	factor = std::max<size_t>(1, static_cast<size_t>(std::lround(static_cast<double>(sampleRate) / TARGET_RATE)));
+	const double rate = static_cast<double>(sampleRate) / static_cast<double>(factor);
+
+	// Butterworth pole pair Qs
+	antiAlias[0] = BiquadCoeffs::lowPass(sampleRate, ANTI_ALIAS_HZ, 0.5412);
+	antiAlias[1] = BiquadCoeffs::lowPass(sampleRate, ANTI_ALIAS_HZ, 1.3066);
+
+	lowHighPass = BiquadCoeffs::highPass(rate, 100.0, 0.707);
+	lowLowPass = BiquadCoeffs::lowPass(rate, 300.0, 0.707);
+	midHighPass = BiquadCoeffs::highPass(rate, 1000.0, 0.707);
+	midLowPass = BiquadCoeffs::lowPass(rate, 3000.0, 0.707);
+	reset();
+}
+
+void ProximityBands::reset()
+{
+	for (BiquadState &state : antiAliasStates)
+		state.reset();
+	for (BiquadState &state : lowStates)
+		state.reset();
+	for (BiquadState &state : midStates)
+		state.reset();
+	pendingCount = 0;
+}
+
+void ProximityBands::measure(const float *samples, size_t count, double &lowPower, double &midPower)
+{
+	double lowSum = 0.0;
+	double midSum = 0.0;
+	size_t produced = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		float x = samples[i];
+		if (factor > 1)
+			x = antiAliasStates[1].process(antiAlias[1], antiAliasStates[0].process(antiAlias[0], x));
+		if (++pendingCount < factor)
+			continue;
+		pendingCount = 0;
+
+		const float low = lowStates[1].process(lowLowPass, lowStates[0].process(lowHighPass, x));
+		const float mid = midStates[1].process(midLowPass, midStates[0].process(midHighPass, x));
+		lowSum += static_cast<double>(low) * low;
+		midSum += static_cast<double>(mid) * mid;
+		produced++;
+	}
+
+	lowPower = produced ? lowSum / static_cast<double>(produced) : 0.0;
+	midPower = produced ? midSum / static_cast<double>(produced) : 0.0;
+}
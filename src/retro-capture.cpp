@@ -0,0 +1,249 @@
+/*
+ * Retro Capture Implementation
+ * Copyright (C) 2025
+ */
+
+#include "retro-capture.hpp"
+#include "filter-models.hpp"
+#include "wav-file.hpp"
+
+#include <plugin-support.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+
+static constexpr double PI = 3.14159265358979323846;
+
+// 4x polyphase interpolator, 12 taps per phase (as in BS.1770 Annex 2)
+static constexpr int TP_PHASES = 4;
+static constexpr int TP_TAPS = 12;
+using TruePeakTaps = std::array<std::array<float, TP_TAPS>, TP_PHASES>;
+
+static const TruePeakTaps &truePeakTaps()
+{
+	static const TruePeakTaps taps = []() {
+		TruePeakTaps result{};
+		const int length = TP_PHASES * TP_TAPS;
+		const double center = (length - 1) / 2.0;
+		for (int p = 0; p < TP_PHASES; p++) {
+			double sum = 0.0;
+			for (int k = 0; k < TP_TAPS; k++) {
+				const int m = k * TP_PHASES + p;
+				const double t = (m - center) / TP_PHASES;
+				const double sinc = std::sin(PI * t) / (PI * t);
+				const double window = 0.5 - 0.5 * std::cos(2.0 * PI * (m + 0.5) / length);
+				result[p][k] = static_cast<float>(sinc * window);
+				sum += sinc * window;
+			}
+			// Unity DC gain for every phase
+			for (int k = 0; k < TP_TAPS; k++)
+				result[p][k] = static_cast<float>(result[p][k] / sum);
+		}
+		return result;
+	}();
+	return taps;
+}
+
+static inline float toDb(float amplitude)
+{
+	return amplitude > 0.00001f ? 20.0f * std::log10(amplitude) : -100.0f;
+}
+
+RetroRing::RetroRing(uint32_t sampleRate, size_t channels, double seconds) : rate(sampleRate), length(seconds)
+{
+	const size_t capacity = static_cast<size_t>((seconds + HEADROOM_SECONDS) * sampleRate);
+	channels = std::max<size_t>(1, std::min<size_t>(channels, MAX_AUDIO_CHANNELS));
+	for (size_t ch = 0; ch < channels; ch++)
+		rings.push_back(std::make_unique<SampleRing>(capacity));
+}
+
+void RetroRing::push(const struct audio_data *audioData)
+{
+	static const float silence[AUDIO_OUTPUT_FRAMES] = {};
+
+	for (size_t ch = 0; ch < rings.size(); ch++) {
+		const float *samples = reinterpret_cast<const float *>(audioData->data[ch]);
+		if (samples) {
+			rings[ch]->write(samples, audioData->frames);
+			continue;
+		}
+
+		// Keep channels aligned when a plane is missing
+		for (size_t done = 0; done < audioData->frames; done += AUDIO_OUTPUT_FRAMES)
+			rings[ch]->write(silence, std::min<size_t>(AUDIO_OUTPUT_FRAMES, audioData->frames - done));
+	}
+}
+
+uint64_t RetroRing::position() const
+{
+	uint64_t end = UINT64_MAX;
+	for (const auto &ring : rings)
+		end = std::min(end, ring->written());
+	return end;
+}
+
+RetroSnapshotPtr RetroRing::snapshot(uint64_t end) const
+{
+	const uint64_t wanted = static_cast<uint64_t>(length * rate);
+	uint64_t begin = end > wanted ? end - wanted : 0;
+	for (const auto &ring : rings)
+		begin = std::max(begin, ring->oldest());
+	if (begin >= end)
+		return nullptr;
+
+	auto snapshot = std::make_shared<RetroSnapshot>();
+	snapshot->sampleRate = rate;
+	snapshot->channels.resize(rings.size());
+	for (size_t ch = 0; ch < rings.size(); ch++) {
+		std::vector<float> &dst = snapshot->channels[ch];
+		dst.resize(static_cast<size_t>(end - begin));
+		if (!rings[ch]->read(begin, dst.data(), dst.size())) {
+			obs_log(LOG_WARNING, "[RetroCapture] Snapshot overrun; the ring moved on before it was copied");
+			return nullptr;
+		}
+	}
+	return snapshot;
+}
+
+float RetroCapture::truePeak(const float *samples, size_t count)
+{
+	const TruePeakTaps &taps = truePeakTaps();
+	float history[TP_TAPS] = {};
+	float peak = 0.0f;
+
+	for (size_t n = 0; n < count; n++) {
+		// history[0] is the newest sample
+		std::copy_backward(history, history + TP_TAPS - 1, history + TP_TAPS);
+		history[0] = samples[n];
+		peak = std::max(peak, std::fabs(samples[n]));
+
+		for (int p = 0; p < TP_PHASES; p++) {
+			float sum = 0.0f;
+			for (int k = 0; k < TP_TAPS; k++)
+				sum += taps[p][k] * history[k];
+			peak = std::max(peak, std::fabs(sum));
+		}
+	}
+	return peak;
+}
+
+RetroAnalysis RetroCapture::analyze(const RetroSnapshot &snapshot, const CalibrationChain &chain)
+{
+	RetroAnalysis result;
+	result.seconds = snapshot.seconds();
+	if (snapshot.frames() == 0)
+		return result;
+
+	const double msPerSample = 1000.0 / snapshot.sampleRate;
+
+	// Peaks and clipping across all channels
+	float samplePeak = 0.0f;
+	float truePeakValue = 0.0f;
+	size_t longestRun = 0;
+	for (const std::vector<float> &channel : snapshot.channels) {
+		size_t run = 0;
+		for (size_t i = 0; i <= channel.size(); i++) {
+			const float magnitude = i < channel.size() ? std::fabs(channel[i]) : 0.0f;
+			samplePeak = std::max(samplePeak, magnitude);
+			if (magnitude >= CLIP_LEVEL) {
+				run++;
+				continue;
+			}
+			if (run >= MIN_CLIP_RUN) {
+				result.clipRuns++;
+				result.clippedSamples += run;
+				longestRun = std::max(longestRun, run);
+			}
+			run = 0;
+		}
+		truePeakValue = std::max(truePeakValue, truePeak(channel.data(), channel.size()));
+	}
+	result.samplePeakDb = toDb(samplePeak);
+	result.truePeakDb = toDb(truePeakValue);
+	result.longestClipMs = static_cast<double>(longestRun) * msPerSample;
+
+	// Gate and compressor behaviour, sampled every millisecond
+	ChainModel model(chain, snapshot.sampleRate);
+	std::vector<float> work = snapshot.channels[0];
+	const size_t step = std::max<size_t>(1, snapshot.sampleRate / 1000);
+
+	bool wasOpen = false;
+	double lastChangeMs = -1e9;
+	size_t openChunks = 0;
+	size_t reducingChunks = 0;
+	double reductionSum = 0.0;
+	size_t chunks = 0;
+
+	for (size_t pos = 0; pos < work.size(); pos += step) {
+		const size_t count = std::min(step, work.size() - pos);
+		model.process(work.data() + pos, count);
+		chunks++;
+
+		const double nowMs = static_cast<double>(pos + count) * msPerSample;
+		const bool open = model.noiseGate().isOpen();
+		if (open != wasOpen) {
+			if (open)
+				result.gateOpenings++;
+			if (nowMs - lastChangeMs < CHATTER_MS)
+				result.gateChatter++;
+			lastChangeMs = nowMs;
+			wasOpen = open;
+		}
+		if (open)
+			openChunks++;
+
+		const float reduction = model.compressorStage().lastGainDb();
+		if (reduction < -0.5f) {
+			reducingChunks++;
+			reductionSum += reduction;
+		}
+		result.maxGainReductionDb = std::min(result.maxGainReductionDb, reduction);
+	}
+
+	if (!chain.options.noiseGate) {
+		result.gateOpenings = 0;
+		result.gateChatter = 0;
+	}
+	result.gateOpenPercent = chain.options.noiseGate ? 100.0 * openChunks / chunks : 100.0;
+	result.compressingPercent = 100.0 * reducingChunks / chunks;
+	result.avgGainReductionDb = reducingChunks ? static_cast<float>(reductionSum / reducingChunks) : 0.0f;
+	return result;
+}
+
+std::string RetroAnalysis::summary() const
+{
+	char text[512];
+	snprintf(text, sizeof(text),
+		 "%.1f s: peak %.1f dBFS, true peak %.1f dBTP, %d clip run(s) (longest %.1f ms); "
+		 "gate open %.0f%% with %d opening(s), %d chatter; compressor active %.0f%%, "
+		 "avg %.1f dB / max %.1f dB reduction",
+		 seconds, samplePeakDb, truePeakDb, clipRuns, longestClipMs, gateOpenPercent, gateOpenings,
+		 gateChatter, compressingPercent, avgGainReductionDb, maxGainReductionDb);
+	return text;
+}
+
+bool RetroCapture::exportWav(const RetroSnapshot &snapshot, const std::string &path)
+{
+	const size_t channels = snapshot.channels.size();
+	WavWriter writer;
+	if (channels == 0 || !writer.open(path, snapshot.sampleRate, static_cast<uint16_t>(channels))) {
+		obs_log(LOG_WARNING, "[RetroCapture] Could not open %s", path.c_str());
+		return false;
+	}
+
+	const size_t blockFrames = 1024;
+	std::vector<float> interleaved(blockFrames * channels);
+	for (size_t pos = 0; pos < snapshot.frames(); pos += blockFrames) {
+		const size_t count = std::min(blockFrames, snapshot.frames() - pos);
+		for (size_t i = 0; i < count; i++)
+			for (size_t ch = 0; ch < channels; ch++)
+				interleaved[i * channels + ch] = snapshot.channels[ch][pos + i];
+		if (!writer.write(interleaved.data(), count)) {
+			obs_log(LOG_WARNING, "[RetroCapture] Write failed for %s", path.c_str());
+			return false;
+		}
+	}
+	return writer.close();
+}
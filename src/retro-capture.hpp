@@ -0,0 +1,98 @@
+/*
+ * Retro Capture - Rolling buffer of the last N seconds and its analysis
+ * Copyright (C) 2025
+ *
+ * The ring costs one memcpy per channel on the audio thread. Freezing only
+ * records the current position; copying out, analysing and exporting all
+ * happen later on a worker thread.
+ */
+
+#ifndef RETRO_CAPTURE_HPP
+#define RETRO_CAPTURE_HPP
+
+#include <obs.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "calibration-chain.hpp"
+#include "sample-ring.hpp"
+
+// Planar copy of the ring at the moment it was frozen
+struct RetroSnapshot {
+	uint32_t sampleRate = 0;
+	std::vector<std::vector<float>> channels;
+
+	size_t frames() const { return channels.empty() ? 0 : channels[0].size(); }
+	double seconds() const { return sampleRate ? static_cast<double>(frames()) / sampleRate : 0.0; }
+};
+using RetroSnapshotPtr = std::shared_ptr<const RetroSnapshot>;
+
+class RetroRing {
+public:
+	RetroRing(uint32_t sampleRate, size_t channels, double seconds);
+
+	double seconds() const { return length; }
+
+	// Audio thread
+	void push(const struct audio_data *audioData);
+
+	// Frames written on every channel so far; freeze by remembering this
+	uint64_t position() const;
+
+	// Copy the seconds() before end. Call soon after taking end: the ring
+	// keeps a little headroom but the writer does not wait for us.
+	RetroSnapshotPtr snapshot(uint64_t end) const;
+
+private:
+	static constexpr double HEADROOM_SECONDS = 2.0;
+
+	uint32_t rate;
+	double length;
+	std::vector<std::unique_ptr<SampleRing>> rings;
+};
+
+struct RetroAnalysis {
+	double seconds = 0.0;
+
+	float samplePeakDb = -100.0f;
+	float truePeakDb = -100.0f; // dBTP, 4x oversampled
+
+	int clipRuns = 0;
+	uint64_t clippedSamples = 0;
+	double longestClipMs = 0.0;
+
+	// Proposed noise gate on the first channel
+	int gateOpenings = 0;
+	int gateChatter = 0; // state changes within CHATTER_MS of the previous one
+	double gateOpenPercent = 0.0;
+
+	// Proposed compressor on the first channel
+	float maxGainReductionDb = 0.0f;
+	float avgGainReductionDb = 0.0f; // while reducing
+	double compressingPercent = 0.0;
+
+	std::string summary() const;
+};
+
+class RetroCapture {
+public:
+	static constexpr double CHATTER_MS = 100.0;
+
+	// Samples at or above this magnitude count towards clipping runs
+	static constexpr float CLIP_LEVEL = 0.999f;
+	static constexpr size_t MIN_CLIP_RUN = 3;
+
+	// Runs the chain model over the snapshot; safe on a worker thread
+	static RetroAnalysis analyze(const RetroSnapshot &snapshot, const CalibrationChain &chain);
+
+	// 32-bit float WAV, all channels
+	static bool exportWav(const RetroSnapshot &snapshot, const std::string &path);
+
+	// Highest inter-sample peak of one channel (linear)
+	static float truePeak(const float *samples, size_t count);
+};
+
+#endif // RETRO_CAPTURE_HPP
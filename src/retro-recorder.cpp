@@ -0,0 +1,205 @@
+/*
+ * Retro Recorder Implementation
+ * Copyright (C) 2025
+ */
+
+#include "retro-recorder.hpp"
+
+#include <obs-module.h>
+#include <plugin-support.h>
+#include <util/platform.h>
+
+#include "live-recalibrator.hpp"
+#include "profile-switcher.hpp"
+#include "retro-capture.hpp"
+#include "worker-pool.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <ctime>
+
+static const char *OUTPUT_DIRECTORY = "retro";
+
+static bool isAudioInput(obs_source_t *source)
+{
+	return source && obs_source_get_type(source) == OBS_SOURCE_TYPE_INPUT &&
+	       (obs_source_get_output_flags(source) & OBS_SOURCE_AUDIO) != 0;
+}
+
+// Source names may hold anything; file names get letters, digits, - and _
+static std::string fileSafe(const std::string &name)
+{
+	std::string safe = name;
+	for (char &c : safe) {
+		if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '_')
+			c = '_';
+	}
+	return safe.empty() ? std::string("source") : safe;
+}
+
+RetroRecorder &RetroRecorder::instance()
+{
+	static RetroRecorder recorder;
+	return recorder;
+}
+
+void RetroRecorder::attach()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (attached)
+			return;
+		attached = true;
+	}
+
+	// The taps hold a reference, so a source would never be destroyed while
+	// tapped: let go when it is removed instead
+	signal_handler_t *handler = obs_get_signal_handler();
+	signal_handler_connect(handler, "source_create", sourceCreated, this);
+	signal_handler_connect(handler, "source_remove", sourceRemoved, this);
+
+	obs_enum_sources(
+		[](void *param, obs_source_t *source) {
+			static_cast<RetroRecorder *>(param)->watch(source);
+			return true;
+		},
+		this);
+}
+
+void RetroRecorder::detach()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!attached)
+			return;
+		attached = false;
+	}
+
+	signal_handler_t *handler = obs_get_signal_handler();
+	signal_handler_disconnect(handler, "source_create", sourceCreated, this);
+	signal_handler_disconnect(handler, "source_remove", sourceRemoved, this);
+
+	// Released outside the lock; the last reference may also go on the worker
+	std::vector<std::shared_ptr<AnalysisTap>> released;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		released.swap(taps);
+	}
+}
+
+void RetroRecorder::watch(obs_source_t *source)
+{
+	if (!isAudioInput(source) || obs_source_removed(source))
+		return;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (std::any_of(taps.begin(), taps.end(), [source](const auto &tap) { return tap->source() == source; }))
+			return;
+	}
+
+	std::shared_ptr<AnalysisTap> tap = AnalysisWorker::shared().tap(source);
+	if (!tap)
+		return;
+	std::lock_guard<std::mutex> lock(mutex);
+	if (attached && std::find(taps.begin(), taps.end(), tap) == taps.end())
+		taps.push_back(std::move(tap));
+}
+
+void RetroRecorder::forget(obs_source_t *source)
+{
+	// Released after unlocking, like in detach()
+	std::shared_ptr<AnalysisTap> removed;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = std::find_if(taps.begin(), taps.end(),
+				       [source](const auto &tap) { return tap->source() == source; });
+		if (it == taps.end())
+			return;
+		removed = std::move(*it);
+		taps.erase(it);
+	}
+}
+
+void RetroRecorder::sourceCreated(void *data, calldata_t *cd)
+{
+	auto *source = static_cast<obs_source_t *>(calldata_ptr(cd, "source"));
+	static_cast<RetroRecorder *>(data)->watch(source);
+}
+
+void RetroRecorder::sourceRemoved(void *data, calldata_t *cd)
+{
+	auto *source = static_cast<obs_source_t *>(calldata_ptr(cd, "source"));
+	static_cast<RetroRecorder *>(data)->forget(source);
+}
+
+std::string RetroRecorder::outputDirectory()
+{
+	char *path = obs_module_config_path(OUTPUT_DIRECTORY);
+	if (!path)
+		return std::string();
+	std::string result(path);
+	bfree(path);
+	if (os_mkdirs(result.c_str()) == MKDIR_ERROR) {
+		obs_log(LOG_WARNING, "[Retro] Could not create %s; captures are analysed but not saved",
+			result.c_str());
+		return std::string();
+	}
+	return result;
+}
+
+void RetroRecorder::capture()
+{
+	std::vector<std::shared_ptr<AnalysisTap>> tapped;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		tapped = taps;
+	}
+
+	// Freeze every ring first, so all sources end at the press
+	std::vector<std::shared_ptr<RetroRing>> rings(tapped.size());
+	std::vector<uint64_t> ends(tapped.size(), 0);
+	for (size_t i = 0; i < tapped.size(); i++) {
+		rings[i] = tapped[i]->retroRing();
+		if (rings[i])
+			ends[i] = rings[i]->position();
+	}
+	if (std::none_of(rings.begin(), rings.end(), [](const auto &ring) { return ring != nullptr; })) {
+		obs_log(LOG_INFO, "[Retro] Nothing to capture: no audio inputs, or retro capture is off");
+		return;
+	}
+
+	const std::string directory = outputDirectory();
+	char stamp[32] = "";
+	const std::time_t now = std::time(nullptr);
+	if (const std::tm *local = std::localtime(&now))
+		std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", local);
+
+	for (size_t i = 0; i < tapped.size(); i++) {
+		if (!rings[i])
+			continue;
+		const std::string name = tapped[i]->name();
+
+		// Judge gate and compressor as the source's filters run them now;
+		// a source never calibrated gets the default chain
+		CalibrationChain chain;
+		CalibrationBaseline baseline;
+		if (ProfileSwitcher::instance().baseline(name, baseline))
+			chain = LiveRecalibrator::appliedChain(tapped[i]->source(), baseline);
+
+		std::string path;
+		if (!directory.empty())
+			path = directory + "/retro-" + fileSafe(name) + "-" + stamp + ".wav";
+
+		WorkerPool::shared().submit([name, ring = rings[i], end = ends[i], chain, path]() {
+			RetroSnapshotPtr snapshot = ring->snapshot(end);
+			if (!snapshot) {
+				obs_log(LOG_INFO, "[Retro] %s: no audio in the buffer yet", name.c_str());
+				return;
+			}
+			const RetroAnalysis analysis = RetroCapture::analyze(*snapshot, chain);
+			const bool saved = !path.empty() && RetroCapture::exportWav(*snapshot, path);
+			obs_log(LOG_INFO, "[Retro] %s: %s%s%s", name.c_str(), analysis.summary().c_str(),
+				saved ? "; saved to " : "", saved ? path.c_str() : "");
+		});
+	}
+}
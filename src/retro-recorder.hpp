@@ -0,0 +1,53 @@
+/*
+ * Retro Recorder - "Did I just clip?" for every audio input, wizard or not
+ * Copyright (C) 2025
+ *
+ * Holds a shared analysis tap on every audio input, so each one keeps its
+ * retro ring filling (AnalysisTap::retroRing) whether or not the wizard is
+ * open. The retro hotkey freezes every ring at once; copying, analysing
+ * against the source's applied chain and exporting a WAV into the plugin's
+ * config directory then happen on the worker pool, one job per source.
+ */
+
+#ifndef RETRO_RECORDER_HPP
+#define RETRO_RECORDER_HPP
+
+#include <obs.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "analysis-worker.hpp"
+
+class RetroRecorder {
+public:
+	static RetroRecorder &instance();
+
+	// Tap existing and future audio inputs
+	void attach();
+	void detach();
+
+	// Freeze every ring now and analyse the frozen audio on the pool. UI
+	// thread (lookups go through the profile switcher).
+	void capture();
+
+private:
+	RetroRecorder() = default;
+
+	void watch(obs_source_t *source);
+	void forget(obs_source_t *source);
+
+	static void sourceCreated(void *data, calldata_t *cd);
+	static void sourceRemoved(void *data, calldata_t *cd);
+
+	// Where captures are written; created on first use
+	static std::string outputDirectory();
+
+	std::mutex mutex;
+	bool attached = false;
+	std::vector<std::shared_ptr<AnalysisTap>> taps;
+};
+
+#endif // RETRO_RECORDER_HPP
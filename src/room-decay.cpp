@@ -0,0 +1,223 @@
+/*
+ * Room Decay Implementation
+ * Copyright (C) 2025
+ */
+
+#include "room-decay.hpp"
+#include "biquad.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+static const float OCTAVE_CENTERS[] = {125.0f, 250.0f, 500.0f, 1000.0f, 2000.0f, 4000.0f};
+
+// Two cascaded sections give roughly an octave-wide band
+static constexpr double BAND_Q = 1.0;
+
+// The last fifth of the capture after the clap is taken as room noise
+static constexpr double NOISE_FRACTION = 0.2;
+
+// Stop integrating where the decay comes this close to the noise
+static constexpr float NOISE_MARGIN_DB = 5.0f;
+
+static float powerDb(double power)
+{
+	return power > 1e-20 ? static_cast<float>(10.0 * std::log10(power)) : -200.0f;
+}
+
+// Time for the integrated curve to fall from `from` to `to` dB, extrapolated
+// to 60 dB by a least-squares line; 0 if the curve never reaches `to`
+static float fitRange(const std::vector<double> &schroeder, size_t end, uint32_t sampleRate, float from, float to)
+{
+	const double total = schroeder[0];
+	double n = 0.0;
+	double sumT = 0.0;
+	double sumL = 0.0;
+	double sumTT = 0.0;
+	double sumTL = 0.0;
+	bool reached = false;
+
+	for (size_t i = 0; i < end; i++) {
+		const float level = powerDb(schroeder[i] / total);
+		if (level > from)
+			continue;
+		if (level < to) {
+			reached = true;
+			break;
+		}
+		const double t = static_cast<double>(i) / sampleRate;
+		n += 1.0;
+		sumT += t;
+		sumL += level;
+		sumTT += t * t;
+		sumTL += t * level;
+	}
+
+	const double denominator = n * sumTT - sumT * sumT;
+	if (!reached || n < 2.0 || denominator <= 0.0)
+		return 0.0f;
+	const double slope = (n * sumTL - sumT * sumL) / denominator; // dB per second
+	return slope < 0.0 ? static_cast<float>(-60.0 / slope) : 0.0f;
+}
+
+DecayBand RoomDecay::fitDecay(const std::vector<float> &energy, uint32_t sampleRate)
+{
+	DecayBand band;
+	const size_t window = std::max<size_t>(1, static_cast<size_t>(WINDOW_SECONDS * sampleRate));
+	const size_t windows = energy.size() / window;
+	if (windows < 4)
+		return band;
+
+	std::vector<double> levels(windows, 0.0);
+	for (size_t w = 0; w < windows; w++) {
+		double sum = 0.0;
+		for (size_t i = w * window; i < (w + 1) * window; i++)
+			sum += energy[i];
+		levels[w] = sum / window;
+	}
+
+	// Noise: mean of the tail end, which should be silent room
+	const size_t noiseWindows = std::max<size_t>(1, static_cast<size_t>(windows * NOISE_FRACTION));
+	double noise = 0.0;
+	for (size_t w = windows - noiseWindows; w < windows; w++)
+		noise += levels[w];
+	noise /= noiseWindows;
+
+	const double peak = *std::max_element(levels.begin(), levels.end());
+	band.dynamicRangeDb = powerDb(peak) - powerDb(noise);
+
+	// Truncate where the decay meets the noise (first window within the margin)
+	const double limit = noise * std::pow(10.0, NOISE_MARGIN_DB / 10.0);
+	size_t truncate = windows;
+	for (size_t w = 1; w < windows; w++) {
+		if (levels[w] <= limit) {
+			truncate = w;
+			break;
+		}
+	}
+	const size_t end = truncate * window;
+
+	// Schroeder backward integration with the noise subtracted
+	std::vector<double> schroeder(end + 1, 0.0);
+	for (size_t i = end; i-- > 0;)
+		schroeder[i] = schroeder[i + 1] + std::max(0.0, static_cast<double>(energy[i]) - noise);
+	if (schroeder[0] <= 0.0)
+		return band;
+
+	band.t20 = fitRange(schroeder, end, sampleRate, -5.0f, -25.0f);
+	band.t30 = fitRange(schroeder, end, sampleRate, -5.0f, -35.0f);
+	return band;
+}
+
+RoomDecayResult RoomDecay::analyze(const float *samples, size_t count, uint32_t sampleRate)
+{
+	RoomDecayResult result;
+	const size_t window = static_cast<size_t>(WINDOW_SECONDS * sampleRate);
+	if (sampleRate == 0 || count < 4 * window) {
+		result.message = "No audio captured";
+		return result;
+	}
+
+	// Clap: loudest 10 ms window
+	size_t clapWindow = 0;
+	double loudest = 0.0;
+	for (size_t start = 0; start + window <= count; start += window) {
+		double sum = 0.0;
+		for (size_t i = start; i < start + window; i++)
+			sum += static_cast<double>(samples[i]) * samples[i];
+		if (sum > loudest) {
+			loudest = sum;
+			clapWindow = start;
+		}
+	}
+	if (loudest <= 0.0) {
+		result.message = "The capture is silent";
+		return result;
+	}
+
+	// Start at the sample peak inside that window
+	size_t clap = clapWindow;
+	for (size_t i = clapWindow; i < clapWindow + window; i++) {
+		if (std::fabs(samples[i]) > std::fabs(samples[clap]))
+			clap = i;
+	}
+	result.clapSeconds = static_cast<double>(clap) / sampleRate;
+	if (static_cast<double>(count - clap) / sampleRate < MIN_TAIL_SECONDS) {
+		result.message = "The clap came too late; clap once near the start and stay quiet";
+		return result;
+	}
+
+	std::vector<float> energy(count - clap);
+	for (float centerHz : OCTAVE_CENTERS) {
+		if (centerHz * 1.5f >= sampleRate * 0.5f)
+			continue;
+
+		// Filter from the start so the sections have settled by the clap
+		const BiquadCoeffs coeffs = BiquadCoeffs::bandPass(sampleRate, centerHz, BAND_Q);
+		BiquadState first;
+		BiquadState second;
+		for (size_t i = 0; i < count; i++) {
+			const float y = second.process(coeffs, first.process(coeffs, samples[i]));
+			if (i >= clap)
+				energy[i - clap] = y * y;
+		}
+
+		DecayBand band = fitDecay(energy, sampleRate);
+		band.centerHz = centerHz;
+		if (band.dynamicRangeDb < MIN_DYNAMIC_RANGE_DB)
+			band.t20 = band.t30 = 0.0f;
+		else if (band.dynamicRangeDb < MIN_DYNAMIC_RANGE_DB + 10.0f)
+			band.t30 = 0.0f; // -35 dB would sit in the noise
+		result.bands.push_back(band);
+	}
+
+	// Mid-frequency figures, as RT60 is usually quoted
+	int t20Count = 0;
+	int t30Count = 0;
+	for (const DecayBand &band : result.bands) {
+		if (band.centerHz != 500.0f && band.centerHz != 1000.0f)
+			continue;
+		if (band.t20 > 0.0f) {
+			result.t20 += band.t20;
+			t20Count++;
+		}
+		if (band.t30 > 0.0f) {
+			result.t30 += band.t30;
+			t30Count++;
+		}
+	}
+	result.t20 = t20Count ? result.t20 / t20Count : 0.0f;
+	result.t30 = t30Count ? result.t30 / t30Count : 0.0f;
+
+	if (result.t20 <= 0.0f && result.t30 <= 0.0f) {
+		result.message = "The clap was not loud enough over the room noise; clap sharply, closer to the mic";
+		return result;
+	}
+	result.ok = true;
+	return result;
+}
+
+std::string RoomDecayResult::summary() const
+{
+	if (!ok)
+		return message;
+
+	char part[96];
+	if (t30 > 0.0f)
+		snprintf(part, sizeof(part), "RT60 T20 %.2f s, T30 %.2f s (T20/T30 by band:", t20, t30);
+	else
+		snprintf(part, sizeof(part), "RT60 T20 %.2f s, T30 n/a (T20/T30 by band:", t20);
+	std::string text = part;
+
+	for (const DecayBand &band : bands) {
+		if (band.t20 <= 0.0f)
+			snprintf(part, sizeof(part), " %.0f Hz -", band.centerHz);
+		else if (band.t30 <= 0.0f)
+			snprintf(part, sizeof(part), " %.0f Hz %.2f/-", band.centerHz, band.t20);
+		else
+			snprintf(part, sizeof(part), " %.0f Hz %.2f/%.2f", band.centerHz, band.t20, band.t30);
+		text += part;
+	}
+	return text + ")";
+}
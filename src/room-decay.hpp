@@ -0,0 +1,58 @@
+/*
+ * Room Decay - Reverberation time from a recorded hand clap
+ * Copyright (C) 2025
+ *
+ * The clap is found as the loudest 10 ms window of the capture. Each octave
+ * band is filtered, the noise floor is taken from the quiet end of the
+ * capture, the squared response is Schroeder backward-integrated up to where
+ * the decay meets the noise, and T20/T30 come from a straight-line fit of
+ * the integrated curve. Everything is a single pass over the samples per
+ * band.
+ */
+
+#ifndef ROOM_DECAY_HPP
+#define ROOM_DECAY_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct DecayBand {
+	float centerHz = 0.0f;
+	float t20 = 0.0f;           // seconds; 0 if the decay was too short to fit
+	float t30 = 0.0f;
+	float dynamicRangeDb = 0.0f; // clap over the band's noise floor
+};
+
+struct RoomDecayResult {
+	bool ok = false;
+	std::string message;
+
+	double clapSeconds = 0.0; // position of the clap in the capture
+	std::vector<DecayBand> bands;
+
+	// Mean of the 500 Hz and 1 kHz bands (0 if neither could be fitted)
+	float t20 = 0.0f;
+	float t30 = 0.0f;
+
+	std::string summary() const;
+};
+
+class RoomDecay {
+public:
+	static constexpr double WINDOW_SECONDS = 0.01;
+
+	// The clap must clear the capture's noise floor by this much for T20
+	static constexpr float MIN_DYNAMIC_RANGE_DB = 35.0f;
+
+	// Decay after the clap needed to see the noise floor
+	static constexpr double MIN_TAIL_SECONDS = 1.0;
+
+	// Mono capture; safe on a worker thread
+	static RoomDecayResult analyze(const float *samples, size_t count, uint32_t sampleRate);
+
+	// Fit one band: squared, already filtered samples from the clap on
+	static DecayBand fitDecay(const std::vector<float> &energy, uint32_t sampleRate);
+};
+
+#endif // ROOM_DECAY_HPP
@@ -0,0 +1,69 @@
+/*
+ * Sample Ring Implementation
+ * Copyright (C) 2025
+ */
+
+#include "sample-ring.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+static size_t roundUpPowerOfTwo(size_t value)
+{
+	size_t result = 1;
+	while (result < value)
+		result <<= 1;
+	return result;
+}
+
+SampleRing::SampleRing(size_t minCapacity)
+	: buffer(roundUpPowerOfTwo(std::max<size_t>(minCapacity, 2 * WRITE_CHUNK)), 0.0f),
+	  mask(buffer.size() - 1)
+{
+}
+
+void SampleRing::write(const float *samples, size_t count)
+{
+	uint64_t position = writeCount.load(std::memory_order_relaxed);
+
+	// Only the newest capacity() samples can survive
+	if (count > buffer.size()) {
+		position += count - buffer.size();
+		samples += count - buffer.size();
+		count = buffer.size();
+	}
+
+	while (count > 0) {
+		const size_t chunk = std::min(count, WRITE_CHUNK);
+		const size_t offset = static_cast<size_t>(position) & mask;
+		const size_t first = std::min(chunk, buffer.size() - offset);
+		std::memcpy(buffer.data() + offset, samples, first * sizeof(float));
+		if (first < chunk)
+			std::memcpy(buffer.data(), samples + first, (chunk - first) * sizeof(float));
+
+		position += chunk;
+		samples += chunk;
+		count -= chunk;
+		writeCount.store(position, std::memory_order_release);
+	}
+}
+
+bool SampleRing::read(uint64_t position, float *out, size_t count) const
+{
+	if (count > buffer.size())
+		return false;
+
+	const uint64_t end = written();
+	if (position + count > end || end - position + WRITE_CHUNK > buffer.size())
+		return false;
+
+	const size_t offset = static_cast<size_t>(position) & mask;
+	const size_t first = std::min(count, buffer.size() - offset);
+	std::memcpy(out, buffer.data() + offset, first * sizeof(float));
+	if (first < count)
+		std::memcpy(out + first, buffer.data(), (count - first) * sizeof(float));
+
+	// The writer may have lapped us while copying
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return written() - position + WRITE_CHUNK <= buffer.size();
+}
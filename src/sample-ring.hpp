@@ -0,0 +1,56 @@
+/*
+ * Sample Ring - Single-producer ring of float samples
+ * Copyright (C) 2025
+ *
+ * The audio thread only copies into the ring and publishes a running sample
+ * count; readers on other threads copy out by absolute position and detect
+ * when the writer has lapped them.
+ */
+
+#ifndef SAMPLE_RING_HPP
+#define SAMPLE_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class SampleRing {
+public:
+	// Capacity is rounded up to a power of two
+	explicit SampleRing(size_t minCapacity);
+
+	size_t capacity() const { return buffer.size(); }
+
+	// Producer side (audio thread): memcpy plus one atomic store
+	void write(const float *samples, size_t count);
+
+	// Total samples ever written
+	uint64_t written() const { return writeCount.load(std::memory_order_acquire); }
+
+	// Oldest position that is still safely readable
+	uint64_t oldest() const
+	{
+		const uint64_t end = written();
+		const uint64_t span = buffer.size() - WRITE_CHUNK;
+		return end > span ? end - span : 0;
+	}
+
+	// Copy [position, position + count). Returns false if any of it has not
+	// been written yet or was overwritten while copying.
+	bool read(uint64_t position, float *out, size_t count) const;
+
+	// Forget everything written so far (only while the producer is idle)
+	void clear() { writeCount.store(0, std::memory_order_release); }
+
+private:
+	// A write in progress may touch up to this many slots past written(),
+	// so readers need that much headroom to trust what they copied.
+	static constexpr size_t WRITE_CHUNK = 4096;
+
+	std::vector<float> buffer;
+	size_t mask;
+	std::atomic<uint64_t> writeCount{0};
+};
+
+#endif // SAMPLE_RING_HPP
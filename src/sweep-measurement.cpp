@@ -0,0 +1,300 @@
+/*
+ * Sweep Measurement Implementation
+ * Copyright (C) 2025
+ */
+
+#include "sweep-measurement.hpp"
+#include "wav-file.hpp"
+#include <plugin-support.h>
+
+#include <obs.h>
+#include <util/platform.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+static constexpr double PI = 3.14159265358979323846;
+
+// Width of the raised-cosine taper at each band edge of the inverse filter
+static constexpr double EDGE_OCTAVES = 0.5;
+
+static float toDb(double linear)
+{
+	return linear > 1e-10 ? static_cast<float>(20.0 * std::log10(linear)) : -200.0f;
+}
+
+ExponentialSweep::ExponentialSweep(const SweepParams &params) : sweepParams(params)
+{
+	const double rate = sweepParams.sampleRate;
+	const size_t count = static_cast<size_t>(sweepParams.seconds * rate);
+	const double octaveRate = std::log(sweepParams.endHz / sweepParams.startHz);
+	const double scale = 2.0 * PI * sweepParams.startHz * sweepParams.seconds / octaveRate;
+	const size_t fade = std::min(count / 2, static_cast<size_t>(sweepParams.fadeSeconds * rate));
+
+	signal.resize(count);
+	for (size_t i = 0; i < count; i++) {
+		const double t = static_cast<double>(i) / rate;
+		double gain = sweepParams.amplitude;
+		if (i < fade)
+			gain *= 0.5 - 0.5 * std::cos(PI * static_cast<double>(i) / fade);
+		else if (i >= count - fade)
+			gain *= 0.5 - 0.5 * std::cos(PI * static_cast<double>(count - 1 - i) / fade);
+		const double phase = scale * (std::exp(t * octaveRate / sweepParams.seconds) - 1.0);
+		signal[i] = static_cast<float>(gain * std::sin(phase));
+	}
+}
+
+bool ExponentialSweep::writeWav(const std::string &path) const
+{
+	WavWriter writer;
+	if (!writer.open(path, sweepParams.sampleRate, 1))
+		return false;
+
+	const std::vector<float> tail(static_cast<size_t>(sweepParams.tailSeconds * sweepParams.sampleRate), 0.0f);
+	const bool ok = writer.write(signal.data(), signal.size()) && writer.write(tail.data(), tail.size());
+	return writer.close() && ok;
+}
+
+float SweepResult::levelAt(float hz) const
+{
+	if (response.empty())
+		return -100.0f;
+	auto nearest = std::min_element(response.begin(), response.end(), [hz](const auto &a, const auto &b) {
+		return std::fabs(std::log(a.hz / hz)) < std::fabs(std::log(b.hz / hz));
+	});
+	return nearest->db;
+}
+
+std::string SweepResult::summary() const
+{
+	if (!ok)
+		return message;
+
+	// Spread of the speech band relative to 1 kHz
+	const float reference = levelAt(1000.0f);
+	float low = 0.0f;
+	float high = 0.0f;
+	for (const ResponsePoint &point : response) {
+		if (point.hz < 100.0f || point.hz > 10000.0f)
+			continue;
+		low = std::min(low, point.db - reference);
+		high = std::max(high, point.db - reference);
+	}
+
+	char text[256];
+	snprintf(text, sizeof(text),
+		 "latency %.1f ms, path gain %.1f dB, SNR %.0f dB, 100 Hz-10 kHz within %+.1f/%+.1f dB of 1 kHz "
+		 "(100 Hz %+.1f, 4 kHz %+.1f, 8 kHz %+.1f)",
+		 latencyMs, peakDb, snrDb, low, high, levelAt(100.0f) - reference, levelAt(4000.0f) - reference,
+		 levelAt(8000.0f) - reference);
+	return text;
+}
+
+SweepDeconvolver::SweepDeconvolver(const ExponentialSweep &sweep, size_t maxRecordingFrames)
+	: params(sweep.params()),
+	  sweepFrames(sweep.samples().size()),
+	  maxFrames(maxRecordingFrames),
+	  // Distortion products reach back up to one sweep length before the
+	  // impulse; the transform is long enough that they never wrap onto it
+	  plan(FftPlan::nextPowerOfTwo(maxRecordingFrames + sweep.samples().size()))
+{
+	const size_t n = plan.size();
+	std::vector<float> padded(n, 0.0f);
+	std::copy(sweep.samples().begin(), sweep.samples().end(), padded.begin());
+
+	std::vector<std::complex<float>> scratch(n / 2);
+	inverse.resize(plan.bins());
+	plan.forwardReal(padded.data(), inverse.data(), scratch.data());
+
+	// Band-limited 1/X with raised-cosine edges; outside the sweep there is
+	// nothing to divide by. Scaling by 1/N here saves a pass later.
+	const double binHz = static_cast<double>(params.sampleRate) / n;
+	const double edge = std::pow(2.0, EDGE_OCTAVES);
+	const double nyquist = params.sampleRate * 0.5;
+	const double lowStart = params.startHz;
+	const double highEnd = std::min(params.endHz, nyquist);
+	double peakPower = 0.0;
+	for (const auto &value : inverse)
+		peakPower = std::max(peakPower, static_cast<double>(std::norm(value)));
+	const double floorPower = peakPower * 1e-8;
+
+	for (size_t k = 0; k < inverse.size(); k++) {
+		const double hz = k * binHz;
+		double weight = 1.0;
+		if (hz <= lowStart || hz >= highEnd)
+			weight = 0.0;
+		else if (hz < lowStart * edge)
+			weight = 0.5 - 0.5 * std::cos(PI * std::log(hz / lowStart) / std::log(edge));
+		else if (hz > highEnd / edge)
+			weight = 0.5 - 0.5 * std::cos(PI * std::log(highEnd / hz) / std::log(edge));
+
+		const std::complex<float> x = inverse[k];
+		const double power = std::max(static_cast<double>(std::norm(x)), floorPower);
+		inverse[k] = std::conj(x) * static_cast<float>(weight / (power * n));
+	}
+}
+
+SweepResult SweepDeconvolver::deconvolve(const float *recording, size_t frames) const
+{
+	SweepResult result;
+	result.sampleRate = params.sampleRate;
+
+	const uint64_t startNs = os_gettime_ns();
+	frames = std::min(frames, maxFrames);
+	if (frames < sweepFrames) {
+		result.message = "Recording is shorter than the sweep";
+		return result;
+	}
+
+	const size_t n = plan.size();
+	std::vector<float> buffer(n, 0.0f);
+	std::copy(recording, recording + frames, buffer.begin());
+
+	std::vector<std::complex<float>> spectrum(plan.bins());
+	std::vector<std::complex<float>> scratch(n / 2);
+	plan.forwardReal(buffer.data(), spectrum.data(), scratch.data());
+	for (size_t k = 0; k < spectrum.size(); k++)
+		spectrum[k] *= inverse[k];
+	plan.inverseReal(spectrum.data(), buffer.data(), scratch.data());
+
+	// The direct sound can only arrive while the sweep still fits in the
+	// recording
+	const size_t searchEnd = frames - sweepFrames + 1;
+	size_t peakIndex = 0;
+	float peak = 0.0f;
+	for (size_t i = 0; i < searchEnd; i++) {
+		const float magnitude = std::fabs(buffer[i]);
+		if (magnitude > peak) {
+			peak = magnitude;
+			peakIndex = i;
+		}
+	}
+	if (peak <= 0.0f) {
+		result.message = "No sweep found in the recording";
+		return result;
+	}
+
+	const size_t pre = static_cast<size_t>(PRE_SECONDS * params.sampleRate);
+	const size_t start = peakIndex > pre ? peakIndex - pre : 0;
+	const size_t length = std::min(static_cast<size_t>(IMPULSE_SECONDS * params.sampleRate), n - start);
+	result.impulse.assign(buffer.begin() + static_cast<std::ptrdiff_t>(start),
+			      buffer.begin() + static_cast<std::ptrdiff_t>(start + length));
+
+	// Half-Hann fade over the last tenth so the window edge does not ring
+	const size_t fade = length / 10;
+	for (size_t i = 0; i < fade; i++)
+		result.impulse[length - 1 - i] *= static_cast<float>(0.5 - 0.5 * std::cos(PI * i / fade));
+
+	// Noise: what the deconvolution leaves after the room has died away
+	const size_t noiseStart = start + length;
+	const size_t noiseLength = static_cast<size_t>(NOISE_SECONDS * params.sampleRate);
+	double noisePower = 0.0;
+	if (noiseStart + noiseLength <= n - sweepFrames) {
+		for (size_t i = noiseStart; i < noiseStart + noiseLength; i++)
+			noisePower += static_cast<double>(buffer[i]) * buffer[i];
+		noisePower /= noiseLength;
+	}
+
+	result.latencyMs = 1000.0 * peakIndex / params.sampleRate;
+	result.peakDb = toDb(peak);
+	result.snrDb = noisePower > 0.0 ? static_cast<float>(10.0 * std::log10(peak * peak / noisePower)) : 0.0f;
+	result.response = frequencyResponse(result.impulse.data(), result.impulse.size(), params.sampleRate,
+					    params.startHz, std::min(params.endHz, params.sampleRate * 0.5));
+	result.deconvolveMs = static_cast<double>(os_gettime_ns() - startNs) / 1e6;
+	result.ok = true;
+	return result;
+}
+
+SweepResult SweepDeconvolver::measureWav(const ExponentialSweep &sweep, const std::string &path)
+{
+	SweepResult result;
+	WavAudio audio;
+	if (!WavReader::read(path, audio)) {
+		result.message = "Cannot read " + path;
+		return result;
+	}
+	if (audio.sampleRate != sweep.params().sampleRate) {
+		result.message = "Recording is " + std::to_string(audio.sampleRate) + " Hz, the sweep is " +
+				 std::to_string(sweep.params().sampleRate) + " Hz";
+		return result;
+	}
+
+	if (audio.frames() > MAX_RECORDING_SECONDS * audio.sampleRate) {
+		result.message = "Recording is longer than " + std::to_string(static_cast<int>(MAX_RECORDING_SECONDS)) +
+				 " s; trim it around the sweep";
+		return result;
+	}
+
+	const SweepDeconvolver deconvolver(sweep, audio.frames());
+	return deconvolver.deconvolve(audio.channels[0].data(), audio.frames());
+}
+
+std::vector<float> SweepDeconvolver::simulatePlayback(const std::vector<float> &sweep,
+						      const std::vector<float> &impulse, size_t delayFrames,
+						      float noiseDb, uint32_t seed)
+{
+	const size_t convolved = sweep.size() + impulse.size() - 1;
+	const FftPlan plan(FftPlan::nextPowerOfTwo(convolved));
+	const size_t n = plan.size();
+
+	std::vector<float> a(n, 0.0f);
+	std::vector<float> b(n, 0.0f);
+	std::copy(sweep.begin(), sweep.end(), a.begin());
+	std::copy(impulse.begin(), impulse.end(), b.begin());
+
+	std::vector<std::complex<float>> spectrumA(plan.bins());
+	std::vector<std::complex<float>> spectrumB(plan.bins());
+	std::vector<std::complex<float>> scratch(n / 2);
+	plan.forwardReal(a.data(), spectrumA.data(), scratch.data());
+	plan.forwardReal(b.data(), spectrumB.data(), scratch.data());
+	for (size_t k = 0; k < spectrumA.size(); k++)
+		spectrumA[k] *= spectrumB[k] / static_cast<float>(n);
+	plan.inverseReal(spectrumA.data(), a.data(), scratch.data());
+
+	std::vector<float> recording(delayFrames + convolved, 0.0f);
+	std::copy(a.begin(), a.begin() + static_cast<std::ptrdiff_t>(convolved),
+		  recording.begin() + static_cast<std::ptrdiff_t>(delayFrames));
+
+	std::mt19937 rng(seed);
+	std::normal_distribution<float> noise(0.0f, static_cast<float>(std::pow(10.0, noiseDb / 20.0)));
+	for (float &sample : recording)
+		sample += noise(rng);
+	return recording;
+}
+
+std::vector<ResponsePoint> SweepDeconvolver::frequencyResponse(const float *impulse, size_t count,
+							       uint32_t sampleRate, double startHz, double endHz)
+{
+	const FftPlan plan(std::max<size_t>(FftPlan::nextPowerOfTwo(count), 4096));
+	const size_t n = plan.size();
+
+	std::vector<float> padded(n, 0.0f);
+	std::copy(impulse, impulse + count, padded.begin());
+	std::vector<std::complex<float>> spectrum(plan.bins());
+	std::vector<std::complex<float>> scratch(n / 2);
+	plan.forwardReal(padded.data(), spectrum.data(), scratch.data());
+
+	// Running sum of bin powers so each 1/6-octave average is O(1)
+	std::vector<double> cumulative(spectrum.size() + 1, 0.0);
+	for (size_t k = 0; k < spectrum.size(); k++)
+		cumulative[k + 1] = cumulative[k] + std::norm(spectrum[k]);
+
+	const double binHz = static_cast<double>(sampleRate) / n;
+	const double halfWidth = std::pow(2.0, 1.0 / 12.0);
+	std::vector<ResponsePoint> points;
+	for (double hz = startHz; hz <= endHz * 1.0001; hz *= std::pow(2.0, 1.0 / 12.0)) {
+		size_t lo = static_cast<size_t>(std::floor(hz / halfWidth / binHz));
+		size_t hi = static_cast<size_t>(std::ceil(hz * halfWidth / binHz));
+		lo = std::min(lo, spectrum.size() - 1);
+		hi = std::min(std::max(hi, lo + 1), spectrum.size());
+
+		ResponsePoint point;
+		point.hz = static_cast<float>(hz);
+		const double power = (cumulative[hi] - cumulative[lo]) / static_cast<double>(hi - lo);
+		point.db = power > 1e-20 ? static_cast<float>(10.0 * std::log10(power)) : -200.0f;
+		points.push_back(point);
+	}
+	return points;
+}
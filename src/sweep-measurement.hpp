@@ -0,0 +1,114 @@
+/*
+ * Sweep Measurement - Impulse and frequency response of speaker, room and mic
+ * Copyright (C) 2025
+ *
+ * An exponential sine sweep (Farina) is played into the room and recorded
+ * through the mic. Dividing the recording's spectrum by the sweep's gives the
+ * impulse response; harmonic distortion lands at negative time and is left
+ * out of the window. The recording can come from a retro capture, a WAV file,
+ * or simulatePlayback() when there is no speaker.
+ */
+
+#ifndef SWEEP_MEASUREMENT_HPP
+#define SWEEP_MEASUREMENT_HPP
+
+#include <complex>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "fft.hpp"
+
+struct SweepParams {
+	uint32_t sampleRate = 48000;
+	double startHz = 20.0;
+	double endHz = 20000.0;
+	double seconds = 10.0;
+	double fadeSeconds = 0.05;   // raised-cosine fade at both ends
+	float amplitude = 0.5f;      // -6 dBFS
+	double tailSeconds = 1.0;    // silence after the sweep in the WAV
+};
+
+class ExponentialSweep {
+public:
+	explicit ExponentialSweep(const SweepParams &params);
+
+	const SweepParams &params() const { return sweepParams; }
+	const std::vector<float> &samples() const { return signal; }
+
+	// Mono float WAV: the sweep followed by tailSeconds of silence, for
+	// playing from a media source or another device
+	bool writeWav(const std::string &path) const;
+
+private:
+	SweepParams sweepParams;
+	std::vector<float> signal;
+};
+
+struct ResponsePoint {
+	float hz = 0.0f;
+	float db = -100.0f;
+};
+
+struct SweepResult {
+	bool ok = false;
+	std::string message;
+
+	uint32_t sampleRate = 0;
+	std::vector<float> impulse;  // starts PRE_SECONDS before the direct sound
+	double latencyMs = 0.0;      // sweep start to direct sound in the recording
+	float peakDb = -100.0f;      // impulse peak (gain of the whole path)
+	float snrDb = 0.0f;          // impulse peak over the deconvolved noise
+
+	// 1/6-octave smoothed magnitude in dB re the sweep, 1/12-octave spacing.
+	// The inverse filter tapers over the outer half octave of the sweep.
+	std::vector<ResponsePoint> response;
+
+	double deconvolveMs = 0.0;
+
+	// Smoothed response at the point nearest to hz
+	float levelAt(float hz) const;
+
+	std::string summary() const;
+};
+
+class SweepDeconvolver {
+public:
+	static constexpr double IMPULSE_SECONDS = 0.5;
+	static constexpr double PRE_SECONDS = 0.005;
+	static constexpr double NOISE_SECONDS = 0.25;
+
+	// Bounds the transform (and its memory) for long captures and files
+	static constexpr double MAX_RECORDING_SECONDS = 60.0;
+
+	// Precomputes the regularised inverse of the sweep for recordings of up
+	// to maxRecordingFrames; longer recordings are truncated
+	SweepDeconvolver(const ExponentialSweep &sweep, size_t maxRecordingFrames);
+
+	size_t maxRecordingFrames() const { return maxFrames; }
+
+	// The recording must contain the whole sweep; where it starts does not
+	// matter. Safe to call from several threads.
+	SweepResult deconvolve(const float *recording, size_t frames) const;
+
+	// First channel of a WAV recorded at the sweep's sample rate
+	static SweepResult measureWav(const ExponentialSweep &sweep, const std::string &path);
+
+	// Headless stand-in for speaker, room and mic: the sweep convolved with
+	// impulse, delayed and with white noise at noiseDb RMS added
+	static std::vector<float> simulatePlayback(const std::vector<float> &sweep, const std::vector<float> &impulse,
+						   size_t delayFrames, float noiseDb, uint32_t seed);
+
+	// Smoothed magnitude response of an impulse, as in SweepResult::response
+	static std::vector<ResponsePoint> frequencyResponse(const float *impulse, size_t count, uint32_t sampleRate,
+							    double startHz, double endHz);
+
+private:
+	SweepParams params;
+	size_t sweepFrames;
+	size_t maxFrames;
+	FftPlan plan;
+	std::vector<std::complex<float>> inverse; // conj(X) / |X|^2, band-limited, pre-scaled by 1/N
+};
+
+#endif // SWEEP_MEASUREMENT_HPP
@@ -0,0 +1,63 @@
+/*
+ * Timeline Monitor Implementation
+ * Copyright (C) 2025
+ */
+
+#include "timeline-monitor.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+std::string TimelineCounts::summary() const
+{
+	if (callbacks == 0)
+		return "no audio";
+	if (gaps == 0 && overlaps == 0 && jitter == 0)
+		return "continuous";
+
+	char text[128];
+	snprintf(text, sizeof(text), "%llu gaps (%.0f ms lost), %llu overlaps, %llu jittered",
+		 static_cast<unsigned long long>(gaps), static_cast<double>(missingNs) / 1e6,
+		 static_cast<unsigned long long>(overlaps), static_cast<unsigned long long>(jitter));
+	return text;
+}
+
+void TimelineMonitor::configure(uint32_t sampleRate)
+{
+	nsPerFrameQ16 = (1000000000ULL << 16) / std::max<uint32_t>(1, sampleRate);
+	reset();
+}
+
+void TimelineMonitor::reset()
+{
+	expected = 0;
+	started = false;
+	callbacks.store(0, std::memory_order_relaxed);
+	gaps.store(0, std::memory_order_relaxed);
+	overlaps.store(0, std::memory_order_relaxed);
+	jitter.store(0, std::memory_order_relaxed);
+	missingNs.store(0, std::memory_order_relaxed);
+}
+
+void TimelineMonitor::onDeviation(int64_t deviation)
+{
+	if (deviation > DISCONTINUITY_NS) {
+		bump(gaps);
+		bump(missingNs, static_cast<uint64_t>(deviation));
+	} else if (deviation < -DISCONTINUITY_NS) {
+		bump(overlaps);
+	} else {
+		bump(jitter);
+	}
+}
+
+TimelineCounts TimelineMonitor::counts() const
+{
+	TimelineCounts result;
+	result.callbacks = callbacks.load(std::memory_order_relaxed);
+	result.gaps = gaps.load(std::memory_order_relaxed);
+	result.overlaps = overlaps.load(std::memory_order_relaxed);
+	result.jitter = jitter.load(std::memory_order_relaxed);
+	result.missingNs = missingNs.load(std::memory_order_relaxed);
+	return result;
+}
@@ -0,0 +1,88 @@
+/*
+ * Timeline Monitor - Continuity of a source's audio callback timestamps
+ * Copyright (C) 2025
+ *
+ * Each capture callback should start where the previous one ended. The
+ * check predicts the next timestamp from the frame count and compares: one
+ * multiply, one subtract and a compare in the common case. Gaps (audio
+ * OBS never delivered), overlaps (audio delivered twice or timestamps
+ * jumping back) and smaller cadence jitter are counted in relaxed atomics
+ * that the UI reads at any time. Anything measured across a gap or overlap
+ * is not a valid calibration window.
+ */
+
+#ifndef TIMELINE_MONITOR_HPP
+#define TIMELINE_MONITOR_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+struct TimelineCounts {
+	uint64_t callbacks = 0;
+	uint64_t gaps = 0;
+	uint64_t overlaps = 0;
+	uint64_t jitter = 0;
+	uint64_t missingNs = 0; // total time lost in gaps
+
+	// Gaps and overlaps; jitter alone does not break a window
+	uint64_t discontinuities() const { return gaps + overlaps; }
+	std::string summary() const;
+};
+
+class TimelineMonitor {
+public:
+	// Deviations inside this are timestamp rounding
+	static constexpr int64_t TOLERANCE_NS = 1000000;
+	// Beyond this the stream is discontinuous (half a 1024-frame buffer
+	// at 48 kHz)
+	static constexpr int64_t DISCONTINUITY_NS = 10000000;
+
+	// Only while no callback is checking; also resets
+	void configure(uint32_t sampleRate);
+	void reset();
+
+	// Audio thread, once per callback
+	inline void check(uint64_t timestamp, uint32_t frames)
+	{
+		const int64_t deviation = static_cast<int64_t>(timestamp - expected);
+		expected = timestamp + ((frames * nsPerFrameQ16) >> 16);
+		bump(callbacks);
+
+		if (deviation >= -TOLERANCE_NS && deviation <= TOLERANCE_NS)
+			return;
+		if (!started) {
+			started = true;
+			return;
+		}
+		onDeviation(deviation);
+	}
+
+	TimelineCounts counts() const;
+	uint64_t discontinuities() const
+	{
+		return gaps.load(std::memory_order_relaxed) + overlaps.load(std::memory_order_relaxed);
+	}
+
+private:
+	// Single writer, so no read-modify-write instruction is needed
+	static inline void bump(std::atomic<uint64_t> &counter, uint64_t amount = 1)
+	{
+		counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+	}
+
+	void onDeviation(int64_t deviation);
+
+	// Audio-thread state
+	uint64_t expected = 0;
+	uint64_t nsPerFrameQ16 = (1000000000ULL << 16) / 48000;
+	bool started = false;
+
+	std::atomic<uint64_t> callbacks{0};
+	std::atomic<uint64_t> gaps{0};
+	std::atomic<uint64_t> overlaps{0};
+	std::atomic<uint64_t> jitter{0};
+	std::atomic<uint64_t> missingNs{0};
+};
+
+#endif // TIMELINE_MONITOR_HPP
@@ -0,0 +1,196 @@
+/*
+ * Transient Detector Implementation
+ * Copyright (C) 2025
+ */
+
+#include "transient-detector.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// Background per 2 ms frame: about 50 ms to follow a change in room noise
+static constexpr float BACKGROUND_ALPHA = 0.04f;
+
+// While waiting out speech the background creeps up so a long sound ends
+static constexpr float SUSTAINED_ALPHA = 0.02f;
+
+// An impulse is over once it is this far under its own top
+static constexpr float DECAY_DB = 20.0f;
+
+static float powerDb(double power)
+{
+	return power > 1e-12 ? static_cast<float>(10.0 * std::log10(power)) : -120.0f;
+}
+
+static float percentile90(std::vector<float> &values)
+{
+	if (values.empty())
+		return 0.0f;
+	const size_t index = std::min(values.size() - 1, values.size() * 9 / 10);
+	std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+	return values[index];
+}
+
+void TransientDetector::configure(uint32_t sampleRate)
+{
+	rate = sampleRate;
+	frameLength = std::max<size_t>(1, static_cast<size_t>(sampleRate * FRAME_MS / 1000.0f));
+	reset();
+}
+
+void TransientDetector::reset()
+{
+	filled = 0;
+	energy = 0.0;
+	diffEnergy = 0.0;
+	peak = 0.0f;
+	previousSample = 0.0f;
+	frames = 0;
+	backgroundDb = -100.0f;
+	lastFrameDb = -100.0f;
+	inEvent = false;
+	sustained = false;
+}
+
+int TransientDetector::process(const float *samples, size_t count, TransientEvent *events, int maxEvents)
+{
+	int found = 0;
+	size_t i = 0;
+	while (i < count) {
+		const size_t take = std::min(count - i, frameLength - filled);
+		double e = 0.0;
+		double d = 0.0;
+		float p = peak;
+		float previous = previousSample;
+		for (size_t j = i; j < i + take; j++) {
+			const float x = samples[j];
+			const float diff = x - previous;
+			e += static_cast<double>(x) * x;
+			d += static_cast<double>(diff) * diff;
+			p = std::max(p, std::fabs(x));
+			previous = x;
+		}
+		energy += e;
+		diffEnergy += d;
+		peak = p;
+		previousSample = previous;
+		filled += take;
+		i += take;
+
+		if (filled == frameLength)
+			endFrame(events, maxEvents, found);
+	}
+	return found;
+}
+
+void TransientDetector::endFrame(TransientEvent *events, int maxEvents, int &found)
+{
+	const float frameDb = powerDb(energy / static_cast<double>(frameLength));
+
+	if (!inEvent) {
+		if (sustained) {
+			backgroundDb += SUSTAINED_ALPHA * (frameDb - backgroundDb);
+			if (frameDb < backgroundDb + END_MARGIN_DB)
+				sustained = false;
+		} else if (frames > 0 && frameDb - lastFrameDb >= STEP_DB && frameDb >= backgroundDb + RISE_DB &&
+			   20.0f * std::log10(std::max(peak, 1e-6f)) >= MIN_PEAK_DB) {
+			inEvent = true;
+			eventStart = frames;
+			eventFrames = 0;
+			eventPeak = 0.0f;
+			eventTopDb = frameDb;
+			eventEnergy = 0.0;
+			eventDiffEnergy = 0.0;
+			std::fill(std::begin(windowEnergy), std::end(windowEnergy), 0.0);
+			windowSum = 0.0;
+			bestWindow = 0.0;
+		} else {
+			backgroundDb = frames == 0 ? frameDb : backgroundDb + BACKGROUND_ALPHA * (frameDb - backgroundDb);
+		}
+	}
+
+	if (inEvent) {
+		const float durationMs = static_cast<float>(eventFrames) * FRAME_MS;
+		if (eventFrames > 0 && frameDb < std::max(backgroundDb + END_MARGIN_DB, eventTopDb - DECAY_DB)) {
+			inEvent = false;
+			if (found < maxEvents) {
+				TransientEvent &event = events[found];
+				event.brightness =
+					eventEnergy > 0.0 ? static_cast<float>(eventDiffEnergy / (4.0 * eventEnergy)) : 0.0f;
+				event.kind = event.brightness >= CLICK_BRIGHTNESS ? TransientKind::Click : TransientKind::Bump;
+				event.seconds = static_cast<double>(eventStart * frameLength) / rate;
+				event.durationMs = durationMs;
+				event.peakDb = 20.0f * std::log10(std::max(eventPeak, 1e-5f));
+				event.levelDb = powerDb(bestWindow / static_cast<double>(WINDOW_FRAMES * frameLength));
+			}
+			found++;
+		} else if (durationMs >= MAX_EVENT_MS) {
+			inEvent = false;
+			sustained = true;
+		} else {
+			const int slot = eventFrames % WINDOW_FRAMES;
+			windowSum += energy - windowEnergy[slot];
+			windowEnergy[slot] = energy;
+			bestWindow = std::max(bestWindow, windowSum);
+			eventEnergy += energy;
+			eventDiffEnergy += diffEnergy;
+			eventPeak = std::max(eventPeak, peak);
+			eventTopDb = std::max(eventTopDb, frameDb);
+			eventFrames++;
+		}
+	}
+
+	lastFrameDb = frameDb;
+	frames++;
+	filled = 0;
+	energy = 0.0;
+	diffEnergy = 0.0;
+	peak = 0.0f;
+}
+
+TransientProfile TransientDetector::profile(const float *samples, size_t count, uint32_t sampleRate)
+{
+	TransientProfile result;
+	if (!samples || sampleRate == 0)
+		return result;
+
+	TransientDetector detector;
+	detector.configure(sampleRate);
+
+	std::vector<float> peaks;
+	std::vector<float> levels;
+	std::vector<float> durations;
+	TransientEvent events[32];
+	const size_t chunk = sampleRate / 10;
+	for (size_t start = 0; start < count; start += chunk) {
+		const int n = std::min(detector.process(samples + start, std::min(chunk, count - start), events, 32), 32);
+		for (int k = 0; k < n; k++) {
+			if (events[k].kind == TransientKind::Click)
+				result.clicks++;
+			else
+				result.bumps++;
+			peaks.push_back(events[k].peakDb);
+			levels.push_back(events[k].levelDb);
+			durations.push_back(events[k].durationMs);
+		}
+	}
+
+	if (result.count() > 0) {
+		result.peakDb = percentile90(peaks);
+		result.levelDb = percentile90(levels);
+		result.durationMs = percentile90(durations);
+	}
+	return result;
+}
+
+std::string TransientProfile::summary() const
+{
+	if (count() == 0)
+		return "no transients";
+	char text[160];
+	snprintf(text, sizeof(text), "%d clicks, %d bumps; peak %.1f dB, 10 ms level %.1f dB, %.0f ms long (90th pct)",
+		 clicks, bumps, peakDb, levelDb, durationMs);
+	return text;
+}
@@ -0,0 +1,71 @@
+/*
+ * Voice Activity Implementation
+ * Copyright (C) 2025
+ */
+
+#include "voice-activity.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// Floor tracking per 10 ms frame: fall fast onto quiet frames, rise slowly
+// (about 1.5 dB/s) so sustained speech does not become the floor
+static constexpr float FLOOR_FALL = 0.3f;
+static constexpr float FLOOR_RISE_DB = 0.015f;
+
+// Frames used to seed the floor before making decisions
+static constexpr int WARMUP_FRAMES = 30;
+
+void VoiceActivityDetector::configure(uint32_t sampleRate)
+{
+	highPass = BiquadCoeffs::highPass(sampleRate, 150.0, 0.707);
+	lowPass = BiquadCoeffs::lowPass(sampleRate, std::min(4000.0, 0.45 * sampleRate), 0.707);
+	frameLength = std::max<size_t>(1, static_cast<size_t>(sampleRate * FRAME_MS / 1000.0f));
+	reset();
+}
+
+void VoiceActivityDetector::reset()
+{
+	highPassState.reset();
+	lowPassState.reset();
+	floorDb = -60.0f;
+	frameDb = -100.0f;
+	hangover = 0;
+	framesSeen = 0;
+}
+
+bool VoiceActivityDetector::process(const float *samples, size_t count)
+{
+	if (count == 0)
+		return isSpeech();
+
+	double sum = 0.0;
+	for (size_t i = 0; i < count; i++) {
+		const float y = lowPassState.process(lowPass, highPassState.process(highPass, samples[i]));
+		sum += static_cast<double>(y) * y;
+	}
+	return classify(sum / static_cast<double>(count));
+}
+
+bool VoiceActivityDetector::classify(double meanSquare)
+{
+	frameDb = meanSquare > 1e-12 ? static_cast<float>(10.0 * std::log10(meanSquare)) : -120.0f;
+
+	if (framesSeen < WARMUP_FRAMES) {
+		floorDb = framesSeen == 0 ? frameDb : std::min(floorDb, frameDb);
+		framesSeen++;
+		return false;
+	}
+
+	if (frameDb < floorDb)
+		floorDb += FLOOR_FALL * (frameDb - floorDb);
+	else
+		floorDb += FLOOR_RISE_DB;
+
+	const bool speech = frameDb > floorDb + SPEECH_MARGIN_DB && frameDb > MIN_SPEECH_DB;
+	if (speech)
+		hangover = HANGOVER_FRAMES;
+	else if (hangover > 0)
+		hangover--;
+	return isSpeech();
+}
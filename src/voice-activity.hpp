@@ -0,0 +1,57 @@
+/*
+ * Voice Activity - Energy-based speech detector with adaptive noise floor
+ * Copyright (C) 2025
+ *
+ * Works on 10 ms frames of the speech band (150 Hz - 4 kHz). The noise
+ * floor follows quiet frames quickly and creeps up slowly during speech, so
+ * a frame counts as speech when it stands clearly above the floor. A short
+ * hangover bridges the gaps between words.
+ */
+
+#ifndef VOICE_ACTIVITY_HPP
+#define VOICE_ACTIVITY_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "biquad.hpp"
+
+class VoiceActivityDetector {
+public:
+	static constexpr float FRAME_MS = 10.0f;
+	static constexpr float SPEECH_MARGIN_DB = 9.0f;
+	static constexpr float MIN_SPEECH_DB = -60.0f;
+	static constexpr int HANGOVER_FRAMES = 20;
+
+	void configure(uint32_t sampleRate);
+	void reset();
+
+	// Samples per decision at the configured rate
+	size_t frameSamples() const { return frameLength; }
+
+	// Classify one frame (normally frameSamples() long)
+	bool process(const float *samples, size_t count);
+
+	// Classify one frame from its speech-band mean square, measured
+	// elsewhere with the same filters (VadFeatures in a fused pipeline);
+	// this detector's own filters are not run
+	bool classify(double meanSquare);
+
+	bool isSpeech() const { return hangover > 0; }
+	float noiseFloorDb() const { return floorDb; }
+	float lastFrameDb() const { return frameDb; }
+
+private:
+	BiquadCoeffs highPass;
+	BiquadCoeffs lowPass;
+	BiquadState highPassState;
+	BiquadState lowPassState;
+	size_t frameLength = 480;
+
+	float floorDb = -60.0f;
+	float frameDb = -100.0f;
+	int hangover = 0;
+	int framesSeen = 0;
+};
+
+#endif // VOICE_ACTIVITY_HPP
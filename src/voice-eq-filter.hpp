@@ -0,0 +1,14 @@
+/*
+ * Voice EQ Filter - Native OBS parametric EQ for the voice-matching bands
+ * Copyright (C) 2025
+ */
+
+#ifndef VOICE_EQ_FILTER_HPP
+#define VOICE_EQ_FILTER_HPP
+
+static constexpr const char *VOICE_EQ_FILTER_ID = "audio_calibrator_voice_eq";
+
+// Registers the filter type with OBS (call from obs_module_load)
+void registerVoiceEqFilter();
+
+#endif // VOICE_EQ_FILTER_HPP
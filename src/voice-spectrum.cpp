@@ -0,0 +1,358 @@
+/*
+ * Voice Spectrum Implementation
+ * Copyright (C) 2025
+ */
+
+#include "voice-spectrum.hpp"
+#include "biquad.hpp"
+
+#include <util/platform.h>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+
+// Range the fit looks at: below 100 Hz the analysis frame has too few bins,
+// above 8 kHz the long-term spectrum is mostly sibilance
+static constexpr double FIT_START_HZ = 100.0;
+static constexpr double FIT_END_HZ = 8000.0;
+
+struct TargetPoint {
+	double hz;
+	double db;
+};
+
+// Long-term average speech spectrum (ANSI S3.5-1997 "normal" effort,
+// spectrum level in dB/Hz at the 1/3-octave centres). 100 and 125 Hz are
+// extrapolated from the 160-250 Hz slope.
+static const TargetPoint SPEECH_SPECTRUM[] = {
+	{100.0, 29.4},   {125.0, 31.4},   {160.0, 32.41},  {200.0, 34.48},  {250.0, 34.75},  {315.0, 33.98},
+	{400.0, 34.59},  {500.0, 34.27},  {630.0, 32.06},  {800.0, 28.30},  {1000.0, 25.01}, {1250.0, 23.00},
+	{1600.0, 20.15}, {2000.0, 17.32}, {2500.0, 13.18}, {3150.0, 11.55}, {4000.0, 9.33},  {5000.0, 5.31},
+	{6300.0, 2.59},  {8000.0, 1.13},
+};
+
+// Smooth step in octaves around cornerHz: 0 well below, 1 well above
+static double octaveStep(double hz, double cornerHz)
+{
+	return 1.0 / (1.0 + std::exp(-4.0 * std::log2(hz / cornerHz)));
+}
+
+// Bell in octaves around centerHz, about an octave wide at half height
+static double octaveBell(double hz, double centerHz)
+{
+	const double octaves = std::log2(hz / centerHz);
+	return std::exp(-2.77 * octaves * octaves);
+}
+
+static float rms(const std::vector<double> &values)
+{
+	double sum = 0.0;
+	for (double value : values)
+		sum += value * value;
+	return values.empty() ? 0.0f : static_cast<float>(std::sqrt(sum / values.size()));
+}
+
+LongTermSpectrum::LongTermSpectrum(std::shared_ptr<const DspTables> tables) : tables(std::move(tables))
+{
+	power.assign(this->tables->fft->bins(), 0.0);
+}
+
+void LongTermSpectrum::add(const float *samples, size_t count)
+{
+	const size_t n = tables->frameSize;
+	const size_t hop = n / 2;
+	if (count < n)
+		return;
+
+	std::vector<float> frame(n);
+	std::vector<std::complex<float>> spectrum(tables->fft->bins());
+	std::vector<std::complex<float>> scratch(n / 2);
+	const double gate = std::pow(10.0, gateDb / 10.0) * n;
+
+	for (size_t start = 0; start + n <= count; start += hop) {
+		double energy = 0.0;
+		for (size_t i = 0; i < n; i++)
+			energy += static_cast<double>(samples[start + i]) * samples[start + i];
+		if (energy < gate)
+			continue;
+
+		for (size_t i = 0; i < n; i++)
+			frame[i] = samples[start + i] * tables->window[i];
+		tables->fft->forwardReal(frame.data(), spectrum.data(), scratch.data());
+		for (size_t k = 0; k < spectrum.size(); k++)
+			power[k] += std::norm(spectrum[k]);
+		frameCount++;
+	}
+}
+
+void LongTermSpectrum::merge(const LongTermSpectrum &other)
+{
+	if (other.power.size() != power.size())
+		return;
+	for (size_t k = 0; k < power.size(); k++)
+		power[k] += other.power[k];
+	frameCount += other.frameCount;
+}
+
+std::vector<ResponsePoint> LongTermSpectrum::smoothed(double startHz, double endHz) const
+{
+	std::vector<ResponsePoint> points;
+	if (frameCount == 0)
+		return points;
+
+	// Running sum of bin powers so each 1/6-octave average is O(1)
+	std::vector<double> cumulative(power.size() + 1, 0.0);
+	for (size_t k = 0; k < power.size(); k++)
+		cumulative[k + 1] = cumulative[k] + power[k];
+
+	const double binHz = tables->binHz();
+	const double scale = 2.0 / (static_cast<double>(frameCount) * tables->windowPower * tables->config.sampleRate);
+	const double halfWidth = std::pow(2.0, 1.0 / 12.0);
+	for (double hz = startHz; hz <= endHz * 1.0001; hz *= std::pow(2.0, 1.0 / 12.0)) {
+		size_t lo = static_cast<size_t>(std::floor(hz / halfWidth / binHz));
+		size_t hi = static_cast<size_t>(std::ceil(hz * halfWidth / binHz));
+		lo = std::min(lo, power.size() - 1);
+		hi = std::min(std::max(hi, lo + 1), power.size());
+
+		ResponsePoint point;
+		point.hz = static_cast<float>(hz);
+		const double density = scale * (cumulative[hi] - cumulative[lo]) / static_cast<double>(hi - lo);
+		point.db = density > 1e-20 ? static_cast<float>(10.0 * std::log10(density)) : -200.0f;
+		points.push_back(point);
+	}
+	return points;
+}
+
+std::vector<ResponsePoint> LongTermSpectrum::thirdOctaveBands() const
+{
+	std::vector<ResponsePoint> points;
+	if (frameCount == 0)
+		return points;
+
+	const double scale = 2.0 / (static_cast<double>(frameCount) * tables->windowPower * tables->config.sampleRate);
+	for (const BandRange &band : tables->thirdOctaveBands) {
+		double sum = 0.0;
+		for (uint32_t k = band.firstBin; k <= band.lastBin && k < power.size(); k++)
+			sum += power[k];
+
+		ResponsePoint point;
+		point.hz = band.centerHz;
+		const double density = scale * sum / static_cast<double>(band.lastBin - band.firstBin + 1);
+		point.db = density > 1e-20 ? static_cast<float>(10.0 * std::log10(density)) : -200.0f;
+		points.push_back(point);
+	}
+	return points;
+}
+
+const char *VoiceEqFitter::describe(VoiceTarget target)
+{
+	switch (target) {
+	case VoiceTarget::Natural: return "Natural";
+	case VoiceTarget::Broadcast: return "Broadcast";
+	case VoiceTarget::Warm: return "Warm";
+	}
+	return "Natural";
+}
+
+float VoiceEqFitter::targetDb(VoiceTarget target, double hz)
+{
+	// Interpolate the speech spectrum on a log-frequency axis
+	const size_t count = sizeof(SPEECH_SPECTRUM) / sizeof(SPEECH_SPECTRUM[0]);
+	double db = SPEECH_SPECTRUM[0].db;
+	if (hz >= SPEECH_SPECTRUM[count - 1].hz) {
+		db = SPEECH_SPECTRUM[count - 1].db;
+	} else {
+		for (size_t i = 1; i < count; i++) {
+			if (hz < SPEECH_SPECTRUM[i].hz) {
+				const TargetPoint &a = SPEECH_SPECTRUM[i - 1];
+				const TargetPoint &b = SPEECH_SPECTRUM[i];
+				const double t = std::max(0.0, std::log(hz / a.hz) / std::log(b.hz / a.hz));
+				db = a.db + t * (b.db - a.db);
+				break;
+			}
+		}
+	}
+
+	switch (target) {
+	case VoiceTarget::Broadcast:
+		// Presence lift, less boom
+		db += 3.0 * octaveBell(hz, 4000.0) - 2.0 * octaveBell(hz, 250.0);
+		break;
+	case VoiceTarget::Warm:
+		// More chest, softer top
+		db += 2.0 * (1.0 - octaveStep(hz, 200.0)) - 2.0 * octaveStep(hz, 6000.0);
+		break;
+	case VoiceTarget::Natural: break;
+	}
+	return static_cast<float>(db);
+}
+
+// Response of one band at every fit frequency
+static void bandResponse(const VoiceEqBand &band, uint32_t sampleRate, const std::vector<double> &hz,
+			 std::vector<double> &out)
+{
+	const BiquadCoeffs coeffs = BiquadCoeffs::peaking(sampleRate, band.hz, band.q, band.gainDb);
+	for (size_t i = 0; i < hz.size(); i++)
+		out[i] = coeffs.responseDb(sampleRate, hz[i]);
+}
+
+// Least-squares gains for the current centres and widths, one band at a
+// time with the others held (the peaking response in dB is nearly
+// proportional to its gain at fixed Q)
+static void refineGains(VoiceEqBand *bands, int count, uint32_t sampleRate, const std::vector<double> &hz,
+			std::vector<double> &residual, std::vector<std::vector<double>> &responses)
+{
+	std::vector<double> shape(hz.size());
+	for (int pass = 0; pass < 8; pass++) {
+		for (int b = 0; b < count; b++) {
+			VoiceEqBand unit = bands[b];
+			unit.gainDb = 1.0f;
+			bandResponse(unit, sampleRate, hz, shape);
+
+			double num = 0.0;
+			double den = 0.0;
+			for (size_t i = 0; i < hz.size(); i++) {
+				residual[i] += responses[b][i];
+				num += residual[i] * shape[i];
+				den += shape[i] * shape[i];
+			}
+			const float gain = den > 0.0 ? static_cast<float>(num / den) : 0.0f;
+			bands[b].gainDb = std::max(VoiceEqFitter::MAX_CUT_DB, std::min(gain, VoiceEqFitter::MAX_BOOST_DB));
+
+			bandResponse(bands[b], sampleRate, hz, responses[b]);
+			for (size_t i = 0; i < hz.size(); i++)
+				residual[i] -= responses[b][i];
+		}
+	}
+}
+
+VoiceEqFit VoiceEqFitter::fit(const LongTermSpectrum &spectrum, VoiceTarget target)
+{
+	VoiceEqFit result;
+	const uint64_t startNs = os_gettime_ns();
+
+	if (spectrum.frames() < MIN_FRAMES) {
+		result.message = "Not enough speech for a voice spectrum; record the speaking steps";
+		return result;
+	}
+
+	const uint32_t sampleRate = spectrum.sampleRate();
+	const std::vector<ResponsePoint> measured =
+		spectrum.smoothed(FIT_START_HZ, std::min(FIT_END_HZ, sampleRate * 0.45));
+	if (measured.size() < 24) {
+		result.message = "Sample rate too low for a voice spectrum";
+		return result;
+	}
+
+	// Difference to the target at equal mean level (the gain stage sets the
+	// level; the EQ only reshapes)
+	std::vector<double> hz(measured.size());
+	std::vector<double> residual(measured.size());
+	double mean = 0.0;
+	for (size_t i = 0; i < measured.size(); i++) {
+		hz[i] = measured[i].hz;
+		residual[i] = targetDb(target, hz[i]) - measured[i].db;
+		mean += residual[i];
+	}
+	mean /= static_cast<double>(residual.size());
+	for (double &value : residual)
+		value -= mean;
+	result.errorBeforeDb = rms(residual);
+
+	const double binHz = static_cast<double>(sampleRate) / spectrum.frameSize();
+	std::vector<std::vector<double>> responses;
+	while (result.bandCount < VoiceEqBand::MAX_BANDS) {
+		size_t peak = 0;
+		for (size_t i = 1; i < residual.size(); i++) {
+			if (std::fabs(residual[i]) > std::fabs(residual[peak]))
+				peak = i;
+		}
+		if (std::fabs(residual[peak]) < TOLERANCE_DB)
+			break;
+
+		// Width where the error stays above half its peak, same sign
+		const double half = residual[peak] * 0.5;
+		size_t lo = peak;
+		while (lo > 0 && residual[lo - 1] * half > 0.0 && std::fabs(residual[lo - 1]) >= std::fabs(half))
+			lo--;
+		size_t hi = peak;
+		while (hi + 1 < residual.size() && residual[hi + 1] * half > 0.0 &&
+		       std::fabs(residual[hi + 1]) >= std::fabs(half))
+			hi++;
+		const double octaves = std::max(1.0 / 3.0, static_cast<double>(hi - lo + 1) / 12.0);
+		const double ratio = std::pow(2.0, octaves);
+
+		VoiceEqBand band;
+		band.hz = static_cast<float>(std::sqrt(hz[lo] * hz[hi]));
+
+		// A second band on top of one already at its bound would get round
+		// the boost and cut limits
+		bool overlaps = false;
+		for (int b = 0; b < result.bandCount; b++)
+			overlaps = overlaps || std::fabs(std::log2(band.hz / result.bands[b].hz)) < 0.5;
+		if (overlaps)
+			break;
+
+		// No narrower than two analysis bins, which is all the spectrum resolves
+		const double maxQ = std::min(MAX_Q, band.hz / (2.0 * binHz));
+		band.q = static_cast<float>(std::max(MIN_Q, std::min(std::sqrt(ratio) / (ratio - 1.0), maxQ)));
+		band.gainDb = std::max(MAX_CUT_DB, std::min(static_cast<float>(residual[peak]), MAX_BOOST_DB));
+
+		// Keep the band only if it still helps once all gains are refit
+		VoiceEqBand trial[VoiceEqBand::MAX_BANDS];
+		std::copy(result.bands, result.bands + result.bandCount, trial);
+		trial[result.bandCount] = band;
+		std::vector<std::vector<double>> trialResponses = responses;
+		trialResponses.emplace_back(hz.size());
+		bandResponse(band, sampleRate, hz, trialResponses.back());
+		std::vector<double> trialResidual = residual;
+		for (size_t i = 0; i < hz.size(); i++)
+			trialResidual[i] -= trialResponses.back()[i];
+		refineGains(trial, result.bandCount + 1, sampleRate, hz, trialResidual, trialResponses);
+
+		if (rms(trialResidual) > rms(residual) - 0.1f)
+			break;
+		result.bandCount++;
+		std::copy(trial, trial + result.bandCount, result.bands);
+		responses.swap(trialResponses);
+		residual.swap(trialResidual);
+	}
+
+	// Drop bands the refit has all but zeroed; the rest run low to high
+	int kept = 0;
+	for (int b = 0; b < result.bandCount; b++) {
+		if (std::fabs(result.bands[b].gainDb) >= 0.5f)
+			result.bands[kept++] = result.bands[b];
+	}
+	result.bandCount = kept;
+	std::sort(result.bands, result.bands + kept,
+		  [](const VoiceEqBand &a, const VoiceEqBand &b) { return a.hz < b.hz; });
+
+	result.errorAfterDb = rms(residual);
+	result.solveMs = static_cast<double>(os_gettime_ns() - startNs) / 1e6;
+	result.ok = true;
+	if (result.bandCount == 0)
+		result.message = "Voice already matches the target";
+	return result;
+}
+
+std::string VoiceEqFit::summary() const
+{
+	if (!ok)
+		return message;
+	if (bandCount == 0)
+		return message;
+
+	char part[96];
+	std::string text = "Voice EQ:";
+	for (int b = 0; b < bandCount; b++) {
+		snprintf(part, sizeof(part), " %.0f Hz %+.1f dB Q %.1f%s", bands[b].hz, bands[b].gainDb, bands[b].q,
+			 b + 1 < bandCount ? "," : "");
+		text += part;
+	}
+	snprintf(part, sizeof(part), " (off target %.1f dB -> %.1f dB RMS, %.1f ms)", errorBeforeDb, errorAfterDb,
+		 solveMs);
+	return text + part;
+}
@@ -0,0 +1,100 @@
+/*
+ * Voice Spectrum - Long-term average spectrum and voice-matching EQ fit
+ * Copyright (C) 2025
+ *
+ * The speaking steps are cut into the shared analysis frames (Hann window,
+ * half overlap) and their bin powers summed, skipping frames near the noise
+ * floor so pauses between words do not pull the spectrum towards the room.
+ * Each step is accumulated once as it is recorded and the steps are merged
+ * by adding their sums. The 1/6-octave smoothed result is compared with a
+ * target voice curve at equal overall level and the difference is fitted
+ * with a few peaking bands of bounded gain: greedily at the largest
+ * remaining error, then refined together by least squares on the gains.
+ */
+
+#ifndef VOICE_SPECTRUM_HPP
+#define VOICE_SPECTRUM_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "calibration-chain.hpp"
+#include "dsp-tables.hpp"
+#include "sweep-measurement.hpp"
+
+class LongTermSpectrum {
+public:
+	explicit LongTermSpectrum(std::shared_ptr<const DspTables> tables);
+
+	// Frames with an RMS below this are left out (set a little above the
+	// noise floor)
+	void setGateDb(float db) { gateDb = db; }
+
+	// Mono samples at the tables' sample rate; frames do not straddle calls
+	void add(const float *samples, size_t count);
+
+	// Adds other's frames; both must use the same tables
+	void merge(const LongTermSpectrum &other);
+
+	size_t frames() const { return frameCount; }
+	uint32_t sampleRate() const { return tables->config.sampleRate; }
+	size_t frameSize() const { return tables->frameSize; }
+
+	// Power spectral density in dB, 1/6-octave smoothed at 1/12-octave
+	// spacing (as SweepResult::response)
+	std::vector<ResponsePoint> smoothed(double startHz, double endHz) const;
+
+	// Power spectral density in dB in each of the tables' 1/3-octave bands,
+	// on the same scale as smoothed()
+	std::vector<ResponsePoint> thirdOctaveBands() const;
+
+private:
+	std::shared_ptr<const DspTables> tables;
+	std::vector<double> power; // summed |X|^2 per bin
+	size_t frameCount = 0;
+	float gateDb = -100.0f;
+};
+
+enum class VoiceTarget { Natural, Broadcast, Warm };
+
+struct VoiceEqFit {
+	bool ok = false;
+	std::string message;
+
+	VoiceEqBand bands[VoiceEqBand::MAX_BANDS];
+	int bandCount = 0;
+
+	// RMS of the level-matched difference from the target, 100 Hz - 8 kHz
+	float errorBeforeDb = 0.0f;
+	float errorAfterDb = 0.0f;
+
+	double solveMs = 0.0;
+
+	std::string summary() const;
+};
+
+class VoiceEqFitter {
+public:
+	static constexpr float MAX_BOOST_DB = 4.0f;
+	static constexpr float MAX_CUT_DB = -8.0f;
+	static constexpr double MIN_Q = 0.5;
+	static constexpr double MAX_Q = 3.0;
+
+	// Errors smaller than this are left alone
+	static constexpr float TOLERANCE_DB = 1.0f;
+
+	// Speech needed for a stable average
+	static constexpr size_t MIN_FRAMES = 200;
+
+	static const char *describe(VoiceTarget target);
+
+	// Target spectrum shape in dB at hz (arbitrary level)
+	static float targetDb(VoiceTarget target, double hz);
+
+	// Safe on a worker thread
+	static VoiceEqFit fit(const LongTermSpectrum &spectrum, VoiceTarget target);
+};
+
+#endif // VOICE_SPECTRUM_HPP
@@ -0,0 +1,236 @@
+/*
+ * WAV File Implementation
+ * Copyright (C) 2025
+ */
+
+#include "wav-file.hpp"
+#include <plugin-support.h>
+
+#include <obs.h>
+#include <util/platform.h>
+
+#include <algorithm>
+#include <cstring>
+
+static void putU16(uint8_t *dst, uint16_t value)
+{
+	dst[0] = static_cast<uint8_t>(value & 0xff);
+	dst[1] = static_cast<uint8_t>(value >> 8);
+}
+
+static void putU32(uint8_t *dst, uint32_t value)
+{
+	for (int i = 0; i < 4; i++)
+		dst[i] = static_cast<uint8_t>((value >> (8 * i)) & 0xff);
+}
+
+WavWriter::~WavWriter()
+{
+	close();
+}
+
+bool WavWriter::open(const std::string &path, uint32_t sampleRate, uint16_t channels)
+{
+	close();
+
+	file = os_fopen(path.c_str(), "wb");
+	if (!file) {
+		obs_log(LOG_WARNING, "[WavWriter] Cannot open %s for writing", path.c_str());
+		return false;
+	}
+
+	rate = sampleRate;
+	channelCount = channels > 0 ? channels : 1;
+	dataBytes = 0;
+	return writeHeader();
+}
+
+bool WavWriter::writeHeader()
+{
+	// RIFF/WAVE with a WAVE_FORMAT_IEEE_FLOAT fmt chunk
+	uint8_t header[44];
+	const uint32_t dataSize = dataBytes > 0xffffffd3ull ? 0xffffffd3u : static_cast<uint32_t>(dataBytes);
+	const uint16_t blockAlign = static_cast<uint16_t>(channelCount * sizeof(float));
+
+	std::memcpy(header, "RIFF", 4);
+	putU32(header + 4, 36 + dataSize);
+	std::memcpy(header + 8, "WAVE", 4);
+	std::memcpy(header + 12, "fmt ", 4);
+	putU32(header + 16, 16);
+	putU16(header + 20, 3);
+	putU16(header + 22, channelCount);
+	putU32(header + 24, rate);
+	putU32(header + 28, rate * blockAlign);
+	putU16(header + 32, blockAlign);
+	putU16(header + 34, 32);
+	std::memcpy(header + 36, "data", 4);
+	putU32(header + 40, dataSize);
+
+	return fwrite(header, 1, sizeof(header), file) == sizeof(header);
+}
+
+bool WavWriter::write(const float *frames, size_t frameCount)
+{
+	if (!file)
+		return false;
+
+	// WAV is little-endian, as are all platforms OBS ships on
+	const size_t count = frameCount * channelCount;
+	if (fwrite(frames, sizeof(float), count, file) != count)
+		return false;
+
+	dataBytes += count * sizeof(float);
+	return true;
+}
+
+bool WavWriter::close()
+{
+	if (!file)
+		return true;
+
+	bool ok = fseek(file, 0, SEEK_SET) == 0 && writeHeader();
+	ok = fclose(file) == 0 && ok;
+	file = nullptr;
+	return ok;
+}
+
+static uint16_t getU16(const uint8_t *src)
+{
+	return static_cast<uint16_t>(src[0] | (src[1] << 8));
+}
+
+static uint32_t getU32(const uint8_t *src)
+{
+	return static_cast<uint32_t>(src[0]) | (static_cast<uint32_t>(src[1]) << 8) |
+	       (static_cast<uint32_t>(src[2]) << 16) | (static_cast<uint32_t>(src[3]) << 24);
+}
+
+static float decodeSample(const uint8_t *src, bool isFloat, uint16_t bits)
+{
+	if (isFloat) {
+		float value;
+		std::memcpy(&value, src, sizeof(value));
+		return value;
+	}
+
+	switch (bits) {
+	case 16:
+		return static_cast<float>(static_cast<int16_t>(getU16(src))) / 32768.0f;
+	case 24: {
+		// Sign-extend from the top byte
+		const int32_t value = static_cast<int32_t>((static_cast<uint32_t>(src[0]) << 8) |
+							   (static_cast<uint32_t>(src[1]) << 16) |
+							   (static_cast<uint32_t>(src[2]) << 24)) >>
+				      8;
+		return static_cast<float>(value) / 8388608.0f;
+	}
+	default:
+		return static_cast<float>(static_cast<int32_t>(getU32(src))) / 2147483648.0f;
+	}
+}
+
+bool WavReader::read(const std::string &path, WavAudio &audio)
+{
+	FILE *file = os_fopen(path.c_str(), "rb");
+	if (!file) {
+		obs_log(LOG_WARNING, "[WavReader] Cannot open %s", path.c_str());
+		return false;
+	}
+
+	auto fail = [&](const char *reason) {
+		obs_log(LOG_WARNING, "[WavReader] %s: %s", path.c_str(), reason);
+		fclose(file);
+		return false;
+	};
+
+	uint8_t riff[12];
+	if (fread(riff, 1, sizeof(riff), file) != sizeof(riff) || std::memcmp(riff, "RIFF", 4) != 0 ||
+	    std::memcmp(riff + 8, "WAVE", 4) != 0)
+		return fail("not a RIFF/WAVE file");
+
+	uint16_t format = 0;
+	uint16_t channels = 0;
+	uint16_t bits = 0;
+	uint32_t rate = 0;
+	bool haveFormat = false;
+	uint32_t dataSize = 0;
+
+	for (;;) {
+		uint8_t chunk[8];
+		if (fread(chunk, 1, sizeof(chunk), file) != sizeof(chunk))
+			return fail("no data chunk");
+		const uint32_t size = getU32(chunk + 4);
+
+		if (std::memcmp(chunk, "fmt ", 4) == 0) {
+			uint8_t fmt[40] = {};
+			const size_t wanted = std::min<size_t>(size, sizeof(fmt));
+			if (size < 16 || fread(fmt, 1, wanted, file) != wanted)
+				return fail("truncated fmt chunk");
+			format = getU16(fmt);
+			channels = getU16(fmt + 2);
+			rate = getU32(fmt + 4);
+			bits = getU16(fmt + 14);
+			// WAVE_FORMAT_EXTENSIBLE keeps the real format in the sub-format GUID
+			if (format == 0xfffe && size >= 26)
+				format = getU16(fmt + 24);
+			haveFormat = true;
+			if (size > wanted && fseek(file, static_cast<long>(size - wanted), SEEK_CUR) != 0)
+				return fail("truncated fmt chunk");
+		} else if (std::memcmp(chunk, "data", 4) == 0) {
+			dataSize = size;
+			break;
+		} else if (fseek(file, static_cast<long>(size), SEEK_CUR) != 0) {
+			return fail("truncated chunk");
+		}
+		// Chunks are word aligned
+		if ((size & 1) && fseek(file, 1, SEEK_CUR) != 0)
+			return fail("truncated chunk");
+	}
+
+	const bool isFloat = format == 3 && bits == 32;
+	const bool isPcm = format == 1 && (bits == 16 || bits == 24 || bits == 32);
+	if (!haveFormat || channels == 0 || rate == 0 || (!isFloat && !isPcm))
+		return fail("unsupported sample format");
+
+	audio.sampleRate = rate;
+	audio.channels.assign(channels, {});
+
+	// Trailing chunks (LIST, id3) must not be read as audio, so the data
+	// size is honoured. Writers that are still recording or crashed leave
+	// it 0 or 0xFFFFFFFF, and files over 4 GB overflow it; those are read
+	// to EOF.
+	const int64_t dataStart = os_ftelli64(file);
+	if (dataStart < 0 || os_fseeki64(file, 0, SEEK_END) != 0)
+		return fail("cannot seek");
+	const int64_t fileEnd = os_ftelli64(file);
+	if (fileEnd < dataStart || os_fseeki64(file, dataStart, SEEK_SET) != 0)
+		return fail("cannot seek");
+	uint64_t remaining = static_cast<uint64_t>(fileEnd - dataStart);
+	if (dataSize != 0 && dataSize != 0xFFFFFFFFu && dataSize <= remaining)
+		remaining = dataSize;
+
+	const size_t frameBytes = static_cast<size_t>(channels) * (bits / 8);
+	std::vector<uint8_t> buffer(frameBytes * 4096);
+	while (remaining >= frameBytes) {
+		const size_t wanted = static_cast<size_t>(std::min<uint64_t>(buffer.size(), remaining));
+		const size_t got = fread(buffer.data(), 1, wanted - wanted % frameBytes, file) / frameBytes;
+		if (got == 0)
+			break;
+		remaining -= got * frameBytes;
+		for (uint16_t c = 0; c < channels; c++) {
+			std::vector<float> &out = audio.channels[c];
+			const size_t offset = out.size();
+			out.resize(offset + got);
+			const uint8_t *in = buffer.data() + c * (bits / 8);
+			for (size_t i = 0; i < got; i++)
+				out[offset + i] = decodeSample(in + i * frameBytes, isFloat, bits);
+		}
+	}
+	fclose(file);
+
+	if (audio.frames() == 0) {
+		obs_log(LOG_WARNING, "[WavReader] %s: no audio", path.c_str());
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,59 @@
+/*
+ * WAV File - Streaming 32-bit float WAV writer and whole-file reader
+ * Copyright (C) 2025
+ */
+
+#ifndef WAV_FILE_HPP
+#define WAV_FILE_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Writes the header up front and patches the chunk sizes on close, so
+// arbitrarily long renders never need to be held in memory.
+class WavWriter {
+public:
+	WavWriter() = default;
+	~WavWriter();
+
+	WavWriter(const WavWriter &) = delete;
+	WavWriter &operator=(const WavWriter &) = delete;
+
+	// path is UTF-8
+	bool open(const std::string &path, uint32_t sampleRate, uint16_t channels);
+
+	// Interleaved frames
+	bool write(const float *frames, size_t frameCount);
+
+	bool close();
+
+	bool isOpen() const { return file != nullptr; }
+	uint64_t framesWritten() const { return dataBytes / (sizeof(float) * channelCount); }
+
+private:
+	bool writeHeader();
+
+	FILE *file = nullptr;
+	uint32_t rate = 0;
+	uint16_t channelCount = 1;
+	uint64_t dataBytes = 0;
+};
+
+// Planar float samples of a whole file
+struct WavAudio {
+	uint32_t sampleRate = 0;
+	std::vector<std::vector<float>> channels;
+
+	size_t frames() const { return channels.empty() ? 0 : channels[0].size(); }
+};
+
+class WavReader {
+public:
+	// 16/24/32-bit PCM and 32-bit float, plain or WAVE_FORMAT_EXTENSIBLE.
+	// path is UTF-8.
+	static bool read(const std::string &path, WavAudio &audio);
+};
+
+#endif // WAV_FILE_HPP
@@ -0,0 +1,165 @@
+/*
+ * Worker Pool Implementation
+ * Copyright (C) 2025
+ */
+
+#include "worker-pool.hpp"
+#include <plugin-support.h>
+
+#include <obs.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+WorkerPool &WorkerPool::shared()
+{
+	static WorkerPool pool(std::max(2u, std::thread::hardware_concurrency() / 2));
+	return pool;
+}
+
+WorkerPool::WorkerPool(size_t threads) : targetThreads(threads) {}
+
+WorkerPool::~WorkerPool()
+{
+	shutdown();
+}
+
+void WorkerPool::start()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (stopping || !threads.empty())
+		return;
+
+	for (size_t i = 0; i < targetThreads; i++)
+		threads.emplace_back(&WorkerPool::workerLoop, this);
+	pollThread = std::thread(&WorkerPool::pollLoop, this);
+	obs_log(LOG_INFO, "[WorkerPool] Started %zu worker threads", targetThreads);
+}
+
+bool WorkerPool::submit(std::function<void()> task)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (stopping)
+			return false;
+		tasks.push_back(std::move(task));
+	}
+	wake.notify_one();
+	return true;
+}
+
+int WorkerPool::addPoller(std::function<void()> poll)
+{
+	auto poller = std::make_shared<const std::function<void()>>(std::move(poll));
+
+	std::lock_guard<std::mutex> lock(mutex);
+	const int id = nextPollerId++;
+	pollers.emplace(id, std::move(poller));
+	return id;
+}
+
+void WorkerPool::removePoller(int id)
+{
+	Poller removed;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = pollers.find(id);
+		if (it == pollers.end())
+			return;
+		removed = std::move(it->second);
+		pollers.erase(it);
+	}
+	// Destroyed outside the lock, in case it holds the last reference to
+	// something that removes other pollers
+}
+
+void WorkerPool::parallelChunks(size_t total, ChunkTask task, std::function<void()> done)
+{
+	struct Fanout {
+		ChunkTask task;
+		std::function<void()> done;
+		std::atomic<size_t> remaining{0};
+	};
+	auto fanout = std::make_shared<Fanout>();
+	fanout->task = std::move(task);
+	fanout->done = std::move(done);
+
+	const size_t chunks = std::max<size_t>(1, std::min(targetThreads, total));
+	fanout->remaining = chunks;
+	auto run = [fanout](size_t chunk, size_t first, size_t last) {
+		fanout->task(chunk, first, last);
+		if (fanout->remaining.fetch_sub(1) == 1)
+			fanout->done();
+	};
+
+	// Queue the others first so they overlap with the inline chunk
+	for (size_t c = chunks; c-- > 0;) {
+		const size_t first = total * c / chunks;
+		const size_t last = total * (c + 1) / chunks;
+		if (c == 0 || !submit([run, c, first, last]() { run(c, first, last); }))
+			run(c, first, last);
+	}
+}
+
+void WorkerPool::shutdown()
+{
+	std::vector<std::thread> joining;
+	std::thread polling;
+	std::map<int, Poller> removed;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (stopping)
+			return;
+		stopping = true;
+		joining.swap(threads);
+		polling.swap(pollThread);
+		removed.swap(pollers);
+	}
+	wake.notify_all();
+	pollWake.notify_all();
+
+	if (polling.joinable())
+		polling.join();
+	for (auto &thread : joining) {
+		if (thread.joinable())
+			thread.join();
+	}
+}
+
+void WorkerPool::workerLoop()
+{
+	for (;;) {
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake.wait(lock, [this]() { return stopping || !tasks.empty(); });
+			if (tasks.empty())
+				return;
+			task = std::move(tasks.front());
+			tasks.pop_front();
+		}
+		task();
+	}
+}
+
+void WorkerPool::pollLoop()
+{
+	std::vector<Poller> running;
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			pollWake.wait_for(lock, std::chrono::milliseconds(POLL_MS), [this]() { return stopping; });
+			if (stopping)
+				return;
+			for (const auto &entry : pollers)
+				running.push_back(entry.second);
+		}
+
+		for (const Poller &poll : running)
+			(*poll)();
+
+		// A poller removed in the meantime is destroyed here
+		running.clear();
+	}
+}
@@ -0,0 +1,81 @@
+/*
+ * Worker Pool - Shared background threads for analysis work
+ * Copyright (C) 2025
+ *
+ * Anything that must not run on the audio or UI thread (table planning,
+ * offline analysis, encoding) is submitted here. The audio thread never
+ * submits: it raises an atomic flag that a poller (run every POLL_MS on
+ * the pool's poll thread) picks up.
+ */
+
+#ifndef WORKER_POOL_HPP
+#define WORKER_POOL_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkerPool {
+public:
+	static WorkerPool &shared();
+
+	static constexpr int POLL_MS = 10;
+
+	using ChunkTask = std::function<void(size_t chunk, size_t first, size_t last)>;
+
+	// Start the worker and poll threads. Called from obs_module_load;
+	// tasks submitted before then wait for it.
+	void start();
+
+	// Queue a task. Locks and allocates, so never call it from the audio
+	// thread. Returns false once the pool has been shut down.
+	bool submit(std::function<void()> task);
+
+	// Run poll every POLL_MS on the poll thread until removed. poll must be
+	// short (it may submit longer work) and may run once more after
+	// removePoller returns, so it should hold weak references only.
+	int addPoller(std::function<void()> poll);
+	void removePoller(int id);
+
+	// Splits [0, total) into one contiguous chunk per thread and runs task
+	// on each; done runs once, on the thread that finishes the last chunk.
+	// Chunk 0, and any chunk the pool refuses, runs on the calling thread,
+	// so call this from a task of the pool rather than the UI thread.
+	void parallelChunks(size_t total, ChunkTask task, std::function<void()> done);
+
+	size_t threadCount() const { return targetThreads; }
+
+	// Drain and join all threads. Called from obs_module_unload so that no
+	// worker outlives the module.
+	void shutdown();
+
+private:
+	explicit WorkerPool(size_t threads);
+	~WorkerPool();
+
+	WorkerPool(const WorkerPool &) = delete;
+	WorkerPool &operator=(const WorkerPool &) = delete;
+
+	void workerLoop();
+	void pollLoop();
+
+	using Poller = std::shared_ptr<const std::function<void()>>;
+
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable pollWake;
+	std::deque<std::function<void()>> tasks;
+	std::vector<std::thread> threads;
+	std::thread pollThread;
+	std::map<int, Poller> pollers;
+	int nextPollerId = 1;
+	size_t targetThreads;
+	bool stopping = false;
+};
+
+#endif // WORKER_POOL_HPP